@@ -0,0 +1,312 @@
+// arena.h - Per-thread monotonic arenas for kernel scratch memory
+#pragma once
+
+#include "memory.h"
+
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace compas {
+
+struct ArenaStats {
+    size_t reserved = 0;           // bytes held by all arenas, in use or spare
+    size_t high_water = 0;         // most bytes one arena had in use at once
+    size_t chunk_allocations = 0;  // heap allocations made by arenas
+    size_t arenas = 0;             // threads that currently own an arena
+};
+
+/**
+ * Process-wide arena bookkeeping: statistics and the chunks of threads that have exited
+ * parallel_for starts fresh worker threads on every call, so their chunks are parked here on
+ * thread exit and adopted by the next workers instead of going back to the heap.
+ */
+struct ArenaRegistry {
+    std::mutex mutex;
+    std::vector<std::pair<std::byte*, size_t>> spare;
+    std::atomic<size_t> reserved{0};
+    std::atomic<size_t> high_water{0};
+    std::atomic<size_t> chunk_allocations{0};
+    std::atomic<size_t> arenas{0};
+
+    static ArenaRegistry& instance() {
+        static ArenaRegistry registry;
+        return registry;
+    }
+
+    ~ArenaRegistry() {
+        for (auto [data, size] : spare)
+            ::operator delete(data, size);
+    }
+};
+
+/**
+ * Monotonic bump allocator that is rewound rather than freed
+ * Allocation is a pointer bump inside the current chunk. When a chunk is full a larger one is
+ * added; once the arena is rewound to empty the chunks are merged into one that holds the
+ * high-water mark, so a kernel called again with the same sizes never touches the heap.
+ * Only trivially destructible objects live here, nothing is destroyed on rewind.
+ */
+class Arena {
+public:
+    static constexpr size_t MIN_CHUNK = size_t(64) << 10;
+
+    struct Mark {
+        size_t chunk = 0;
+        size_t offset = 0;
+    };
+
+    Arena() { ++ArenaRegistry::instance().arenas; }
+
+    ~Arena() {
+        auto& registry = ArenaRegistry::instance();
+        --registry.arenas;
+        if (chunks_.empty())
+            return;
+        merge();
+        if (chunks_.empty())
+            return;
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.spare.emplace_back(chunks_[0].data, chunks_[0].size);
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @return Uninitialized storage of at least `bytes` bytes, valid until the arena is rewound past it
+     */
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        if (chunk_ < chunks_.size()) {
+            size_t offset = aligned(offset_, align);
+            if (offset + bytes <= chunks_[chunk_].size)
+                return bump(offset, bytes);
+        }
+        next_chunk(bytes + align);
+        return bump(aligned(offset_, align), bytes);
+    }
+
+    Mark mark() const { return {chunk_, offset_}; }
+
+    /**
+     * Release everything allocated after a mark
+     */
+    void rewind(Mark mark) {
+        chunk_ = mark.chunk;
+        offset_ = mark.offset;
+        used_ = mark.chunk < bases_.size() ? bases_[mark.chunk] + mark.offset : 0;
+        if (used_ == 0 && chunks_.size() > 1)
+            merge();
+    }
+
+    /**
+     * @return Bytes in use
+     */
+    size_t used() const { return used_; }
+
+private:
+    struct Chunk {
+        std::byte* data;
+        size_t size;
+    };
+
+    // Chunks are only aligned for max_align_t, so over-aligned types such as vectorized Eigen
+    // matrices are aligned by address rather than by offset
+    size_t aligned(size_t offset, size_t align) const {
+        auto address = reinterpret_cast<uintptr_t>(chunks_[chunk_].data) + offset;
+        return offset + ((align - address % align) % align);
+    }
+
+    void* bump(size_t offset, size_t bytes) {
+        offset_ = offset + bytes;
+        used_ = bases_[chunk_] + offset_;
+        auto& high_water = ArenaRegistry::instance().high_water;
+        for (size_t seen = high_water.load(std::memory_order_relaxed); used_ > seen && !high_water.compare_exchange_weak(seen, used_);) {
+        }
+        return chunks_[chunk_].data + offset;
+    }
+
+    void next_chunk(size_t bytes) {
+        // Move on to a retained chunk if it is big enough, otherwise drop the rest and grow
+        size_t next = chunks_.empty() ? 0 : chunk_ + 1;
+        if (next < chunks_.size() && chunks_[next].size >= bytes) {
+            chunk_ = next;
+            offset_ = 0;
+            return;
+        }
+        while (chunks_.size() > next)
+            release_last();
+        size_t base = chunks_.empty() ? 0 : bases_.back() + chunks_.back().size;
+        size_t size = std::max({bytes, MIN_CHUNK, chunks_.empty() ? size_t(0) : 2 * chunks_.back().size});
+        chunks_.reserve(chunks_.size() + 1);
+        bases_.reserve(bases_.size() + 1);
+        chunks_.push_back(obtain(size));
+        bases_.push_back(base);
+        chunk_ = chunks_.size() - 1;
+        offset_ = 0;
+    }
+
+    /**
+     * Smallest parked chunk that fits, a new heap chunk otherwise
+     * Best fit lets workers that start in any order share out the chunks of the previous call.
+     */
+    static Chunk obtain(size_t bytes, bool enforce = true) {
+        auto& registry = ArenaRegistry::instance();
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            auto best = registry.spare.end();
+            for (auto it = registry.spare.begin(); it != registry.spare.end(); ++it)
+                if (it->second >= bytes && (best == registry.spare.end() || it->second < best->second))
+                    best = it;
+            if (best != registry.spare.end()) {
+                Chunk chunk{best->first, best->second};
+                *best = registry.spare.back();
+                registry.spare.pop_back();
+                return chunk;
+            }
+        }
+        track_allocation(MemoryTag::ARENA, bytes, enforce);
+        Chunk chunk{nullptr, bytes};
+        try {
+            chunk.data = static_cast<std::byte*>(::operator new(bytes));
+        } catch (...) {
+            track_release(MemoryTag::ARENA, bytes);
+            throw;
+        }
+        registry.reserved += bytes;
+        ++registry.chunk_allocations;
+        return chunk;
+    }
+
+    void release_last() {
+        ::operator delete(chunks_.back().data, chunks_.back().size);
+        ArenaRegistry::instance().reserved -= chunks_.back().size;
+        track_release(MemoryTag::ARENA, chunks_.back().size);
+        chunks_.pop_back();
+        bases_.pop_back();
+    }
+
+    /**
+     * Replace all chunks of an empty arena by one as large as all of them together
+     * Runs on rewind, so it must not throw; if the memory is gone the arena simply starts empty.
+     */
+    void merge() noexcept {
+        if (chunks_.size() > 1) {
+            size_t total = bases_.back() + chunks_.back().size;
+            while (!chunks_.empty())
+                release_last();
+            try {
+                chunks_.push_back(obtain(total, false));
+                bases_.push_back(0);
+            } catch (const std::bad_alloc&) {
+            }
+        }
+        chunk_ = offset_ = used_ = 0;
+    }
+
+    std::vector<Chunk> chunks_;
+    std::vector<size_t> bases_;  // bytes in the chunks before each chunk
+    size_t chunk_ = 0;
+    size_t offset_ = 0;
+    size_t used_ = 0;
+};
+
+/**
+ * Whether objects of type T may be dropped without running their destructor
+ * Eigen::AlignedBox declares an empty destructor, so it is not trivially destructible although
+ * skipping it is harmless.
+ */
+template <class T>
+struct scratch_safe : std::is_trivially_destructible<T> {};
+
+template <class Scalar, int Dim>
+struct scratch_safe<Eigen::AlignedBox<Scalar, Dim>> : std::true_type {};
+
+/**
+ * @return Arena of the calling thread
+ */
+inline Arena& thread_arena() {
+    thread_local Arena arena;
+    return arena;
+}
+
+/**
+ * Scratch allocations from the thread arena, all returned when the scope ends
+ * Scopes nest like the calls that open them, so a kernel may call another that uses scratch.
+ */
+class Scratch {
+public:
+    Scratch() : arena_(thread_arena()), mark_(arena_.mark()) {}
+    ~Scratch() { arena_.rewind(mark_); }
+
+    Scratch(const Scratch&) = delete;
+    Scratch& operator=(const Scratch&) = delete;
+
+    /**
+     * @return n uninitialized objects
+     */
+    template <class T>
+    std::span<T> array(size_t n) {
+        static_assert(scratch_safe<T>::value, "Scratch arrays are never destroyed.");
+        return {static_cast<T*>(arena_.allocate(n * sizeof(T), alignof(T))), n};
+    }
+
+    /**
+     * @return n copies of value
+     */
+    template <class T>
+    std::span<T> array(size_t n, const T& value) {
+        std::span<T> out = array<T>(n);
+        std::uninitialized_fill(out.begin(), out.end(), value);
+        return out;
+    }
+
+private:
+    Arena& arena_;
+    Arena::Mark mark_;
+};
+
+/**
+ * @return Statistics of all arenas
+ */
+inline ArenaStats arena_stats() {
+    auto& registry = ArenaRegistry::instance();
+    return {registry.reserved.load(), registry.high_water.load(), registry.chunk_allocations.load(), registry.arenas.load()};
+}
+
+/**
+ * Restart the high-water mark and allocation count
+ */
+inline void reset_arena_stats() {
+    auto& registry = ArenaRegistry::instance();
+    registry.high_water = 0;
+    registry.chunk_allocations = 0;
+}
+
+/**
+ * Return the chunks parked by exited threads to the heap
+ * @return Bytes released
+ */
+inline size_t trim_arenas() {
+    auto& registry = ArenaRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    size_t released = 0;
+    for (auto [data, size] : registry.spare) {
+        ::operator delete(data, size);
+        track_release(MemoryTag::ARENA, size);
+        released += size;
+    }
+    registry.spare.clear();
+    registry.reserved -= released;
+    return released;
+}
+
+} // namespace compas
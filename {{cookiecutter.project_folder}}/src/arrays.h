@@ -0,0 +1,133 @@
+// arrays.h - Shared ndarray types and conversions for the COMPAS C++ extensions
+#pragma once
+
+#include "compas.h"
+#include "arena.h"
+#include "memory.h"
+#include "mesh.h"
+#include "predicates.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Read-only inputs, row-major on the CPU
+template <int D>
+using RowsIn = nb::ndarray<const double, nb::shape<-1, D>, nb::c_contig, nb::device::cpu>;
+using PointsIn = RowsIn<3>;
+using FacesIn = nb::ndarray<const int32_t, nb::shape<-1, 3>, nb::c_contig, nb::device::cpu>;
+using BoxesIn = nb::ndarray<const double, nb::shape<-1, 6>, nb::c_contig, nb::device::cpu>;
+using ValuesIn = nb::ndarray<const double, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+using OffsetsIn = nb::ndarray<const int64_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+// Caller-provided outputs, written in place
+template <int D>
+using RowsOut = nb::ndarray<double, nb::shape<-1, D>, nb::c_contig, nb::device::cpu>;
+using ValuesOut = nb::ndarray<double, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Move a result buffer into a NumPy array without copying
+ * The buffer is kept alive by a capsule until the array is garbage collected. Its allocator
+ * accounted the memory under MemoryTag::ARRAYS when it was allocated and releases it with it.
+ * @param data Buffer holding the array contents in row-major order
+ * @param shape Shape of the resulting array
+ * @return NumPy array owning the buffer
+ */
+template <class T>
+nb::ndarray<nb::numpy, T> to_ndarray(compas::ArrayBuffer<T>&& data, std::initializer_list<size_t> shape) {
+    auto* owner = new compas::ArrayBuffer<T>(std::move(data));
+    nb::capsule deleter(owner, [](void* p) noexcept { delete static_cast<compas::ArrayBuffer<T>*>(p); });
+    return nb::ndarray<nb::numpy, T>(owner->data(), shape, deleter);
+}
+
+/**
+ * Copy index pairs into an (K,2) int32 NumPy array
+ * @param pairs Index pairs
+ * @return NumPy array with one pair per row
+ */
+template <class Pair>
+nb::ndarray<nb::numpy, int32_t> pairs_to_ndarray(const std::vector<Pair>& pairs) {
+    compas::ArrayBuffer<int32_t> flat(2 * pairs.size());
+    for (size_t k = 0; k < pairs.size(); ++k) {
+        flat[2 * k] = static_cast<int32_t>(pairs[k].first);
+        flat[2 * k + 1] = static_cast<int32_t>(pairs[k].second);
+    }
+    return to_ndarray(std::move(flat), {pairs.size(), 2});
+}
+
+/**
+ * Check that an offsets array partitions `size` items into `count` consecutive ranges
+ * @param offsets (count+1,) non-decreasing offsets starting at 0 and ending at size
+ * @param count Expected number of ranges
+ * @param size Total number of items
+ * @param name Name used in the error message
+ */
+inline void check_offsets(const OffsetsIn& offsets, size_t count, size_t size, const char* name) {
+    const int64_t* o = offsets.data();
+    bool valid = offsets.shape(0) == count + 1 && o[0] == 0 && static_cast<size_t>(o[count]) == size;
+    for (size_t i = 0; valid && i < count; ++i)
+        valid = o[i] <= o[i + 1];
+    if (!valid)
+        throw std::invalid_argument(std::string(name) + " must hold " + std::to_string(count + 1) + " non-decreasing offsets from 0 to " + std::to_string(size) + ".");
+}
+
+/**
+ * Wrap vertex and face arrays as a mesh view
+ * @param vertices (V,3) vertex coordinates
+ * @param faces (F,3) vertex indices per face
+ * @return Validated view of the arrays
+ */
+inline compas::MeshView mesh_view(const PointsIn& vertices, const FacesIn& faces) {
+    compas::MeshView mesh{vertices.data(), vertices.shape(0), faces.data(), faces.shape(0)};
+    mesh.validate();
+    return mesh;
+}
+
+/**
+ * Point this extension at the process-wide memory ledger, like share_predicate_counts()
+ * Called first thing in every module, before any allocation is tracked.
+ */
+inline void share_memory_ledger() {
+    const char* name = "_compas_memory_ledger_v1";
+    nb::module_ sys = nb::module_::import_("sys");
+    if (!nb::hasattr(sys, name))
+        sys.attr(name) = nb::capsule(&compas::memory_ledger());
+    compas::memory_ledger_slot().store(static_cast<compas::MemoryLedger*>(nb::cast<nb::capsule>(sys.attr(name)).data()));
+}
+
+/**
+ * Point this extension at the process-wide predicate statistics, creating them if this is the first one
+ * Every extension is its own shared library with its own counters, so the first one to load publishes
+ * its registry through a capsule on the sys module and the others adopt it. Called by every module
+ * whose kernels evaluate predicates, so that predicates.stats() also counts the evaluations made
+ * inside other extensions.
+ */
+inline void share_predicate_counts() {
+    const char* name = "_compas_predicate_registry_v1";
+    nb::module_ sys = nb::module_::import_("sys");
+    if (!nb::hasattr(sys, name))
+        sys.attr(name) = nb::capsule(&compas::detail::predicate_registry());
+    compas::detail::predicate_registry_slot().store(static_cast<compas::detail::PredicateRegistry*>(nb::cast<nb::capsule>(sys.attr(name)).data()));
+}
+
+/**
+ * Add arena_stats(), reset_arena_stats() and trim_arenas() to a module whose kernels use scratch
+ * Every extension is its own shared library with its own arenas, so the Python side sums the
+ * statistics over the modules that define these functions.
+ * @param m Extension module
+ */
+inline void def_arena_stats(nb::module_& m) {
+    m.def("arena_stats", [] {
+        compas::ArenaStats stats = compas::arena_stats();
+        nb::dict result;
+        result["reserved"] = stats.reserved;
+        result["high_water"] = stats.high_water;
+        result["chunk_allocations"] = stats.chunk_allocations;
+        result["arenas"] = stats.arenas;
+        return result;
+    }, "Bytes held by the scratch arenas of this module, their high-water mark and heap allocations");
+    m.def("reset_arena_stats", &compas::reset_arena_stats, "Restart the arena high-water mark and allocation count");
+    m.def("trim_arenas", &compas::trim_arenas, "Free the arena memory parked by exited worker threads");
+}
@@ -0,0 +1,133 @@
+#include "compas.h"
+#include "arrays.h"
+#include "attributes.h"
+
+#include <nanobind/stl/optional.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+#include <optional>
+
+using namespace compas;
+
+using IndicesIn = nb::ndarray<const int32_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+using RealsIn = nb::ndarray<const double, nb::c_contig, nb::device::cpu>;
+using IntegersIn = nb::ndarray<const int64_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Writable view of a column buffer
+ * The capsule holds a reference to the shared buffer, so the array stays valid after the column
+ * is removed, the store is resized or the store itself is garbage collected.
+ */
+template <class T>
+nb::ndarray<nb::numpy, T> column_view(const std::shared_ptr<AttributeBuffer<T>>& buffer, size_t rows, size_t width) {
+    auto* owner = new std::shared_ptr<AttributeBuffer<T>>(buffer);
+    nb::capsule deleter(owner, [](void* p) noexcept {
+        delete static_cast<std::shared_ptr<AttributeBuffer<T>>*>(p);
+    });
+    if (width == 1)
+        return nb::ndarray<nb::numpy, T>((*owner)->data(), {rows}, deleter);
+    return nb::ndarray<nb::numpy, T>((*owner)->data(), {rows, width}, deleter);
+}
+
+/**
+ * Zero-copy view of a column, float64 for float and vector columns and int64 otherwise
+ */
+nb::object view(AttributeStore& self, const std::string& name) {
+    AttributeColumn& c = self.column(name);
+    if (c.is_real())
+        return nb::cast(column_view(c.reals, self.size(), c.width()));
+    return nb::cast(column_view(c.integers, self.size(), 1));
+}
+
+/**
+ * Copy the rows of a column at the given indices
+ */
+nb::object get(const AttributeStore& self, const std::string& name, const IndicesIn& indices) {
+    const AttributeColumn& c = self.column(name);
+    size_t K = indices.shape(0), width = c.width();
+    if (c.is_real()) {
+        ArrayBuffer<double> values(K * width);
+        self.gather(name, indices.data(), K, values.data());
+        return width == 1 ? nb::cast(to_ndarray(std::move(values), {K})) : nb::cast(to_ndarray(std::move(values), {K, width}));
+    }
+    ArrayBuffer<int64_t> values(K);
+    self.gather(name, indices.data(), K, values.data());
+    return nb::cast(to_ndarray(std::move(values), {K}));
+}
+
+/**
+ * Write rows of a float or vector column
+ */
+void set_reals(AttributeStore& self, const std::string& name, const IndicesIn& indices, const RealsIn& values) {
+    const AttributeColumn& c = self.column(name);
+    if (!c.is_real())
+        throw std::invalid_argument("Attribute '" + name + "' does not hold floats or vectors.");
+    if (values.size() != indices.shape(0) * c.width())
+        throw std::invalid_argument("Expected " + std::to_string(c.width()) + " values per index.");
+    self.scatter(name, indices.data(), indices.shape(0), values.data());
+}
+
+/**
+ * Write rows of an integer or string id column
+ */
+void set_integers(AttributeStore& self, const std::string& name, const IndicesIn& indices, const IntegersIn& values) {
+    const AttributeColumn& c = self.column(name);
+    if (c.is_real())
+        throw std::invalid_argument("Attribute '" + name + "' does not hold integers.");
+    if (values.shape(0) != indices.shape(0))
+        throw std::invalid_argument("Expected one value per index.");
+    if (c.type == AttributeType::STRING)
+        for (size_t k = 0; k < values.shape(0); ++k)
+            if (values.data()[k] < -1 || values.data()[k] >= static_cast<int64_t>(c.strings.size()))
+                throw std::out_of_range("String id " + std::to_string(values.data()[k]) + " does not exist.");
+    self.scatter(name, indices.data(), indices.shape(0), values.data());
+}
+
+/**
+ * Ids of strings in the table of a string column, adding new strings
+ */
+nb::ndarray<nb::numpy, int64_t> intern(AttributeStore& self, const std::string& name, const std::vector<std::string>& strings) {
+    AttributeColumn& c = self.column(name);
+    if (c.type != AttributeType::STRING)
+        throw std::invalid_argument("Attribute '" + name + "' does not hold strings.");
+    ArrayBuffer<int64_t> ids(strings.size());
+    for (size_t k = 0; k < strings.size(); ++k)
+        ids[k] = c.intern(strings[k]);
+    return to_ndarray(std::move(ids), {strings.size()});
+}
+
+NB_MODULE(_attributes, m) {
+    m.doc() = "Columnar attribute storage for mesh elements.";
+    share_memory_ledger();
+
+    nb::enum_<AttributeType>(m, "AttributeType")
+        .value("FLOAT", AttributeType::FLOAT)
+        .value("INT", AttributeType::INT)
+        .value("VEC3", AttributeType::VEC3)
+        .value("STRING", AttributeType::STRING);
+
+    nb::class_<AttributeStore>(m, "AttributeStore")
+        .def(nb::init<size_t>(), "size"_a = 0, "Create an empty store for the given number of elements")
+        .def("__len__", &AttributeStore::size)
+        .def("__contains__", &AttributeStore::has, "name"_a)
+        .def("names", &AttributeStore::names, "Column names in insertion order")
+        .def("add", [](AttributeStore& self, const std::string& name, AttributeType type, std::optional<ValuesIn> defaults) {
+            size_t width = type == AttributeType::VEC3 ? 3 : 1;
+            if (defaults && type == AttributeType::STRING)
+                throw std::invalid_argument("String columns default to no string.");
+            if (defaults && defaults->shape(0) != width)
+                throw std::invalid_argument("Expected " + std::to_string(width) + " default values.");
+            self.add(name, type, defaults ? defaults->data() : nullptr);
+        }, "name"_a, "type"_a, "default"_a.none() = nb::none(), "Add a column filled with a default value")
+        .def("remove", &AttributeStore::remove, "name"_a, "Remove a column")
+        .def("resize", &AttributeStore::resize, "size"_a, "Change the number of elements, new rows take the column defaults")
+        .def("type", [](const AttributeStore& self, const std::string& name) { return self.column(name).type; }, "name"_a)
+        .def("column", &view, "name"_a, "Writable zero-copy view of a column")
+        .def("get", &get, "name"_a, "indices"_a, "Copy the rows of a column at the given indices")
+        .def("set", &set_reals, "name"_a, "indices"_a, "values"_a, "Write rows of a float or vector column")
+        .def("set", &set_integers, "name"_a, "indices"_a, "values"_a, "Write rows of an integer or string id column")
+        .def("intern", &intern, "name"_a, "strings"_a, "Ids of strings in the table of a string column, adding new strings")
+        .def("strings", [](const AttributeStore& self, const std::string& name) { return self.column(name).strings; }, "name"_a,
+             "String table of a string column")
+        .def_prop_ro("nbytes", &AttributeStore::nbytes);
+}
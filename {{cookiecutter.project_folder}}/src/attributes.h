@@ -0,0 +1,233 @@
+// attributes.h - Columnar attribute storage for mesh elements
+#pragma once
+
+#include "memory.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace compas {
+
+enum class AttributeType : uint8_t { FLOAT = 0, INT = 1, VEC3 = 2, STRING = 3 };
+
+template <class T>
+using AttributeBuffer = std::vector<T, TrackedAllocator<T, MemoryTag::ATTRIBUTES>>;
+
+/**
+ * One typed attribute column
+ * Floats and vectors are stored as doubles, integers and string ids as int64. The buffer is
+ * shared so that array views handed out to Python can keep it alive independently of the store.
+ * Strings are interned per column; the column holds ids into the string table and -1 for none.
+ */
+struct AttributeColumn {
+    AttributeType type;
+    std::shared_ptr<AttributeBuffer<double>> reals;
+    std::shared_ptr<AttributeBuffer<int64_t>> integers;
+    double default_real[3] = {0.0, 0.0, 0.0};
+    int64_t default_integer = 0;
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, int64_t> string_ids;
+
+    bool is_real() const { return type == AttributeType::FLOAT || type == AttributeType::VEC3; }
+    size_t width() const { return type == AttributeType::VEC3 ? 3 : 1; }
+
+    /**
+     * @return Id of a string, added to the table if new
+     */
+    int64_t intern(const std::string& value) {
+        auto it = string_ids.find(value);
+        if (it != string_ids.end())
+            return it->second;
+        int64_t id = static_cast<int64_t>(strings.size());
+        strings.push_back(value);
+        string_ids.emplace(value, id);
+        return id;
+    }
+};
+
+/**
+ * Attribute columns for one kind of mesh element (vertices, edges or faces)
+ * All columns have one row per element. Resizing replaces buffers that are still referenced by
+ * views rather than reallocating them in place, so an outstanding view never dangles; it simply
+ * stops tracking the store.
+ */
+class AttributeStore {
+public:
+    explicit AttributeStore(size_t size = 0) : size_(size) {}
+
+    size_t size() const { return size_; }
+    size_t column_count() const { return columns_.size(); }
+
+    std::vector<std::string> names() const {
+        std::vector<std::string> result;
+        result.reserve(columns_.size());
+        for (const auto& column : columns_)
+            result.push_back(column.first);
+        return result;
+    }
+
+    bool has(const std::string& name) const { return index_.count(name) != 0; }
+
+    /**
+     * Add a column filled with a default value
+     * @param name Column name
+     * @param type Element type
+     * @param defaults Default value, width() entries for floats and vectors, one for integers, or null for zero
+     * @throws std::invalid_argument if the column exists
+     */
+    AttributeColumn& add(const std::string& name, AttributeType type, const double* defaults = nullptr) {
+        if (has(name))
+            throw std::invalid_argument("Attribute '" + name + "' already exists.");
+        AttributeColumn column;
+        column.type = type;
+        if (column.is_real()) {
+            if (defaults)
+                std::copy(defaults, defaults + column.width(), column.default_real);
+            column.reals = std::make_shared<AttributeBuffer<double>>(size_ * column.width());
+            for (size_t i = 0; i < size_; ++i)
+                std::copy(column.default_real, column.default_real + column.width(), column.reals->data() + column.width() * i);
+        } else {
+            column.default_integer = type == AttributeType::STRING ? -1 : (defaults ? static_cast<int64_t>(defaults[0]) : 0);
+            column.integers = std::make_shared<AttributeBuffer<int64_t>>(size_, column.default_integer);
+        }
+        index_.emplace(name, columns_.size());
+        columns_.emplace_back(name, std::move(column));
+        return columns_.back().second;
+    }
+
+    /**
+     * Remove a column; views of it stay valid
+     */
+    void remove(const std::string& name) {
+        size_t k = position(name);
+        columns_.erase(columns_.begin() + k);
+        index_.clear();
+        for (size_t i = 0; i < columns_.size(); ++i)
+            index_.emplace(columns_[i].first, i);
+    }
+
+    AttributeColumn& column(const std::string& name) { return columns_[position(name)].second; }
+    const AttributeColumn& column(const std::string& name) const { return columns_[position(name)].second; }
+
+    /**
+     * Change the number of elements, new rows take the column defaults
+     */
+    void resize(size_t size) {
+        for (auto& entry : columns_) {
+            AttributeColumn& c = entry.second;
+            if (c.is_real())
+                grow(c.reals, size * c.width(), c.default_real, c.width());
+            else
+                grow(c.integers, size, &c.default_integer, 1);
+        }
+        size_ = size;
+    }
+
+    /**
+     * Copy the rows of a column at the given indices
+     * @param name Column name
+     * @param indices (K,) element indices
+     * @param count Number of indices K
+     * @param out (K,width) values, double for float and vector columns
+     * @throws std::out_of_range if an index is out of range
+     */
+    template <class T>
+    void gather(const std::string& name, const int32_t* indices, size_t count, T* out) const {
+        const AttributeColumn& c = column(name);
+        check_indices(indices, count);
+        if (c.is_real())
+            copy_rows(c.reals->data(), indices, count, c.width(), out, true);
+        else
+            copy_rows(c.integers->data(), indices, count, 1, out, true);
+    }
+
+    /**
+     * Write rows of a column at the given indices; with repeated indices the last write wins
+     * @param name Column name
+     * @param indices (K,) element indices
+     * @param count Number of indices K
+     * @param values (K,width) values
+     * @throws std::out_of_range if an index is out of range
+     */
+    template <class T>
+    void scatter(const std::string& name, const int32_t* indices, size_t count, const T* values) {
+        AttributeColumn& c = column(name);
+        check_indices(indices, count);
+        if (c.is_real())
+            copy_rows(values, indices, count, c.width(), c.reals->data(), false);
+        else
+            copy_rows(values, indices, count, 1, c.integers->data(), false);
+    }
+
+    /**
+     * @return Bytes held by the column buffers and string tables
+     */
+    size_t nbytes() const {
+        size_t bytes = 0;
+        for (const auto& entry : columns_) {
+            const AttributeColumn& c = entry.second;
+            bytes += c.is_real() ? c.reals->capacity() * sizeof(double) : c.integers->capacity() * sizeof(int64_t);
+            for (const auto& s : c.strings)
+                bytes += s.capacity();
+        }
+        return bytes;
+    }
+
+private:
+    size_t position(const std::string& name) const {
+        auto it = index_.find(name);
+        if (it == index_.end())
+            throw std::invalid_argument("Attribute '" + name + "' does not exist.");
+        return it->second;
+    }
+
+    void check_indices(const int32_t* indices, size_t count) const {
+        for (size_t k = 0; k < count; ++k)
+            if (indices[k] < 0 || static_cast<size_t>(indices[k]) >= size_)
+                throw std::out_of_range("Element " + std::to_string(indices[k]) + " does not exist.");
+    }
+
+    template <class T>
+    static void grow(std::shared_ptr<AttributeBuffer<T>>& buffer, size_t length, const T* fill, size_t width) {
+        size_t old = buffer->size();
+        // A buffer seen by a view is replaced so that the view keeps its memory
+        if (buffer.use_count() > 1)
+            buffer = std::make_shared<AttributeBuffer<T>>(buffer->begin(), buffer->begin() + std::min(old, length));
+        buffer->resize(length);
+        if (length < old)
+            buffer->shrink_to_fit();
+        for (size_t i = old; i < length; i += width)
+            std::copy(fill, fill + width, buffer->data() + i);
+    }
+
+    // Gather (src rows at indices -> dense dst) or scatter (dense src -> dst rows at indices)
+    template <class S, class D>
+    static void copy_rows(const S* src, const int32_t* indices, size_t count, size_t width, D* dst, bool gathering) {
+        auto copy = [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                size_t row = static_cast<size_t>(indices[k]);
+                const S* from = src + width * (gathering ? row : k);
+                D* to = dst + width * (gathering ? k : row);
+                for (size_t j = 0; j < width; ++j)
+                    to[j] = static_cast<D>(from[j]);
+            }
+        };
+        // Scatters with repeated indices must run in order
+        if (gathering)
+            parallel_for(count, 16384, copy);
+        else
+            copy(0, count);
+    }
+
+    size_t size_;
+    std::vector<std::pair<std::string, AttributeColumn>> columns_;
+    std::unordered_map<std::string, size_t> index_;
+};
+
+} // namespace compas
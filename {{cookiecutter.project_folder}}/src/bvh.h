@@ -0,0 +1,239 @@
+// bvh.h - Bounding volume hierarchy over axis-aligned boxes
+#pragma once
+
+#include "arena.h"
+#include "mesh.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Node of a BVH stored in depth-first order
+ * Inner nodes have their left child at the next index and the right child at `start`.
+ * Leaves reference `count` entries of BVH::indices starting at `start`.
+ */
+struct BVHNode {
+    Box3 box;
+    uint32_t start = 0;
+    uint32_t count = 0;
+
+    bool leaf() const { return count > 0; }
+};
+
+/**
+ * Median-split BVH over a set of primitive bounding boxes
+ */
+class BVH {
+public:
+    std::vector<BVHNode> nodes;
+    std::vector<uint32_t> indices;
+    std::vector<Box3> boxes;  // primitive boxes in the order of indices
+
+    BVH() = default;
+
+    /**
+     * Build the hierarchy
+     * @param primitives Bounding box of each primitive
+     * @param leaf_size Maximum number of primitives per leaf
+     */
+    explicit BVH(std::span<const Box3> primitives, uint32_t leaf_size = 4) {
+        build(primitives, leaf_size);
+    }
+
+    void build(std::span<const Box3> primitives, uint32_t leaf_size = 4) {
+        nodes.clear();
+        boxes.clear();
+        indices.resize(primitives.size());
+        std::iota(indices.begin(), indices.end(), 0u);
+        if (primitives.empty())
+            return;
+
+        Scratch scratch;
+        std::span<Vec3> centroids = scratch.array<Vec3>(primitives.size());
+        for (size_t i = 0; i < primitives.size(); ++i)
+            centroids[i] = primitives[i].center();
+
+        nodes.reserve(2 * primitives.size() / std::max<uint32_t>(leaf_size, 1) + 1);
+        build_node(0, primitives.size(), primitives, centroids, std::max<uint32_t>(leaf_size, 1));
+
+        boxes.resize(primitives.size());
+        for (size_t i = 0; i < primitives.size(); ++i)
+            boxes[i] = primitives[indices[i]];
+    }
+
+    bool empty() const { return nodes.empty(); }
+
+    /**
+     * @return Bounding box of all primitives
+     */
+    Box3 bounds() const { return empty() ? Box3() : nodes[0].box; }
+
+    /**
+     * Visit every primitive whose box overlaps `box`
+     * @param box Query box
+     * @param fn Callable fn(primitive) returning false to stop the traversal
+     */
+    template <class F>
+    void query(const Box3& box, F&& fn) const {
+        if (empty())
+            return;
+        std::array<uint32_t, 64> stack;
+        size_t top = 0;
+        stack[top++] = 0;
+        while (top) {
+            const BVHNode& node = nodes[stack[--top]];
+            if (!node.box.intersects(box))
+                continue;
+            if (node.leaf()) {
+                for (uint32_t i = node.start; i < node.start + node.count; ++i)
+                    if (boxes[i].intersects(box) && !fn(indices[i]))
+                        return;
+            } else {
+                uint32_t left = static_cast<uint32_t>(&node - nodes.data()) + 1;
+                stack[top++] = node.start;
+                stack[top++] = left;
+            }
+        }
+    }
+
+    /**
+     * Find the primitive nearest to a point by best-first descent
+     * Subtrees whose boxes are farther than the current best are skipped.
+     * @param point Query point
+     * @param distance Callable distance(primitive) returning the squared distance to the point
+     * @param best Squared search radius on input, squared distance of the result on output
+     * @return Nearest primitive, or UINT32_MAX if none lies within the search radius
+     */
+    template <class F>
+    uint32_t nearest(const Vec3& point, F&& distance, double& best) const {
+        uint32_t result = std::numeric_limits<uint32_t>::max();
+        if (empty())
+            return result;
+        std::array<std::pair<uint32_t, double>, 64> stack;
+        size_t top = 0;
+        stack[top++] = {0, nodes[0].box.squaredExteriorDistance(point)};
+        while (top) {
+            auto [index, bound] = stack[--top];
+            if (bound >= best)
+                continue;
+            const BVHNode& node = nodes[index];
+            if (node.leaf()) {
+                for (uint32_t i = node.start; i < node.start + node.count; ++i) {
+                    if (boxes[i].squaredExteriorDistance(point) >= best)
+                        continue;
+                    double d = distance(indices[i]);
+                    if (d < best) {
+                        best = d;
+                        result = indices[i];
+                    }
+                }
+            } else {
+                // Push the farther child first so the closer one is visited next
+                uint32_t left = index + 1, right = node.start;
+                double dl = nodes[left].box.squaredExteriorDistance(point);
+                double dr = nodes[right].box.squaredExteriorDistance(point);
+                if (dl < dr) {
+                    stack[top++] = {right, dr};
+                    stack[top++] = {left, dl};
+                } else {
+                    stack[top++] = {left, dl};
+                    stack[top++] = {right, dr};
+                }
+            }
+        }
+        return result;
+    }
+
+private:
+    uint32_t build_node(size_t begin, size_t end, std::span<const Box3> primitives, std::span<const Vec3> centroids, uint32_t leaf_size) {
+        uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+
+        Box3 box;
+        Box3 centers;
+        for (size_t i = begin; i < end; ++i) {
+            box.extend(primitives[indices[i]]);
+            centers.extend(centroids[indices[i]]);
+        }
+        nodes[index].box = box;
+
+        if (end - begin <= leaf_size) {
+            nodes[index].start = static_cast<uint32_t>(begin);
+            nodes[index].count = static_cast<uint32_t>(end - begin);
+            return index;
+        }
+
+        // Split at the median centroid along the widest axis
+        int axis;
+        centers.sizes().maxCoeff(&axis);
+        size_t mid = (begin + end) / 2;
+        std::nth_element(indices.begin() + begin, indices.begin() + mid, indices.begin() + end,
+                         [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+
+        build_node(begin, mid, primitives, centroids, leaf_size);
+        uint32_t right = build_node(mid, end, primitives, centroids, leaf_size);
+        nodes[index].start = right;
+        nodes[index].count = 0;
+        return index;
+    }
+};
+
+/**
+ * Simultaneous descent of two hierarchies, visiting all primitive pairs with overlapping boxes
+ * @param a First hierarchy
+ * @param b Second hierarchy
+ * @param fn Callable fn(primitive_a, primitive_b) returning false to stop the traversal
+ */
+template <class F>
+void traverse(const BVH& a, const BVH& b, F&& fn) {
+    if (a.empty() || b.empty())
+        return;
+    // Each step replaces a pair by at most two, so the stack never exceeds the sum of the depths
+    std::array<std::pair<uint32_t, uint32_t>, 128> stack;
+    size_t top = 0;
+    stack[top++] = {0, 0};
+    while (top) {
+        auto [i, j] = stack[--top];
+        const BVHNode& na = a.nodes[i];
+        const BVHNode& nb = b.nodes[j];
+        if (!na.box.intersects(nb.box))
+            continue;
+
+        if (na.leaf() && nb.leaf()) {
+            for (uint32_t p = na.start; p < na.start + na.count; ++p)
+                for (uint32_t q = nb.start; q < nb.start + nb.count; ++q)
+                    if (a.boxes[p].intersects(b.boxes[q]) && !fn(a.indices[p], b.indices[q]))
+                        return;
+        } else if (nb.leaf() || (!na.leaf() && na.box.volume() >= nb.box.volume())) {
+            // Descend into the larger of the two nodes
+            stack[top++] = {na.start, j};
+            stack[top++] = {i + 1, j};
+        } else {
+            stack[top++] = {i, nb.start};
+            stack[top++] = {i, j + 1};
+        }
+    }
+}
+
+/**
+ * Build a BVH over the faces of a mesh
+ * @param mesh Triangle mesh
+ * @return Hierarchy whose primitives are face indices
+ */
+inline BVH face_bvh(const MeshView& mesh) {
+    Scratch scratch;
+    std::span<Box3> boxes = scratch.array<Box3>(mesh.face_count);
+    for (size_t f = 0; f < mesh.face_count; ++f)
+        boxes[f] = mesh.face_box(f);
+    return BVH(boxes);
+}
+
+} // namespace compas
@@ -0,0 +1,90 @@
+#include "compas.h"
+#include "arrays.h"
+#include "closest.h"
+
+using namespace compas;
+
+/**
+ * Convert a projection into NumPy arrays
+ * @return Tuple of closest points (N,3), distances (N,), ids (N,) and parameters (N,) or (N,3)
+ */
+nb::tuple projection_to_tuple(Projection&& result, size_t n, size_t param_size) {
+    auto points = to_ndarray(std::move(result.points), {n, 3});
+    auto distances = to_ndarray(std::move(result.distances), {n});
+    auto ids = to_ndarray(std::move(result.ids), {n});
+    if (param_size == 1)
+        return nb::make_tuple(points, distances, ids, to_ndarray(std::move(result.params), {n}));
+    return nb::make_tuple(points, distances, ids, to_ndarray(std::move(result.params), {n, param_size}));
+}
+
+/**
+ * @throws std::invalid_argument if the search radius is negative or NaN
+ */
+void check_max_distance(double max_distance) {
+    if (!(max_distance >= 0.0))
+        throw std::invalid_argument("max_distance must not be negative.");
+}
+
+/**
+ * Project points onto the nearest polyline
+ * @param self Projector
+ * @param points (N,3) query points
+ * @param max_distance Search radius, points outside it get id -1 and infinite distance
+ * @return Closest points, distances, polyline ids and polyline parameters
+ */
+nb::tuple project_polylines(const PolylineProjector& self, const PointsIn& points, double max_distance) {
+    check_max_distance(max_distance);
+    size_t n = points.shape(0);
+    Projection result(0, 1);
+    {
+        nb::gil_scoped_release release;
+        result = self.project(points.data(), n, max_distance);
+    }
+    return projection_to_tuple(std::move(result), n, 1);
+}
+
+/**
+ * Project points onto the mesh surface
+ * @param self Projector
+ * @param points (N,3) query points
+ * @param max_distance Search radius, points outside it get id -1 and infinite distance
+ * @return Closest points, distances, face ids and barycentric coordinates
+ */
+nb::tuple project_mesh(const MeshProjector& self, const PointsIn& points, double max_distance) {
+    check_max_distance(max_distance);
+    size_t n = points.shape(0);
+    Projection result(0, 3);
+    {
+        nb::gil_scoped_release release;
+        result = self.project(points.data(), n, max_distance);
+    }
+    return projection_to_tuple(std::move(result), n, 3);
+}
+
+NB_MODULE(_closest, m) {
+    m.doc() = "Closest-point projection onto polylines and meshes.";
+    share_memory_ledger();
+
+    constexpr double unbounded = std::numeric_limits<double>::infinity();
+
+    nb::class_<PolylineProjector>(m, "PolylineProjector")
+        .def("__init__", [](PolylineProjector* self, const PointsIn& points, const OffsetsIn& offsets) {
+            size_t count = offsets.shape(0) > 0 ? offsets.shape(0) - 1 : 0;
+            check_offsets(offsets, count, points.shape(0), "offsets");
+            new (self) PolylineProjector(points.data(), offsets.data(), count);
+        }, "points"_a, "offsets"_a, "Build a segment hierarchy over (M,3) vertices split into polylines by offsets")
+        .def_prop_ro("polyline_count", &PolylineProjector::polyline_count)
+        .def_prop_ro("segment_count", &PolylineProjector::segment_count)
+        .def("project", &project_polylines, "points"_a, "max_distance"_a = unbounded,
+             "Closest points, distances, polyline ids and parameters of (N,3) points");
+
+    nb::class_<MeshProjector>(m, "MeshProjector")
+        .def("__init__", [](MeshProjector* self, const PointsIn& vertices, const FacesIn& faces) {
+            new (self) MeshProjector(mesh_view(vertices, faces));
+        }, "vertices"_a, "faces"_a, "Build a face hierarchy over a copy of the mesh")
+        .def_prop_ro("face_count", [](const MeshProjector& self) { return self.view().face_count; })
+        .def("project", &project_mesh, "points"_a, "max_distance"_a = unbounded,
+             "Closest points, distances, face ids and barycentric coordinates of (N,3) points");
+
+    def_arena_stats(m);
+}
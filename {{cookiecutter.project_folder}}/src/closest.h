@@ -0,0 +1,233 @@
+// closest.h - Closest-point projection onto polylines and triangle meshes
+#pragma once
+
+#include "bvh.h"
+#include "memory.h"
+#include "mesh.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Closest point on the segment ab
+ * @param t Output parameter of the closest point in [0, 1]
+ */
+inline Vec3 closest_point_segment(const Vec3& p, const Vec3& a, const Vec3& b, double& t) {
+    Vec3 ab = b - a;
+    double length = ab.squaredNorm();
+    t = length > 0 ? std::clamp((p - a).dot(ab) / length, 0.0, 1.0) : 0.0;
+    return a + t * ab;
+}
+
+/**
+ * Closest point on the triangle abc, by Voronoi region classification (Ericson, Real-Time Collision Detection 5.1.5)
+ * @param uvw Output barycentric coordinates of the closest point
+ */
+inline Vec3 closest_point_triangle(const Vec3& p, const Vec3& a, const Vec3& b, const Vec3& c, Vec3& uvw) {
+    Vec3 ab = b - a, ac = c - a, ap = p - a;
+    double d1 = ab.dot(ap), d2 = ac.dot(ap);
+    if (d1 <= 0 && d2 <= 0) {
+        uvw = Vec3(1, 0, 0);
+        return a;
+    }
+    Vec3 bp = p - b;
+    double d3 = ab.dot(bp), d4 = ac.dot(bp);
+    if (d3 >= 0 && d4 <= d3) {
+        uvw = Vec3(0, 1, 0);
+        return b;
+    }
+    double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        double v = d1 / (d1 - d3);
+        uvw = Vec3(1 - v, v, 0);
+        return a + v * ab;
+    }
+    Vec3 cp = p - c;
+    double d5 = ab.dot(cp), d6 = ac.dot(cp);
+    if (d6 >= 0 && d5 <= d6) {
+        uvw = Vec3(0, 0, 1);
+        return c;
+    }
+    double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        double w = d2 / (d2 - d6);
+        uvw = Vec3(1 - w, 0, w);
+        return a + w * ac;
+    }
+    double va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+        double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        uvw = Vec3(0, 1 - w, w);
+        return b + w * (c - b);
+    }
+    double denom = va + vb + vc;
+    if (!(denom > 0)) {
+        // Degenerate triangle: fall back to the closest of its edges
+        double t;
+        Vec3 best = closest_point_segment(p, a, b, t);
+        uvw = Vec3(1 - t, t, 0);
+        Vec3 q = closest_point_segment(p, b, c, t);
+        if ((q - p).squaredNorm() < (best - p).squaredNorm()) {
+            best = q;
+            uvw = Vec3(0, 1 - t, t);
+        }
+        q = closest_point_segment(p, a, c, t);
+        if ((q - p).squaredNorm() < (best - p).squaredNorm()) {
+            best = q;
+            uvw = Vec3(1 - t, 0, t);
+        }
+        return best;
+    }
+    double v = vb / denom, w = vc / denom;
+    uvw = Vec3(1 - v - w, v, w);
+    return a + v * ab + w * ac;
+}
+
+/**
+ * Result of a batched projection, one row per query point
+ */
+struct Projection {
+    ArrayBuffer<double> points;     // (N,3) closest points
+    ArrayBuffer<double> distances;  // (N,) distances, infinity where nothing was found
+    ArrayBuffer<int32_t> ids;       // (N,) polyline or face index, -1 where nothing was found
+    ArrayBuffer<double> params;     // (N,) polyline parameters or (N,3) barycentric coordinates
+
+    Projection(size_t n, size_t param_size)
+        : points(3 * n, 0.0), distances(n, std::numeric_limits<double>::infinity()), ids(n, -1), params(param_size * n, 0.0) {}
+};
+
+/**
+ * Segment hierarchy over a set of polylines, built once and queried many times
+ * The parameter of a projection is the segment index plus the position along that segment,
+ * so that floor(t) recovers the segment and t runs from 0 to vertex count - 1.
+ */
+class PolylineProjector {
+public:
+    /**
+     * @param points Row-major (M,3) vertices of all polylines
+     * @param offsets (C+1,) vertex offsets per polyline
+     * @param count Number of polylines C
+     * @throws std::invalid_argument if a polyline has fewer than two vertices
+     */
+    PolylineProjector(const double* points, const int64_t* offsets, size_t count) {
+        for (size_t c = 0; c < count; ++c) {
+            if (offsets[c + 1] - offsets[c] < 2)
+                throw std::invalid_argument("Polyline " + std::to_string(c) + " needs at least two vertices.");
+            for (int64_t i = offsets[c]; i < offsets[c + 1]; ++i)
+                vertices_.emplace_back(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+            for (int64_t i = offsets[c]; i + 1 < offsets[c + 1]; ++i) {
+                segment_start_.push_back(static_cast<uint32_t>(i));
+                segment_polyline_.push_back(static_cast<uint32_t>(c));
+                segment_index_.push_back(static_cast<uint32_t>(i - offsets[c]));
+            }
+        }
+        polyline_count_ = count;
+        Scratch scratch;
+        std::span<Box3> boxes = scratch.array<Box3>(segment_start_.size());
+        for (size_t s = 0; s < boxes.size(); ++s) {
+            boxes[s] = Box3(vertices_[segment_start_[s]]);
+            boxes[s].extend(vertices_[segment_start_[s] + 1]);
+        }
+        bvh_.build(boxes);
+    }
+
+    size_t polyline_count() const { return polyline_count_; }
+    size_t segment_count() const { return segment_start_.size(); }
+
+    /**
+     * Project points onto the nearest polyline
+     * @param points Row-major (N,3) query points
+     * @param n Number of query points
+     * @param max_distance Points farther than this from every polyline are left unmatched
+     */
+    Projection project(const double* points, size_t n, double max_distance = std::numeric_limits<double>::infinity()) const {
+        Projection result(n, 1);
+        parallel_for(n, 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Vec3 p(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+                double best = max_distance * max_distance;
+                uint32_t segment = bvh_.nearest(p, [&](uint32_t s) {
+                    double t;
+                    return (closest_point_segment(p, vertices_[segment_start_[s]], vertices_[segment_start_[s] + 1], t) - p).squaredNorm();
+                }, best);
+                if (segment == std::numeric_limits<uint32_t>::max())
+                    continue;
+                double t;
+                Vec3 q = closest_point_segment(p, vertices_[segment_start_[segment]], vertices_[segment_start_[segment] + 1], t);
+                std::copy(q.data(), q.data() + 3, result.points.data() + 3 * i);
+                result.distances[i] = std::sqrt(best);
+                result.ids[i] = static_cast<int32_t>(segment_polyline_[segment]);
+                result.params[i] = segment_index_[segment] + t;
+            }
+        });
+        return result;
+    }
+
+private:
+    std::vector<Vec3> vertices_;
+    std::vector<uint32_t> segment_start_;     // first vertex of each segment
+    std::vector<uint32_t> segment_polyline_;  // polyline of each segment
+    std::vector<uint32_t> segment_index_;     // index of each segment within its polyline
+    size_t polyline_count_ = 0;
+    BVH bvh_;
+};
+
+/**
+ * Face hierarchy over a triangle mesh, built once and queried many times
+ * The mesh is copied so the projector stays valid after the input arrays are released.
+ */
+class MeshProjector {
+public:
+    explicit MeshProjector(const MeshView& mesh)
+        : vertices_(mesh.vertices, mesh.vertices + 3 * mesh.vertex_count), faces_(mesh.faces, mesh.faces + 3 * mesh.face_count) {
+        mesh.validate();
+        bvh_ = face_bvh(view());
+    }
+
+    MeshView view() const { return MeshView{vertices_.data(), vertices_.size() / 3, faces_.data(), faces_.size() / 3}; }
+
+    /**
+     * Project points onto the mesh surface
+     * @param points Row-major (N,3) query points
+     * @param n Number of query points
+     * @param max_distance Points farther than this from the mesh are left unmatched
+     */
+    Projection project(const double* points, size_t n, double max_distance = std::numeric_limits<double>::infinity()) const {
+        Projection result(n, 3);
+        MeshView mesh = view();
+        parallel_for(n, 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Vec3 p(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+                Vec3 uvw;
+                double best = max_distance * max_distance;
+                uint32_t face = bvh_.nearest(p, [&](uint32_t f) {
+                    return (closest_point_triangle(p, mesh.corner(f, 0), mesh.corner(f, 1), mesh.corner(f, 2), uvw) - p).squaredNorm();
+                }, best);
+                if (face == std::numeric_limits<uint32_t>::max())
+                    continue;
+                Vec3 q = closest_point_triangle(p, mesh.corner(face, 0), mesh.corner(face, 1), mesh.corner(face, 2), uvw);
+                std::copy(q.data(), q.data() + 3, result.points.data() + 3 * i);
+                std::copy(uvw.data(), uvw.data() + 3, result.params.data() + 3 * i);
+                result.distances[i] = std::sqrt(best);
+                result.ids[i] = static_cast<int32_t>(face);
+            }
+        });
+        return result;
+    }
+
+private:
+    std::vector<double> vertices_;
+    std::vector<int32_t> faces_;
+    BVH bvh_;
+};
+
+} // namespace compas
@@ -0,0 +1,85 @@
+#include "compas.h"
+#include "arrays.h"
+#include "collision.h"
+
+using namespace compas;
+
+/**
+ * Overlapping pairs among a set of axis-aligned boxes
+ * @param boxes (N,6) boxes as xmin, ymin, zmin, xmax, ymax, zmax
+ * @return (K,2) int32 array of box index pairs (i < j)
+ */
+nb::ndarray<nb::numpy, int32_t> box_pairs(const BoxesIn& boxes) {
+    Scratch scratch;
+    std::span<Box3> list = scratch.array<Box3>(boxes.shape(0));
+    const double* b = boxes.data();
+    for (size_t i = 0; i < list.size(); ++i)
+        list[i] = Box3(Vec3(b[6 * i], b[6 * i + 1], b[6 * i + 2]), Vec3(b[6 * i + 3], b[6 * i + 4], b[6 * i + 5]));
+
+    std::vector<IndexPair> pairs;
+    {
+        nb::gil_scoped_release release;
+        pairs = sweep_and_prune(list);
+    }
+    return pairs_to_ndarray(pairs);
+}
+
+/**
+ * Intersecting faces between two meshes
+ * @param vertices_a (V,3) vertices of the first mesh
+ * @param faces_a (F,3) faces of the first mesh
+ * @param vertices_b (V,3) vertices of the second mesh
+ * @param faces_b (F,3) faces of the second mesh
+ * @return (K,2) int32 array of face pairs (face of a, face of b)
+ */
+nb::ndarray<nb::numpy, int32_t> face_pairs(const PointsIn& vertices_a, const FacesIn& faces_a, const PointsIn& vertices_b, const FacesIn& faces_b) {
+    MeshView a = mesh_view(vertices_a, faces_a);
+    MeshView b = mesh_view(vertices_b, faces_b);
+
+    std::vector<IndexPair> pairs;
+    {
+        nb::gil_scoped_release release;
+        pairs = intersecting_faces(a, face_bvh(a), b, face_bvh(b));
+    }
+    return pairs_to_ndarray(pairs);
+}
+
+/**
+ * Colliding pairs among many meshes
+ * @param vertices List of (V,3) vertex arrays, one per mesh
+ * @param faces List of (F,3) face arrays, one per mesh
+ * @return (K,2) int32 array of mesh index pairs (i < j)
+ */
+nb::ndarray<nb::numpy, int32_t> mesh_pairs(const std::vector<PointsIn>& vertices, const std::vector<FacesIn>& faces) {
+    if (vertices.size() != faces.size())
+        throw std::invalid_argument("Expected as many vertex arrays as face arrays.");
+
+    Scratch scratch;
+    std::span<MeshView> meshes = scratch.array<MeshView>(vertices.size());
+    for (size_t i = 0; i < meshes.size(); ++i)
+        meshes[i] = mesh_view(vertices[i], faces[i]);
+
+    std::vector<IndexPair> pairs;
+    {
+        nb::gil_scoped_release release;
+        pairs = colliding_meshes(meshes);
+    }
+    return pairs_to_ndarray(pairs);
+}
+
+NB_MODULE(_collision, m) {
+    m.doc() = "Mesh collision queries.";
+    share_memory_ledger();
+    share_predicate_counts();
+
+    m.def("box_pairs", &box_pairs, "boxes"_a,
+          "Overlapping pairs among (N,6) axis-aligned boxes, found by sweep-and-prune");
+
+    m.def("face_pairs", &face_pairs, "vertices_a"_a, "faces_a"_a, "vertices_b"_a, "faces_b"_a,
+          "Pairs of intersecting faces between two triangle meshes");
+
+    m.def("mesh_pairs", &mesh_pairs, "vertices"_a, "faces"_a,
+          "Pairs of colliding meshes, broad phase on mesh bounds and narrow phase on face hierarchies");
+
+    def_arena_stats(m);
+}
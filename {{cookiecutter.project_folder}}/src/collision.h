@@ -0,0 +1,281 @@
+// collision.h - Triangle-triangle intersection and mesh collision queries
+#pragma once
+
+#include "bvh.h"
+#include "parallel.h"
+#include "predicates.h"
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace compas {
+
+using Vec2 = Eigen::Vector2d;
+using IndexPair = std::pair<uint32_t, uint32_t>;
+
+namespace detail {
+
+inline int sign(double x) {
+    return (x > 0) - (x < 0);
+}
+
+/**
+ * Exact sign of ((a - c) x (b - c)) . (d - c)
+ */
+inline int orient3(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d) {
+    return -sign(orient3d(a, b, c, d));
+}
+
+/**
+ * Exact sign of the signed area of the 2D triangle abc
+ */
+inline int orient2(const Vec2& a, const Vec2& b, const Vec2& c) {
+    return sign(orient2d(a, b, c));
+}
+
+inline bool on_segment(const Vec2& p, const Vec2& q, const Vec2& r) {
+    return std::min(p.x(), q.x()) <= r.x() && r.x() <= std::max(p.x(), q.x()) &&
+           std::min(p.y(), q.y()) <= r.y() && r.y() <= std::max(p.y(), q.y());
+}
+
+/**
+ * Closed segment-segment intersection test in 2D
+ */
+inline bool segments_intersect(const Vec2& p, const Vec2& q, const Vec2& r, const Vec2& s) {
+    int o1 = orient2(p, q, r);
+    int o2 = orient2(p, q, s);
+    int o3 = orient2(r, s, p);
+    int o4 = orient2(r, s, q);
+    if (o1 * o2 < 0 && o3 * o4 < 0)
+        return true;
+    return (o1 == 0 && on_segment(p, q, r)) || (o2 == 0 && on_segment(p, q, s)) ||
+           (o3 == 0 && on_segment(r, s, p)) || (o4 == 0 && on_segment(r, s, q));
+}
+
+/**
+ * Closed point-in-triangle test in 2D, false for degenerate triangles
+ */
+inline bool point_in_triangle(const Vec2& p, const Vec2& a, const Vec2& b, const Vec2& c) {
+    int area = orient2(a, b, c);
+    if (area == 0)
+        return false;
+    return orient2(a, b, p) * area >= 0 && orient2(b, c, p) * area >= 0 && orient2(c, a, p) * area >= 0;
+}
+
+/**
+ * Intersection test for two triangles lying in the same plane
+ */
+inline bool coplanar_triangles_intersect(const Vec3* t1, const Vec3* t2) {
+    // Project onto the coordinate plane most parallel to the triangles
+    Vec3 normal = (t1[1] - t1[0]).cross(t1[2] - t1[0]);
+    if (normal.isZero())
+        normal = (t2[1] - t2[0]).cross(t2[2] - t2[0]);
+    int drop;
+    normal.cwiseAbs().maxCoeff(&drop);
+    int u = (drop + 1) % 3;
+    int v = (drop + 2) % 3;
+
+    Vec2 a[3], b[3];
+    for (int k = 0; k < 3; ++k) {
+        a[k] = Vec2(t1[k][u], t1[k][v]);
+        b[k] = Vec2(t2[k][u], t2[k][v]);
+    }
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            if (segments_intersect(a[i], a[(i + 1) % 3], b[j], b[(j + 1) % 3]))
+                return true;
+    return point_in_triangle(a[0], b[0], b[1], b[2]) || point_in_triangle(b[0], a[0], a[1], a[2]);
+}
+
+/**
+ * Interval overlap check once p1 is the only vertex of the first triangle on its side
+ */
+inline bool check_min_max(const Vec3& p1, const Vec3& q1, const Vec3& r1, const Vec3& p2, const Vec3& q2, const Vec3& r2) {
+    if (orient3(p2, p1, q1, q2) > 0)
+        return false;
+    if (orient3(p2, r1, p1, r2) > 0)
+        return false;
+    return true;
+}
+
+/**
+ * Permute the second triangle so that p2 is alone on its side of the first triangle's plane
+ */
+inline bool tri_tri_3d(const Vec3& p1, const Vec3& q1, const Vec3& r1, const Vec3& p2, const Vec3& q2, const Vec3& r2,
+                       int sp2, int sq2, int sr2, const Vec3* t1, const Vec3* t2) {
+    if (sp2 > 0) {
+        if (sq2 > 0) return check_min_max(p1, r1, q1, r2, p2, q2);
+        if (sr2 > 0) return check_min_max(p1, r1, q1, q2, r2, p2);
+        return check_min_max(p1, q1, r1, p2, q2, r2);
+    }
+    if (sp2 < 0) {
+        if (sq2 < 0) return check_min_max(p1, q1, r1, r2, p2, q2);
+        if (sr2 < 0) return check_min_max(p1, q1, r1, q2, r2, p2);
+        return check_min_max(p1, r1, q1, p2, q2, r2);
+    }
+    if (sq2 < 0) {
+        if (sr2 >= 0) return check_min_max(p1, r1, q1, q2, r2, p2);
+        return check_min_max(p1, q1, r1, p2, q2, r2);
+    }
+    if (sq2 > 0) {
+        if (sr2 > 0) return check_min_max(p1, r1, q1, p2, q2, r2);
+        return check_min_max(p1, q1, r1, q2, r2, p2);
+    }
+    if (sr2 > 0) return check_min_max(p1, q1, r1, r2, p2, q2);
+    if (sr2 < 0) return check_min_max(p1, r1, q1, r2, p2, q2);
+    return coplanar_triangles_intersect(t1, t2);
+}
+
+} // namespace detail
+
+/**
+ * Closed triangle-triangle intersection test (Guigue-Devillers)
+ * The test only branches on exact orientation signs, so it is robust for touching and coplanar input.
+ * @param t1 Corners of the first triangle
+ * @param t2 Corners of the second triangle
+ * @return True if the triangles touch or overlap
+ */
+inline bool triangles_intersect(const Vec3* t1, const Vec3* t2) {
+    using detail::orient3;
+    const Vec3 &p1 = t1[0], &q1 = t1[1], &r1 = t1[2];
+    const Vec3 &p2 = t2[0], &q2 = t2[1], &r2 = t2[2];
+
+    int sp1 = orient3(p2, q2, r2, p1);
+    int sq1 = orient3(p2, q2, r2, q1);
+    int sr1 = orient3(p2, q2, r2, r1);
+    if (sp1 * sq1 > 0 && sp1 * sr1 > 0)
+        return false;
+
+    int sp2 = orient3(p1, q1, r1, p2);
+    int sq2 = orient3(p1, q1, r1, q2);
+    int sr2 = orient3(p1, q1, r1, r2);
+    if (sp2 * sq2 > 0 && sp2 * sr2 > 0)
+        return false;
+
+    // Permute the first triangle so that p1 is alone on its side of the second triangle's plane
+    if (sp1 > 0) {
+        if (sq1 > 0) return detail::tri_tri_3d(r1, p1, q1, p2, r2, q2, sp2, sr2, sq2, t1, t2);
+        if (sr1 > 0) return detail::tri_tri_3d(q1, r1, p1, p2, r2, q2, sp2, sr2, sq2, t1, t2);
+        return detail::tri_tri_3d(p1, q1, r1, p2, q2, r2, sp2, sq2, sr2, t1, t2);
+    }
+    if (sp1 < 0) {
+        if (sq1 < 0) return detail::tri_tri_3d(r1, p1, q1, p2, q2, r2, sp2, sq2, sr2, t1, t2);
+        if (sr1 < 0) return detail::tri_tri_3d(q1, r1, p1, p2, q2, r2, sp2, sq2, sr2, t1, t2);
+        return detail::tri_tri_3d(p1, q1, r1, p2, r2, q2, sp2, sr2, sq2, t1, t2);
+    }
+    if (sq1 < 0) {
+        if (sr1 >= 0) return detail::tri_tri_3d(q1, r1, p1, p2, r2, q2, sp2, sr2, sq2, t1, t2);
+        return detail::tri_tri_3d(p1, q1, r1, p2, q2, r2, sp2, sq2, sr2, t1, t2);
+    }
+    if (sq1 > 0) {
+        if (sr1 > 0) return detail::tri_tri_3d(p1, q1, r1, p2, r2, q2, sp2, sr2, sq2, t1, t2);
+        return detail::tri_tri_3d(q1, r1, p1, p2, q2, r2, sp2, sq2, sr2, t1, t2);
+    }
+    if (sr1 > 0) return detail::tri_tri_3d(r1, p1, q1, p2, q2, r2, sp2, sq2, sr2, t1, t2);
+    if (sr1 < 0) return detail::tri_tri_3d(r1, p1, q1, p2, r2, q2, sp2, sr2, sq2, t1, t2);
+    return detail::coplanar_triangles_intersect(t1, t2);
+}
+
+/**
+ * Broad phase: all pairs of overlapping boxes, found by sweep-and-prune
+ * Boxes are swept along the axis with the largest spread of centers.
+ * @param boxes Boxes to test against each other
+ * @return Sorted pairs (i, j) with i < j
+ */
+inline std::vector<IndexPair> sweep_and_prune(std::span<const Box3> boxes) {
+    size_t n = boxes.size();
+    if (n < 2)
+        return {};
+
+    Box3 centers;
+    for (const Box3& box : boxes)
+        centers.extend(box.center());
+    int axis;
+    centers.sizes().maxCoeff(&axis);
+
+    Scratch scratch;
+    std::span<uint32_t> order = scratch.array<uint32_t>(n);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return boxes[a].min()[axis] < boxes[b].min()[axis]; });
+
+    // Each sweep start is independent once the boxes are sorted
+    std::vector<std::vector<IndexPair>> found(thread_count());
+    parallel_for(n, 256, [&](size_t begin, size_t end, size_t worker) {
+        auto& out = found[worker];
+        for (size_t k = begin; k < end; ++k) {
+            const Box3& a = boxes[order[k]];
+            for (size_t m = k + 1; m < n && boxes[order[m]].min()[axis] <= a.max()[axis]; ++m) {
+                if (a.intersects(boxes[order[m]]))
+                    out.emplace_back(std::min(order[k], order[m]), std::max(order[k], order[m]));
+            }
+        }
+    });
+
+    std::vector<IndexPair> pairs;
+    for (auto& part : found)
+        pairs.insert(pairs.end(), part.begin(), part.end());
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+/**
+ * Narrow phase: pairs of intersecting faces between two meshes
+ * @param a First mesh
+ * @param bvh_a Face hierarchy of the first mesh
+ * @param b Second mesh
+ * @param bvh_b Face hierarchy of the second mesh
+ * @param first_only Stop after the first intersecting pair
+ * @return Pairs (face of a, face of b)
+ */
+inline std::vector<IndexPair> intersecting_faces(const MeshView& a, const BVH& bvh_a, const MeshView& b, const BVH& bvh_b, bool first_only = false) {
+    std::vector<IndexPair> pairs;
+    traverse(bvh_a, bvh_b, [&](uint32_t fa, uint32_t fb) {
+        Vec3 t1[3] = {a.corner(fa, 0), a.corner(fa, 1), a.corner(fa, 2)};
+        Vec3 t2[3] = {b.corner(fb, 0), b.corner(fb, 1), b.corner(fb, 2)};
+        if (triangles_intersect(t1, t2)) {
+            pairs.emplace_back(fa, fb);
+            return !first_only;
+        }
+        return true;
+    });
+    return pairs;
+}
+
+/**
+ * Collision detection over many meshes
+ * Mesh bounds are culled with sweep-and-prune, candidate pairs are resolved in parallel with BVH-vs-BVH traversal.
+ * @param meshes Meshes to test against each other
+ * @return Sorted pairs (i, j) with i < j of meshes that touch or overlap
+ */
+inline std::vector<IndexPair> colliding_meshes(std::span<const MeshView> meshes) {
+    std::vector<BVH> bvhs(meshes.size());
+    Scratch scratch;
+    std::span<Box3> bounds = scratch.array<Box3>(meshes.size());
+    parallel_for(meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            bvhs[i] = face_bvh(meshes[i]);
+            bounds[i] = bvhs[i].bounds();
+        }
+    });
+
+    std::vector<IndexPair> candidates = sweep_and_prune(bounds);
+    std::span<uint8_t> hit = scratch.array<uint8_t>(candidates.size(), 0);
+    parallel_for(candidates.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            auto [i, j] = candidates[k];
+            hit[k] = !intersecting_faces(meshes[i], bvhs[i], meshes[j], bvhs[j], true).empty();
+        }
+    });
+
+    std::vector<IndexPair> pairs;
+    for (size_t k = 0; k < candidates.size(); ++k)
+        if (hit[k])
+            pairs.push_back(candidates[k]);
+    return pairs;
+}
+
+} // namespace compas
@@ -0,0 +1,59 @@
+// csr.h - Compressed sparse row incidence lists for edge arrays
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Compressed sparse row lists: the items of row i are items[offsets[i]:offsets[i + 1]]
+ */
+struct CSR {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> items;
+
+    size_t rows() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    uint32_t begin(size_t row) const { return offsets[row]; }
+    uint32_t end(size_t row) const { return offsets[row + 1]; }
+    uint32_t degree(size_t row) const { return offsets[row + 1] - offsets[row]; }
+};
+
+/**
+ * Check that every edge references an existing vertex
+ * @param edges Row-major (E,2) vertex indices
+ * @throws std::out_of_range if an index is negative or too large
+ */
+inline void check_edges(const int32_t* edges, size_t edge_count, size_t vertex_count) {
+    for (size_t i = 0; i < 2 * edge_count; ++i)
+        if (edges[i] < 0 || static_cast<size_t>(edges[i]) >= vertex_count)
+            throw std::out_of_range("Edge " + std::to_string(i / 2) + " references missing vertex " + std::to_string(edges[i]));
+}
+
+/**
+ * Edges incident to each vertex, in increasing edge order
+ * @param edges Row-major (E,2) vertex indices
+ * @param edge_count Number of edges E
+ * @param vertex_count Number of vertices V
+ * @return V rows of edge indices; a loop edge appears twice in its vertex row
+ */
+inline CSR vertex_edges(const int32_t* edges, size_t edge_count, size_t vertex_count) {
+    CSR csr;
+    csr.offsets.assign(vertex_count + 1, 0);
+    for (size_t i = 0; i < 2 * edge_count; ++i)
+        ++csr.offsets[edges[i] + 1];
+    for (size_t v = 0; v < vertex_count; ++v)
+        csr.offsets[v + 1] += csr.offsets[v];
+    csr.items.resize(2 * edge_count);
+    std::vector<uint32_t> cursor(csr.offsets.begin(), csr.offsets.end() - 1);
+    for (size_t e = 0; e < edge_count; ++e) {
+        csr.items[cursor[edges[2 * e]]++] = static_cast<uint32_t>(e);
+        csr.items[cursor[edges[2 * e + 1]]++] = static_cast<uint32_t>(e);
+    }
+    return csr;
+}
+
+} // namespace compas
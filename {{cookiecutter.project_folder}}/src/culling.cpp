@@ -0,0 +1,137 @@
+#include "compas.h"
+#include "arrays.h"
+#include "culling.h"
+
+#include <mutex>
+#include <shared_mutex>
+
+using namespace compas;
+
+using IndicesIn = nb::ndarray<const int32_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+using PlanesIn = RowsIn<4>;
+using MatrixIn = nb::ndarray<const double, nb::shape<4, 4>, nb::c_contig, nb::device::cpu>;
+using Indices = nb::ndarray<nb::numpy, uint32_t>;
+
+/**
+ * Box set shared by Python threads
+ * Queries run without the GIL, so they hold the mutex shared, while updates and refits hold it
+ * exclusively; a query that finds moved objects refits first under the exclusive lock.
+ */
+struct SharedBoxSet {
+    BoxSet set;
+    std::shared_mutex mutex;
+
+    SharedBoxSet(const BoxesIn& boxes) : set(boxes.data(), boxes.shape(0)) {}
+};
+
+/**
+ * Move query results into a NumPy array
+ * @param indices Object indices
+ * @return (K,) uint32 array
+ */
+Indices indices_to_ndarray(ArrayBuffer<uint32_t>&& indices) {
+    size_t n = indices.size();
+    return to_ndarray(std::move(indices), {n});
+}
+
+/**
+ * Run a query without the GIL, refitting the block bounds first if objects moved
+ * @param self Box set
+ * @param query Callable query(set) returning the kept indices
+ * @return (K,) uint32 indices of the kept objects
+ */
+template <class Query>
+Indices run(SharedBoxSet& self, Query&& query) {
+    ArrayBuffer<uint32_t> indices;
+    {
+        nb::gil_scoped_release release;
+        std::shared_lock<std::shared_mutex> read(self.mutex);
+        if (self.set.dirty()) {
+            read.unlock();
+            std::unique_lock<std::shared_mutex> write(self.mutex);
+            self.set.refit();
+            indices = query(self.set);
+        } else {
+            indices = query(self.set);
+        }
+    }
+    return indices_to_ndarray(std::move(indices));
+}
+
+/**
+ * Replace the boxes of many objects
+ * @param self Box set
+ * @param indices (K,) object indices
+ * @param boxes (K,6) boxes
+ */
+void update(SharedBoxSet& self, const IndicesIn& indices, const BoxesIn& boxes) {
+    if (indices.shape(0) != boxes.shape(0))
+        throw std::invalid_argument("Expected one box per object index.");
+    nb::gil_scoped_release release;
+    std::unique_lock<std::shared_mutex> write(self.mutex);
+    // All indices are checked before any box moves, so a bad one leaves the set unchanged
+    for (size_t k = 0; k < indices.shape(0); ++k)
+        if (indices.data()[k] < 0 || static_cast<size_t>(indices.data()[k]) >= self.set.size())
+            throw std::out_of_range("Box " + std::to_string(indices.data()[k]) + " does not exist.");
+    for (size_t k = 0; k < indices.shape(0); ++k)
+        self.set.set(static_cast<uint32_t>(indices.data()[k]), boxes.data() + 6 * k);
+}
+
+/**
+ * Copy of all boxes
+ * @param self Box set
+ * @return (N,6) boxes
+ */
+nb::ndarray<nb::numpy, double> boxes(SharedBoxSet& self) {
+    size_t n = self.set.size();
+    ArrayBuffer<double> data(6 * n);
+    {
+        nb::gil_scoped_release release;
+        std::shared_lock<std::shared_mutex> read(self.mutex);
+        for (size_t i = 0; i < n; ++i)
+            self.set.get(static_cast<uint32_t>(i), data.data() + 6 * i);
+    }
+    return to_ndarray(std::move(data), {n, 6});
+}
+
+/**
+ * Clipping planes of a view-projection matrix
+ * @param matrix (4,4) view-projection matrix
+ * @return (6,4) inward planes left, right, bottom, top, near, far
+ */
+nb::ndarray<nb::numpy, double> planes(const MatrixIn& matrix) {
+    ArrayBuffer<double> data(24);
+    frustum_planes(matrix.data(), data.data());
+    return to_ndarray(std::move(data), {6, 4});
+}
+
+NB_MODULE(_culling, m) {
+    m.doc() = "Frustum, box and sphere culling over many axis-aligned boxes.";
+    share_memory_ledger();
+
+    m.def("frustum_planes", &planes, "matrix"_a,
+          "Inward (6,4) clipping planes of a 4x4 view-projection matrix");
+
+    nb::class_<SharedBoxSet>(m, "BoxSet")
+        .def("__init__", [](SharedBoxSet* self, const BoxesIn& boxes) {
+            new (self) SharedBoxSet(boxes);
+        }, "boxes"_a, "Store (N,6) boxes as xmin, ymin, zmin, xmax, ymax, zmax")
+        .def("__len__", [](const SharedBoxSet& self) { return self.set.size(); })
+        .def("update", &update, "indices"_a, "boxes"_a, "Replace the boxes of moved objects")
+        .def("boxes", &boxes, "Copy of all boxes")
+        .def("frustum", [](SharedBoxSet& self, const PlanesIn& planes) {
+            return run(self, [&](const BoxSet& s) { return s.frustum(planes.data(), planes.shape(0)); });
+        }, "planes"_a, "Indices of boxes not entirely outside one of the (P,4) planes")
+        .def("box", [](SharedBoxSet& self, const BoxesIn& box) {
+            if (box.shape(0) != 1)
+                throw std::invalid_argument("Expected a single query box.");
+            return run(self, [&](const BoxSet& s) { return s.box(box.data()); });
+        }, "box"_a, "Indices of boxes overlapping a (1,6) query box")
+        .def("sphere", [](SharedBoxSet& self, const PointsIn& center, double radius) {
+            if (center.shape(0) != 1)
+                throw std::invalid_argument("Expected a single center.");
+            return run(self, [&](const BoxSet& s) { return s.sphere(center.data(), radius); });
+        }, "center"_a, "radius"_a, "Indices of boxes intersecting a ball");
+
+    def_arena_stats(m);
+}
@@ -0,0 +1,276 @@
+// culling.h - Bounding box sets with frustum, box and sphere culling
+#pragma once
+
+#include "arena.h"
+#include "memory.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Extract the six clipping planes of a view-projection matrix
+ * Planes are stored as a, b, c, d with normalized, inward-pointing normals, so a point is inside
+ * when a x + b y + c z + d >= 0. The matrix maps column vectors to clip space with -w <= z <= w.
+ * @param matrix Row-major 4x4 view-projection matrix
+ * @param planes Output (6,4) planes in the order left, right, bottom, top, near, far
+ * @throws std::invalid_argument if the matrix yields a degenerate plane
+ */
+inline void frustum_planes(const double* matrix, double* planes) {
+    const double* w = matrix + 12;
+    for (int p = 0; p < 6; ++p) {
+        const double* row = matrix + 4 * (p / 2);
+        double sign = p % 2 ? -1.0 : 1.0;
+        double* plane = planes + 4 * p;
+        for (int k = 0; k < 4; ++k)
+            plane[k] = w[k] + sign * row[k];
+        double length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (!(length > 0.0))
+            throw std::invalid_argument("The matrix does not define a valid frustum.");
+        for (int k = 0; k < 4; ++k)
+            plane[k] /= length;
+    }
+}
+
+/**
+ * Axis-aligned boxes of many objects, stored one coordinate array per bound
+ * Boxes are grouped in blocks of BLOCK consecutive objects, each with its own bounds. Queries
+ * reject or accept whole blocks from their bounds and test the remaining blocks with branch-free
+ * loops over the coordinate arrays, which the compiler vectorizes. Moving objects only marks
+ * their blocks for refit, so per-frame updates cost the number of moved objects.
+ */
+class BoxSet {
+public:
+    static constexpr size_t BLOCK = 64;
+
+    BoxSet() = default;
+
+    /**
+     * @param boxes Row-major (N,6) boxes as xmin, ymin, zmin, xmax, ymax, zmax
+     * @param count Number of boxes N
+     * @throws std::invalid_argument if a box has a minimum above its maximum
+     */
+    BoxSet(const double* boxes, size_t count) {
+        for (auto& c : coords_)
+            c.resize(count);
+        for (size_t i = 0; i < count; ++i)
+            store(i, boxes + 6 * i);
+        size_t blocks = (count + BLOCK - 1) / BLOCK;
+        for (auto& c : block_coords_)
+            c.resize(blocks);
+        dirty_.assign(blocks, 1);
+        for (size_t b = 0; b < blocks; ++b)
+            pending_.push_back(static_cast<uint32_t>(b));
+        refit();
+    }
+
+    size_t size() const { return coords_[0].size(); }
+
+    /**
+     * Replace the box of one object
+     * Block bounds are updated by the next refit().
+     * @param index Object index
+     * @param box Six values xmin, ymin, zmin, xmax, ymax, zmax
+     */
+    void set(uint32_t index, const double* box) {
+        if (index >= size())
+            throw std::out_of_range("Box " + std::to_string(index) + " does not exist.");
+        store(index, box);
+        uint32_t block = index / BLOCK;
+        if (!dirty_[block]) {
+            dirty_[block] = 1;
+            pending_.push_back(block);
+        }
+    }
+
+    /**
+     * Copy the box of one object
+     * @param index Object index
+     * @param box Output six values
+     */
+    void get(uint32_t index, double* box) const {
+        for (int k = 0; k < 6; ++k)
+            box[k] = coords_[k][index];
+    }
+
+    bool dirty() const { return !pending_.empty(); }
+
+    /**
+     * Recompute the bounds of blocks holding moved objects
+     * Must be called after set() and before the next query.
+     * @return Number of refitted blocks
+     */
+    size_t refit() {
+        for (uint32_t b : pending_) {
+            size_t begin = size_t(b) * BLOCK, end = std::min(size(), begin + BLOCK);
+            for (int k = 0; k < 3; ++k) {
+                block_coords_[k][b] = *std::min_element(coords_[k].begin() + begin, coords_[k].begin() + end);
+                block_coords_[k + 3][b] = *std::max_element(coords_[k + 3].begin() + begin, coords_[k + 3].begin() + end);
+            }
+            dirty_[b] = 0;
+        }
+        size_t count = pending_.size();
+        pending_.clear();
+        return count;
+    }
+
+    /**
+     * Objects whose boxes are not entirely outside a convex region
+     * A box is culled when it lies fully on the negative side of one plane. This is conservative:
+     * boxes near the corners of the region may be kept although they do not intersect it.
+     * @param planes Row-major (P,4) planes a, b, c, d, inside where a x + b y + c z + d >= 0
+     * @param plane_count Number of planes P
+     * @return Indices of the kept objects in increasing order
+     */
+    ArrayBuffer<uint32_t> frustum(const double* planes, size_t plane_count) const {
+        return cull([&](const Coords& c, size_t begin, size_t n, uint8_t* keep) {
+            std::fill(keep, keep + n, uint8_t(1));
+            for (size_t p = 0; p < plane_count; ++p) {
+                const double* plane = planes + 4 * p;
+                // The box corner farthest along the normal decides, pick its bounds once per plane
+                const double* x = c[plane[0] >= 0.0 ? 3 : 0].data() + begin;
+                const double* y = c[plane[1] >= 0.0 ? 4 : 1].data() + begin;
+                const double* z = c[plane[2] >= 0.0 ? 5 : 2].data() + begin;
+                for (size_t i = 0; i < n; ++i)
+                    keep[i] &= uint8_t(plane[0] * x[i] + plane[1] * y[i] + plane[2] * z[i] + plane[3] >= 0.0);
+            }
+        }, [&](const Coords& c, size_t b) {
+            // A block is inside when its corner nearest along every normal is inside
+            for (size_t p = 0; p < plane_count; ++p) {
+                const double* plane = planes + 4 * p;
+                double x = c[plane[0] >= 0.0 ? 0 : 3][b], y = c[plane[1] >= 0.0 ? 1 : 4][b], z = c[plane[2] >= 0.0 ? 2 : 5][b];
+                if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0)
+                    return false;
+            }
+            return true;
+        });
+    }
+
+    /**
+     * Objects whose boxes overlap a query box, touching boxes included
+     * @param box Six values xmin, ymin, zmin, xmax, ymax, zmax
+     * @return Indices of the overlapping objects in increasing order
+     */
+    ArrayBuffer<uint32_t> box(const double* box) const {
+        return cull([&](const Coords& c, size_t begin, size_t n, uint8_t* keep) {
+            std::fill(keep, keep + n, uint8_t(1));
+            for (int k = 0; k < 3; ++k) {
+                const double* lo = c[k].data() + begin;
+                const double* hi = c[k + 3].data() + begin;
+                for (size_t i = 0; i < n; ++i)
+                    keep[i] &= uint8_t(lo[i] <= box[k + 3]) & uint8_t(hi[i] >= box[k]);
+            }
+        }, [&](const Coords& c, size_t b) {
+            for (int k = 0; k < 3; ++k)
+                if (c[k][b] < box[k] || c[k + 3][b] > box[k + 3])
+                    return false;
+            return true;
+        });
+    }
+
+    /**
+     * Objects whose boxes intersect a ball
+     * @param center Three coordinates of the center
+     * @param radius Radius of the ball
+     * @return Indices of the intersecting objects in increasing order
+     */
+    ArrayBuffer<uint32_t> sphere(const double* center, double radius) const {
+        double r2 = radius * radius;
+        return cull([&](const Coords& c, size_t begin, size_t n, uint8_t* keep) {
+            double d2[BLOCK] = {};
+            for (int k = 0; k < 3; ++k) {
+                const double* lo = c[k].data() + begin;
+                const double* hi = c[k + 3].data() + begin;
+                for (size_t i = 0; i < n; ++i) {
+                    double d = std::max(std::max(lo[i] - center[k], center[k] - hi[i]), 0.0);
+                    d2[i] += d * d;
+                }
+            }
+            for (size_t i = 0; i < n; ++i)
+                keep[i] = uint8_t(d2[i] <= r2);
+        }, [&](const Coords& c, size_t b) {
+            // Inside when the farthest corner of the block is within the radius
+            double d2 = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                double d = std::max(center[k] - c[k][b], c[k + 3][b] - center[k]);
+                d2 += d * d;
+            }
+            return d2 <= r2;
+        });
+    }
+
+private:
+    using Coords = std::vector<double>[6];
+
+    void store(size_t index, const double* box) {
+        for (int k = 0; k < 3; ++k)
+            if (!(box[k] <= box[k + 3]))
+                throw std::invalid_argument("Box " + std::to_string(index) + " has a minimum above its maximum.");
+        for (int k = 0; k < 6; ++k)
+            coords_[k][index] = box[k];
+    }
+
+    /**
+     * Run a query block by block in parallel
+     * Blocks whose bounds fail the object test are skipped, blocks accepted by `inside` are kept
+     * whole and the rest are tested object by object. Each chunk of blocks writes its hits into
+     * its own range of one scratch array, which are then concatenated.
+     * @param test Callable test(coords, begin, n, keep) setting keep[i] for objects begin + i
+     * @param inside Callable inside(block_coords, block) true if every object of the block passes
+     * @return Indices of the kept objects in increasing order
+     */
+    template <class Test, class Inside>
+    ArrayBuffer<uint32_t> cull(Test&& test, Inside&& inside) const {
+        if (dirty())
+            throw std::logic_error("The boxes changed since the last refit.");
+        size_t blocks = block_coords_[0].size();
+        constexpr size_t grain = 16;
+        Scratch scratch;
+        std::span<uint32_t> hits = scratch.array<uint32_t>(size());
+        std::span<size_t> counts = scratch.array<size_t>((blocks + grain - 1) / grain, 0);
+
+        parallel_for(blocks, grain, [&](size_t begin, size_t end) {
+            uint32_t* result = hits.data() + begin * BLOCK;
+            size_t& count = counts[begin / grain];
+            uint8_t keep[BLOCK];
+            for (size_t b = begin; b < end; ++b) {
+                size_t first = b * BLOCK, n = std::min(size(), first + BLOCK) - first;
+                test(block_coords_, b, 1, keep);
+                if (!keep[0])
+                    continue;
+                if (inside(block_coords_, b)) {
+                    for (size_t i = 0; i < n; ++i)
+                        result[count++] = static_cast<uint32_t>(first + i);
+                    continue;
+                }
+                test(coords_, first, n, keep);
+                for (size_t i = 0; i < n; ++i)
+                    if (keep[i])
+                        result[count++] = static_cast<uint32_t>(first + i);
+            }
+        });
+
+        ArrayBuffer<uint32_t> indices;
+        size_t total = 0;
+        for (size_t count : counts)
+            total += count;
+        indices.reserve(total);
+        for (size_t c = 0; c < counts.size(); ++c)
+            indices.insert(indices.end(), hits.begin() + c * grain * BLOCK, hits.begin() + c * grain * BLOCK + counts[c]);
+        return indices;
+    }
+
+    Coords coords_;        // xmin, ymin, zmin, xmax, ymax, zmax per object
+    Coords block_coords_;  // the same per block of BLOCK objects
+    std::vector<uint8_t> dirty_;
+    std::vector<uint32_t> pending_;  // blocks with moved objects since the last refit
+};
+
+} // namespace compas
@@ -0,0 +1,192 @@
+#include "compas.h"
+#include "arrays.h"
+#include "nurbs.h"
+#include "parallel.h"
+
+using namespace compas;
+
+using ControlGridIn = nb::ndarray<const double, nb::shape<-1, -1, 3>, nb::c_contig, nb::device::cpu>;
+using WeightGridIn = nb::ndarray<const double, nb::ndim<2>, nb::c_contig, nb::device::cpu>;
+using DegreesIn = nb::ndarray<const int32_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Evaluate many NURBS curves, each at its own parameters
+ * Curves are packed back to back; offsets arrays delimit each curve's entries.
+ * @param points (M,3) control points of all curves
+ * @param weights (M,) control point weights
+ * @param point_offsets (C+1,) control point offsets per curve
+ * @param knots (K,) knots of all curves
+ * @param knot_offsets (C+1,) knot offsets per curve
+ * @param degrees (C,) degree per curve
+ * @param params (N,) parameters of all curves
+ * @param param_offsets (C+1,) parameter offsets per curve
+ * @param order Highest derivative, 0 for points only
+ * @return (N,order+1,3) points followed by their derivatives
+ */
+nb::ndarray<nb::numpy, double> evaluate_curves(const PointsIn& points, const ValuesIn& weights, const OffsetsIn& point_offsets,
+                                               const ValuesIn& knots, const OffsetsIn& knot_offsets, const DegreesIn& degrees,
+                                               const ValuesIn& params, const OffsetsIn& param_offsets, int order) {
+    size_t count = degrees.shape(0);
+    if (weights.shape(0) != points.shape(0))
+        throw std::invalid_argument("Expected one weight per control point.");
+    if (order < 0 || order > MAX_DEGREE)
+        throw std::invalid_argument("Derivative order must be in [0, " + std::to_string(MAX_DEGREE) + "].");
+    check_offsets(point_offsets, count, points.shape(0), "point_offsets");
+    check_offsets(knot_offsets, count, knots.shape(0), "knot_offsets");
+    check_offsets(param_offsets, count, params.shape(0), "param_offsets");
+
+    const int64_t* po = point_offsets.data();
+    const int64_t* ko = knot_offsets.data();
+    Scratch scratch;
+    std::span<NurbsCurve> curves = scratch.array<NurbsCurve>(count);
+    for (size_t c = 0; c < count; ++c) {
+        curves[c] = {degrees.data()[c], points.data() + 3 * po[c], weights.data() + po[c], size_t(po[c + 1] - po[c]),
+                     knots.data() + ko[c], size_t(ko[c + 1] - ko[c])};
+        curves[c].validate();
+    }
+
+    size_t n = params.shape(0);
+    size_t stride = size_t(order + 1) * 3;
+    ArrayBuffer<double> out(n * stride);
+    {
+        nb::gil_scoped_release release;
+        const int64_t* to = param_offsets.data();
+        std::vector<BasisTable> tables(thread_count());
+        parallel_for(count, 16, [&](size_t begin, size_t end, size_t worker) {
+            for (size_t c = begin; c < end; ++c)
+                evaluate_curve(curves[c], params.data() + to[c], size_t(to[c + 1] - to[c]), order, out.data() + to[c] * stride, tables[worker]);
+        });
+    }
+    return to_ndarray(std::move(out), {n, size_t(order + 1), 3});
+}
+
+/**
+ * Wrap surface arrays as a validated surface view
+ */
+NurbsSurface surface_view(const ControlGridIn& points, const WeightGridIn& weights, const ValuesIn& knots_u, const ValuesIn& knots_v, int degree_u, int degree_v) {
+    if (weights.shape(0) != points.shape(0) || weights.shape(1) != points.shape(1))
+        throw std::invalid_argument("Expected one weight per control point.");
+    NurbsSurface surface{degree_u, degree_v, points.data(), weights.data(), points.shape(0), points.shape(1),
+                         knots_u.data(), knots_u.shape(0), knots_v.data(), knots_v.shape(0)};
+    surface.validate();
+    return surface;
+}
+
+/**
+ * Evaluate a NURBS surface at scattered (u, v) parameters
+ * @param points (U,V,3) control points
+ * @param weights (U,V) weights
+ * @param knots_u Knots in u
+ * @param knots_v Knots in v
+ * @param degree_u Degree in u
+ * @param degree_v Degree in v
+ * @param params (N,2) parameters
+ * @param derivatives Also return the first partial derivatives
+ * @return (N,3,3) point, dS/du, dS/dv, or (N,1,3) points only
+ */
+nb::ndarray<nb::numpy, double> evaluate_surface(const ControlGridIn& points, const WeightGridIn& weights, const ValuesIn& knots_u, const ValuesIn& knots_v,
+                                                int degree_u, int degree_v, const RowsIn<2>& params, bool derivatives) {
+    NurbsSurface surface = surface_view(points, weights, knots_u, knots_v, degree_u, degree_v);
+    size_t n = params.shape(0);
+    size_t rows = derivatives ? 3 : 1;
+    int order = derivatives ? 1 : 0;
+    ArrayBuffer<double> out(n * rows * 3);
+    {
+        nb::gil_scoped_release release;
+        parallel_for(n, 1024, [&](size_t begin, size_t end) {
+            double bu[2 * (MAX_DEGREE + 1)], bv[2 * (MAX_DEGREE + 1)], result[9];
+            for (size_t i = begin; i < end; ++i) {
+                double u = params.data()[2 * i], v = params.data()[2 * i + 1];
+                size_t su = find_span(surface.knots_u, surface.count_u, degree_u, u);
+                size_t sv = find_span(surface.knots_v, surface.count_v, degree_v, v);
+                basis_derivatives(su, u, degree_u, order, surface.knots_u, bu);
+                basis_derivatives(sv, v, degree_v, order, surface.knots_v, bv);
+                evaluate_surface_basis(surface, su, bu, sv, bv, derivatives, result);
+                std::copy(result, result + 3 * rows, out.data() + i * rows * 3);
+            }
+        });
+    }
+    return to_ndarray(std::move(out), {n, rows, 3});
+}
+
+/**
+ * Evaluate a NURBS surface on the grid us x vs
+ * Basis functions are computed once per u and once per v value and shared across the grid.
+ * @return (Nu,Nv,3,3) point, dS/du, dS/dv, or (Nu,Nv,1,3) points only
+ */
+nb::ndarray<nb::numpy, double> evaluate_surface_grid(const ControlGridIn& points, const WeightGridIn& weights, const ValuesIn& knots_u, const ValuesIn& knots_v,
+                                                     int degree_u, int degree_v, const ValuesIn& us, const ValuesIn& vs, bool derivatives) {
+    NurbsSurface surface = surface_view(points, weights, knots_u, knots_v, degree_u, degree_v);
+    size_t nu = us.shape(0), nv = vs.shape(0);
+    size_t rows = derivatives ? 3 : 1;
+    int order = derivatives ? 1 : 0;
+    ArrayBuffer<double> out(nu * nv * rows * 3);
+    {
+        nb::gil_scoped_release release;
+        BasisTable table_u, table_v;
+        table_u.build(degree_u, order, surface.knots_u, surface.knot_count_u, surface.count_u, us.data(), nu);
+        table_v.build(degree_v, order, surface.knots_v, surface.knot_count_v, surface.count_v, vs.data(), nv);
+        parallel_for(nu, 4, [&](size_t begin, size_t end) {
+            double result[9];
+            for (size_t i = begin; i < end; ++i) {
+                for (size_t j = 0; j < nv; ++j) {
+                    evaluate_surface_basis(surface, table_u.spans[i], table_u.at(i), table_v.spans[j], table_v.at(j), derivatives, result);
+                    std::copy(result, result + 3 * rows, out.data() + (i * nv + j) * rows * 3);
+                }
+            }
+        });
+    }
+    return to_ndarray(std::move(out), {nu, nv, rows, 3});
+}
+
+/**
+ * Evaluate many polylines by normalized arc length
+ * @param points (M,3) vertices of all polylines
+ * @param point_offsets (C+1,) vertex offsets per polyline
+ * @param params (N,) parameters in [0, 1] of all polylines
+ * @param param_offsets (C+1,) parameter offsets per polyline
+ * @return (N,2,3) points and derivatives with respect to the parameter
+ */
+nb::ndarray<nb::numpy, double> evaluate_polylines(const PointsIn& points, const OffsetsIn& point_offsets, const ValuesIn& params, const OffsetsIn& param_offsets) {
+    size_t count = point_offsets.shape(0) > 0 ? point_offsets.shape(0) - 1 : 0;
+    check_offsets(point_offsets, count, points.shape(0), "point_offsets");
+    check_offsets(param_offsets, count, params.shape(0), "param_offsets");
+    const int64_t* po = point_offsets.data();
+    const int64_t* to = param_offsets.data();
+    for (size_t c = 0; c < count; ++c)
+        if (po[c + 1] - po[c] < 2)
+            throw std::invalid_argument("Polylines need at least two vertices.");
+
+    size_t n = params.shape(0);
+    ArrayBuffer<double> out(n * 6);
+    {
+        nb::gil_scoped_release release;
+        parallel_for(count, 64, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c)
+                evaluate_polyline(points.data() + 3 * po[c], size_t(po[c + 1] - po[c]), params.data() + to[c], size_t(to[c + 1] - to[c]), out.data() + 6 * to[c]);
+        });
+    }
+    return to_ndarray(std::move(out), {n, 2, 3});
+}
+
+NB_MODULE(_curves, m) {
+    m.doc() = "Batched curve and surface evaluation.";
+    share_memory_ledger();
+
+    m.def("evaluate_curves", &evaluate_curves, "points"_a, "weights"_a, "point_offsets"_a, "knots"_a, "knot_offsets"_a,
+          "degrees"_a, "params"_a, "param_offsets"_a, "order"_a = 0,
+          "Evaluate packed NURBS curves and their derivatives at packed parameters");
+
+    m.def("evaluate_surface", &evaluate_surface, "points"_a, "weights"_a, "knots_u"_a, "knots_v"_a, "degree_u"_a, "degree_v"_a,
+          "params"_a, "derivatives"_a = false,
+          "Evaluate a NURBS surface at (N,2) parameters");
+
+    m.def("evaluate_surface_grid", &evaluate_surface_grid, "points"_a, "weights"_a, "knots_u"_a, "knots_v"_a, "degree_u"_a, "degree_v"_a,
+          "us"_a, "vs"_a, "derivatives"_a = false,
+          "Evaluate a NURBS surface on a parameter grid with cached basis functions");
+
+    m.def("evaluate_polylines", &evaluate_polylines, "points"_a, "point_offsets"_a, "params"_a, "param_offsets"_a,
+          "Evaluate packed polylines by normalized arc length");
+
+    def_arena_stats(m);
+}
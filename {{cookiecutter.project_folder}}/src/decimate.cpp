@@ -0,0 +1,64 @@
+#include "compas.h"
+#include "arrays.h"
+#include "decimate.h"
+
+using namespace compas;
+
+/**
+ * Move compact mesh arrays into NumPy arrays
+ * @return Tuple of vertices (V,3) and faces (F,3)
+ */
+nb::tuple mesh_arrays(ArrayBuffer<double>&& points, ArrayBuffer<int32_t>&& triangles) {
+    size_t V = points.size() / 3, F = triangles.size() / 3;
+    return nb::make_tuple(to_ndarray(std::move(points), {V, 3}), to_ndarray(std::move(triangles), {F, 3}));
+}
+
+/**
+ * Quadric error edge collapse simplification
+ * @param vertices (V,3) vertex coordinates
+ * @param faces (F,3) vertex indices per face
+ * @param target_faces Stop at or below this number of faces
+ * @param max_error Stop before a collapse with a larger quadric error
+ * @return Tuple of vertices (V',3) and faces (F',3)
+ */
+nb::tuple decimate_mesh(const PointsIn& vertices, const FacesIn& faces, size_t target_faces, double max_error) {
+    MeshView mesh = mesh_view(vertices, faces);
+    ArrayBuffer<double> points;
+    ArrayBuffer<int32_t> triangles;
+    {
+        nb::gil_scoped_release release;
+        decimate(mesh, DecimateOptions{target_faces, max_error}).compact(points, triangles);
+    }
+    return mesh_arrays(std::move(points), std::move(triangles));
+}
+
+/**
+ * Vertex clustering simplification on a uniform grid
+ * @param vertices (V,3) vertex coordinates
+ * @param faces (F,3) vertex indices per face
+ * @param cell_size Edge length of the grid cells
+ * @return Tuple of vertices (V',3) and faces (F',3)
+ */
+nb::tuple cluster_mesh(const PointsIn& vertices, const FacesIn& faces, double cell_size) {
+    MeshView mesh = mesh_view(vertices, faces);
+    ArrayBuffer<double> points;
+    ArrayBuffer<int32_t> triangles;
+    {
+        nb::gil_scoped_release release;
+        cluster_decimate(mesh, cell_size, points, triangles);
+    }
+    return mesh_arrays(std::move(points), std::move(triangles));
+}
+
+NB_MODULE(_decimate, m) {
+    m.doc() = "Mesh simplification with quadric error metrics.";
+    share_memory_ledger();
+
+    m.def("decimate", &decimate_mesh, "vertices"_a, "faces"_a, "target_faces"_a, "max_error"_a,
+          "Collapse edges in order of quadric error until the face count or error bound is reached");
+
+    m.def("cluster", &cluster_mesh, "vertices"_a, "faces"_a, "cell_size"_a,
+          "Merge the vertices of each grid cell into the point of least quadric error");
+
+    def_arena_stats(m);
+}
@@ -0,0 +1,310 @@
+// decimate.h - Mesh simplification with quadric error metrics
+#pragma once
+
+#include "arena.h"
+#include "halfedge.h"
+#include "heap.h"
+#include "memory.h"
+#include "parallel.h"
+#include "pool.h"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace compas {
+
+using Quadric = Eigen::Matrix4d;
+
+struct DecimateOptions {
+    size_t target_faces = 0;                                      // stop at or below this face count
+    double max_error = std::numeric_limits<double>::infinity();  // stop before a collapse costs more
+};
+
+/**
+ * Fundamental quadric of the plane of a triangle, weighted by its area
+ * The squared distance of x to the plane, times the area, is [x 1] Q [x 1]^T.
+ */
+inline Quadric face_quadric(const Vec3& a, const Vec3& b, const Vec3& c) {
+    Vec3 n = (b - a).cross(c - a);
+    double area = 0.5 * n.norm();
+    if (!(area > 0.0))
+        return Quadric::Zero();
+    Eigen::Vector4d plane;
+    plane << n / (2.0 * area), -n.dot(a) / (2.0 * area);
+    return area * plane * plane.transpose();
+}
+
+/**
+ * @return Quadric error [x 1] Q [x 1]^T of a position, clamped at zero against round-off
+ */
+inline double quadric_error(const Quadric& q, const Vec3& x) {
+    return std::max(x.dot(q.topLeftCorner<3, 3>() * x) + 2.0 * x.dot(q.topRightCorner<3, 1>()) + q(3, 3), 0.0);
+}
+
+/**
+ * Position minimizing a quadric, or the best of the fallback points if it is singular
+ * @param q Quadric
+ * @param fallbacks Candidate positions tried when the system is ill-conditioned
+ * @param error Output quadric error at the returned position
+ */
+inline Vec3 quadric_minimizer(const Quadric& q, std::initializer_list<Vec3> fallbacks, double& error) {
+    Eigen::Matrix3d A = q.topLeftCorner<3, 3>();
+    double det = A.determinant(), scale = A.norm();
+    if (std::abs(det) > 1e-12 * scale * scale * scale) {
+        Vec3 x = A.inverse() * -q.topRightCorner<3, 1>();
+        error = quadric_error(q, x);
+        return x;
+    }
+    Vec3 best;
+    error = std::numeric_limits<double>::infinity();
+    for (const Vec3& x : fallbacks) {
+        double e = quadric_error(q, x);
+        if (e < error) {
+            error = e;
+            best = x;
+        }
+    }
+    return best;
+}
+
+/**
+ * Quadric error edge collapse simplification (Garland and Heckbert 1997)
+ * Collapse candidates live in a pool and are ordered by an indexed 4-ary heap keyed by their
+ * error, so an edge whose cost changes is updated in place and removed candidates are recycled.
+ * After a collapse only the edges at the merged vertex are re-evaluated. Boundary vertices stay
+ * in place and boundary edges are not collapsed. Collapses that would break manifoldness or fold
+ * a face are skipped until a neighbouring collapse changes them.
+ * @param input Manifold triangle mesh
+ * @param options Target face count and error bound
+ * @return Simplified mesh, compact() gives the output arrays
+ */
+inline HalfEdgeMesh decimate(const MeshView& input, const DecimateOptions& options) {
+    HalfEdgeMesh mesh(input);
+    constexpr uint32_t NONE = HalfEdgeMesh::NONE;
+
+    // Vertex quadrics gathered from the faces in parallel, one vertex per task
+    Scratch scratch;
+    std::span<Quadric> quadrics = scratch.array<Quadric>(mesh.vertex_capacity(), Quadric::Zero());
+    parallel_for(mesh.vertex_capacity(), 1024, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v)
+            mesh.for_each_outgoing(static_cast<uint32_t>(v), [&](uint32_t h) {
+                quadrics[v] += face_quadric(mesh.points[v], mesh.points[mesh.to(h)], mesh.points[mesh.opposite(h)]);
+            });
+    });
+
+    struct Candidate {
+        uint32_t halfedge = NONE;  // collapses from(halfedge) into to(halfedge)
+        Vec3 point = Vec3::Zero();
+    };
+    Pool<Candidate> candidates;
+    candidates.reserve(mesh.halfedge_capacity() / 2);
+    std::span<uint32_t> edge_candidate = scratch.array(mesh.halfedge_capacity(), NONE);
+    IndexedHeap heap;
+
+    auto key = [&](uint32_t h) { return mesh.twin(h) == NONE ? h : std::min(h, mesh.twin(h)); };
+
+    auto remove = [&](uint32_t h) {
+        uint32_t& c = edge_candidate[key(h)];
+        if (c == NONE)
+            return;
+        heap.erase(c);
+        candidates.release(c);
+        c = NONE;
+    };
+
+    // Evaluate the collapse of an edge, reusing its candidate so that the heap entry is updated in place
+    auto update = [&](uint32_t h) {
+        // The removed vertex must be interior; a boundary survivor keeps its position
+        uint32_t g = mesh.boundary_vertex(mesh.from(h)) ? mesh.twin(h) : h;
+        if (g == NONE || mesh.boundary_vertex(mesh.from(g))) {
+            remove(h);
+            return;
+        }
+        uint32_t a = mesh.from(g), b = mesh.to(g);
+        Quadric q = quadrics[a] + quadrics[b];
+        double error;
+        Vec3 point;
+        if (mesh.boundary_vertex(b)) {
+            point = mesh.points[b];
+            error = quadric_error(q, point);
+        } else {
+            point = quadric_minimizer(q, {mesh.points[a], mesh.points[b], Vec3(0.5 * (mesh.points[a] + mesh.points[b]))}, error);
+        }
+        uint32_t& c = edge_candidate[key(h)];
+        if (c == NONE)
+            c = candidates.acquire();
+        candidates[c] = Candidate{g, point};
+        heap.push(c, error);
+    };
+
+    for (uint32_t h = 0; h < mesh.halfedge_capacity(); ++h)
+        if (mesh.twin(h) != NONE && h < mesh.twin(h))
+            update(h);
+
+    size_t faces = mesh.face_capacity();
+    while (faces > options.target_faces && !heap.empty()) {
+        auto [c, error] = heap.top();
+        if (error > options.max_error)
+            break;
+        Candidate candidate = candidates[c];
+        uint32_t h = candidate.halfedge;
+        remove(h);
+        if (!mesh.can_collapse(h) || !mesh.collapse_keeps_orientation(h, candidate.point))
+            continue;
+
+        // Edges at the removed vertex disappear or merge with edges at the kept one, whose keys change
+        uint32_t a = mesh.from(h), b = mesh.to(h);
+        mesh.for_each_edge(a, remove);
+        remove(HalfEdgeMesh::next(h));
+        remove(HalfEdgeMesh::prev(mesh.twin(h)));
+        mesh.collapse(h);
+        mesh.points[b] = candidate.point;
+        quadrics[b] += quadrics[a];
+        faces -= 2;
+        mesh.for_each_edge(b, update);
+    }
+    return mesh;
+}
+
+/**
+ * Vertex clustering simplification on a uniform grid (Lindstrom 2000)
+ * Vertices falling into the same cell are merged into the point minimizing the sum of their
+ * quadrics; faces whose corners fall into fewer than three cells are dropped, as are duplicates.
+ * Every step except the final deduplication runs in parallel, which suits very large meshes;
+ * the result is not guaranteed to be manifold.
+ * @param mesh Triangle mesh
+ * @param cell_size Edge length of the grid cells
+ * @param vertices Output row-major (V',3) cell representatives
+ * @param faces Output row-major (F',3) faces
+ */
+inline void cluster_decimate(const MeshView& mesh, double cell_size, ArrayBuffer<double>& vertices, ArrayBuffer<int32_t>& faces) {
+    if (!(cell_size > 0.0))
+        throw std::invalid_argument("The cell size must be positive.");
+    mesh.validate();
+    const size_t V = mesh.vertex_count, F = mesh.face_count;
+    vertices.clear();
+    faces.clear();
+    if (F == 0)
+        return;
+    Box3 bounds = mesh.bounds();
+
+    // Cell key per vertex, 21 bits per axis
+    Scratch scratch;
+    std::span<uint64_t> keys = scratch.array(V, std::numeric_limits<uint64_t>::max());
+    std::span<uint8_t> used = scratch.array<uint8_t>(V, 0);
+    for (size_t i = 0; i < 3 * F; ++i)
+        used[mesh.faces[i]] = 1;
+    parallel_for(V, 4096, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            if (!used[v])
+                continue;
+            Vec3 cell = ((mesh.vertex(v) - bounds.min()) / cell_size).array().floor();
+            uint64_t key = 0;
+            for (int k = 0; k < 3; ++k)
+                key |= std::min<uint64_t>(static_cast<uint64_t>(cell[k]), (1u << 21) - 1) << (21 * k);
+            keys[v] = key;
+        }
+    });
+
+    // Number the occupied cells and list their vertices
+    std::span<uint32_t> order = scratch.array<uint32_t>(V);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+    std::span<uint32_t> cell_of = scratch.array(V, HalfEdgeMesh::NONE), offsets = scratch.array<uint32_t>(V + 1);
+    size_t cells = 0;
+    for (size_t k = 0; k < V && used[order[k]]; ++k) {
+        if (k == 0 || keys[order[k]] != keys[order[k - 1]])
+            offsets[cells++] = static_cast<uint32_t>(k);
+        cell_of[order[k]] = static_cast<uint32_t>(cells - 1);
+    }
+    offsets[cells] = static_cast<uint32_t>(std::count(used.begin(), used.end(), 1));
+
+    std::span<Quadric> quadrics = scratch.array<Quadric>(V, Quadric::Zero());
+    std::span<uint32_t> corner_offsets = scratch.array<uint32_t>(V + 1, 0), corner_faces = scratch.array<uint32_t>(3 * F);
+    for (size_t i = 0; i < 3 * F; ++i)
+        ++corner_offsets[mesh.faces[i] + 1];
+    std::partial_sum(corner_offsets.begin(), corner_offsets.end(), corner_offsets.begin());
+    {
+        std::span<uint32_t> cursor = scratch.array<uint32_t>(V);
+        std::copy(corner_offsets.begin(), corner_offsets.end() - 1, cursor.begin());
+        for (size_t i = 0; i < 3 * F; ++i)
+            corner_faces[cursor[mesh.faces[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+    parallel_for(V, 1024, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v)
+            for (uint32_t k = corner_offsets[v]; k < corner_offsets[v + 1]; ++k) {
+                uint32_t f = corner_faces[k];
+                quadrics[v] += face_quadric(mesh.corner(f, 0), mesh.corner(f, 1), mesh.corner(f, 2));
+            }
+    });
+
+    vertices.resize(3 * cells);
+    parallel_for(cells, 256, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            Quadric q = Quadric::Zero();
+            Vec3 mean = Vec3::Zero();
+            for (uint32_t k = offsets[c]; k < offsets[c + 1]; ++k) {
+                q += quadrics[order[k]];
+                mean += mesh.vertex(order[k]);
+            }
+            mean /= double(offsets[c + 1] - offsets[c]);
+            // Keep the representative inside its cell, the minimizer of a flat cluster may lie far away
+            double error;
+            Vec3 point = quadric_minimizer(q, {mean}, error);
+            Box3 cell(mesh.vertex(order[offsets[c]]));
+            for (uint32_t k = offsets[c]; k < offsets[c + 1]; ++k)
+                cell.extend(mesh.vertex(order[k]));
+            if (!cell.contains(point))
+                point = mean;
+            std::copy(point.data(), point.data() + 3, vertices.data() + 3 * c);
+        }
+    });
+
+    std::span<std::array<int32_t, 3>> triangles = scratch.array<std::array<int32_t, 3>>(F);
+    parallel_for(F, 4096, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; ++f) {
+            std::array<int32_t, 3> t;
+            for (int k = 0; k < 3; ++k)
+                t[k] = static_cast<int32_t>(cell_of[mesh.faces[3 * f + k]]);
+            if (t[0] == t[1] || t[1] == t[2] || t[2] == t[0]) {
+                triangles[f] = {-1, -1, -1};
+                continue;
+            }
+            // Rotate the smallest index first so duplicates with the same orientation compare equal
+            std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+            triangles[f] = t;
+        }
+    });
+    std::sort(triangles.begin(), triangles.end());
+    triangles = triangles.first(std::unique(triangles.begin(), triangles.end()) - triangles.begin());
+
+    // Drop cells left without faces
+    std::span<int32_t> index = scratch.array<int32_t>(cells, -1);
+    for (const auto& t : triangles)
+        if (t[0] >= 0)
+            for (int32_t c : t)
+                index[c] = 0;
+    int32_t count = 0;
+    for (size_t c = 0; c < cells; ++c) {
+        if (index[c] < 0)
+            continue;
+        index[c] = count;
+        std::copy(vertices.begin() + 3 * c, vertices.begin() + 3 * c + 3, vertices.begin() + 3 * size_t(count++));
+    }
+    vertices.resize(3 * size_t(count));
+    for (const auto& t : triangles)
+        if (t[0] >= 0)
+            for (int32_t c : t)
+                faces.push_back(index[c]);
+}
+
+} // namespace compas
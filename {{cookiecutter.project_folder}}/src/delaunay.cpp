@@ -0,0 +1,39 @@
+#include "compas.h"
+#include "arrays.h"
+#include "delaunay.h"
+
+using namespace compas;
+
+/**
+ * Delaunay triangulation of D-dimensional points
+ * @param points (N,D) point coordinates
+ * @return (T,D+1) int32 array of point indices per simplex, positively oriented
+ */
+template <int D>
+nb::ndarray<nb::numpy, int32_t> triangulate(const RowsIn<D>& points) {
+    size_t n = points.shape(0);
+    if (n > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+        throw std::invalid_argument("Too many points for int32 simplex indices.");
+
+    ArrayBuffer<int32_t> simplices;
+    {
+        nb::gil_scoped_release release;
+        simplices = delaunay<D>(points.data(), n);
+    }
+    size_t count = simplices.size() / (D + 1);
+    return to_ndarray(std::move(simplices), {count, D + 1});
+}
+
+NB_MODULE(_delaunay, m) {
+    m.doc() = "Delaunay triangulation.";
+    share_memory_ledger();
+    share_predicate_counts();
+
+    m.def("delaunay_2d", &triangulate<2>, "points"_a,
+          "Delaunay triangulation of (N,2) points, returns (T,3) counterclockwise triangles");
+
+    m.def("delaunay_3d", &triangulate<3>, "points"_a,
+          "Delaunay tetrahedralization of (N,3) points, returns (T,4) positively oriented tetrahedra");
+
+    def_arena_stats(m);
+}
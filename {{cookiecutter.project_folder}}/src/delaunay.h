@@ -0,0 +1,498 @@
+// delaunay.h - Incremental 2D/3D Delaunay triangulation (Bowyer-Watson)
+//
+// The convex hull is closed with "ghost" simplices that share a vertex at infinity, so no
+// bounding super-simplex is needed and the result covers exactly the convex hull of the input.
+// All decisions go through the exact predicates of predicates.h.
+#pragma once
+
+#include "arena.h"
+#include "memory.h"
+#include "pool.h"
+#include "predicates.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace compas {
+
+constexpr int32_t INFINITE_VERTEX = -1;
+constexpr uint32_t NO_SIMPLEX = std::numeric_limits<uint32_t>::max();
+
+/**
+ * Triangle (D = 2) or tetrahedron (D = 3) with positive orientation
+ * Neighbor n[k] is across the facet opposite vertex v[k]. Ghost simplices store the vertex at
+ * infinity in the last slot.
+ */
+template <int D>
+struct Simplex {
+    std::array<int32_t, D + 1> v;
+    std::array<uint32_t, D + 1> n;
+    uint32_t mark = 0;
+
+    Simplex() {
+        v.fill(INFINITE_VERTEX);
+        n.fill(NO_SIMPLEX);
+    }
+
+    bool ghost() const { return v[D] == INFINITE_VERTEX; }
+};
+
+/**
+ * Spread the low 64/D bits of x so that consecutive bits end up D positions apart
+ */
+template <int D>
+uint64_t spread_bits(uint64_t x) {
+    if constexpr (D == 2) {
+        x &= 0xFFFFFFFFull;
+        x = (x | x << 16) & 0x0000FFFF0000FFFFull;
+        x = (x | x << 8) & 0x00FF00FF00FF00FFull;
+        x = (x | x << 4) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | x << 2) & 0x3333333333333333ull;
+        x = (x | x << 1) & 0x5555555555555555ull;
+    } else {
+        x &= 0x1FFFFFull;
+        x = (x | x << 32) & 0x1F00000000FFFFull;
+        x = (x | x << 16) & 0x1F0000FF0000FFull;
+        x = (x | x << 8) & 0x100F00F00F00F00Full;
+        x = (x | x << 4) & 0x10C30C30C30C30C3ull;
+        x = (x | x << 2) & 0x1249249249249249ull;
+    }
+    return x;
+}
+
+/**
+ * Morton code of a point quantized on a 2^(64/D) grid over the given bounds
+ */
+template <int D>
+uint64_t morton_code(const double* p, const double* lo, const double* scale) {
+    constexpr int bits = 64 / D;
+    uint64_t code = 0;
+    for (int k = 0; k < D; ++k) {
+        double t = std::clamp((p[k] - lo[k]) * scale[k], 0.0, 1.0);
+        uint64_t q = static_cast<uint64_t>(t * static_cast<double>((uint64_t(1) << bits) - 1));
+        code |= spread_bits<D>(q) << k;
+    }
+    return code;
+}
+
+/**
+ * Biased randomized insertion order (BRIO)
+ * Points are shuffled and split into rounds of doubling size; each round is sorted along a
+ * Morton curve so consecutive insertions are spatially close.
+ * @param points Row-major (N,D) coordinates
+ * @param count Number of points
+ * @param order Output (N,) insertion order
+ * @param seed Seed of the shuffle
+ */
+template <int D>
+void brio_order(const double* points, size_t count, std::span<uint32_t> order, uint64_t seed = 0) {
+    std::iota(order.begin(), order.end(), 0u);
+    if (count == 0)
+        return;
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(seed));
+
+    double lo[D], hi[D], scale[D];
+    std::fill(lo, lo + D, std::numeric_limits<double>::infinity());
+    std::fill(hi, hi + D, -std::numeric_limits<double>::infinity());
+    for (size_t i = 0; i < count; ++i)
+        for (int k = 0; k < D; ++k) {
+            lo[k] = std::min(lo[k], points[D * i + k]);
+            hi[k] = std::max(hi[k], points[D * i + k]);
+        }
+    for (int k = 0; k < D; ++k)
+        scale[k] = hi[k] > lo[k] ? 1.0 / (hi[k] - lo[k]) : 0.0;
+
+    Scratch scratch;
+    std::span<std::pair<uint64_t, uint32_t>> keys = scratch.array<std::pair<uint64_t, uint32_t>>(count);
+    for (size_t i = 0; i < count; ++i)
+        keys[i] = {morton_code<D>(points + D * size_t(order[i]), lo, scale), order[i]};
+
+    // Round boundaries: ..., n/4, n/2, n, with the first round holding at least 128 points
+    std::vector<size_t> ends;
+    for (size_t end = count; end > 128; end /= 2)
+        ends.push_back(end);
+    ends.push_back(std::min<size_t>(count, 128));
+    std::reverse(ends.begin(), ends.end());
+
+    size_t begin = 0;
+    for (size_t end : ends) {
+        std::sort(keys.begin() + begin, keys.begin() + end);
+        begin = end;
+    }
+    for (size_t i = 0; i < count; ++i)
+        order[i] = keys[i].second;
+}
+
+/**
+ * Delaunay triangulation of a point set in D = 2 or 3 dimensions
+ */
+template <int D>
+class DelaunayTriangulation {
+public:
+    /**
+     * Triangulate the points
+     * The points are copied in insertion order, so vertices inserted one after the other are
+     * also neighbours in memory; simplices() maps them back to the input indices.
+     * @param points Row-major (N,D) coordinates
+     * @param count Number of points
+     */
+    DelaunayTriangulation(const double* points, size_t count) : order_(count), points_(D * count) {
+        brio_order<D>(points, count, order_);
+        for (size_t i = 0; i < count; ++i)
+            std::copy_n(points + D * size_t(order_[i]), D, points_.begin() + D * i);
+        pool_.reserve((D == 2 ? 2 : 7) * count + 16);
+
+        Scratch scratch;
+        std::span<uint8_t> used = scratch.array<uint8_t>(count, 0);
+        if (!initialize(used))
+            return;
+        for (size_t i = 0; i < count; ++i)
+            if (!used[i])
+                insert(static_cast<int32_t>(i));
+    }
+
+    /**
+     * @return Finite simplices as a flat array of D + 1 point indices each
+     */
+    ArrayBuffer<int32_t> simplices() const {
+        ArrayBuffer<int32_t> out;
+        out.reserve((D + 1) * pool_.size());
+        for (uint32_t s = 0; s < pool_.capacity(); ++s)
+            if (pool_.live(s) && !pool_[s].ghost())
+                for (int32_t v : pool_[s].v)
+                    out.push_back(static_cast<int32_t>(order_[v]));
+        return out;
+    }
+
+    /**
+     * @return Number of input points that coincide with an earlier point and were skipped
+     */
+    size_t duplicates() const { return duplicates_; }
+
+private:
+    using Vertices = std::array<int32_t, D + 1>;
+    using Neighbors = std::array<uint32_t, D + 1>;
+
+    ArrayBuffer<uint32_t> order_;  // input index of each inserted point
+    ArrayBuffer<double> points_;   // coordinates in insertion order
+    Pool<Simplex<D>> pool_;
+    uint32_t last_ = NO_SIMPLEX;
+    uint32_t stamp_ = 0;
+    uint64_t walk_state_ = 0x9E3779B97F4A7C15ull;
+    uint32_t glued_ = 0;
+    size_t duplicates_ = 0;
+    ArrayBuffer<uint32_t> cavity_;
+    ArrayBuffer<uint32_t> created_;
+
+    struct OpenFacet {
+        std::array<int32_t, D> key;
+        uint32_t simplex = NO_SIMPLEX;
+        int slot = 0;
+        uint32_t stamp = 0;  // entries from an earlier glue() count as empty
+    };
+    ArrayBuffer<OpenFacet> facets_;
+
+    const double* point(int32_t i) const { return points_.data() + size_t(D) * size_t(i); }
+
+    double orientation(const Vertices& v) const {
+        if constexpr (D == 2)
+            return orient2d(point(v[0]), point(v[1]), point(v[2]));
+        else
+            return orient3d(point(v[0]), point(v[1]), point(v[2]), point(v[3]));
+    }
+
+    double sphere(const Vertices& v, int32_t p) const {
+        if constexpr (D == 2)
+            return incircle(point(v[0]), point(v[1]), point(v[2]), point(p));
+        else
+            return insphere(point(v[0]), point(v[1]), point(v[2]), point(v[3]), point(p));
+    }
+
+    bool same_point(int32_t a, int32_t b) const {
+        return std::equal(point(a), point(a) + D, point(b));
+    }
+
+    /**
+     * Move the vertex at infinity to the last slot with an even permutation
+     */
+    static void normalize(Vertices& v, Neighbors& n) {
+        int k = static_cast<int>(std::find(v.begin(), v.end(), INFINITE_VERTEX) - v.begin());
+        if (k >= D)
+            return;
+        if constexpr (D == 2) {
+            // Cyclic rotation
+            while (v[2] != INFINITE_VERTEX) {
+                std::rotate(v.begin(), v.begin() + 1, v.end());
+                std::rotate(n.begin(), n.begin() + 1, n.end());
+            }
+        } else {
+            // Two transpositions
+            std::swap(v[k], v[3]);
+            std::swap(n[k], n[3]);
+            int a = k == 0 ? 1 : 0;
+            int b = k == 2 ? 1 : 2;
+            std::swap(v[a], v[b]);
+            std::swap(n[a], n[b]);
+        }
+    }
+
+    uint32_t create(Vertices v, Neighbors n) {
+        normalize(v, n);
+        uint32_t s = pool_.acquire();
+        pool_[s].v = v;
+        pool_[s].n = n;
+        created_.push_back(s);
+        return s;
+    }
+
+    /**
+     * Connect the facets of newly created simplices that have no neighbor yet
+     * Open facets are matched through a small open-addressing table keyed by their sorted vertices.
+     * The table is kept between calls and its entries are stamped, so it is only cleared when it grows.
+     */
+    void glue() {
+        size_t size = std::max<size_t>(facets_.size(), 16);
+        while (size < 4 * (D + 1) * created_.size())
+            size *= 2;
+        if (size != facets_.size() || ++glued_ == 0) {
+            facets_.assign(size, OpenFacet());
+            glued_ = 1;
+        }
+
+        for (uint32_t s : created_) {
+            for (int k = 0; k <= D; ++k) {
+                if (pool_[s].n[k] != NO_SIMPLEX)
+                    continue;
+                std::array<int32_t, D> key;
+                for (int j = 0, m = 0; j <= D; ++j)
+                    if (j != k)
+                        key[m++] = pool_[s].v[j];
+                std::sort(key.begin(), key.end());
+
+                uint64_t h = 0;
+                for (int32_t x : key)
+                    h = (h ^ static_cast<uint32_t>(x)) * 0x100000001B3ull;
+                for (size_t i = (h ^ (h >> 29)) & (size - 1);; i = (i + 1) & (size - 1)) {
+                    OpenFacet& f = facets_[i];
+                    if (f.stamp != glued_) {
+                        f = {key, s, k, glued_};
+                        break;
+                    }
+                    if (f.key == key) {
+                        pool_[s].n[k] = f.simplex;
+                        pool_[f.simplex].n[f.slot] = s;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Build the first simplex from the first affinely independent points and close it with ghosts
+     * @return False if all points are affinely dependent
+     */
+    bool initialize(std::span<uint8_t> used) {
+        Vertices v;
+        int found = 0;
+        for (size_t i = 0; i < used.size(); ++i) {
+            int32_t p = static_cast<int32_t>(i);
+            if (found == 0) {
+                v[found++] = p;
+            } else if (found == 1) {
+                if (!same_point(v[0], p))
+                    v[found++] = p;
+            } else if (found == 2) {
+                if (!collinear(point(v[0]), point(v[1]), point(p)))
+                    v[found++] = p;
+            } else if constexpr (D == 3) {
+                if (orient3d(point(v[0]), point(v[1]), point(v[2]), point(p)) != 0)
+                    v[found++] = p;
+            }
+            if (found == D + 1)
+                break;
+        }
+        if (found < D + 1)
+            return false;
+
+        if (orientation(v) < 0)
+            std::swap(v[0], v[1]);
+        for (int32_t p : v)
+            used[p] = 1;
+
+        Neighbors none;
+        none.fill(NO_SIMPLEX);
+        created_.clear();
+        uint32_t root = create(v, none);
+        for (int k = 0; k <= D; ++k) {
+            // Replacing a vertex by infinity flips the side, an odd permutation restores orientation
+            Vertices g = v;
+            g[k] = INFINITE_VERTEX;
+            std::swap(g[(k + 1) % (D + 1)], g[(k + 2) % (D + 1)]);
+            Neighbors n = none;
+            n[k] = root;
+            uint32_t ghost = create(g, n);
+            pool_[root].n[k] = ghost;
+        }
+        glue();
+        last_ = root;
+        return true;
+    }
+
+    static bool collinear(const double* a, const double* b, const double* c) {
+        if constexpr (D == 2) {
+            return orient2d(a, b, c) == 0;
+        } else {
+            // Collinear in 3D iff collinear in all three coordinate projections
+            for (int k = 0; k < 3; ++k) {
+                double pa[2] = {a[k], a[(k + 1) % 3]};
+                double pb[2] = {b[k], b[(k + 1) % 3]};
+                double pc[2] = {c[k], c[(k + 1) % 3]};
+                if (orient2d(pa, pb, pc) != 0)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    /**
+     * Whether point p lies strictly inside the circumsphere of simplex s
+     * For ghosts, the circumsphere degenerates to the open half-space beyond the hull facet,
+     * plus the circumcircle of the facet itself.
+     */
+    bool conflict(uint32_t s, int32_t p) const {
+        const Simplex<D>& simplex = pool_[s];
+        if (!simplex.ghost())
+            return sphere(simplex.v, p) > 0;
+
+        Vertices w = simplex.v;
+        w[D] = p;
+        double o = orientation(w);
+        if (o != 0)
+            return o > 0;
+
+        if constexpr (D == 2) {
+            const double* a = point(w[0]);
+            const double* b = point(w[1]);
+            const double* q = point(p);
+            int k = a[0] != b[0] ? 0 : 1;
+            return std::min(a[k], b[k]) < q[k] && q[k] < std::max(a[k], b[k]);
+        } else {
+            // p is in the hull facet's plane: inside its circumcircle iff inside the circumsphere
+            // of the finite tetrahedron on the other side of the facet
+            const Simplex<D>& inner = pool_[simplex.n[D]];
+            int32_t q = INFINITE_VERTEX;
+            for (int k = 0; k <= D; ++k)
+                if (inner.n[k] == s)
+                    q = inner.v[k];
+            return insphere(point(w[1]), point(w[0]), point(w[2]), point(q), point(p)) > 0;
+        }
+    }
+
+    /**
+     * Visibility walk towards p
+     * @return Finite simplex containing p, or a ghost simplex whose hull facet sees p
+     */
+    uint32_t locate(int32_t p) {
+        uint32_t s = last_;
+        if (pool_[s].ghost())
+            s = pool_[s].n[D];
+        for (;;) {
+            const Simplex<D>& simplex = pool_[s];
+            if (simplex.ghost())
+                return s;
+            walk_state_ ^= walk_state_ << 13;
+            walk_state_ ^= walk_state_ >> 7;
+            walk_state_ ^= walk_state_ << 17;
+            int start = static_cast<int>(walk_state_ % (D + 1));
+            bool moved = false;
+            for (int i = 0; i <= D && !moved; ++i) {
+                int k = (start + i) % (D + 1);
+                Vertices w = simplex.v;
+                w[k] = p;
+                if (orientation(w) < 0) {
+                    s = simplex.n[k];
+                    moved = true;
+                }
+            }
+            if (!moved)
+                return s;
+        }
+    }
+
+    void insert(int32_t p) {
+        uint32_t start = locate(p);
+        if (!pool_[start].ghost()) {
+            for (int32_t q : pool_[start].v) {
+                if (same_point(p, q)) {
+                    ++duplicates_;
+                    return;
+                }
+            }
+        }
+
+        // Grow the cavity of all simplices whose circumsphere contains p
+        stamp_ += 2;
+        const uint32_t inside = stamp_, outside = stamp_ + 1;
+        cavity_.clear();
+        cavity_.push_back(start);
+        pool_[start].mark = inside;
+        for (size_t i = 0; i < cavity_.size(); ++i) {
+            for (uint32_t nb : pool_[cavity_[i]].n) {
+                uint32_t mark = pool_[nb].mark;
+                if (mark == inside || mark == outside)
+                    continue;
+                if (conflict(nb, p)) {
+                    pool_[nb].mark = inside;
+                    cavity_.push_back(nb);
+                } else {
+                    pool_[nb].mark = outside;
+                }
+            }
+        }
+
+        // Connect p to every boundary facet of the cavity
+        created_.clear();
+        for (uint32_t c : cavity_) {
+            for (int k = 0; k <= D; ++k) {
+                uint32_t nb = pool_[c].n[k];
+                if (pool_[nb].mark == inside)
+                    continue;
+                Vertices v = pool_[c].v;
+                v[k] = p;
+                Neighbors n;
+                n.fill(NO_SIMPLEX);
+                n[k] = nb;
+                uint32_t s = create(v, n);
+                Simplex<D>& outer = pool_[nb];
+                for (int j = 0; j <= D; ++j)
+                    if (outer.n[j] == c)
+                        outer.n[j] = s;
+            }
+        }
+        glue();
+
+        for (uint32_t c : cavity_)
+            pool_.release(c);
+        last_ = created_.back();
+    }
+};
+
+/**
+ * Delaunay triangulation of a point set
+ * @param points Row-major (N,D) coordinates
+ * @param count Number of points
+ * @return Flat array of D + 1 point indices per simplex
+ */
+template <int D>
+ArrayBuffer<int32_t> delaunay(const double* points, size_t count) {
+    return DelaunayTriangulation<D>(points, count).simplices();
+}
+
+} // namespace compas
@@ -0,0 +1,92 @@
+#include "compas.h"
+#include "arrays.h"
+#include "fdm.h"
+
+#include <nanobind/stl/optional.h>
+#include <mutex>
+#include <optional>
+
+using namespace compas;
+
+using EdgesIn = nb::ndarray<const int32_t, nb::shape<-1, 2>, nb::c_contig, nb::device::cpu>;
+using MaskIn = nb::ndarray<const uint8_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+using MatrixIn = nb::ndarray<const double, nb::ndim<2>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Force density network with the solver kept for repeated single solves
+ * Solves run without the GIL, so the kept solver is guarded by a mutex; a call that finds it in
+ * use by another Python thread solves with a solver of its own rather than waiting.
+ */
+struct ForceDensityNetwork {
+    ForceDensity network;
+    std::unique_ptr<ForceDensity::Solver> solver;
+    std::mutex mutex;
+
+    ForceDensityNetwork(const EdgesIn& edges, const MaskIn& fixed)
+        : network(edges.data(), edges.shape(0), fixed.data(), fixed.shape(0)), solver(network.solver()) {}
+
+    void check(const PointsIn& vertices, const std::optional<PointsIn>& loads) const {
+        if (vertices.shape(0) != network.vertex_count() || (loads && loads->shape(0) != network.vertex_count()))
+            throw std::invalid_argument("vertices and loads must have one row per vertex of the network.");
+    }
+};
+
+/**
+ * Solve for the equilibrium of one set of force densities
+ * @param q (E,) force densities
+ * @param vertices (V,3) coordinates, the fixed vertices are kept
+ * @param loads (V,3) loads, or None
+ * @return Tuple of coordinates (V,3), edge lengths (E,) and axial forces (E,)
+ */
+nb::tuple solve(ForceDensityNetwork& self, const ValuesIn& q, const PointsIn& vertices, std::optional<PointsIn> loads) {
+    size_t V = self.network.vertex_count(), E = self.network.edge_count();
+    self.check(vertices, loads);
+    if (q.shape(0) != E)
+        throw std::invalid_argument("q must have one force density per edge.");
+    ArrayBuffer<double> xyz(vertices.data(), vertices.data() + 3 * V), lengths(E), forces(E);
+    {
+        nb::gil_scoped_release release;
+        std::unique_lock<std::mutex> lock(self.mutex, std::try_to_lock);
+        std::unique_ptr<ForceDensity::Solver> own = lock.owns_lock() ? nullptr : self.network.solver();
+        self.network.solve(own ? *own : *self.solver, q.data(), xyz.data(), loads ? loads->data() : nullptr);
+        self.network.forces(q.data(), xyz.data(), lengths.data(), forces.data());
+    }
+    return nb::make_tuple(to_ndarray(std::move(xyz), {V, 3}), to_ndarray(std::move(lengths), {E}), to_ndarray(std::move(forces), {E}));
+}
+
+/**
+ * Solve for the equilibria of many sets of force densities in parallel
+ * @param q (B,E) force densities
+ * @param vertices (V,3) coordinates, the fixed vertices are kept
+ * @param loads (V,3) loads, or None
+ * @return Tuple of coordinates (B,V,3) and axial forces (B,E)
+ */
+nb::tuple solve_many(const ForceDensityNetwork& self, const MatrixIn& q, const PointsIn& vertices, std::optional<PointsIn> loads) {
+    size_t V = self.network.vertex_count(), E = self.network.edge_count(), B = q.shape(0);
+    self.check(vertices, loads);
+    if (q.shape(1) != E)
+        throw std::invalid_argument("q must have one column per edge.");
+    ArrayBuffer<double> xyz(B * V * 3), forces(B * E);
+    {
+        nb::gil_scoped_release release;
+        self.network.solve_many(q.data(), B, vertices.data(), loads ? loads->data() : nullptr, xyz.data(), forces.data());
+    }
+    return nb::make_tuple(to_ndarray(std::move(xyz), {B, V, 3}), to_ndarray(std::move(forces), {B, E}));
+}
+
+NB_MODULE(_fdm, m) {
+    m.doc() = "Force density method with a cached sparse factorization.";
+    share_memory_ledger();
+
+    nb::class_<ForceDensityNetwork>(m, "ForceDensity")
+        .def("__init__", [](ForceDensityNetwork* self, const EdgesIn& edges, const MaskIn& fixed) { new (self) ForceDensityNetwork(edges, fixed); },
+             "edges"_a, "fixed"_a, "Build the connectivity and analyse the sparsity pattern of a network")
+        .def_prop_ro("vertex_count", [](const ForceDensityNetwork& self) { return self.network.vertex_count(); })
+        .def_prop_ro("edge_count", [](const ForceDensityNetwork& self) { return self.network.edge_count(); })
+        .def_prop_ro("free_count", [](const ForceDensityNetwork& self) { return self.network.free_count(); })
+        .def("solve", &solve, "q"_a, "vertices"_a, "loads"_a.none() = nb::none(), "Solve for the equilibrium of one set of force densities")
+        .def("solve_many", &solve_many, "q"_a, "vertices"_a, "loads"_a.none() = nb::none(),
+             "Solve for the equilibria of many sets of force densities in parallel");
+
+    def_arena_stats(m);
+}
@@ -0,0 +1,197 @@
+// fdm.h - Force density method with a cached sparse factorization
+#pragma once
+
+#include "arena.h"
+#include "csr.h"
+#include "mesh.h"
+#include "parallel.h"
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace compas {
+
+using SparseMatrix = Eigen::SparseMatrix<double>;
+
+/**
+ * Force density network (Schek 1974)
+ * The equilibrium of the free vertices is (Ci^T Q Ci) x = p - Ci^T Q Cf xf, where C is the
+ * edge-vertex connectivity matrix split into free and fixed columns. The sparsity pattern of
+ * Ci^T Q Ci depends only on the connectivity, so it is built and symbolically analysed once;
+ * a new set of force densities only refills the values and repeats the numeric factorization.
+ */
+class ForceDensity {
+public:
+    /**
+     * @param edges Row-major (E,2) vertex indices
+     * @param edge_count Number of edges E
+     * @param fixed (V,) non-zero for supports
+     * @param vertex_count Number of vertices V
+     */
+    ForceDensity(const int32_t* edges, size_t edge_count, const uint8_t* fixed, size_t vertex_count)
+        : edges_(edges, edges + 2 * edge_count), free_index_(vertex_count, -1) {
+        check_edges(edges, edge_count, vertex_count);
+        for (size_t v = 0; v < vertex_count; ++v)
+            if (!fixed[v])
+                free_index_[v] = free_count_++;
+
+        // Pattern of the free-free block, then the value slot each edge contributes to
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(4 * edge_count);
+        for (size_t e = 0; e < edge_count; ++e) {
+            int32_t i = free_index_[edges[2 * e]], j = free_index_[edges[2 * e + 1]];
+            if (i >= 0)
+                triplets.emplace_back(i, i, 1.0);
+            if (j >= 0)
+                triplets.emplace_back(j, j, 1.0);
+            if (i >= 0 && j >= 0) {
+                triplets.emplace_back(i, j, 1.0);
+                triplets.emplace_back(j, i, 1.0);
+            }
+        }
+        pattern_.resize(free_count_, free_count_);
+        pattern_.setFromTriplets(triplets.begin(), triplets.end());
+        pattern_.makeCompressed();
+
+        slots_.assign(4 * edge_count, -1);
+        for (size_t e = 0; e < edge_count; ++e) {
+            int32_t i = free_index_[edges[2 * e]], j = free_index_[edges[2 * e + 1]];
+            if (i >= 0)
+                slots_[4 * e] = slot(i, i);
+            if (j >= 0)
+                slots_[4 * e + 1] = slot(j, j);
+            if (i >= 0 && j >= 0) {
+                slots_[4 * e + 2] = slot(i, j);
+                slots_[4 * e + 3] = slot(j, i);
+            }
+        }
+    }
+
+    size_t edge_count() const { return edges_.size() / 2; }
+    size_t vertex_count() const { return free_index_.size(); }
+    size_t free_count() const { return static_cast<size_t>(free_count_); }
+
+    /**
+     * Solver with the symbolic factorization of the pattern, one per thread
+     */
+    struct Solver {
+        SparseMatrix matrix;
+        Eigen::SimplicialLDLT<SparseMatrix> ldlt;
+    };
+
+    std::unique_ptr<Solver> solver() const {
+        auto s = std::make_unique<Solver>();
+        s->matrix = pattern_;
+        s->ldlt.analyzePattern(s->matrix);
+        return s;
+    }
+
+    /**
+     * Equilibrium coordinates for one set of force densities
+     * @param solver Solver from solver(), reused across calls
+     * @param q (E,) force densities
+     * @param xyz Row-major (V,3) coordinates; fixed vertices are read, free vertices are written
+     * @param loads Row-major (V,3) loads, or null
+     * @throws std::invalid_argument if the system is singular, e.g. a free part is not connected to a support
+     */
+    void solve(Solver& solver, const double* q, double* xyz, const double* loads) const {
+        size_t E = edge_count();
+        double* values = solver.matrix.valuePtr();
+        std::fill(values, values + solver.matrix.nonZeros(), 0.0);
+        Scratch scratch;
+        Eigen::Map<Eigen::MatrixX3d> rhs(scratch.array(3 * size_t(free_count_), 0.0).data(), free_count_, 3);
+        Eigen::Map<Eigen::MatrixX3d> x(scratch.array<double>(3 * size_t(free_count_)).data(), free_count_, 3);
+        if (loads)
+            for (size_t v = 0; v < free_index_.size(); ++v)
+                if (free_index_[v] >= 0)
+                    rhs.row(free_index_[v]) = Eigen::Map<const Eigen::RowVector3d>(loads + 3 * v);
+
+        for (size_t e = 0; e < E; ++e) {
+            const int32_t* s = slots_.data() + 4 * e;
+            for (int k = 0; k < 2; ++k)
+                if (s[k] >= 0)
+                    values[s[k]] += q[e];
+            if (s[2] >= 0) {
+                values[s[2]] -= q[e];
+                values[s[3]] -= q[e];
+            }
+            // Coupling to fixed vertices moves to the right-hand side
+            int32_t a = edges_[2 * e], b = edges_[2 * e + 1];
+            int32_t i = free_index_[a], j = free_index_[b];
+            if (i >= 0 && j < 0)
+                rhs.row(i) += q[e] * Eigen::Map<const Eigen::RowVector3d>(xyz + 3 * size_t(b));
+            if (j >= 0 && i < 0)
+                rhs.row(j) += q[e] * Eigen::Map<const Eigen::RowVector3d>(xyz + 3 * size_t(a));
+        }
+
+        solver.ldlt.factorize(solver.matrix);
+        // Simplicial LDLT accepts zero pivots, so rank deficiency shows up in D
+        const auto& d = solver.ldlt.vectorD();
+        double scale = d.size() ? d.cwiseAbs().maxCoeff() : 0.0;
+        if (solver.ldlt.info() != Eigen::Success || (d.size() && d.cwiseAbs().minCoeff() <= 1e-12 * scale))
+            throw std::invalid_argument("The force density matrix is singular; every free vertex must connect to a support through non-zero force densities.");
+        x = solver.ldlt.solve(rhs);
+        for (size_t v = 0; v < free_index_.size(); ++v)
+            if (free_index_[v] >= 0)
+                Eigen::Map<Eigen::RowVector3d>(xyz + 3 * v) = x.row(free_index_[v]);
+    }
+
+    /**
+     * Edge lengths and axial forces q * L of a solved geometry
+     */
+    void forces(const double* q, const double* xyz, double* lengths, double* forces) const {
+        for (size_t e = 0; e < edge_count(); ++e) {
+            Eigen::Map<const Vec3> a(xyz + 3 * size_t(edges_[2 * e])), b(xyz + 3 * size_t(edges_[2 * e + 1]));
+            lengths[e] = (b - a).norm();
+            forces[e] = q[e] * lengths[e];
+        }
+    }
+
+    /**
+     * Solve many sets of force densities in parallel, one solver per worker
+     * @param q Row-major (B,E) force densities
+     * @param count Number of sets B
+     * @param xyz Row-major (V,3) initial coordinates providing the fixed vertices
+     * @param loads Row-major (V,3) loads, or null
+     * @param out Row-major (B,V,3) equilibrium coordinates
+     * @param forces Row-major (B,E) axial forces
+     */
+    void solve_many(const double* q, size_t count, const double* xyz, const double* loads, double* out, double* forces) const {
+        size_t V = vertex_count(), E = edge_count();
+        std::vector<std::unique_ptr<Solver>> solvers(thread_count());
+        parallel_for(count, 1, [&](size_t begin, size_t end, size_t worker) {
+            if (!solvers[worker])
+                solvers[worker] = solver();
+            Scratch scratch;
+            std::span<double> lengths = scratch.array<double>(E);
+            for (size_t b = begin; b < end; ++b) {
+                double* x = out + 3 * V * b;
+                std::copy(xyz, xyz + 3 * V, x);
+                solve(*solvers[worker], q + E * b, x, loads);
+                this->forces(q + E * b, x, lengths.data(), forces + E * b);
+            }
+        });
+    }
+
+private:
+    int64_t slot(int32_t row, int32_t col) const {
+        // Position of (row, col) in the compressed value array
+        const int* inner = pattern_.innerIndexPtr();
+        const int* outer = pattern_.outerIndexPtr();
+        return std::lower_bound(inner + outer[col], inner + outer[col + 1], row) - inner;
+    }
+
+    std::vector<int32_t> edges_;
+    std::vector<int32_t> free_index_;  // index among the free vertices, -1 for fixed ones
+    int32_t free_count_ = 0;
+    SparseMatrix pattern_;
+    std::vector<int32_t> slots_;  // per edge: value slots of (i,i), (j,j), (i,j), (j,i), -1 if unused
+};
+
+} // namespace compas
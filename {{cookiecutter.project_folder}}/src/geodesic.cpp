@@ -0,0 +1,59 @@
+#include "compas.h"
+#include "arrays.h"
+#include "geodesic.h"
+
+using namespace compas;
+
+using IndicesIn = nb::ndarray<const int32_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Distances to the nearest of a set of sources
+ * @param sources (K,) source vertices
+ * @return (V,) distances
+ */
+nb::ndarray<nb::numpy, double> distances(const GeodesicSolver& self, const IndicesIn& sources) {
+    ArrayBuffer<double> out(self.vertex_count());
+    {
+        nb::gil_scoped_release release;
+        self.distances(sources.data(), sources.shape(0), out.data());
+    }
+    return to_ndarray(std::move(out), {self.vertex_count()});
+}
+
+/**
+ * Distances for many source sets in parallel
+ * @param sources Source vertices of all sets
+ * @param offsets (B+1,) ranges of the sets in sources
+ * @return (B,V) distances
+ */
+nb::ndarray<nb::numpy, double> distances_many(const GeodesicSolver& self, const IndicesIn& sources, const OffsetsIn& offsets) {
+    size_t count = offsets.shape(0) > 0 ? offsets.shape(0) - 1 : 0, V = self.vertex_count();
+    check_offsets(offsets, count, sources.shape(0), "offsets");
+    ArrayBuffer<double> out(count * V);
+    {
+        nb::gil_scoped_release release;
+        self.distances_many(sources.data(), offsets.data(), count, out.data());
+    }
+    return to_ndarray(std::move(out), {count, V});
+}
+
+NB_MODULE(_geodesic, m) {
+    m.doc() = "Geodesic distances by the heat method with cached factorizations.";
+    share_memory_ledger();
+
+    nb::class_<GeodesicSolver>(m, "GeodesicSolver")
+        .def("__init__",
+             [](GeodesicSolver* self, const PointsIn& vertices, const FacesIn& faces, double time_factor) {
+                 MeshView mesh = mesh_view(vertices, faces);
+                 nb::gil_scoped_release release;
+                 new (self) GeodesicSolver(mesh, time_factor);
+             },
+             "vertices"_a, "faces"_a, "time_factor"_a = 1.0, "Factorize the heat and Poisson matrices of a mesh")
+        .def_prop_ro("vertex_count", &GeodesicSolver::vertex_count)
+        .def_prop_ro("face_count", &GeodesicSolver::face_count)
+        .def_prop_ro("time", &GeodesicSolver::time)
+        .def("distances", &distances, "sources"_a, "Distances to the nearest of a set of sources")
+        .def("distances_many", &distances_many, "sources"_a, "offsets"_a, "Distances for many source sets in parallel");
+
+    def_arena_stats(m);
+}
@@ -0,0 +1,184 @@
+// geodesic.h - Geodesic distances on triangle meshes by the heat method
+#pragma once
+
+#include "arena.h"
+#include "graph.h"
+#include "laplacian.h"
+#include "parallel.h"
+
+#include <Eigen/SparseCholesky>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Geodesic distances from arbitrary source sets (Crane, Weischedel and Wardetzky 2013)
+ * Heat diffused from the sources for a short time t gives the direction of the distance
+ * gradient, and a Poisson equation recovers the distance from those directions. Both matrices,
+ * M + t L and the cotangent Laplacian L with one vertex per connected part pinned, depend only on
+ * the mesh, so they are factorized once and a query costs two back-substitutions plus a pass
+ * over the faces. Boundaries use the Neumann condition of the plain Laplacian.
+ */
+class GeodesicSolver {
+public:
+    static constexpr double INF = std::numeric_limits<double>::infinity();
+
+    /**
+     * @param mesh Triangle mesh, not necessarily manifold
+     * @param time_factor Diffusion time as a multiple of the squared mean edge length
+     * @throws std::invalid_argument if the time factor is not positive or a factorization fails
+     */
+    explicit GeodesicSolver(const MeshView& mesh, double time_factor = 1.0)
+        : faces_(mesh.faces, mesh.faces + 3 * mesh.face_count), edges_(mesh.face_count), cotangents_(mesh.face_count),
+          component_(mesh.vertex_count), index_(mesh.vertex_count, -1) {
+        if (!(time_factor > 0.0))
+            throw std::invalid_argument("The time factor must be positive.");
+        mesh.validate();
+        size_t V = mesh.vertex_count, F = mesh.face_count;
+
+        // Per face: the edge opposite each corner and the cotangent of its angle
+        double length = 0.0;
+        ConcurrentDisjointSets sets(V);
+        for (size_t f = 0; f < F; ++f) {
+            std::array<Vec3, 3> p = {mesh.corner(f, 0), mesh.corner(f, 1), mesh.corner(f, 2)};
+            for (int k = 0; k < 3; ++k) {
+                const Vec3 &a = p[(k + 1) % 3], &b = p[(k + 2) % 3];
+                edges_[f][k] = b - a;
+                cotangents_[f][k] = cotangent(p[k], a, b);
+                length += edges_[f][k].norm();
+            }
+            sets.unite(faces_[3 * f], faces_[3 * f + 1]);
+            sets.unite(faces_[3 * f], faces_[3 * f + 2]);
+        }
+        double h = F ? length / double(3 * F) : 0.0;
+        time_ = time_factor * h * h;
+
+        SparseMatrix L = cotangent_laplacian(mesh);
+        std::vector<double> areas = vertex_areas(mesh);
+        SparseMatrix heat = time_ * L;
+        // Vertices without area only get a unit diagonal, their temperature is never read
+        for (size_t v = 0; v < V; ++v)
+            heat.coeffRef(v, v) += areas[v] > 0.0 ? areas[v] : 1.0;
+        heat_.compute(heat);
+        check(heat_, "heat");
+
+        // The root of every part, its smallest vertex, is pinned to make L definite
+        for (size_t v = 0; v < V; ++v) {
+            component_[v] = sets.find(static_cast<uint32_t>(v));
+            if (component_[v] != v)
+                index_[v] = static_cast<int32_t>(free_count_++);
+        }
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(L.nonZeros());
+        for (Eigen::Index col = 0; col < L.outerSize(); ++col)
+            for (SparseMatrix::InnerIterator it(L, col); it; ++it)
+                if (index_[it.row()] >= 0 && index_[col] >= 0)
+                    triplets.emplace_back(index_[it.row()], index_[col], it.value());
+        SparseMatrix poisson(free_count_, free_count_);
+        poisson.setFromTriplets(triplets.begin(), triplets.end());
+        poisson_.compute(poisson);
+        check(poisson_, "Laplacian");
+    }
+
+    size_t vertex_count() const { return component_.size(); }
+    size_t face_count() const { return edges_.size(); }
+    double time() const { return time_; }
+
+    /**
+     * Distances to the nearest source
+     * @param sources Source vertices
+     * @param count Number of sources
+     * @param out (V,) distances, infinite in parts of the mesh without a source
+     * @throws std::out_of_range if a source does not exist
+     */
+    void distances(const int32_t* sources, size_t count, double* out) const {
+        size_t V = vertex_count(), F = face_count();
+        Scratch scratch;
+        Eigen::Map<Eigen::VectorXd> delta(scratch.array(V, 0.0).data(), V), u(scratch.array<double>(V).data(), V);
+        for (size_t k = 0; k < count; ++k) {
+            if (sources[k] < 0 || static_cast<size_t>(sources[k]) >= V)
+                throw std::out_of_range("Source vertex " + std::to_string(sources[k]) + " does not exist.");
+            delta[sources[k]] = 1.0;
+        }
+        u = heat_.solve(delta);
+
+        // Integrated divergence of the normalized, negated heat gradient
+        std::span<double> divergence = scratch.array(V, 0.0);
+        for (size_t f = 0; f < F; ++f) {
+            const int32_t* face = faces_.data() + 3 * f;
+            const std::array<Vec3, 3>& e = edges_[f];
+            // The gradient of u is sum u_k n x e_k / |n|^2, only its direction is needed
+            Vec3 n = e[1].cross(e[2]), g = Vec3::Zero();
+            for (int k = 0; k < 3; ++k)
+                g += u[face[k]] * n.cross(e[k]);
+            double norm = g.norm();
+            if (!(norm > 0.0))
+                continue;
+            Vec3 x = -g / norm;
+            for (int k = 0; k < 3; ++k) {
+                // Edges from corner k to the next corner i and the previous corner j
+                int i = (k + 1) % 3, j = (k + 2) % 3;
+                divergence[face[k]] += 0.5 * (cotangents_[f][j] * e[j].dot(x) - cotangents_[f][i] * e[i].dot(x));
+            }
+        }
+
+        Eigen::Map<Eigen::VectorXd> rhs(scratch.array<double>(free_count_).data(), free_count_), phi(scratch.array<double>(free_count_).data(), free_count_);
+        for (size_t v = 0; v < V; ++v)
+            if (index_[v] >= 0)
+                rhs[index_[v]] = -divergence[v];
+        phi = poisson_.solve(rhs);
+
+        // Shift every part so that its nearest source is at distance zero
+        std::span<double> offset = scratch.array(V, INF);
+        for (size_t k = 0; k < count; ++k) {
+            uint32_t v = static_cast<uint32_t>(sources[k]);
+            offset[component_[v]] = std::min(offset[component_[v]], value(phi, v));
+        }
+        for (size_t v = 0; v < V; ++v) {
+            double shift = offset[component_[v]];
+            out[v] = shift == INF ? INF : std::max(value(phi, static_cast<uint32_t>(v)) - shift, 0.0);
+        }
+    }
+
+    /**
+     * Distances for many source sets in parallel
+     * @param sources Source vertices of all sets
+     * @param offsets (B+1,) ranges of the sets in sources
+     * @param count Number of sets B
+     * @param out Row-major (B,V) distances
+     */
+    void distances_many(const int32_t* sources, const int64_t* offsets, size_t count, double* out) const {
+        parallel_for(count, 1, [&](size_t begin, size_t end) {
+            for (size_t b = begin; b < end; ++b)
+                distances(sources + offsets[b], static_cast<size_t>(offsets[b + 1] - offsets[b]), out + b * vertex_count());
+        });
+    }
+
+private:
+    using Factorization = Eigen::SimplicialLDLT<SparseMatrix>;
+
+    static void check(const Factorization& factorization, const char* name) {
+        if (factorization.info() != Eigen::Success)
+            throw std::invalid_argument(std::string("Factorization of the ") + name + " matrix failed.");
+    }
+
+    double value(const Eigen::Map<Eigen::VectorXd>& phi, uint32_t v) const { return index_[v] >= 0 ? phi[index_[v]] : 0.0; }
+
+    std::vector<int32_t> faces_;
+    std::vector<std::array<Vec3, 3>> edges_;         // edge opposite each corner, in face order
+    std::vector<std::array<double, 3>> cotangents_;  // cotangent of each corner angle
+    std::vector<uint32_t> component_;                // smallest vertex of the connected part
+    std::vector<int32_t> index_;                     // row in the Poisson system, -1 if pinned
+    size_t free_count_ = 0;
+    double time_ = 0.0;
+    Factorization heat_;
+    Factorization poisson_;
+};
+
+} // namespace compas
@@ -0,0 +1,132 @@
+#include "compas.h"
+#include "arrays.h"
+#include "graph.h"
+
+#include <nanobind/stl/optional.h>
+#include <nanobind/stl/string.h>
+#include <optional>
+
+using namespace compas;
+
+using EdgesIn = nb::ndarray<const int32_t, nb::shape<-1, 2>, nb::c_contig, nb::device::cpu>;
+using IndicesIn = nb::ndarray<const int32_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Breadth-first search from one vertex
+ * @return Tuple of hop counts (V,) and BFS tree parents (V,), -1 where unreachable
+ */
+nb::tuple bfs(const Graph& self, uint32_t source) {
+    size_t V = self.vertex_count();
+    ArrayBuffer<int32_t> depth(V), parents(V);
+    {
+        nb::gil_scoped_release release;
+        self.bfs(source, depth.data(), parents.data());
+    }
+    return nb::make_tuple(to_ndarray(std::move(depth), {V}), to_ndarray(std::move(parents), {V}));
+}
+
+/**
+ * Connected components
+ * @return Tuple of component labels (V,) and the number of components
+ */
+nb::tuple components(const Graph& self) {
+    size_t V = self.vertex_count(), count;
+    ArrayBuffer<int32_t> labels(V);
+    {
+        nb::gil_scoped_release release;
+        count = self.components(labels.data());
+    }
+    return nb::make_tuple(to_ndarray(std::move(labels), {V}), count);
+}
+
+/**
+ * Shortest paths from one vertex
+ * @param method "delta" for parallel delta-stepping or "dijkstra"
+ * @param delta Bucket width for delta-stepping, 0 for the mean edge weight
+ * @return Tuple of distances (V,) and shortest path tree parents (V,)
+ */
+nb::tuple shortest_paths(const Graph& self, uint32_t source, const std::string& method, double delta) {
+    if (method != "delta" && method != "dijkstra")
+        throw std::invalid_argument("method must be 'delta' or 'dijkstra'.");
+    size_t V = self.vertex_count();
+    ArrayBuffer<double> distances(V);
+    ArrayBuffer<int32_t> parents(V);
+    {
+        nb::gil_scoped_release release;
+        if (method == "delta")
+            self.delta_stepping(source, delta, distances.data(), parents.data());
+        else
+            self.dijkstra(source, distances.data(), parents.data());
+    }
+    return nb::make_tuple(to_ndarray(std::move(distances), {V}), to_ndarray(std::move(parents), {V}));
+}
+
+/**
+ * Shortest path lengths from many vertices, one Dijkstra search per source in parallel
+ * @return (S,V) distances
+ */
+nb::ndarray<nb::numpy, double> distance_matrix(const Graph& self, const IndicesIn& sources) {
+    size_t S = sources.shape(0), V = self.vertex_count();
+    for (size_t s = 0; s < S; ++s)
+        if (sources.data()[s] < 0 || static_cast<size_t>(sources.data()[s]) >= V)
+            throw std::out_of_range("Vertex " + std::to_string(sources.data()[s]) + " does not exist.");
+    ArrayBuffer<double> distances(S * V);
+    {
+        nb::gil_scoped_release release;
+        parallel_for(S, 1, [&](size_t begin, size_t end) {
+            for (size_t s = begin; s < end; ++s)
+                self.dijkstra(static_cast<uint32_t>(sources.data()[s]), distances.data() + V * s, nullptr);
+        });
+    }
+    return to_ndarray(std::move(distances), {S, V});
+}
+
+/**
+ * Minimum spanning forest
+ * @return Tuple of edge indices (V-C,) and total weight
+ */
+nb::tuple spanning_tree(const Graph& self) {
+    ArrayBuffer<int32_t> selected;
+    double total;
+    {
+        nb::gil_scoped_release release;
+        total = self.minimum_spanning_forest(selected);
+    }
+    size_t n = selected.size();
+    return nb::make_tuple(to_ndarray(std::move(selected), {n}), total);
+}
+
+/**
+ * Adjacency in CSR form
+ * @return Tuple of offsets (V+1,), neighbours (2E,) and the edge of each neighbour (2E,)
+ */
+nb::tuple adjacency(const Graph& self) {
+    const CSR& csr = self.adjacency();
+    ArrayBuffer<int64_t> offsets(csr.offsets.begin(), csr.offsets.end());
+    ArrayBuffer<int32_t> neighbours(self.targets().begin(), self.targets().end()), edges(csr.items.begin(), csr.items.end());
+    size_t V = self.vertex_count(), K = neighbours.size();
+    return nb::make_tuple(to_ndarray(std::move(offsets), {V + 1}), to_ndarray(std::move(neighbours), {K}), to_ndarray(std::move(edges), {K}));
+}
+
+NB_MODULE(_graph, m) {
+    m.doc() = "Undirected graphs in CSR form with parallel traversal, components, shortest paths and spanning trees.";
+    share_memory_ledger();
+
+    nb::class_<Graph>(m, "Graph")
+        .def("__init__", [](Graph* self, const EdgesIn& edges, size_t vertex_count, std::optional<ValuesIn> weights) {
+            if (weights && weights->shape(0) != edges.shape(0))
+                throw std::invalid_argument("Expected one weight per edge.");
+            nb::gil_scoped_release release;
+            new (self) Graph(edges.data(), edges.shape(0), vertex_count, weights ? weights->data() : nullptr);
+        }, "edges"_a, "vertex_count"_a, "weights"_a.none() = nb::none(), "Build the adjacency of (E,2) edges with optional (E,) weights")
+        .def_prop_ro("vertex_count", &Graph::vertex_count)
+        .def_prop_ro("edge_count", &Graph::edge_count)
+        .def("adjacency", &adjacency, "Offsets, neighbours and edges of the adjacency lists")
+        .def("bfs", &bfs, "source"_a, "Breadth-first hop counts and tree from a vertex")
+        .def("components", &components, "Connected component labels and their number")
+        .def("shortest_paths", &shortest_paths, "source"_a, "method"_a = "delta", "delta"_a = 0.0, "Shortest path lengths and tree from a vertex")
+        .def("distance_matrix", &distance_matrix, "sources"_a, "Shortest path lengths from many vertices")
+        .def("minimum_spanning_tree", &spanning_tree, "Edges and total weight of the minimum spanning forest");
+
+    def_arena_stats(m);
+}
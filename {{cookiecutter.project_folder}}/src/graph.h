@@ -0,0 +1,377 @@
+// graph.h - Undirected graph in CSR form with parallel traversal, components and spanning trees
+#pragma once
+
+#include "arena.h"
+#include "csr.h"
+#include "memory.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Lock-free union-find over vertex indices
+ * Roots are always linked under the smaller index, so the root of a set is its smallest member
+ * regardless of the order in which threads unite.
+ */
+class ConcurrentDisjointSets {
+public:
+    explicit ConcurrentDisjointSets(size_t count) : parent_(count) { std::iota(parent_.begin(), parent_.end(), 0u); }
+
+    uint32_t find(uint32_t x) {
+        while (true) {
+            uint32_t p = std::atomic_ref<uint32_t>(parent_[x]).load(std::memory_order_relaxed);
+            if (p == x)
+                return x;
+            uint32_t g = std::atomic_ref<uint32_t>(parent_[p]).load(std::memory_order_relaxed);
+            // Path halving, losing the race only skips the shortcut
+            std::atomic_ref<uint32_t>(parent_[x]).compare_exchange_weak(p, g, std::memory_order_relaxed);
+            x = g;
+        }
+    }
+
+    /**
+     * @return True if a and b were in different sets
+     */
+    bool unite(uint32_t a, uint32_t b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b)
+                return false;
+            if (a < b)
+                std::swap(a, b);
+            uint32_t expected = a;
+            if (std::atomic_ref<uint32_t>(parent_[a]).compare_exchange_strong(expected, b, std::memory_order_acq_rel))
+                return true;
+        }
+    }
+
+private:
+    std::vector<uint32_t> parent_;
+};
+
+/**
+ * Undirected weighted graph stored as incidence lists
+ * The neighbours of vertex v are targets[adjacency.begin(v):adjacency.end(v)], reached through the
+ * edges adjacency.items[...]. Parallel algorithms produce the same results for any thread count:
+ * trees are built from the final depths or distances rather than from the order of updates.
+ */
+class Graph {
+public:
+    static constexpr double INF = std::numeric_limits<double>::infinity();
+
+    /**
+     * @param edges Row-major (E,2) vertex indices
+     * @param edge_count Number of edges E
+     * @param vertex_count Number of vertices V
+     * @param weights (E,) non-negative edge weights, or null for unit weights
+     * @throws std::out_of_range if an edge references a missing vertex
+     * @throws std::invalid_argument if a weight is negative or NaN
+     */
+    Graph(const int32_t* edges, size_t edge_count, size_t vertex_count, const double* weights = nullptr)
+        : edges_(edges, edges + 2 * edge_count), weights_(edge_count, 1.0), vertex_count_(vertex_count) {
+        check_edges(edges, edge_count, vertex_count);
+        if (weights) {
+            for (size_t e = 0; e < edge_count; ++e)
+                if (!(weights[e] >= 0))
+                    throw std::invalid_argument("Edge weights must be non-negative.");
+            weights_.assign(weights, weights + edge_count);
+        }
+        adjacency_ = vertex_edges(edges, edge_count, vertex_count);
+        targets_.resize(adjacency_.items.size());
+        parallel_for(vertex_count, 4096, [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v)
+                for (uint32_t k = adjacency_.begin(v); k < adjacency_.end(v); ++k)
+                    targets_[k] = opposite(adjacency_.items[k], static_cast<uint32_t>(v));
+        });
+    }
+
+    size_t vertex_count() const { return vertex_count_; }
+    size_t edge_count() const { return weights_.size(); }
+    const CSR& adjacency() const { return adjacency_; }
+    const std::vector<uint32_t>& targets() const { return targets_; }
+    const std::vector<double>& weights() const { return weights_; }
+
+    uint32_t opposite(uint32_t edge, uint32_t v) const {
+        uint32_t a = static_cast<uint32_t>(edges_[2 * edge]);
+        return a == v ? static_cast<uint32_t>(edges_[2 * edge + 1]) : a;
+    }
+
+    /**
+     * Level-synchronous breadth-first search
+     * @param source Start vertex
+     * @param depth (V,) output hop counts, -1 for unreachable vertices
+     * @param parents (V,) output BFS tree, -1 for the source and unreachable vertices
+     * @throws std::out_of_range if the source does not exist
+     */
+    void bfs(uint32_t source, int32_t* depth, int32_t* parents) const {
+        check_vertex(source);
+        std::fill(depth, depth + vertex_count_, -1);
+        depth[source] = 0;
+        std::vector<uint32_t> frontier{source};
+        for (int32_t level = 1; !frontier.empty(); ++level) {
+            std::vector<std::vector<uint32_t>> next(thread_count());
+            parallel_for(frontier.size(), 1024, [&](size_t begin, size_t end, size_t worker) {
+                for (size_t i = begin; i < end; ++i)
+                    for (uint32_t k = adjacency_.begin(frontier[i]); k < adjacency_.end(frontier[i]); ++k) {
+                        uint32_t v = targets_[k];
+                        int32_t unvisited = -1;
+                        if (std::atomic_ref<int32_t>(depth[v]).load(std::memory_order_relaxed) == -1 &&
+                            std::atomic_ref<int32_t>(depth[v]).compare_exchange_strong(unvisited, level, std::memory_order_relaxed))
+                            next[worker].push_back(v);
+                    }
+            });
+            frontier.clear();
+            for (const auto& part : next)
+                frontier.insert(frontier.end(), part.begin(), part.end());
+        }
+        parallel_for(vertex_count_, 4096, [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) {
+                parents[v] = -1;
+                if (depth[v] > 0)
+                    for (uint32_t k = adjacency_.begin(v); k < adjacency_.end(v); ++k)
+                        if (depth[targets_[k]] == depth[v] - 1 && (parents[v] < 0 || targets_[k] < static_cast<uint32_t>(parents[v])))
+                            parents[v] = static_cast<int32_t>(targets_[k]);
+            }
+        });
+    }
+
+    /**
+     * Connected components by concurrent union-find
+     * @param labels (V,) output component per vertex, numbered in order of their smallest vertex
+     * @return Number of components
+     */
+    size_t components(int32_t* labels) const {
+        ConcurrentDisjointSets sets(vertex_count_);
+        parallel_for(edge_count(), 16384, [&](size_t begin, size_t end) {
+            for (size_t e = begin; e < end; ++e)
+                sets.unite(static_cast<uint32_t>(edges_[2 * e]), static_cast<uint32_t>(edges_[2 * e + 1]));
+        });
+        size_t count = 0;
+        for (size_t v = 0; v < vertex_count_; ++v) {
+            uint32_t root = sets.find(static_cast<uint32_t>(v));
+            labels[v] = root == v ? static_cast<int32_t>(count++) : labels[root];
+        }
+        return count;
+    }
+
+    /**
+     * Single-source shortest paths with a binary heap
+     * @param source Start vertex
+     * @param distances (V,) output path lengths, infinity for unreachable vertices
+     * @param parents (V,) output shortest path tree, or null
+     */
+    void dijkstra(uint32_t source, double* distances, int32_t* parents) const {
+        check_vertex(source);
+        std::fill(distances, distances + vertex_count_, INF);
+        distances[source] = 0.0;
+        using Entry = std::pair<double, uint32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+        heap.emplace(0.0, source);
+        while (!heap.empty()) {
+            auto [d, u] = heap.top();
+            heap.pop();
+            if (d > distances[u])
+                continue;
+            for (uint32_t k = adjacency_.begin(u); k < adjacency_.end(u); ++k) {
+                double candidate = d + weights_[adjacency_.items[k]];
+                if (candidate < distances[targets_[k]]) {
+                    distances[targets_[k]] = candidate;
+                    heap.emplace(candidate, targets_[k]);
+                }
+            }
+        }
+        if (parents)
+            shortest_path_tree(source, distances, parents);
+    }
+
+    /**
+     * Single-source shortest paths by delta-stepping (Meyer and Sanders 2003)
+     * Vertices are processed in buckets of width delta; edges lighter than delta are relaxed
+     * repeatedly within a bucket, heavier ones once when the bucket is settled. Each relaxation
+     * phase runs in parallel with an atomic minimum on the tentative distances.
+     * @param source Start vertex
+     * @param delta Bucket width, 0 for the mean edge weight
+     * @param distances (V,) output path lengths, infinity for unreachable vertices
+     * @param parents (V,) output shortest path tree, or null
+     */
+    void delta_stepping(uint32_t source, double delta, double* distances, int32_t* parents) const {
+        check_vertex(source);
+        if (!(delta > 0)) {
+            double total = std::accumulate(weights_.begin(), weights_.end(), 0.0);
+            delta = total > 0 ? total / static_cast<double>(weights_.size()) : 1.0;
+        }
+        std::fill(distances, distances + vertex_count_, INF);
+        distances[source] = 0.0;
+        Scratch scratch;
+        std::span<double> relaxed = scratch.array(vertex_count_, -1.0);  // distance at which light edges were last relaxed
+        std::vector<std::vector<uint32_t>> buckets(1, std::vector<uint32_t>{source});
+        auto bucket_of = [&](double d) { return static_cast<size_t>(d / delta); };
+
+        // Relax the light or heavy edges of `vertices`, collecting improved vertices per worker
+        auto relax = [&](const std::vector<uint32_t>& vertices, bool light) {
+            std::vector<std::vector<uint32_t>> improved(thread_count());
+            parallel_for(vertices.size(), 256, [&](size_t begin, size_t end, size_t worker) {
+                for (size_t i = begin; i < end; ++i) {
+                    uint32_t u = vertices[i];
+                    double du = std::atomic_ref<double>(distances[u]).load(std::memory_order_relaxed);
+                    for (uint32_t k = adjacency_.begin(u); k < adjacency_.end(u); ++k) {
+                        double w = weights_[adjacency_.items[k]];
+                        if ((w <= delta) != light)
+                            continue;
+                        std::atomic_ref<double> dv(distances[targets_[k]]);
+                        double current = dv.load(std::memory_order_relaxed), candidate = du + w;
+                        while (candidate < current && !dv.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                        }
+                        if (candidate < current)
+                            improved[worker].push_back(targets_[k]);
+                    }
+                }
+            });
+            for (const auto& part : improved)
+                for (uint32_t v : part) {
+                    size_t b = bucket_of(distances[v]);
+                    if (b >= buckets.size())
+                        buckets.resize(b + 1);
+                    buckets[b].push_back(v);
+                }
+        };
+
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            std::vector<uint32_t> settled;
+            while (!buckets[i].empty()) {
+                // Keep vertices still in this bucket whose distance improved since their last relaxation
+                std::vector<uint32_t> frontier;
+                frontier.swap(buckets[i]);
+                std::sort(frontier.begin(), frontier.end());
+                frontier.erase(std::unique(frontier.begin(), frontier.end()), frontier.end());
+                frontier.erase(std::remove_if(frontier.begin(), frontier.end(), [&](uint32_t v) {
+                    return bucket_of(distances[v]) != i || relaxed[v] == distances[v];
+                }), frontier.end());
+                for (uint32_t v : frontier)
+                    relaxed[v] = distances[v];
+                settled.insert(settled.end(), frontier.begin(), frontier.end());
+                relax(frontier, true);
+            }
+            std::sort(settled.begin(), settled.end());
+            settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+            relax(settled, false);
+        }
+        if (parents)
+            shortest_path_tree(source, distances, parents);
+    }
+
+    /**
+     * Minimum spanning forest by parallel Boruvka
+     * Ties are broken by edge index, so the forest is unique and independent of the thread count.
+     * @param selected Output edge indices of the forest in increasing order
+     * @return Total weight of the forest
+     */
+    double minimum_spanning_forest(ArrayBuffer<int32_t>& selected) const {
+        size_t E = edge_count();
+        Scratch scratch;
+        std::span<uint32_t> order = scratch.array<uint32_t>(E), rank = scratch.array<uint32_t>(E);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return weights_[a] < weights_[b]; });
+        for (size_t r = 0; r < E; ++r)
+            rank[order[r]] = static_cast<uint32_t>(r);
+
+        constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+        ConcurrentDisjointSets sets(vertex_count_);
+        std::span<uint32_t> best = scratch.array(vertex_count_, NONE);
+        std::span<uint8_t> chosen = scratch.array<uint8_t>(E, 0);
+        std::span<uint32_t> live = scratch.array<uint32_t>(E);
+        std::iota(live.begin(), live.end(), 0u);
+        while (!live.empty()) {
+            // Cheapest edge leaving each component, as the smallest rank
+            parallel_for(live.size(), 16384, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    uint32_t e = live[i];
+                    uint32_t a = sets.find(static_cast<uint32_t>(edges_[2 * e])), b = sets.find(static_cast<uint32_t>(edges_[2 * e + 1]));
+                    if (a == b)
+                        continue;
+                    for (uint32_t root : {a, b}) {
+                        std::atomic_ref<uint32_t> slot(best[root]);
+                        uint32_t current = slot.load(std::memory_order_relaxed);
+                        while (rank[e] < current && !slot.compare_exchange_weak(current, rank[e], std::memory_order_relaxed)) {
+                        }
+                    }
+                }
+            });
+            bool merged = false;
+            for (size_t v = 0; v < vertex_count_; ++v) {
+                if (best[v] == NONE)
+                    continue;
+                uint32_t e = order[best[v]];
+                best[v] = NONE;
+                if (sets.unite(static_cast<uint32_t>(edges_[2 * e]), static_cast<uint32_t>(edges_[2 * e + 1]))) {
+                    chosen[e] = 1;
+                    merged = true;
+                }
+            }
+            if (!merged)
+                break;
+            // Drop edges that now lie inside a component
+            live = live.first(std::remove_if(live.begin(), live.end(), [&](uint32_t e) {
+                return sets.find(static_cast<uint32_t>(edges_[2 * e])) == sets.find(static_cast<uint32_t>(edges_[2 * e + 1]));
+            }) - live.begin());
+        }
+        selected.clear();
+        double total = 0.0;
+        for (size_t e = 0; e < E; ++e)
+            if (chosen[e]) {
+                selected.push_back(static_cast<int32_t>(e));
+                total += weights_[e];
+            }
+        return total;
+    }
+
+private:
+    void check_vertex(uint32_t v) const {
+        if (v >= vertex_count_)
+            throw std::out_of_range("Vertex " + std::to_string(v) + " does not exist.");
+    }
+
+    // Tree of tight edges (distances[u] + w == distances[v]) discovered breadth-first from the source;
+    // the exact comparison holds because every final distance is such a sum
+    void shortest_path_tree(uint32_t source, const double* distances, int32_t* parents) const {
+        std::fill(parents, parents + vertex_count_, -1);
+        // Every vertex enters the queue at most once
+        Scratch scratch;
+        std::span<uint8_t> reached = scratch.array<uint8_t>(vertex_count_, 0);
+        std::span<uint32_t> queue = scratch.array<uint32_t>(vertex_count_);
+        size_t tail = 0;
+        queue[tail++] = source;
+        reached[source] = 1;
+        for (size_t head = 0; head < tail; ++head) {
+            uint32_t u = queue[head];
+            for (uint32_t k = adjacency_.begin(u); k < adjacency_.end(u); ++k) {
+                uint32_t v = targets_[k];
+                if (!reached[v] && distances[u] + weights_[adjacency_.items[k]] == distances[v]) {
+                    reached[v] = 1;
+                    parents[v] = static_cast<int32_t>(u);
+                    queue[tail++] = v;
+                }
+            }
+        }
+    }
+
+    std::vector<int32_t> edges_;
+    std::vector<double> weights_;
+    size_t vertex_count_;
+    CSR adjacency_;
+    std::vector<uint32_t> targets_;  // neighbour across each incidence
+};
+
+} // namespace compas
@@ -0,0 +1,409 @@
+// halfedge.h - Editable half-edge triangle mesh over compact face arrays
+#pragma once
+
+#include "memory.h"
+#include "mesh.h"
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Manifold triangle mesh with implicit half-edges
+ * Half-edge h belongs to face h / 3 and runs from corner h to the next corner of that face, so
+ * faces are stored exactly like the (F,3) input array and next/prev are index arithmetic. Only the
+ * twins and one outgoing half-edge per vertex are stored. Boundary vertices keep their boundary
+ * half-edge as outgoing one, so rotating around a vertex starts at the boundary.
+ * Local operations (split, collapse, flip) only flag removed elements; compact() drops them.
+ */
+class HalfEdgeMesh {
+public:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    std::vector<Vec3> points;
+
+    HalfEdgeMesh() = default;
+
+    /**
+     * @param mesh Triangle mesh with consistently oriented faces
+     * @throws std::invalid_argument if the mesh has degenerate faces, or edges or vertices that are not manifold
+     */
+    explicit HalfEdgeMesh(const MeshView& mesh) : points(mesh.vertex_count), outgoing_(mesh.vertex_count, NONE), vertex_alive_(mesh.vertex_count, 1) {
+        mesh.validate();
+        for (size_t v = 0; v < mesh.vertex_count; ++v)
+            points[v] = mesh.vertex(v);
+        corners_.assign(mesh.faces, mesh.faces + 3 * mesh.face_count);
+        twins_.assign(corners_.size(), NONE);
+        face_alive_.assign(mesh.face_count, 1);
+
+        // Outgoing half-edges grouped by their start vertex; the twin of a->b is found among those of b
+        std::vector<uint32_t> offsets(points.size() + 1, 0), grouped(corners_.size());
+        for (uint32_t c : corners_)
+            ++offsets[c + 1];
+        for (size_t v = 0; v < points.size(); ++v)
+            offsets[v + 1] += offsets[v];
+        {
+            std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (uint32_t h = 0; h < corners_.size(); ++h)
+                grouped[cursor[corners_[h]]++] = h;
+        }
+        for (uint32_t h = 0; h < corners_.size(); ++h) {
+            uint32_t a = from(h), b = to(h);
+            if (a == b)
+                throw std::invalid_argument("Face " + std::to_string(face(h)) + " is degenerate.");
+            for (uint32_t k = offsets[a]; k < offsets[a + 1]; ++k)
+                if (grouped[k] != h && to(grouped[k]) == b)
+                    throw std::invalid_argument("Edge (" + std::to_string(a) + ", " + std::to_string(b) + ") is not manifold or its faces are inconsistently oriented.");
+            for (uint32_t k = offsets[b]; k < offsets[b + 1]; ++k)
+                if (to(grouped[k]) == a)
+                    twins_[h] = grouped[k];
+            outgoing_[a] = h;
+        }
+
+        for (uint32_t v = 0; v < points.size(); ++v) {
+            adjust_outgoing(v);
+            size_t count = 0;
+            for_each_outgoing(v, [&](uint32_t) { ++count; });
+            if (count != offsets[v + 1] - offsets[v])
+                throw std::invalid_argument("Vertex " + std::to_string(v) + " is not manifold.");
+        }
+    }
+
+    static uint32_t face(uint32_t h) { return h / 3; }
+    static uint32_t next(uint32_t h) { return h % 3 == 2 ? h - 2 : h + 1; }
+    static uint32_t prev(uint32_t h) { return h % 3 == 0 ? h + 2 : h - 1; }
+
+    uint32_t from(uint32_t h) const { return corners_[h]; }
+    uint32_t to(uint32_t h) const { return corners_[next(h)]; }
+    uint32_t twin(uint32_t h) const { return twins_[h]; }
+    uint32_t outgoing(uint32_t v) const { return outgoing_[v]; }
+
+    /**
+     * @return Vertex opposite to half-edge h in its face
+     */
+    uint32_t opposite(uint32_t h) const { return corners_[prev(h)]; }
+
+    size_t vertex_capacity() const { return points.size(); }
+    size_t halfedge_capacity() const { return corners_.size(); }
+    size_t face_capacity() const { return face_alive_.size(); }
+
+    bool vertex_alive(uint32_t v) const { return vertex_alive_[v] && outgoing_[v] != NONE; }
+    bool face_alive(uint32_t f) const { return face_alive_[f] != 0; }
+
+    bool boundary_edge(uint32_t h) const { return twins_[h] == NONE; }
+    bool boundary_vertex(uint32_t v) const { return outgoing_[v] != NONE && twins_[outgoing_[v]] == NONE; }
+
+    /**
+     * Visit the outgoing half-edges of a vertex in order, starting at the boundary if there is one
+     * @param fn Callable fn(halfedge)
+     */
+    template <class F>
+    void for_each_outgoing(uint32_t v, F&& fn) const {
+        uint32_t start = outgoing_[v];
+        if (start == NONE)
+            return;
+        uint32_t h = start;
+        do {
+            fn(h);
+            h = twins_[prev(h)];
+        } while (h != NONE && h != start);
+    }
+
+    /**
+     * Visit the neighbours of a vertex in order
+     * @param fn Callable fn(vertex)
+     */
+    template <class F>
+    void for_each_neighbor(uint32_t v, F&& fn) const {
+        uint32_t last = NONE;
+        for_each_outgoing(v, [&](uint32_t h) {
+            fn(to(h));
+            last = h;
+        });
+        if (last != NONE && twins_[prev(last)] == NONE)
+            fn(from(prev(last)));
+    }
+
+    /**
+     * Visit the edges at a vertex, each through one of its half-edges
+     * @param fn Callable fn(halfedge), called with the incoming boundary half-edge for the last edge of a boundary vertex
+     */
+    template <class F>
+    void for_each_edge(uint32_t v, F&& fn) const {
+        uint32_t last = NONE;
+        for_each_outgoing(v, [&](uint32_t h) {
+            fn(h);
+            last = h;
+        });
+        if (last != NONE && twins_[prev(last)] == NONE)
+            fn(prev(last));
+    }
+
+    size_t valence(uint32_t v) const {
+        size_t count = 0;
+        for_each_neighbor(v, [&](uint32_t) { ++count; });
+        return count;
+    }
+
+    /**
+     * @return Half-edge from a to b, or NONE if the vertices are not connected by a face edge
+     */
+    uint32_t find_halfedge(uint32_t a, uint32_t b) const {
+        uint32_t found = NONE;
+        for_each_outgoing(a, [&](uint32_t h) {
+            if (to(h) == b)
+                found = h;
+        });
+        return found;
+    }
+
+    bool connected(uint32_t a, uint32_t b) const {
+        bool found = false;
+        for_each_neighbor(a, [&](uint32_t u) { found |= u == b; });
+        return found;
+    }
+
+    Vec3 face_normal(uint32_t f) const {
+        const Vec3& a = points[corners_[3 * f]];
+        return (points[corners_[3 * f + 1]] - a).cross(points[corners_[3 * f + 2]] - a);
+    }
+
+    /**
+     * Split an edge at a new vertex, splitting its one or two faces in two
+     * @param h Half-edge of the edge
+     * @param point Position of the new vertex
+     * @return Index of the new vertex
+     */
+    uint32_t split(uint32_t h, const Vec3& point) {
+        uint32_t t = twins_[h];
+        uint32_t f0 = face(h), a = from(h), b = to(h), c = opposite(h);
+        uint32_t x_bc = twins_[next(h)], x_ca = twins_[prev(h)];
+        uint32_t f1 = NONE, d = NONE, y_ad = NONE, y_db = NONE;
+        if (t != NONE) {
+            f1 = face(t);
+            d = opposite(t);
+            y_ad = twins_[next(t)];
+            y_db = twins_[prev(t)];
+        }
+
+        uint32_t m = add_vertex(point);
+        uint32_t f2 = add_face();
+        set_face(f0, a, m, c);
+        set_face(f2, m, b, c);
+        link(3 * f0 + 1, 3 * f2 + 2);
+        link(3 * f0 + 2, x_ca);
+        link(3 * f2 + 1, x_bc);
+        if (t == NONE) {
+            twins_[3 * f0] = NONE;
+            update_outgoing({{a, 3 * f0}, {b, 3 * f2 + 1}, {c, 3 * f0 + 2}, {m, 3 * f2}});
+            return m;
+        }
+
+        uint32_t f3 = add_face();
+        set_face(f1, b, m, d);
+        set_face(f3, m, a, d);
+        link(3 * f0, 3 * f3);
+        link(3 * f2, 3 * f1);
+        link(3 * f1 + 1, 3 * f3 + 2);
+        link(3 * f1 + 2, y_db);
+        link(3 * f3 + 1, y_ad);
+        update_outgoing({{a, 3 * f0}, {b, 3 * f2 + 1}, {c, 3 * f0 + 2}, {d, 3 * f1 + 2}, {m, 3 * f2}});
+        return m;
+    }
+
+    /**
+     * Check that collapsing from(h) into to(h) keeps the mesh manifold
+     * The removed vertex must be interior, the two vertices must share exactly the two vertices
+     * opposite the edge (link condition) and those must keep at least three neighbours.
+     */
+    bool can_collapse(uint32_t h) const {
+        uint32_t t = twins_[h];
+        uint32_t a = from(h), b = to(h);
+        if (t == NONE || boundary_vertex(a))
+            return false;
+        uint32_t c = opposite(h), d = opposite(t);
+        if (c == d)
+            return false;
+        size_t shared = 0;
+        bool link = true;
+        for_each_neighbor(a, [&](uint32_t u) {
+            if (u != b && connected(b, u)) {
+                ++shared;
+                link &= u == c || u == d;
+            }
+        });
+        if (!link || shared != 2)
+            return false;
+        for (uint32_t v : {c, d})
+            if (valence(v) <= (boundary_vertex(v) ? 2u : 3u))
+                return false;
+        return true;
+    }
+
+    /**
+     * Check that moving both ends of an edge to one point keeps the orientation of the faces that remain
+     * @param h Half-edge of the edge to collapse
+     * @param point Position of the merged vertex
+     */
+    bool collapse_keeps_orientation(uint32_t h, const Vec3& point) const {
+        uint32_t removed = face(h), other = twins_[h] == NONE ? NONE : face(twins_[h]);
+        bool valid = true;
+        for (uint32_t v : {from(h), to(h)}) {
+            for_each_outgoing(v, [&](uint32_t g) {
+                uint32_t f = face(g);
+                if (!valid || f == removed || f == other)
+                    return;
+                Vec3 after = (points[to(g)] - point).cross(points[opposite(g)] - point);
+                valid = face_normal(f).dot(after) > 0.0;
+            });
+        }
+        return valid;
+    }
+
+    /**
+     * Remove from(h) by merging it into to(h), together with the two faces of the edge
+     * The kept vertex is not moved. Call can_collapse() first.
+     * @return The kept vertex
+     */
+    uint32_t collapse(uint32_t h) {
+        uint32_t t = twins_[h];
+        uint32_t a = from(h), b = to(h), c = opposite(h), d = opposite(t);
+        uint32_t x_cb = twins_[next(h)], x_ac = twins_[prev(h)];
+        uint32_t y_da = twins_[next(t)], y_bd = twins_[prev(t)];
+
+        // Rotation only follows twins, so corners can be renamed on the way
+        for_each_outgoing(a, [&](uint32_t g) { corners_[g] = b; });
+
+        link(x_cb, x_ac);
+        link(y_da, y_bd);
+        face_alive_[face(h)] = face_alive_[face(t)] = 0;
+        vertex_alive_[a] = 0;
+        outgoing_[a] = NONE;
+        update_outgoing({{b, x_ac}, {c, x_cb != NONE ? x_cb : next(x_ac)}, {d, y_da}});
+        return b;
+    }
+
+    /**
+     * Check that an interior edge can be flipped without creating a duplicate edge or a vertex
+     * with fewer than three neighbours
+     */
+    bool can_flip(uint32_t h) const {
+        uint32_t t = twins_[h];
+        if (t == NONE)
+            return false;
+        uint32_t a = from(h), b = to(h), c = opposite(h), d = opposite(t);
+        if (c == d || connected(c, d))
+            return false;
+        for (uint32_t v : {a, b})
+            if (valence(v) <= (boundary_vertex(v) ? 2u : 3u))
+                return false;
+        return true;
+    }
+
+    /**
+     * Replace an interior edge by the other diagonal of its two faces
+     * Call can_flip() first.
+     */
+    void flip(uint32_t h) {
+        uint32_t t = twins_[h];
+        uint32_t f0 = face(h), f1 = face(t);
+        uint32_t a = from(h), b = to(h), c = opposite(h), d = opposite(t);
+        uint32_t x_bc = twins_[next(h)], x_ca = twins_[prev(h)];
+        uint32_t y_ad = twins_[next(t)], y_db = twins_[prev(t)];
+
+        set_face(f0, c, a, d);
+        set_face(f1, d, b, c);
+        link(3 * f0, x_ca);
+        link(3 * f0 + 1, y_ad);
+        link(3 * f0 + 2, 3 * f1 + 2);
+        link(3 * f1, y_db);
+        link(3 * f1 + 1, x_bc);
+        update_outgoing({{a, 3 * f0 + 1}, {b, 3 * f1 + 1}, {c, 3 * f0}, {d, 3 * f1}});
+    }
+
+    /**
+     * Copy the live elements into compact arrays
+     * @param vertices Output row-major (V,3) coordinates of the referenced vertices
+     * @param faces Output row-major (F,3) renumbered faces
+     */
+    void compact(ArrayBuffer<double>& vertices, ArrayBuffer<int32_t>& faces) const {
+        std::vector<int32_t> index(points.size(), -1);
+        vertices.clear();
+        faces.clear();
+        for (uint32_t v = 0; v < points.size(); ++v) {
+            if (!vertex_alive(v))
+                continue;
+            index[v] = static_cast<int32_t>(vertices.size() / 3);
+            vertices.insert(vertices.end(), points[v].data(), points[v].data() + 3);
+        }
+        for (uint32_t f = 0; f < face_alive_.size(); ++f)
+            if (face_alive_[f])
+                for (int k = 0; k < 3; ++k)
+                    faces.push_back(index[corners_[3 * f + k]]);
+    }
+
+private:
+    uint32_t add_vertex(const Vec3& point) {
+        points.push_back(point);
+        outgoing_.push_back(NONE);
+        vertex_alive_.push_back(1);
+        return static_cast<uint32_t>(points.size() - 1);
+    }
+
+    uint32_t add_face() {
+        corners_.resize(corners_.size() + 3);
+        twins_.resize(twins_.size() + 3, NONE);
+        face_alive_.push_back(1);
+        return static_cast<uint32_t>(face_alive_.size() - 1);
+    }
+
+    void set_face(uint32_t f, uint32_t a, uint32_t b, uint32_t c) {
+        corners_[3 * f] = a;
+        corners_[3 * f + 1] = b;
+        corners_[3 * f + 2] = c;
+    }
+
+    void link(uint32_t h, uint32_t g) {
+        if (h != NONE)
+            twins_[h] = g;
+        if (g != NONE)
+            twins_[g] = h;
+    }
+
+    /**
+     * Point each vertex at a valid outgoing half-edge, then move it to the boundary if there is one
+     */
+    void update_outgoing(std::initializer_list<std::array<uint32_t, 2>> entries) {
+        for (const auto& [v, h] : entries)
+            outgoing_[v] = h;
+        for (const auto& entry : entries)
+            adjust_outgoing(entry[0]);
+    }
+
+    void adjust_outgoing(uint32_t v) {
+        uint32_t start = outgoing_[v];
+        if (start == NONE)
+            return;
+        uint32_t h = start;
+        while (twins_[h] != NONE) {
+            h = next(twins_[h]);
+            if (h == start)
+                return;
+        }
+        outgoing_[v] = h;
+    }
+
+    std::vector<uint32_t> corners_;   // (3F,) vertex at each corner, the start of its half-edge
+    std::vector<uint32_t> twins_;     // (3F,) opposite half-edge, NONE on the boundary
+    std::vector<uint32_t> outgoing_;  // (V,) outgoing half-edge, the boundary one if any
+    std::vector<uint8_t> vertex_alive_;
+    std::vector<uint8_t> face_alive_;
+};
+
+} // namespace compas
@@ -0,0 +1,135 @@
+// heap.h - Indexed 4-ary min-heap with updatable keys
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Min-heap over integer handles with keys that can be changed or removed in place
+ * Entries are (key, handle) pairs in one contiguous array and every node has four children, so
+ * a sift-down compares keys within a single cache line and the tree is half as deep as a binary
+ * heap. A position table maps handles to entries, so no stale entries are left behind.
+ */
+class IndexedHeap {
+public:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    bool empty() const { return entries_.empty(); }
+    size_t size() const { return entries_.size(); }
+
+    bool contains(uint32_t handle) const { return handle < positions_.size() && positions_[handle] != NONE; }
+
+    /**
+     * @return Handle and key of the smallest entry
+     */
+    std::pair<uint32_t, double> top() const { return {entries_[0].handle, entries_[0].key}; }
+
+    /**
+     * Insert a handle, or change its key if it is already present
+     */
+    void push(uint32_t handle, double key) {
+        if (handle >= positions_.size())
+            positions_.resize(size_t(handle) + 1, NONE);
+        uint32_t i = positions_[handle];
+        if (i == NONE) {
+            i = static_cast<uint32_t>(entries_.size());
+            entries_.push_back({key, handle});
+            positions_[handle] = i;
+            sift_up(i);
+            return;
+        }
+        double old = entries_[i].key;
+        entries_[i].key = key;
+        if (key < old)
+            sift_up(i);
+        else
+            sift_down(i);
+    }
+
+    /**
+     * Remove and return the handle with the smallest key
+     */
+    uint32_t pop() {
+        uint32_t handle = entries_[0].handle;
+        remove_at(0);
+        return handle;
+    }
+
+    /**
+     * Remove a handle if it is present
+     */
+    void erase(uint32_t handle) {
+        if (contains(handle))
+            remove_at(positions_[handle]);
+    }
+
+    void clear() {
+        for (const Entry& e : entries_)
+            positions_[e.handle] = NONE;
+        entries_.clear();
+    }
+
+private:
+    struct Entry {
+        double key;
+        uint32_t handle;
+    };
+
+    void place(uint32_t i, const Entry& e) {
+        entries_[i] = e;
+        positions_[e.handle] = i;
+    }
+
+    void remove_at(uint32_t i) {
+        positions_[entries_[i].handle] = NONE;
+        Entry last = entries_.back();
+        entries_.pop_back();
+        if (i == entries_.size())
+            return;
+        place(i, last);
+        sift_up(i);
+        sift_down(positions_[last.handle]);
+    }
+
+    void sift_up(uint32_t i) {
+        Entry e = entries_[i];
+        while (i > 0) {
+            uint32_t parent = (i - 1) / 4;
+            if (!(e.key < entries_[parent].key))
+                break;
+            place(i, entries_[parent]);
+            i = parent;
+        }
+        place(i, e);
+    }
+
+    void sift_down(uint32_t i) {
+        Entry e = entries_[i];
+        size_t n = entries_.size();
+        while (true) {
+            size_t first = 4 * size_t(i) + 1;
+            if (first >= n)
+                break;
+            size_t best = first;
+            for (size_t c = first + 1; c < std::min(first + 4, n); ++c)
+                if (entries_[c].key < entries_[best].key)
+                    best = c;
+            if (!(entries_[best].key < e.key))
+                break;
+            place(i, entries_[best]);
+            i = static_cast<uint32_t>(best);
+        }
+        place(i, e);
+    }
+
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> positions_;  // entry of each handle, NONE if absent
+};
+
+} // namespace compas
@@ -0,0 +1,180 @@
+// kdtree.h - Static KD-tree for nearest neighbour queries on point sets
+#pragma once
+
+#include "arena.h"
+#include "mesh.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Node of a KD-tree stored in depth-first order
+ * Inner nodes have their left child at the next index and the right child at `right`.
+ * Leaves reference `count` points of KDTree::points starting at `start`.
+ */
+struct KDNode {
+    double split = 0.0;
+    uint32_t start = 0;
+    uint32_t count = 0;
+    uint32_t right = 0;
+    int axis = 0;
+
+    bool leaf() const { return count > 0; }
+};
+
+/**
+ * KD-tree over a copy of a point set, split at the median of the widest axis
+ * Points are stored in tree order so leaves scan contiguous memory.
+ */
+class KDTree {
+public:
+    std::vector<KDNode> nodes;
+    std::vector<Vec3> points;       // points in tree order
+    std::vector<uint32_t> indices;  // original index of each point in tree order
+
+    KDTree() = default;
+
+    /**
+     * @param data Row-major (N,3) coordinates
+     * @param count Number of points N
+     * @param leaf_size Maximum number of points per leaf
+     */
+    KDTree(const double* data, size_t count, uint32_t leaf_size = 8) {
+        build(data, count, leaf_size);
+    }
+
+    void build(const double* data, size_t count, uint32_t leaf_size = 8) {
+        nodes.clear();
+        points.resize(count);
+        indices.resize(count);
+        std::iota(indices.begin(), indices.end(), 0u);
+        for (size_t i = 0; i < count; ++i)
+            points[i] = Vec3(data[3 * i], data[3 * i + 1], data[3 * i + 2]);
+        if (count == 0)
+            return;
+        nodes.reserve(2 * count / std::max<uint32_t>(leaf_size, 1) + 1);
+        build_node(0, count, std::max<uint32_t>(leaf_size, 1));
+
+        Scratch scratch;
+        std::span<Vec3> ordered = scratch.array<Vec3>(count);
+        for (size_t i = 0; i < count; ++i)
+            ordered[i] = points[indices[i]];
+        std::copy(ordered.begin(), ordered.end(), points.begin());
+    }
+
+    size_t size() const { return points.size(); }
+    bool empty() const { return points.empty(); }
+
+    /**
+     * Nearest point within a search radius
+     * @param query Query point
+     * @param best Squared search radius on input, squared distance of the result on output
+     * @return Original index of the nearest point, or UINT32_MAX if none lies within the radius
+     */
+    uint32_t nearest(const Vec3& query, double& best) const {
+        uint32_t result = std::numeric_limits<uint32_t>::max();
+        visit(query, best, [&](uint32_t i, double d) {
+            best = d;
+            result = indices[i];
+            return best;
+        });
+        return result;
+    }
+
+    /**
+     * k nearest points, sorted by increasing distance
+     * @param query Query point
+     * @param k Number of neighbours
+     * @param out_indices Output original indices, at least k entries
+     * @param out_distances Output squared distances, at least k entries
+     * @return Number of neighbours found, min(k, size())
+     */
+    size_t knn(const Vec3& query, size_t k, uint32_t* out_indices, double* out_distances) const {
+        size_t found = 0;
+        if (k == 0)
+            return 0;
+        double bound = std::numeric_limits<double>::infinity();
+        visit(query, bound, [&](uint32_t i, double d) {
+            // Insertion into the sorted candidate list
+            size_t j = found < k ? found++ : k - 1;
+            while (j > 0 && out_distances[j - 1] > d) {
+                out_distances[j] = out_distances[j - 1];
+                out_indices[j] = out_indices[j - 1];
+                --j;
+            }
+            out_distances[j] = d;
+            out_indices[j] = indices[i];
+            return found < k ? std::numeric_limits<double>::infinity() : out_distances[k - 1];
+        });
+        return found;
+    }
+
+private:
+    /**
+     * Depth-first traversal visiting the near side first
+     * fn(i, squared_distance) is called for points closer than the bound and returns the new bound.
+     */
+    template <class F>
+    void visit(const Vec3& query, double bound, F&& fn) const {
+        if (empty())
+            return;
+        std::array<std::pair<uint32_t, double>, 64> stack;
+        size_t top = 0;
+        stack[top++] = {0, 0.0};
+        while (top) {
+            auto [index, distance] = stack[--top];
+            if (distance >= bound)
+                continue;
+            const KDNode& node = nodes[index];
+            if (node.leaf()) {
+                for (uint32_t i = node.start; i < node.start + node.count; ++i) {
+                    double d = (points[i] - query).squaredNorm();
+                    if (d < bound)
+                        bound = fn(i, d);
+                }
+                continue;
+            }
+            double offset = query[node.axis] - node.split;
+            uint32_t near = offset < 0 ? index + 1 : node.right;
+            uint32_t far = offset < 0 ? node.right : index + 1;
+            stack[top++] = {far, offset * offset};
+            stack[top++] = {near, distance};
+        }
+    }
+
+    uint32_t build_node(size_t begin, size_t end, uint32_t leaf_size) {
+        uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+        if (end - begin <= leaf_size) {
+            nodes[index].start = static_cast<uint32_t>(begin);
+            nodes[index].count = static_cast<uint32_t>(end - begin);
+            return index;
+        }
+
+        Box3 box;
+        for (size_t i = begin; i < end; ++i)
+            box.extend(points[indices[i]]);
+        int axis;
+        box.sizes().maxCoeff(&axis);
+        size_t mid = (begin + end) / 2;
+        std::nth_element(indices.begin() + begin, indices.begin() + mid, indices.begin() + end,
+                         [&](uint32_t a, uint32_t b) { return points[a][axis] < points[b][axis]; });
+
+        nodes[index].axis = axis;
+        nodes[index].split = points[indices[mid]][axis];
+        build_node(begin, mid, leaf_size);
+        uint32_t right = build_node(mid, end, leaf_size);
+        nodes[index].right = right;
+        return index;
+    }
+};
+
+} // namespace compas
@@ -0,0 +1,151 @@
+#include "compas.h"
+#include "arrays.h"
+#include "kinematics.h"
+
+#include <nanobind/stl/optional.h>
+#include <optional>
+
+using namespace compas;
+
+using TypesIn = nb::ndarray<const int32_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+using TransformIn = nb::ndarray<const double, nb::shape<4, 4>, nb::c_contig, nb::device::cpu>;
+using TransformsIn = nb::ndarray<const double, nb::shape<-1, 4, 4>, nb::c_contig, nb::device::cpu>;
+using ConfigurationsIn = nb::ndarray<const double, nb::ndim<2>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Check that an array holds one value per joint
+ */
+void check_joint_count(size_t size, size_t count, const char* name) {
+    if (size != count)
+        throw std::invalid_argument(std::string(name) + " must have one entry per joint, expected " + std::to_string(count) + ".");
+}
+
+/**
+ * Forward kinematics of many configurations
+ * @param self Chain
+ * @param q (N,dofs) joint values
+ * @param all_frames Return every joint frame followed by the end effector
+ * @return (N,4,4) end-effector frames, or (N,J+1,4,4) frames
+ */
+nb::ndarray<nb::numpy, double> forward(const Chain& self, const ConfigurationsIn& q, bool all_frames) {
+    if (q.shape(1) != self.dofs())
+        throw std::invalid_argument("Expected " + std::to_string(self.dofs()) + " joint values per configuration.");
+    size_t n = q.shape(0), frames = self.size() + 1;
+    ArrayBuffer<double> out(16 * n * (all_frames ? frames : 1));
+    {
+        nb::gil_scoped_release release;
+        forward_kinematics(self, q.data(), n, out.data(), all_frames);
+    }
+    if (all_frames)
+        return to_ndarray(std::move(out), {n, frames, 4, 4});
+    return to_ndarray(std::move(out), {n, 4, 4});
+}
+
+/**
+ * Geometric Jacobians of many configurations
+ * @param self Chain
+ * @param q (N,dofs) joint values
+ * @return (N,6,dofs) Jacobians, linear rows first
+ */
+nb::ndarray<nb::numpy, double> jacobians(const Chain& self, const ConfigurationsIn& q) {
+    size_t dofs = self.dofs();
+    if (q.shape(1) != dofs)
+        throw std::invalid_argument("Expected " + std::to_string(dofs) + " joint values per configuration.");
+    size_t n = q.shape(0);
+    ArrayBuffer<double> out(n * 6 * dofs);
+    {
+        nb::gil_scoped_release release;
+        parallel_for(n, 1024, [&](size_t begin, size_t end) {
+            Jacobian jacobian;
+            for (size_t i = begin; i < end; ++i) {
+                self.jacobian(q.data() + i * dofs, jacobian);
+                Eigen::Map<Eigen::Matrix<double, 6, Eigen::Dynamic, Eigen::RowMajor>>(out.data() + i * 6 * dofs, 6, dofs) = jacobian;
+            }
+        });
+    }
+    return to_ndarray(std::move(out), {n, 6, dofs});
+}
+
+/**
+ * Inverse kinematics of many targets
+ * @param self Chain
+ * @param targets (N,4,4) target end-effector frames
+ * @param seeds (N,dofs) initial joint values
+ * @param max_iterations Iteration limit per target
+ * @param position_tolerance Position error below which a target is reached
+ * @param orientation_tolerance Orientation error in radians below which a target is reached
+ * @param orientation_weight Weight of the orientation error, 0 to solve for the position only
+ * @param damping Initial damping
+ * @return Tuple of solutions (N,dofs), success (N,), iterations (N,), position and orientation errors (N,)
+ */
+nb::tuple inverse(const Chain& self, const TransformsIn& targets, const ConfigurationsIn& seeds, int max_iterations,
+                  double position_tolerance, double orientation_tolerance, double orientation_weight, double damping) {
+    size_t n = targets.shape(0), dofs = self.dofs();
+    if (seeds.shape(0) != n || seeds.shape(1) != dofs)
+        throw std::invalid_argument("Expected one seed of " + std::to_string(dofs) + " joint values per target.");
+    if (!(damping > 0))
+        throw std::invalid_argument("The damping must be positive.");
+    IKOptions options;
+    options.max_iterations = max_iterations;
+    options.position_tolerance = position_tolerance;
+    options.orientation_tolerance = orientation_tolerance;
+    options.orientation_weight = orientation_weight;
+    options.damping = damping;
+
+    ArrayBuffer<double> q(seeds.data(), seeds.data() + n * dofs);
+    Scratch scratch;
+    std::span<IKStatus> status = scratch.array<IKStatus>(n);
+    {
+        nb::gil_scoped_release release;
+        inverse_kinematics(self, targets.data(), n, q.data(), status.data(), options);
+    }
+    ArrayBuffer<uint8_t> success(n);
+    ArrayBuffer<int32_t> iterations(n);
+    ArrayBuffer<double> position_error(n), orientation_error(n);
+    for (size_t i = 0; i < n; ++i) {
+        success[i] = status[i].success;
+        iterations[i] = status[i].iterations;
+        position_error[i] = status[i].position_error;
+        orientation_error[i] = status[i].orientation_error;
+    }
+    return nb::make_tuple(to_ndarray(std::move(q), {n, dofs}), to_ndarray(std::move(success), {n}), to_ndarray(std::move(iterations), {n}),
+                          to_ndarray(std::move(position_error), {n}), to_ndarray(std::move(orientation_error), {n}));
+}
+
+NB_MODULE(_kinematics, m) {
+    m.doc() = "Serial kinematic chains.";
+    share_memory_ledger();
+
+    nb::class_<Chain>(m, "Chain")
+        .def("__init__", [](Chain* self, const TransformsIn& origins, const PointsIn& axes, const TypesIn& types, std::optional<TransformIn> tool) {
+            size_t count = origins.shape(0);
+            check_joint_count(axes.shape(0), count, "axes");
+            check_joint_count(types.shape(0), count, "types");
+            new (self) Chain(origins.data(), axes.data(), types.data(), count, tool ? tool->data() : nullptr);
+        }, "origins"_a, "axes"_a, "types"_a, "tool"_a.none() = nb::none(),
+           "Chain from (J,4,4) joint origins, (J,3) joint axes and (J,) joint types (0 revolute, 1 prismatic, 2 fixed)")
+        .def_static("from_dh", [](const ValuesIn& a, const ValuesIn& alpha, const ValuesIn& d, const ValuesIn& theta, const TypesIn& types) {
+            size_t count = a.shape(0);
+            check_joint_count(alpha.shape(0), count, "alpha");
+            check_joint_count(d.shape(0), count, "d");
+            check_joint_count(theta.shape(0), count, "theta");
+            check_joint_count(types.shape(0), count, "types");
+            return Chain::from_dh(a.data(), alpha.data(), d.data(), theta.data(), types.data(), count);
+        }, "a"_a, "alpha"_a, "d"_a, "theta"_a, "types"_a, "Chain from Denavit-Hartenberg parameters")
+        .def("__len__", &Chain::size)
+        .def_prop_ro("dofs", &Chain::dofs)
+        .def("set_limits", [](Chain& self, const ValuesIn& lower, const ValuesIn& upper) {
+            check_joint_count(lower.shape(0), self.dofs(), "lower");
+            check_joint_count(upper.shape(0), self.dofs(), "upper");
+            self.set_limits(lower.data(), upper.data());
+        }, "lower"_a, "upper"_a, "Set the limits of the non-fixed joints")
+        .def("forward", &forward, "q"_a, "all_frames"_a = false,
+             "Frames of (N,dofs) joint configurations")
+        .def("jacobians", &jacobians, "q"_a,
+             "Geometric (N,6,dofs) Jacobians of (N,dofs) joint configurations")
+        .def("inverse", &inverse, "targets"_a, "seeds"_a, "max_iterations"_a = 100, "position_tolerance"_a = 1e-6,
+             "orientation_tolerance"_a = 1e-6, "orientation_weight"_a = 1.0, "damping"_a = 1e-3,
+             "Damped least-squares inverse kinematics of (N,4,4) targets from (N,dofs) seeds");
+
+    def_arena_stats(m);
+}
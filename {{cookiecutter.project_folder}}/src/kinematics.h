@@ -0,0 +1,374 @@
+// kinematics.h - Serial kinematic chains and batched forward kinematics
+#pragma once
+
+#include "mesh.h"
+#include "parallel.h"
+#include "transform.h"
+
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace compas {
+
+enum JointType : int32_t {
+    REVOLUTE = 0,
+    PRISMATIC = 1,
+    FIXED = 2,
+};
+
+constexpr int MAX_DOFS = 32;
+
+/**
+ * Joint in URDF convention: the child frame is origin * motion(q), with the motion a rotation
+ * about or translation along `axis` expressed in the joint frame.
+ */
+struct Joint {
+    Matrix4 origin = Matrix4::Identity();
+    Vec3 axis = Vec3::UnitZ();
+    JointType type = REVOLUTE;
+    double lower = -std::numeric_limits<double>::infinity();
+    double upper = std::numeric_limits<double>::infinity();
+};
+
+using Jacobian = Eigen::Matrix<double, 6, Eigen::Dynamic, Eigen::ColMajor, 6, MAX_DOFS>;
+using JointVector = Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor, MAX_DOFS, 1>;
+
+/**
+ * Serial chain of joints followed by a fixed tool transform
+ * Fixed joints are kept in the chain but take no joint value.
+ */
+class Chain {
+public:
+    std::vector<Joint> joints;
+    Matrix4 tool = Matrix4::Identity();
+
+    Chain() = default;
+
+    /**
+     * @param origins Row-major (J,4,4) joint origins relative to the previous joint frame
+     * @param axes Row-major (J,3) joint axes in the joint frames
+     * @param types (J,) joint types
+     * @param count Number of joints J
+     * @param tool_transform Row-major (4,4) end-effector transform in the last joint frame, or null
+     */
+    Chain(const double* origins, const double* axes, const int32_t* types, size_t count, const double* tool_transform = nullptr) {
+        joints.resize(count);
+        for (size_t j = 0; j < count; ++j) {
+            if (types[j] < REVOLUTE || types[j] > FIXED)
+                throw std::invalid_argument("Joint " + std::to_string(j) + " has unknown type " + std::to_string(types[j]) + ".");
+            joints[j].origin = ConstMatrix4Map(origins + 16 * j);
+            joints[j].axis = Vec3(axes[3 * j], axes[3 * j + 1], axes[3 * j + 2]);
+            joints[j].type = static_cast<JointType>(types[j]);
+            if (joints[j].type != FIXED && !(joints[j].axis.norm() > 0))
+                throw std::invalid_argument("Joint " + std::to_string(j) + " has a zero axis.");
+            joints[j].axis.normalize();
+        }
+        if (tool_transform)
+            tool = ConstMatrix4Map(tool_transform);
+        update_dofs();
+        if (dofs_ > MAX_DOFS)
+            throw std::invalid_argument("Chains with more than " + std::to_string(MAX_DOFS) + " moving joints are not supported.");
+    }
+
+    /**
+     * Chain from Denavit-Hartenberg parameters, frame j = Rz(theta_j + q) Tz(d_j) Tx(a_j) Rx(alpha_j)
+     * For prismatic joints the joint value is added to d instead of theta.
+     */
+    static Chain from_dh(const double* a, const double* alpha, const double* d, const double* theta, const int32_t* types, size_t count) {
+        Chain chain;
+        chain.joints.resize(count);
+        Matrix4 previous = Matrix4::Identity();
+        for (size_t j = 0; j < count; ++j) {
+            if (types[j] != REVOLUTE && types[j] != PRISMATIC)
+                throw std::invalid_argument("DH joint " + std::to_string(j) + " must be revolute or prismatic.");
+            // Motion about z comes first, so the constant part of frame j becomes the origin of joint j + 1
+            Eigen::Affine3d constant = Eigen::AngleAxisd(theta[j], Vec3::UnitZ()) * Eigen::Translation3d(a[j], 0, d[j]) * Eigen::AngleAxisd(alpha[j], Vec3::UnitX());
+            chain.joints[j].origin = previous;
+            chain.joints[j].axis = Vec3::UnitZ();
+            chain.joints[j].type = static_cast<JointType>(types[j]);
+            previous = constant.matrix();
+        }
+        chain.tool = previous;
+        chain.update_dofs();
+        if (chain.dofs_ > MAX_DOFS)
+            throw std::invalid_argument("Chains with more than " + std::to_string(MAX_DOFS) + " joints are not supported.");
+        return chain;
+    }
+
+    size_t size() const { return joints.size(); }
+
+    /**
+     * @return Number of joint values, the number of non-fixed joints
+     */
+    size_t dofs() const { return dofs_; }
+
+    /**
+     * Motion of a joint for a joint value
+     */
+    Matrix4 motion(size_t j, double q) const {
+        Matrix4 m = Matrix4::Identity();
+        if (joints[j].type == REVOLUTE)
+            m.topLeftCorner<3, 3>() = Eigen::AngleAxisd(q, joints[j].axis).toRotationMatrix();
+        else if (joints[j].type == PRISMATIC)
+            m.topRightCorner<3, 1>() = q * joints[j].axis;
+        return m;
+    }
+
+    /**
+     * Frames of all joints and of the end effector for one configuration
+     * @param q dofs() joint values
+     * @param frames Output row-major (J+1,4,4) frames: joint j after its motion, then the end effector
+     */
+    void forward(const double* q, double* frames) const {
+        Matrix4 current = Matrix4::Identity(), joint;
+        size_t k = 0;
+        for (size_t j = 0; j < joints.size(); ++j) {
+            multiply_transform(current.data(), joints[j].origin.data(), joint.data());
+            if (joints[j].type == FIXED) {
+                current = joint;
+            } else {
+                Matrix4 m = motion(j, q[k++]);
+                multiply_transform(joint.data(), m.data(), current.data());
+            }
+            std::copy(current.data(), current.data() + 16, frames + 16 * j);
+        }
+        multiply_transform(current.data(), tool.data(), frames + 16 * joints.size());
+    }
+
+    /**
+     * End-effector frame for one configuration
+     */
+    Matrix4 end_effector(const double* q) const {
+        Matrix4 current = Matrix4::Identity(), next;
+        size_t k = 0;
+        for (size_t j = 0; j < joints.size(); ++j) {
+            multiply_transform(current.data(), joints[j].origin.data(), next.data());
+            if (joints[j].type != FIXED) {
+                Matrix4 m = motion(j, q[k++]);
+                multiply_transform(next.data(), m.data(), current.data());
+            } else {
+                current = next;
+            }
+        }
+        multiply_transform(current.data(), tool.data(), next.data());
+        return next;
+    }
+
+    /**
+     * Set the limits of the non-fixed joints
+     * @param lower dofs() lower limits
+     * @param upper dofs() upper limits
+     */
+    void set_limits(const double* lower, const double* upper) {
+        // Every pair is checked before any joint changes, so a bad one leaves the chain as it was
+        for (size_t j = 0, k = 0; j < joints.size(); ++j)
+            if (joints[j].type != FIXED && lower[k] > upper[k++])
+                throw std::invalid_argument("Joint " + std::to_string(j) + " has a lower limit above its upper limit.");
+        for (size_t j = 0, k = 0; j < joints.size(); ++j) {
+            if (joints[j].type == FIXED)
+                continue;
+            joints[j].lower = lower[k];
+            joints[j].upper = upper[k];
+            ++k;
+        }
+    }
+
+    /**
+     * Clamp joint values to the joint limits
+     */
+    void clamp(double* q) const {
+        size_t k = 0;
+        for (const Joint& joint : joints)
+            if (joint.type != FIXED) {
+                q[k] = std::clamp(q[k], joint.lower, joint.upper);
+                ++k;
+            }
+    }
+
+    /**
+     * End-effector frame and geometric Jacobian for one configuration
+     * Columns map joint velocities to the linear velocity of the end effector (rows 0-2) and
+     * its angular velocity (rows 3-5), both in the base frame.
+     * @param q dofs() joint values
+     * @param jacobian Output 6 x dofs() Jacobian
+     * @return End-effector frame
+     */
+    Matrix4 jacobian(const double* q, Jacobian& jacobian) const {
+        jacobian.resize(6, static_cast<Eigen::Index>(dofs_));
+        Vec3 axes[MAX_DOFS], origins[MAX_DOFS];
+        Matrix4 current = Matrix4::Identity(), next;
+        size_t k = 0;
+        for (size_t j = 0; j < joints.size(); ++j) {
+            multiply_transform(current.data(), joints[j].origin.data(), next.data());
+            if (joints[j].type == FIXED) {
+                current = next;
+                continue;
+            }
+            axes[k] = next.topLeftCorner<3, 3>() * joints[j].axis;
+            origins[k] = next.topRightCorner<3, 1>();
+            Matrix4 m = motion(j, q[k++]);
+            multiply_transform(next.data(), m.data(), current.data());
+        }
+        multiply_transform(current.data(), tool.data(), next.data());
+
+        Vec3 p = next.topRightCorner<3, 1>();
+        k = 0;
+        for (const Joint& joint : joints) {
+            if (joint.type == FIXED)
+                continue;
+            if (joint.type == REVOLUTE) {
+                jacobian.col(k).head<3>() = axes[k].cross(p - origins[k]);
+                jacobian.col(k).tail<3>() = axes[k];
+            } else {
+                jacobian.col(k).head<3>() = axes[k];
+                jacobian.col(k).tail<3>().setZero();
+            }
+            ++k;
+        }
+        return next;
+    }
+
+private:
+    void update_dofs() {
+        dofs_ = 0;
+        for (const Joint& joint : joints)
+            dofs_ += joint.type != FIXED;
+    }
+
+    size_t dofs_ = 0;
+};
+
+/**
+ * Forward kinematics of many configurations in parallel
+ * @param chain Kinematic chain
+ * @param q Row-major (N,dofs) joint values
+ * @param n Number of configurations N
+ * @param out Row-major (N,4,4) end-effector frames, or (N,J+1,4,4) frames if all_frames is set
+ * @param all_frames Output every joint frame followed by the end effector
+ */
+inline void forward_kinematics(const Chain& chain, const double* q, size_t n, double* out, bool all_frames) {
+    size_t dofs = chain.dofs(), frames = chain.size() + 1;
+    parallel_for(n, 1024, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (all_frames) {
+                chain.forward(q + i * dofs, out + 16 * frames * i);
+            } else {
+                Matrix4 frame = chain.end_effector(q + i * dofs);
+                std::copy(frame.data(), frame.data() + 16, out + 16 * i);
+            }
+        }
+    });
+}
+
+struct IKOptions {
+    int max_iterations = 100;
+    double position_tolerance = 1e-6;
+    double orientation_tolerance = 1e-6;  // radians
+    double orientation_weight = 1.0;      // 0 solves for the position only
+    double damping = 1e-3;                // initial Levenberg-Marquardt damping
+};
+
+/**
+ * Outcome of one IK solve
+ */
+struct IKStatus {
+    bool success = false;
+    int iterations = 0;
+    double position_error = 0.0;
+    double orientation_error = 0.0;
+};
+
+/**
+ * Pose error between a frame and a target, linear then angular, in the base frame
+ */
+inline Eigen::Matrix<double, 6, 1> pose_error(const Matrix4& frame, const Matrix4& target) {
+    Eigen::Matrix<double, 6, 1> error;
+    error.head<3>() = target.topRightCorner<3, 1>() - frame.topRightCorner<3, 1>();
+    Eigen::AngleAxisd rotation(Eigen::Matrix3d(target.topLeftCorner<3, 3>() * frame.topLeftCorner<3, 3>().transpose()));
+    error.tail<3>() = rotation.angle() * rotation.axis();
+    return error;
+}
+
+/**
+ * Damped least-squares inverse kinematics with adaptive damping (Levenberg-Marquardt)
+ * Each step solves the 6x6 system (J W J^T + lambda I) y = e and moves by dq = W J^T y, where W
+ * weighs angular rows by the orientation weight. Steps that do not reduce the error are rejected
+ * and the damping is increased; accepted steps decrease it. Joint values are kept within limits.
+ * @param chain Kinematic chain
+ * @param target Target end-effector frame
+ * @param q dofs() joint values, the seed on input and the solution on output
+ * @param options Tolerances and iteration limit
+ */
+inline IKStatus inverse_kinematics(const Chain& chain, const Matrix4& target, double* q, const IKOptions& options) {
+    using Vector6 = Eigen::Matrix<double, 6, 1>;
+    using Matrix6 = Eigen::Matrix<double, 6, 6>;
+    const Eigen::Index dofs = static_cast<Eigen::Index>(chain.dofs());
+    Vector6 weights;
+    weights << 1, 1, 1, options.orientation_weight, options.orientation_weight, options.orientation_weight;
+
+    Eigen::Map<JointVector> current(q, dofs);
+    chain.clamp(q);
+    Jacobian jacobian;
+    Vector6 error = pose_error(chain.jacobian(q, jacobian), target);
+    double cost = error.cwiseProduct(weights).squaredNorm();
+    double damping = options.damping;
+
+    IKStatus status;
+    auto converged = [&](const Vector6& e) {
+        return e.head<3>().norm() <= options.position_tolerance && (options.orientation_weight == 0 || e.tail<3>().norm() <= options.orientation_tolerance);
+    };
+    JointVector candidate(dofs);
+    Jacobian candidate_jacobian;
+    while (!converged(error) && status.iterations < options.max_iterations) {
+        ++status.iterations;
+        Eigen::Matrix<double, 6, Eigen::Dynamic, Eigen::ColMajor, 6, MAX_DOFS> weighted = weights.asDiagonal() * jacobian;
+        Matrix6 system = weighted * weighted.transpose();
+        system.diagonal().array() += damping;
+        candidate = current + weighted.transpose() * system.ldlt().solve(weights.cwiseProduct(error));
+        chain.clamp(candidate.data());
+
+        Vector6 candidate_error = pose_error(chain.jacobian(candidate.data(), candidate_jacobian), target);
+        double candidate_cost = candidate_error.cwiseProduct(weights).squaredNorm();
+        if (candidate_cost < cost) {
+            current = candidate;
+            jacobian = candidate_jacobian;
+            error = candidate_error;
+            cost = candidate_cost;
+            damping = std::max(damping * 0.5, 1e-12);
+        } else {
+            damping *= 4.0;
+            if (damping > 1e12)
+                break;
+        }
+    }
+    status.success = converged(error);
+    status.position_error = error.head<3>().norm();
+    status.orientation_error = error.tail<3>().norm();
+    return status;
+}
+
+/**
+ * Inverse kinematics of many targets in parallel
+ * @param chain Kinematic chain
+ * @param targets Row-major (N,4,4) target frames
+ * @param n Number of targets N
+ * @param q Row-major (N,dofs) joint values, seeds on input and solutions on output
+ * @param status Output (N,) solve statistics
+ * @param options Tolerances and iteration limit
+ */
+inline void inverse_kinematics(const Chain& chain, const double* targets, size_t n, double* q, IKStatus* status, const IKOptions& options) {
+    size_t dofs = chain.dofs();
+    parallel_for(n, 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            status[i] = inverse_kinematics(chain, ConstMatrix4Map(targets + 16 * i), q + i * dofs, options);
+    });
+}
+
+} // namespace compas
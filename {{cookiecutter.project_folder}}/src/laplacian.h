@@ -0,0 +1,66 @@
+// laplacian.h - Discrete Laplace-Beltrami operators on triangle meshes
+#pragma once
+
+#include "mesh.h"
+
+#include <Eigen/Sparse>
+#include <cstdint>
+#include <vector>
+
+namespace compas {
+
+using SparseMatrix = Eigen::SparseMatrix<double>;
+
+/**
+ * Cotangent of the angle at corner c between the edges to a and b, 0 for degenerate corners
+ */
+inline double cotangent(const Vec3& c, const Vec3& a, const Vec3& b) {
+    Vec3 u = a - c, v = b - c;
+    double sine = u.cross(v).norm();
+    return sine > 0.0 ? u.dot(v) / sine : 0.0;
+}
+
+/**
+ * Cotangent Laplacian (Pinkall and Polthier 1993)
+ * L_ij = -(cot alpha_ij + cot beta_ij) / 2 for every edge and L_ii = -sum_j L_ij, so L is
+ * symmetric positive semi-definite and u^T L u / 2 is the Dirichlet energy of the piecewise
+ * linear function u. Obtuse angles give negative weights.
+ * @param mesh Triangle mesh
+ * @return (V,V) matrix
+ */
+inline SparseMatrix cotangent_laplacian(const MeshView& mesh) {
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(12 * mesh.face_count);
+    for (size_t f = 0; f < mesh.face_count; ++f) {
+        const int32_t* face = mesh.faces + 3 * f;
+        for (int k = 0; k < 3; ++k) {
+            int32_t i = face[(k + 1) % 3], j = face[(k + 2) % 3];
+            double w = 0.5 * cotangent(mesh.vertex(face[k]), mesh.vertex(i), mesh.vertex(j));
+            triplets.emplace_back(i, j, -w);
+            triplets.emplace_back(j, i, -w);
+            triplets.emplace_back(i, i, w);
+            triplets.emplace_back(j, j, w);
+        }
+    }
+    SparseMatrix L(mesh.vertex_count, mesh.vertex_count);
+    L.setFromTriplets(triplets.begin(), triplets.end());
+    return L;
+}
+
+/**
+ * Lumped (barycentric) mass matrix: a third of the area of every incident face per vertex
+ * @param mesh Triangle mesh
+ * @return (V,) vertex areas
+ */
+inline std::vector<double> vertex_areas(const MeshView& mesh) {
+    std::vector<double> areas(mesh.vertex_count, 0.0);
+    for (size_t f = 0; f < mesh.face_count; ++f) {
+        Vec3 a = mesh.corner(f, 0);
+        double area = (mesh.corner(f, 1) - a).cross(mesh.corner(f, 2) - a).norm() / 6.0;
+        for (int k = 0; k < 3; ++k)
+            areas[mesh.faces[3 * f + k]] += area;
+    }
+    return areas;
+}
+
+} // namespace compas
@@ -0,0 +1,174 @@
+// marching.h - Marching cubes case table
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Cube corner c sits at (c & 1, c >> 1 & 1, c >> 2 & 1); edge e joins corners[e][0] and
+ * corners[e][1], which differ along axis[e].
+ */
+struct CubeEdges {
+    std::array<std::array<uint8_t, 2>, 12> corners;
+    std::array<uint8_t, 12> axis;
+};
+
+inline const CubeEdges& cube_edges() {
+    static const CubeEdges edges = [] {
+        CubeEdges e{};
+        int n = 0;
+        for (uint8_t a = 0; a < 3; ++a)
+            for (uint8_t c = 0; c < 8; ++c)
+                if (!(c >> a & 1)) {
+                    e.corners[n] = {c, static_cast<uint8_t>(c | 1 << a)};
+                    e.axis[n++] = a;
+                }
+        return e;
+    }();
+    return edges;
+}
+
+using MarchingCubesCase = std::vector<std::array<uint8_t, 3>>;
+
+/**
+ * @return Whether cube edges a and b lie on a common face
+ */
+inline bool on_common_face(int a, int b) {
+    const CubeEdges& edges = cube_edges();
+    for (int axis = 0; axis < 3; ++axis)
+        if (axis != edges.axis[a] && axis != edges.axis[b] && (edges.corners[a][0] >> axis & 1) == (edges.corners[b][0] >> axis & 1))
+            return true;
+    return false;
+}
+
+/**
+ * Triangulate a loop of cube edges with as few diagonals on cube faces as possible
+ * Minimum weight polygon triangulation, weighing a diagonal 1 if it lies on a face; loops have at
+ * most 12 edges, so the cubic search is cheap and runs only while the table is built.
+ */
+inline void triangulate_loop(const std::vector<int>& loop, MarchingCubesCase& triangles) {
+    const int n = static_cast<int>(loop.size());
+    std::vector<int> cost(n * n, 0), apex(n * n, -1);
+    auto weight = [&](int i, int j) { return j - i > 1 && !(i == 0 && j == n - 1) && on_common_face(loop[i], loop[j]) ? 1 : 0; };
+    for (int length = 2; length < n; ++length)
+        for (int i = 0; i + length < n; ++i) {
+            int j = i + length;
+            cost[i * n + j] = n * n;
+            for (int k = i + 1; k < j; ++k) {
+                int c = cost[i * n + k] + cost[k * n + j] + weight(i, k) + weight(k, j);
+                if (c < cost[i * n + j]) {
+                    cost[i * n + j] = c;
+                    apex[i * n + j] = k;
+                }
+            }
+        }
+    std::vector<std::array<int, 2>> stack = {{0, n - 1}};
+    while (!stack.empty()) {
+        auto [i, j] = stack.back();
+        stack.pop_back();
+        if (j - i < 2)
+            continue;
+        int k = apex[i * n + j];
+        triangles.push_back({uint8_t(loop[i]), uint8_t(loop[j]), uint8_t(loop[k])});
+        stack.push_back({i, k});
+        stack.push_back({k, j});
+    }
+}
+
+/**
+ * Triangles of cube edges for each of the 256 sign patterns, bit c set if corner c is inside
+ * The table is derived rather than transcribed: the contour on every cube face follows marching
+ * squares, and on faces with alternating signs each inside corner is cut off on its own. Two cubes
+ * sharing a face see the same corners and cut it the same way, so the surface is watertight.
+ * The face segments are chained into loops and triangulated with normals pointing from the
+ * inside to the outside corners. No diagonal may join two crossings on the same cube face: that
+ * face may be cut the same way by the neighbouring cube, and the diagonal would then be shared by
+ * four triangles. Every loop of the table has such a triangulation.
+ */
+inline const std::array<MarchingCubesCase, 256>& marching_cubes_table() {
+    static const std::array<MarchingCubesCase, 256> table = [] {
+        const CubeEdges& edges = cube_edges();
+        auto edge_of = [&](int a, int b) {
+            for (int e = 0; e < 12; ++e)
+                if ((edges.corners[e][0] == a && edges.corners[e][1] == b) || (edges.corners[e][0] == b && edges.corners[e][1] == a))
+                    return e;
+            return -1;
+        };
+        auto position = [](int c, int axis) { return double(c >> axis & 1); };
+
+        std::array<MarchingCubesCase, 256> cases;
+        for (int inside = 1; inside < 255; ++inside) {
+            std::array<int, 12> next;
+            next.fill(-1);
+            for (int a = 0; a < 3; ++a)
+                for (int side = 0; side < 2; ++side) {
+                    // Face corners counter-clockwise around the outward normal
+                    int u = (a + 1) % 3, v = (a + 2) % 3;
+                    std::array<int, 4> q;
+                    std::array<std::array<int, 2>, 4> uv = {{{0, 0}, {1, 0}, {1, 1}, {0, 1}}};
+                    for (int m = 0; m < 4; ++m)
+                        q[side ? m : 3 - m] = side << a | uv[m][0] << u | uv[m][1] << v;
+                    auto in = [&](int m) { return (inside >> q[(m + 4) % 4] & 1) != 0; };
+
+                    // Segments cut off each inside corner, or join the two crossings of the face
+                    std::vector<std::array<int, 3>> segments;  // edge, edge, an inside corner
+                    int crossings = 0;
+                    for (int m = 0; m < 4; ++m)
+                        crossings += in(m) != in(m + 1);
+                    if (crossings == 4) {
+                        for (int m = 0; m < 4; ++m)
+                            if (in(m))
+                                segments.push_back({edge_of(q[(m + 3) % 4], q[m]), edge_of(q[m], q[(m + 1) % 4]), q[m]});
+                    } else if (crossings == 2) {
+                        std::array<int, 2> cut;
+                        int k = 0, corner = -1;
+                        for (int m = 0; m < 4; ++m) {
+                            if (in(m) != in(m + 1))
+                                cut[k++] = edge_of(q[m], q[(m + 1) % 4]);
+                            if (in(m))
+                                corner = q[m];
+                        }
+                        segments.push_back({cut[0], cut[1], corner});
+                    }
+
+                    // Direct each segment so that, seen from outside the cube, the inside corner is on the left
+                    for (auto [e0, e1, corner] : segments) {
+                        double p0[3], p1[3], d[3], r[3], n[3] = {0.0, 0.0, 0.0};
+                        n[a] = side ? 1.0 : -1.0;
+                        for (int i = 0; i < 3; ++i) {
+                            p0[i] = 0.5 * (position(edges.corners[e0][0], i) + position(edges.corners[e0][1], i));
+                            p1[i] = 0.5 * (position(edges.corners[e1][0], i) + position(edges.corners[e1][1], i));
+                            d[i] = p1[i] - p0[i];
+                            r[i] = position(corner, i) - p0[i];
+                        }
+                        double left = (n[1] * d[2] - n[2] * d[1]) * r[0] + (n[2] * d[0] - n[0] * d[2]) * r[1] + (n[0] * d[1] - n[1] * d[0]) * r[2];
+                        if (left > 0.0)
+                            next[e0] = e1;
+                        else
+                            next[e1] = e0;
+                    }
+                }
+
+            // Chain the segments into loops and triangulate each loop
+            std::array<bool, 12> used{};
+            for (int start = 0; start < 12; ++start) {
+                if (next[start] < 0 || used[start])
+                    continue;
+                std::vector<int> loop;
+                for (int e = start; !used[e]; e = next[e]) {
+                    used[e] = true;
+                    loop.push_back(e);
+                }
+                triangulate_loop(loop, cases[inside]);
+            }
+        }
+        return cases;
+    }();
+    return table;
+}
+
+} // namespace compas
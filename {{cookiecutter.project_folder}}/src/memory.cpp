@@ -0,0 +1,56 @@
+#include "compas.h"
+#include "arrays.h"
+#include "memory.h"
+
+#include <nanobind/stl/optional.h>
+#include <algorithm>
+#include <optional>
+
+using namespace compas;
+
+/**
+ * Memory statistics as a dict mapping each tag, and "total", to its counters
+ * @return Live and peak bytes, and the live and total number of allocations
+ */
+nb::dict memory_stats() {
+    const MemoryLedger& ledger = memory_ledger();
+    auto entry = [](const MemoryCounters& counters) {
+        nb::dict result;
+        size_t allocations = counters.allocations.load(), frees = counters.frees.load();
+        result["live"] = counters.live.load();
+        result["peak"] = counters.peak.load();
+        result["count"] = allocations - std::min(frees, allocations);
+        result["allocations"] = allocations;
+        return result;
+    };
+    nb::dict result;
+    for (size_t k = 0; k < MEMORY_TAG_COUNT; ++k)
+        result[memory_tag_name(static_cast<MemoryTag>(k))] = entry(ledger.tags[k]);
+    result["total"] = entry(ledger.total);
+    return result;
+}
+
+/**
+ * Set or clear the soft limit on the bytes held by all tags together
+ * @param limit Limit in bytes, or None for no limit
+ */
+void set_memory_limit(std::optional<size_t> limit) {
+    if (limit && *limit == 0)
+        throw std::invalid_argument("The memory limit must be positive, or None for no limit.");
+    memory_ledger().limit = limit.value_or(0);
+}
+
+std::optional<size_t> memory_limit() {
+    size_t limit = memory_ledger().limit.load();
+    return limit ? std::optional<size_t>(limit) : std::nullopt;
+}
+
+NB_MODULE(_memory, m) {
+    m.doc() = "Accounting of the memory held by the native extensions.";
+    share_memory_ledger();
+
+    m.def("memory_stats", &memory_stats, "Live and peak bytes and allocation counts per subsystem");
+    m.def("reset_memory_peaks", &reset_memory_peaks, "Restart the peaks from the live bytes");
+    m.def("set_memory_limit", &set_memory_limit, "limit"_a.none(), "Set or clear the soft limit on the bytes held by all subsystems");
+    m.def("memory_limit", &memory_limit, "Soft limit in bytes, or None");
+}
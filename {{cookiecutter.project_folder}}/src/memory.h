@@ -0,0 +1,160 @@
+// memory.h - Accounting of native allocations by subsystem
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace compas {
+
+enum class MemoryTag : uint8_t { ARRAYS, ARENA, POOL, ATTRIBUTES };
+
+constexpr size_t MEMORY_TAG_COUNT = 4;
+
+inline const char* memory_tag_name(MemoryTag tag) {
+    static const char* names[MEMORY_TAG_COUNT] = {"arrays", "arena", "pool", "attributes"};
+    return names[static_cast<size_t>(tag)];
+}
+
+struct MemoryCounters {
+    std::atomic<size_t> live{0};         // bytes currently held
+    std::atomic<size_t> peak{0};         // most bytes held at once since the last reset
+    std::atomic<size_t> allocations{0};  // allocations made
+    std::atomic<size_t> frees{0};        // allocations returned
+};
+
+/**
+ * Counters per tag, their sum and the soft limit on the sum, 0 for none
+ * All members are trivially destructible, so a ledger stays usable during static destruction.
+ */
+struct MemoryLedger {
+    std::array<MemoryCounters, MEMORY_TAG_COUNT> tags;
+    MemoryCounters total;
+    std::atomic<size_t> limit{0};
+};
+
+/**
+ * Ledger used by this library, its own one unless redirected to one shared with other libraries
+ */
+inline std::atomic<MemoryLedger*>& memory_ledger_slot() {
+    static MemoryLedger local;
+    static std::atomic<MemoryLedger*> slot{&local};
+    return slot;
+}
+
+inline MemoryLedger& memory_ledger() { return *memory_ledger_slot().load(std::memory_order_acquire); }
+
+/**
+ * Thrown instead of allocating past the soft limit; a std::bad_alloc, so Python sees a MemoryError
+ */
+class MemoryLimitError : public std::bad_alloc {
+public:
+    MemoryLimitError(MemoryTag tag, size_t bytes, size_t limit)
+        : message_("Allocating " + std::to_string(bytes) + " bytes for " + memory_tag_name(tag) + " would exceed the memory limit of " +
+                   std::to_string(limit) + " bytes.") {}
+
+    const char* what() const noexcept override { return message_.c_str(); }
+
+private:
+    std::string message_;
+};
+
+inline void raise_peak(std::atomic<size_t>& peak, size_t value) {
+    for (size_t seen = peak.load(std::memory_order_relaxed); value > seen && !peak.compare_exchange_weak(seen, value);) {
+    }
+}
+
+/**
+ * Record an allocation, called before the memory is obtained
+ * @param tag Subsystem that owns the memory
+ * @param bytes Size of the allocation
+ * @param enforce Whether the soft limit applies; off for allocations that replace memory just released
+ * @throws MemoryLimitError if the limit is set and would be exceeded
+ */
+inline void track_allocation(MemoryTag tag, size_t bytes, bool enforce = true) {
+    MemoryLedger& ledger = memory_ledger();
+    size_t live = ledger.total.live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t limit = ledger.limit.load(std::memory_order_relaxed);
+    if (enforce && limit && live > limit) {
+        ledger.total.live.fetch_sub(bytes, std::memory_order_relaxed);
+        throw MemoryLimitError(tag, bytes, limit);
+    }
+    raise_peak(ledger.total.peak, live);
+    ledger.total.allocations.fetch_add(1, std::memory_order_relaxed);
+    MemoryCounters& counters = ledger.tags[static_cast<size_t>(tag)];
+    raise_peak(counters.peak, counters.live.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Record that memory recorded by track_allocation() was returned
+ */
+inline void track_release(MemoryTag tag, size_t bytes) noexcept {
+    MemoryLedger& ledger = memory_ledger();
+    MemoryCounters& counters = ledger.tags[static_cast<size_t>(tag)];
+    counters.live.fetch_sub(bytes, std::memory_order_relaxed);
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+    ledger.total.live.fetch_sub(bytes, std::memory_order_relaxed);
+    ledger.total.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Restart the peaks of all tags from their live bytes
+ */
+inline void reset_memory_peaks() {
+    MemoryLedger& ledger = memory_ledger();
+    for (MemoryCounters& counters : ledger.tags)
+        counters.peak = counters.live.load();
+    ledger.total.peak = ledger.total.live.load();
+}
+
+/**
+ * Standard allocator that records its allocations under a tag, for containers that hold long-lived data
+ */
+template <class T, MemoryTag Tag>
+struct TrackedAllocator {
+    using value_type = T;
+
+    template <class U>
+    struct rebind {
+        using other = TrackedAllocator<U, Tag>;
+    };
+
+    TrackedAllocator() noexcept = default;
+    template <class U>
+    TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(size_t n) {
+        track_allocation(Tag, n * sizeof(T));
+        try {
+            return std::allocator<T>().allocate(n);
+        } catch (...) {
+            track_release(Tag, n * sizeof(T));
+            throw;
+        }
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        std::allocator<T>().deallocate(p, n);
+        track_release(Tag, n * sizeof(T));
+    }
+
+    template <class U>
+    bool operator==(const TrackedAllocator<U, Tag>&) const noexcept {
+        return true;
+    }
+};
+
+/**
+ * Vector for kernel results handed to Python, accounted under MemoryTag::ARRAYS as it grows
+ * to_ndarray() adopts it as is, so the limit is checked before each allocation, not afterwards.
+ */
+template <class T>
+using ArrayBuffer = std::vector<T, TrackedAllocator<T, MemoryTag::ARRAYS>>;
+
+} // namespace compas
@@ -0,0 +1,76 @@
+// mesh.h - Non-owning view of a triangle mesh given as vertex and face arrays
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace compas {
+
+using Vec3 = Eigen::Vector3d;
+using Box3 = Eigen::AlignedBox3d;
+
+/**
+ * Triangle mesh borrowed from caller-owned buffers
+ * vertices is a row-major (V,3) double array, faces a row-major (F,3) int32 array.
+ */
+struct MeshView {
+    const double* vertices = nullptr;
+    size_t vertex_count = 0;
+    const int32_t* faces = nullptr;
+    size_t face_count = 0;
+
+    /**
+     * @param i Vertex index
+     * @return Position of vertex i
+     */
+    Eigen::Map<const Vec3> vertex(size_t i) const {
+        return Eigen::Map<const Vec3>(vertices + 3 * i);
+    }
+
+    /**
+     * @param f Face index
+     * @param k Corner index in [0, 3)
+     * @return Position of corner k of face f
+     */
+    Vec3 corner(size_t f, int k) const {
+        return vertex(static_cast<size_t>(faces[3 * f + k]));
+    }
+
+    /**
+     * @param f Face index
+     * @return Axis-aligned bounding box of face f
+     */
+    Box3 face_box(size_t f) const {
+        Box3 box(corner(f, 0));
+        box.extend(corner(f, 1));
+        box.extend(corner(f, 2));
+        return box;
+    }
+
+    /**
+     * @return Axis-aligned bounding box of all vertices referenced by faces
+     */
+    Box3 bounds() const {
+        Box3 box;
+        for (size_t f = 0; f < face_count; ++f)
+            box.extend(face_box(f));
+        return box;
+    }
+
+    /**
+     * Check that every face references an existing vertex
+     * @throws std::out_of_range if a face index is negative or too large
+     */
+    void validate() const {
+        for (size_t i = 0; i < 3 * face_count; ++i) {
+            if (faces[i] < 0 || static_cast<size_t>(faces[i]) >= vertex_count)
+                throw std::out_of_range("Face " + std::to_string(i / 3) + " references missing vertex " + std::to_string(faces[i]));
+        }
+    }
+};
+
+} // namespace compas
@@ -0,0 +1,160 @@
+// normals.h - Normal and curvature estimation for point clouds
+#pragma once
+
+#include "arena.h"
+#include "kdtree.h"
+#include "parallel.h"
+
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace compas {
+
+/**
+ * k nearest neighbours of every point of a cloud
+ * @param tree Tree built over the cloud
+ * @param k Neighbours per point, the point itself included
+ * @return Row-major (N,k) neighbour indices; rows of clouds smaller than k are padded with the point itself
+ */
+inline std::vector<uint32_t> knn_graph(const KDTree& tree, size_t k) {
+    size_t n = tree.size();
+    std::vector<uint32_t> neighbors(n * k);
+    parallel_for(n, 512, [&](size_t begin, size_t end) {
+        Scratch scratch;
+        std::span<double> distances = scratch.array<double>(k);
+        for (size_t t = begin; t < end; ++t) {
+            uint32_t i = tree.indices[t];
+            uint32_t* row = neighbors.data() + size_t(i) * k;
+            size_t found = tree.knn(tree.points[t], k, row, distances.data());
+            std::fill(row + found, row + k, i);
+        }
+    });
+    return neighbors;
+}
+
+/**
+ * Normal and surface variation of each point from PCA of its neighbourhood
+ * The normal is the eigenvector of the smallest covariance eigenvalue, the curvature the
+ * surface variation lambda_0 / (lambda_0 + lambda_1 + lambda_2), which is 0 on planes and 1/3 for isotropic noise.
+ * @param points Row-major (N,3) coordinates
+ * @param neighbors Row-major (N,k) neighbour indices
+ * @param n Number of points N
+ * @param k Neighbours per point
+ * @param normals Output row-major (N,3) unit normals, unoriented
+ * @param curvature Output (N,) surface variation
+ */
+inline void pca_normals(const double* points, const uint32_t* neighbors, size_t n, size_t k, double* normals, double* curvature) {
+    parallel_for(n, 512, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t* row = neighbors + i * k;
+            Vec3 mean = Vec3::Zero();
+            for (size_t j = 0; j < k; ++j)
+                mean += Eigen::Map<const Vec3>(points + 3 * size_t(row[j]));
+            mean /= double(k);
+            Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+            for (size_t j = 0; j < k; ++j) {
+                Vec3 d = Eigen::Map<const Vec3>(points + 3 * size_t(row[j])) - mean;
+                covariance.noalias() += d * d.transpose();
+            }
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+            solver.computeDirect(covariance);
+            Vec3 normal = solver.eigenvectors().col(0);
+            Vec3 values = solver.eigenvalues().cwiseMax(0.0);
+            double total = values.sum();
+            Eigen::Map<Vec3>(normals + 3 * i) = normal.normalized();
+            if (curvature)
+                curvature[i] = total > 0 ? values[0] / total : 0.0;
+        }
+    });
+}
+
+/**
+ * Flip normals to face a viewpoint
+ */
+inline void orient_towards(const double* points, size_t n, const Vec3& viewpoint, double* normals) {
+    parallel_for(n, 4096, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Eigen::Map<Vec3> normal(normals + 3 * i);
+            if (normal.dot(viewpoint - Eigen::Map<const Vec3>(points + 3 * i)) < 0)
+                normal = -normal;
+        }
+    });
+}
+
+/**
+ * Consistently orient normals by propagation along a minimum spanning tree (Hoppe et al. 1992)
+ * Edges of the symmetrized kNN graph are weighted by 1 - |n_i . n_j| so propagation prefers
+ * nearly parallel neighbours. Each connected component is seeded at its highest point, whose
+ * normal is made to point up.
+ * @param points Row-major (N,3) coordinates
+ * @param neighbors Row-major (N,k) neighbour indices
+ * @param n Number of points N
+ * @param k Neighbours per point
+ * @param normals Row-major (N,3) unit normals, oriented in place
+ */
+inline void orient_mst(const double* points, const uint32_t* neighbors, size_t n, size_t k, double* normals) {
+    // Symmetric adjacency in CSR form; it has up to 2nk entries, so offsets are 64-bit
+    Scratch scratch;
+    std::span<size_t> offsets = scratch.array<size_t>(n + 1, 0);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < k; ++j)
+            if (neighbors[i * k + j] != i) {
+                ++offsets[i + 1];
+                ++offsets[neighbors[i * k + j] + 1];
+            }
+    for (size_t i = 0; i < n; ++i)
+        offsets[i + 1] += offsets[i];
+    std::span<uint32_t> adjacency = scratch.array<uint32_t>(offsets[n]);
+    std::span<size_t> cursor = scratch.array<size_t>(n);
+    std::copy(offsets.begin(), offsets.end() - 1, cursor.begin());
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < k; ++j) {
+            uint32_t other = neighbors[i * k + j];
+            if (other != i) {
+                adjacency[cursor[i]++] = other;
+                adjacency[cursor[other]++] = static_cast<uint32_t>(i);
+            }
+        }
+
+    auto normal = [&](uint32_t i) { return Eigen::Map<Vec3>(normals + 3 * size_t(i)); };
+
+    // Seeds in order of decreasing height
+    std::span<uint32_t> seeds = scratch.array<uint32_t>(n);
+    std::iota(seeds.begin(), seeds.end(), 0u);
+    std::sort(seeds.begin(), seeds.end(), [&](uint32_t a, uint32_t b) { return points[3 * size_t(a) + 2] > points[3 * size_t(b) + 2]; });
+
+    std::span<uint8_t> visited = scratch.array<uint8_t>(n, 0);
+    using Edge = std::tuple<double, uint32_t, uint32_t>;  // weight, vertex, parent
+    std::priority_queue<Edge, std::vector<Edge>, std::greater<Edge>> queue;
+    for (uint32_t seed : seeds) {
+        if (visited[seed])
+            continue;
+        if (normal(seed)[2] < 0)
+            normal(seed) = -normal(seed);
+        queue.emplace(0.0, seed, seed);
+        while (!queue.empty()) {
+            auto [weight, v, parent] = queue.top();
+            queue.pop();
+            if (visited[v])
+                continue;
+            visited[v] = 1;
+            if (normal(v).dot(normal(parent)) < 0)
+                normal(v) = -normal(v);
+            for (size_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+                uint32_t w = adjacency[e];
+                if (!visited[w])
+                    queue.emplace(1.0 - std::abs(normal(v).dot(normal(w))), w, v);
+            }
+        }
+    }
+}
+
+} // namespace compas
@@ -0,0 +1,308 @@
+// nurbs.h - Batched B-spline/NURBS curve and surface evaluation
+//
+// Basis functions and their derivatives follow The NURBS Book (Piegl & Tiller), algorithms
+// A2.1 (span search), A2.3 (basis derivatives), A4.2 (rational curve derivatives).
+// Points are accumulated in homogeneous coordinates as Eigen::Vector4d so x, y, z and the
+// weight are combined in one vector operation.
+#pragma once
+
+#include "arena.h"
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace compas {
+
+using Vec4 = Eigen::Vector4d;
+
+constexpr int MAX_DEGREE = 15;
+
+/**
+ * Curve borrowed from caller-owned buffers
+ * points is a row-major (count,3) array, weights is null for non-rational curves.
+ */
+struct NurbsCurve {
+    int degree = 1;
+    const double* points = nullptr;
+    const double* weights = nullptr;
+    size_t count = 0;
+    const double* knots = nullptr;
+    size_t knot_count = 0;
+
+    Vec4 homogeneous(size_t i) const {
+        double w = weights ? weights[i] : 1.0;
+        return Vec4(points[3 * i] * w, points[3 * i + 1] * w, points[3 * i + 2] * w, w);
+    }
+
+    /**
+     * @throws std::invalid_argument if the knot vector does not match degree and control points
+     */
+    void validate() const {
+        if (degree > MAX_DEGREE)
+            throw std::invalid_argument("Degrees above " + std::to_string(MAX_DEGREE) + " are not supported.");
+        if (degree < 1 || count < static_cast<size_t>(degree) + 1)
+            throw std::invalid_argument("A curve of degree " + std::to_string(degree) + " needs at least " + std::to_string(degree + 1) + " control points.");
+        if (knot_count != count + degree + 1)
+            throw std::invalid_argument("Expected " + std::to_string(count + degree + 1) + " knots, got " + std::to_string(knot_count) + ".");
+        for (size_t i = 1; i < knot_count; ++i)
+            if (knots[i] < knots[i - 1])
+                throw std::invalid_argument("Knots must be non-decreasing.");
+    }
+};
+
+/**
+ * Knot span index containing u, clamped to the valid range [degree, count - 1]
+ */
+inline size_t find_span(const double* knots, size_t count, int degree, double u) {
+    const double* first = knots + degree;
+    const double* last = knots + count;  // knot count - degree - 1
+    if (u >= *last)
+        return count - 1;
+    if (u <= *first)
+        return static_cast<size_t>(degree);
+    return static_cast<size_t>(std::upper_bound(first, last, u) - knots) - 1;
+}
+
+/**
+ * Non-zero basis functions and their derivatives at u (A2.3)
+ * @param span Knot span of u
+ * @param u Parameter
+ * @param degree Degree p
+ * @param order Highest derivative n
+ * @param knots Knot vector
+ * @param out (n+1)x(p+1) row-major table, row k holds the k-th derivatives
+ */
+inline void basis_derivatives(size_t span, double u, int degree, int order, const double* knots, double* out) {
+    const int p = degree;
+    const int n = std::min(order, p);
+    double ndu[MAX_DEGREE + 1][MAX_DEGREE + 1], a[2][MAX_DEGREE + 1], left[MAX_DEGREE + 1], right[MAX_DEGREE + 1];
+
+    ndu[0][0] = 1.0;
+    for (int j = 1; j <= p; ++j) {
+        left[j] = u - knots[span + 1 - j];
+        right[j] = knots[span + j] - u;
+        double saved = 0.0;
+        for (int r = 0; r < j; ++r) {
+            ndu[j][r] = right[r + 1] + left[j - r];
+            double temp = ndu[r][j - 1] / ndu[j][r];
+            ndu[r][j] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        ndu[j][j] = saved;
+    }
+    for (int j = 0; j <= p; ++j)
+        out[j] = ndu[j][p];
+
+    for (int r = 0; r <= p; ++r) {
+        int s1 = 0, s2 = 1;
+        a[0][0] = 1.0;
+        for (int k = 1; k <= n; ++k) {
+            double d = 0.0;
+            int rk = r - k, pk = p - k;
+            if (r >= k) {
+                a[s2][0] = a[s1][0] / ndu[pk + 1][rk];
+                d = a[s2][0] * ndu[rk][pk];
+            }
+            int j1 = rk >= -1 ? 1 : -rk;
+            int j2 = r - 1 <= pk ? k - 1 : p - r;
+            for (int j = j1; j <= j2; ++j) {
+                a[s2][j] = (a[s1][j] - a[s1][j - 1]) / ndu[pk + 1][rk + j];
+                d += a[s2][j] * ndu[rk + j][pk];
+            }
+            if (r <= pk) {
+                a[s2][k] = -a[s1][k - 1] / ndu[pk + 1][r];
+                d += a[s2][k] * ndu[r][pk];
+            }
+            out[k * (p + 1) + r] = d;
+            std::swap(s1, s2);
+        }
+    }
+
+    double factor = p;
+    for (int k = 1; k <= n; ++k) {
+        for (int j = 0; j <= p; ++j)
+            out[k * (p + 1) + j] *= factor;
+        factor *= p - k;
+    }
+    // Derivatives above the degree vanish
+    for (int k = n + 1; k <= order; ++k)
+        std::fill(out + k * (p + 1), out + (k + 1) * (p + 1), 0.0);
+}
+
+/**
+ * Spans and basis derivatives of one knot vector at a set of parameters
+ * Evaluating several curves that share degree, knots and parameters reuses the same table.
+ */
+struct BasisTable {
+    int degree = -1;
+    int order = -1;
+    std::vector<double> knots;
+    std::vector<double> params;
+    std::vector<size_t> spans;
+    std::vector<double> values;  // per parameter: (order+1)x(degree+1)
+
+    bool matches(int p, int n, const double* u, size_t knot_count, const double* t, size_t count) const {
+        return degree == p && order == n && knots.size() == knot_count && params.size() == count &&
+               std::equal(knots.begin(), knots.end(), u) && std::equal(params.begin(), params.end(), t);
+    }
+
+    void build(int p, int n, const double* u, size_t knot_count, size_t control_count, const double* t, size_t count) {
+        degree = p;
+        order = n;
+        knots.assign(u, u + knot_count);
+        params.assign(t, t + count);
+        spans.resize(count);
+        size_t stride = size_t(n + 1) * (p + 1);
+        values.resize(count * stride);
+        for (size_t i = 0; i < count; ++i) {
+            spans[i] = find_span(u, control_count, p, t[i]);
+            basis_derivatives(spans[i], t[i], p, n, u, values.data() + i * stride);
+        }
+    }
+
+    const double* at(size_t i) const { return values.data() + i * size_t(order + 1) * (degree + 1); }
+};
+
+/**
+ * Convert homogeneous derivatives to Cartesian ones (A4.2)
+ * @param h Homogeneous derivatives 0..order
+ * @param order Highest derivative
+ * @param out (order+1)x3 row-major output
+ */
+inline void rational_derivatives(const Vec4* h, int order, double* out) {
+    Eigen::Vector3d ck[MAX_DEGREE + 1];
+    for (int k = 0; k <= order; ++k) {
+        Eigen::Vector3d v = h[k].head<3>();
+        double binomial = 1.0;
+        for (int i = 1; i <= k; ++i) {
+            binomial = binomial * (k - i + 1) / i;
+            v -= binomial * h[i][3] * ck[k - i];
+        }
+        ck[k] = v / h[0][3];
+        out[3 * k] = ck[k][0];
+        out[3 * k + 1] = ck[k][1];
+        out[3 * k + 2] = ck[k][2];
+    }
+}
+
+/**
+ * Evaluate a curve and its derivatives at many parameters
+ * @param curve Curve to evaluate
+ * @param params Parameters
+ * @param count Number of parameters
+ * @param order Highest derivative in [0, MAX_DEGREE], 0 for points only
+ * @param out count x (order+1) x 3 row-major output
+ * @param table Basis cache, rebuilt only when the curve's knots or the parameters change
+ */
+inline void evaluate_curve(const NurbsCurve& curve, const double* params, size_t count, int order, double* out, BasisTable& table) {
+    const int p = curve.degree;
+    if (!table.matches(p, order, curve.knots, curve.knot_count, params, count))
+        table.build(p, order, curve.knots, curve.knot_count, curve.count, params, count);
+
+    Vec4 h[MAX_DEGREE + 1];
+    for (size_t i = 0; i < count; ++i) {
+        const double* basis = table.at(i);
+        size_t first = table.spans[i] - p;
+        for (int k = 0; k <= order; ++k) {
+            Vec4 sum = Vec4::Zero();
+            for (int j = 0; j <= p; ++j)
+                sum += basis[k * (p + 1) + j] * curve.homogeneous(first + j);
+            h[k] = sum;
+        }
+        rational_derivatives(h, order, out + i * size_t(order + 1) * 3);
+    }
+}
+
+/**
+ * Surface borrowed from caller-owned buffers
+ * points is a row-major (count_u,count_v,3) array, weights is null for non-rational surfaces.
+ */
+struct NurbsSurface {
+    int degree_u = 1;
+    int degree_v = 1;
+    const double* points = nullptr;
+    const double* weights = nullptr;
+    size_t count_u = 0;
+    size_t count_v = 0;
+    const double* knots_u = nullptr;
+    size_t knot_count_u = 0;
+    const double* knots_v = nullptr;
+    size_t knot_count_v = 0;
+
+    Vec4 homogeneous(size_t i, size_t j) const {
+        size_t k = i * count_v + j;
+        double w = weights ? weights[k] : 1.0;
+        return Vec4(points[3 * k] * w, points[3 * k + 1] * w, points[3 * k + 2] * w, w);
+    }
+
+    void validate() const {
+        NurbsCurve{degree_u, points, nullptr, count_u, knots_u, knot_count_u}.validate();
+        NurbsCurve{degree_v, points, nullptr, count_v, knots_v, knot_count_v}.validate();
+    }
+};
+
+/**
+ * Point and first partial derivatives of a surface from precomputed basis rows
+ * @param out 3x3 row-major output: S, dS/du, dS/dv
+ */
+inline void evaluate_surface_basis(const NurbsSurface& surface, size_t span_u, const double* basis_u, size_t span_v, const double* basis_v, bool derivatives, double* out) {
+    const int p = surface.degree_u, q = surface.degree_v;
+    size_t first_u = span_u - p, first_v = span_v - q;
+    Vec4 s = Vec4::Zero(), su = Vec4::Zero(), sv = Vec4::Zero();
+    for (int i = 0; i <= p; ++i) {
+        Vec4 row = Vec4::Zero(), row_v = Vec4::Zero();
+        for (int j = 0; j <= q; ++j) {
+            Vec4 c = surface.homogeneous(first_u + i, first_v + j);
+            row += basis_v[j] * c;
+            if (derivatives)
+                row_v += basis_v[q + 1 + j] * c;
+        }
+        s += basis_u[i] * row;
+        if (derivatives) {
+            su += basis_u[p + 1 + i] * row;
+            sv += basis_u[i] * row_v;
+        }
+    }
+    Eigen::Map<Eigen::Matrix<double, 3, 3, Eigen::RowMajor>> result(out);
+    Eigen::Vector3d point = s.head<3>() / s[3];
+    result.row(0) = point;
+    if (derivatives) {
+        result.row(1) = (su.head<3>() - su[3] * point) / s[3];
+        result.row(2) = (sv.head<3>() - sv[3] * point) / s[3];
+    }
+}
+
+/**
+ * Evaluate a polyline parametrized by normalized arc length
+ * @param points Row-major (count,3) vertices
+ * @param count Number of vertices, at least 2
+ * @param params Parameters in [0, 1], clamped
+ * @param n Number of parameters
+ * @param out n x 2 x 3 row-major output: point and derivative with respect to the parameter
+ */
+inline void evaluate_polyline(const double* points, size_t count, const double* params, size_t n, double* out) {
+    using Map3 = Eigen::Map<const Eigen::Vector3d>;
+    Scratch scratch;
+    std::span<double> length = scratch.array(count, 0.0);
+    for (size_t i = 1; i < count; ++i)
+        length[i] = length[i - 1] + (Map3(points + 3 * i) - Map3(points + 3 * (i - 1))).norm();
+    double total = length.back();
+
+    for (size_t k = 0; k < n; ++k) {
+        double s = std::clamp(params[k], 0.0, 1.0) * total;
+        size_t i = std::upper_bound(length.begin() + 1, length.end() - 1, s) - length.begin();
+        Eigen::Vector3d a = Map3(points + 3 * (i - 1)), b = Map3(points + 3 * i);
+        double segment = length[i] - length[i - 1];
+        double t = segment > 0 ? (s - length[i - 1]) / segment : 0.0;
+        Eigen::Map<Eigen::Vector3d> point(out + 6 * k), derivative(out + 6 * k + 3);
+        point = a + t * (b - a);
+        derivative = segment > 0 ? Eigen::Vector3d((b - a) * (total / segment)) : Eigen::Vector3d::Zero();
+    }
+}
+
+} // namespace compas
@@ -0,0 +1,81 @@
+// parallel.h - Minimal parallel-for used by the native kernels
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Number of worker threads used by parallel_for
+ * @return Hardware concurrency, at least 1
+ */
+inline size_t thread_count() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+}
+
+/**
+ * Run fn over [0, n) in chunks of `grain` items, distributed dynamically over worker threads.
+ * fn is called as fn(begin, end) or fn(begin, end, worker) where worker < thread_count().
+ * Exceptions thrown by fn are rethrown on the calling thread.
+ * @param n Number of items
+ * @param grain Number of items per chunk
+ * @param fn Callable processing a half-open index range
+ */
+template <class F>
+void parallel_for(size_t n, size_t grain, F&& fn) {
+    grain = std::max<size_t>(grain, 1);
+    size_t chunks = (n + grain - 1) / grain;
+    size_t workers = std::min(thread_count(), chunks);
+
+    auto call = [&](size_t begin, size_t end, size_t worker) {
+        if constexpr (std::is_invocable_v<F&, size_t, size_t, size_t>)
+            fn(begin, end, worker);
+        else
+            fn(begin, end);
+    };
+
+    // Small inputs run inline, spawning threads would cost more than the work. The chunks are
+    // the same as with threads, so callers may keep per-chunk results indexed by begin / grain.
+    if (workers <= 1) {
+        for (size_t begin = 0; begin < n; begin += grain)
+            call(begin, std::min(n, begin + grain), 0);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto run = [&](size_t worker) {
+        try {
+            for (size_t chunk = next++; chunk < chunks; chunk = next++)
+                call(chunk * grain, std::min(n, (chunk + 1) * grain), worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error)
+                error = std::current_exception();
+            next = chunks;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w)
+        threads.emplace_back(run, w);
+    run(0);
+    for (auto& t : threads)
+        t.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace compas
@@ -0,0 +1,95 @@
+#include "compas.h"
+#include "arrays.h"
+#include "parameterize.h"
+
+#include <nanobind/stl/optional.h>
+#include <optional>
+
+using namespace compas;
+
+using IndicesIn = nb::ndarray<const int32_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Parse the name of a parameterization method
+ */
+ParameterizationMethod parameterization_method(const std::string& name) {
+    if (name == "lscm")
+        return ParameterizationMethod::LSCM;
+    if (name == "harmonic")
+        return ParameterizationMethod::HARMONIC;
+    throw std::invalid_argument("Unknown parameterization method '" + name + "', expected 'lscm' or 'harmonic'.");
+}
+
+/**
+ * Positions of all vertices for given positions of the fixed ones
+ * @param positions (K,2) positions of the fixed vertices, or None for the defaults
+ * @return (V,2) positions
+ */
+nb::ndarray<nb::numpy, double> solve(const Parameterization& self, std::optional<RowsIn<2>> positions) {
+    if (positions && positions->shape(0) != self.fixed().size())
+        throw std::invalid_argument("positions must have one row per fixed vertex.");
+    ArrayBuffer<double> uv(2 * self.vertex_count());
+    {
+        nb::gil_scoped_release release;
+        self.solve(positions ? positions->data() : nullptr, uv.data());
+    }
+    return to_ndarray(std::move(uv), {self.vertex_count(), 2});
+}
+
+/**
+ * Flatten many meshes in parallel with their default fixed vertices
+ * @param vertices (V,3) vertices of all meshes
+ * @param vertex_offsets (M+1,) vertex ranges per mesh
+ * @param faces (F,3) faces of all meshes, indexing the vertices of their own mesh
+ * @param face_offsets (M+1,) face ranges per mesh
+ * @param method "lscm" or "harmonic"
+ * @return (V,2) positions of all meshes
+ */
+nb::ndarray<nb::numpy, double> solve_many(const PointsIn& vertices, const OffsetsIn& vertex_offsets, const FacesIn& faces, const OffsetsIn& face_offsets,
+                                          const std::string& method) {
+    size_t count = vertex_offsets.shape(0) > 0 ? vertex_offsets.shape(0) - 1 : 0, V = vertices.shape(0);
+    check_offsets(vertex_offsets, count, V, "vertex_offsets");
+    check_offsets(face_offsets, count, faces.shape(0), "face_offsets");
+    ParameterizationMethod rules = parameterization_method(method);
+    ArrayBuffer<double> uv(2 * V);
+    {
+        nb::gil_scoped_release release;
+        parameterize_many(vertices.data(), vertex_offsets.data(), faces.data(), face_offsets.data(), count, rules, uv.data());
+    }
+    return to_ndarray(std::move(uv), {V, 2});
+}
+
+NB_MODULE(_parameterize, m) {
+    m.doc() = "Harmonic and least squares conformal parameterization with a cached factorization.";
+    share_memory_ledger();
+
+    nb::class_<Parameterization>(m, "Parameterization")
+        .def("__init__",
+             [](Parameterization* self, const PointsIn& vertices, const FacesIn& faces, const std::string& method, std::optional<IndicesIn> fixed) {
+                 MeshView mesh = mesh_view(vertices, faces);
+                 ParameterizationMethod rules = parameterization_method(method);
+                 nb::gil_scoped_release release;
+                 new (self) Parameterization(mesh, rules, fixed ? fixed->data() : nullptr, fixed ? fixed->shape(0) : 0);
+             },
+             "vertices"_a, "faces"_a, "method"_a, "fixed"_a.none() = nb::none(),
+             "Build the cotangent Laplacian and factorize the energy of the free vertices")
+        .def_prop_ro("vertex_count", &Parameterization::vertex_count)
+        .def("fixed", [](const Parameterization& self) {
+                 ArrayBuffer<int32_t> fixed(self.fixed().begin(), self.fixed().end());
+                 size_t K = fixed.size();
+                 return to_ndarray(std::move(fixed), {K});
+             },
+             "Vertices whose positions are given to solve")
+        .def("default_positions", [](const Parameterization& self) {
+                 ArrayBuffer<double> positions(self.default_positions().begin(), self.default_positions().end());
+                 size_t K = positions.size() / 2;
+                 return to_ndarray(std::move(positions), {K, 2});
+             },
+             "Default positions of the fixed vertices, empty if they were given")
+        .def("solve", &solve, "positions"_a.none() = nb::none(), "Positions of all vertices for given positions of the fixed ones");
+
+    m.def("solve_many", &solve_many, "vertices"_a, "vertex_offsets"_a, "faces"_a, "face_offsets"_a, "method"_a,
+          "Flatten many meshes in parallel with their default fixed vertices");
+
+    def_arena_stats(m);
+}
@@ -0,0 +1,259 @@
+// parameterize.h - Harmonic and least squares conformal maps of disk-like triangle meshes
+#pragma once
+
+#include "arena.h"
+#include "halfedge.h"
+#include "laplacian.h"
+#include "parallel.h"
+
+#include <Eigen/SparseCholesky>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace compas {
+
+enum class ParameterizationMethod { HARMONIC, LSCM };
+
+/**
+ * Flattening of a triangle mesh with a factorization cached for new fixed positions
+ * HARMONIC minimizes the Dirichlet energy of u and v separately with the fixed vertices as
+ * boundary conditions, by default the longest boundary loop spread over a circle of the same
+ * length. LSCM (Levy et al. 2002, Desbrun et al. 2002) minimizes the conformal energy, the
+ * Dirichlet energy minus the signed area of the image, with two fixed vertices, by default the
+ * two boundary vertices farthest apart at their true distance. Both use the cotangent Laplacian.
+ * The free-free block is factorized once; solve() only forms a right-hand side and substitutes,
+ * in scratch memory.
+ */
+class Parameterization {
+public:
+    /**
+     * @param mesh Manifold, consistently oriented triangle mesh
+     * @param method Energy to minimize
+     * @param fixed Vertices whose positions are given to solve(), or null for the default ones
+     * @param fixed_count Number of fixed vertices
+     * @throws std::invalid_argument if the default fixed vertices cannot be chosen or the system is singular
+     */
+    Parameterization(const MeshView& mesh, ParameterizationMethod method, const int32_t* fixed = nullptr, size_t fixed_count = 0)
+        : method_(method), vertex_count_(mesh.vertex_count), index_(mesh.vertex_count, -1) {
+        HalfEdgeMesh topology(mesh);
+        if (fixed) {
+            for (size_t k = 0; k < fixed_count; ++k)
+                if (fixed[k] < 0 || static_cast<size_t>(fixed[k]) >= vertex_count_)
+                    throw std::out_of_range("Fixed vertex " + std::to_string(fixed[k]) + " does not exist.");
+            fixed_.assign(fixed, fixed + fixed_count);
+        } else {
+            choose_fixed(topology);
+        }
+        size_t minimum = method_ == ParameterizationMethod::LSCM ? 2 : 1;
+        Scratch scratch;
+        std::span<int32_t> sorted = scratch.array<int32_t>(fixed_.size());
+        std::copy(fixed_.begin(), fixed_.end(), sorted.begin());
+        std::sort(sorted.begin(), sorted.end());
+        if (std::unique(sorted.begin(), sorted.end()) != sorted.end() || fixed_.size() < std::min(minimum, vertex_count_))
+            throw std::invalid_argument("At least " + std::to_string(minimum) + " distinct fixed vertices are required.");
+        // Vertices without faces have no energy and are bound to the origin after the fixed ones
+        for (size_t k = 0; k < fixed_.size(); ++k)
+            index_[fixed_[k]] = -2 - static_cast<int32_t>(k);
+        bound_count_ = fixed_.size();
+        for (size_t v = 0; v < vertex_count_; ++v)
+            if (!topology.vertex_alive(static_cast<uint32_t>(v)) && !std::binary_search(sorted.begin(), sorted.end(), static_cast<int32_t>(v)))
+                index_[v] = -2 - static_cast<int32_t>(bound_count_++);
+        for (size_t v = 0; v < vertex_count_; ++v)
+            if (index_[v] == -1)
+                index_[v] = static_cast<int32_t>(free_count_++);
+        assemble(mesh, topology);
+    }
+
+    size_t vertex_count() const { return vertex_count_; }
+
+    /**
+     * @return Vertices whose positions are given to solve()
+     */
+    const std::vector<int32_t>& fixed() const { return fixed_; }
+
+    /**
+     * @return Row-major (K,2) default positions of the fixed vertices, empty for user-given ones
+     */
+    const std::vector<double>& default_positions() const { return defaults_; }
+
+    /**
+     * Positions of all vertices for given positions of the fixed ones
+     * @param positions Row-major (K,2) positions of the fixed vertices, or null for the defaults
+     * @param uv Row-major (V,2) output positions
+     */
+    void solve(const double* positions, double* uv) const {
+        if (!positions) {
+            if (defaults_.empty())
+                throw std::invalid_argument("Positions are required for user-given fixed vertices.");
+            positions = defaults_.data();
+        }
+        size_t B = bound_count_, K = fixed_.size(), n = free_count_;
+        bool lscm = method_ == ParameterizationMethod::LSCM;
+        // LSCM stacks u over v in one column, HARMONIC keeps them as two columns
+        Eigen::Index rows = lscm ? 2 : 1, cols = lscm ? 1 : 2;
+        Scratch scratch;
+        Eigen::Map<Eigen::MatrixXd> bound(scratch.array(2 * B, 0.0).data(), rows * B, cols);
+        Eigen::Map<Eigen::MatrixXd> rhs(scratch.array<double>(2 * n).data(), rows * n, cols), x(scratch.array<double>(2 * n).data(), rows * n, cols);
+        for (size_t k = 0; k < K; ++k) {
+            bound(k, 0) = positions[2 * k];
+            bound(lscm ? B + k : k, lscm ? 0 : 1) = positions[2 * k + 1];
+        }
+        rhs.noalias() = coupling_ * bound;
+        rhs = -rhs;
+        x = ldlt_.solve(rhs);
+        for (size_t v = 0; v < vertex_count_; ++v) {
+            int32_t i = index_[v];
+            for (int c = 0; c < 2; ++c) {
+                double& out = uv[2 * v + c];
+                if (method_ == ParameterizationMethod::LSCM)
+                    out = i >= 0 ? x(i + c * free_count_, 0) : bound(-2 - i + c * B, 0);
+                else
+                    out = i >= 0 ? x(i, c) : bound(-2 - i, c);
+            }
+        }
+    }
+
+private:
+    /**
+     * Longest boundary loop on a circle for HARMONIC, two farthest boundary vertices for LSCM
+     */
+    void choose_fixed(const HalfEdgeMesh& mesh) {
+        constexpr uint32_t NONE = HalfEdgeMesh::NONE;
+        std::vector<std::vector<uint32_t>> loops;
+        Scratch scratch;
+        std::span<uint8_t> visited = scratch.array<uint8_t>(mesh.halfedge_capacity(), 0);
+        for (uint32_t h = 0; h < mesh.halfedge_capacity(); ++h) {
+            if (!mesh.boundary_edge(h) || visited[h])
+                continue;
+            auto& loop = loops.emplace_back();
+            for (uint32_t g = h; g != NONE && !visited[g]; g = mesh.outgoing(mesh.to(g))) {
+                visited[g] = 1;
+                loop.push_back(mesh.from(g));
+            }
+        }
+        if (loops.empty())
+            throw std::invalid_argument("The mesh has no boundary, fixed vertices must be given.");
+
+        auto distance = [&](uint32_t a, uint32_t b) { return (mesh.points[a] - mesh.points[b]).norm(); };
+        auto perimeter = [&](const std::vector<uint32_t>& loop) {
+            double length = 0.0;
+            for (size_t k = 0; k < loop.size(); ++k)
+                length += distance(loop[k], loop[(k + 1) % loop.size()]);
+            return length;
+        };
+        if (method_ == ParameterizationMethod::HARMONIC) {
+            const auto& loop = *std::max_element(loops.begin(), loops.end(), [&](const auto& a, const auto& b) { return perimeter(a) < perimeter(b); });
+            double length = perimeter(loop), radius = length / (2.0 * std::numbers::pi), arc = 0.0;
+            for (size_t k = 0; k < loop.size(); ++k) {
+                double angle = 2.0 * std::numbers::pi * arc / length;
+                fixed_.push_back(static_cast<int32_t>(loop[k]));
+                defaults_.insert(defaults_.end(), {radius * std::cos(angle), radius * std::sin(angle)});
+                arc += distance(loop[k], loop[(k + 1) % loop.size()]);
+            }
+            return;
+        }
+
+        // Two sweeps for the farthest pair, exact for convex outlines and close otherwise
+        std::vector<uint32_t> boundary;
+        for (const auto& loop : loops)
+            boundary.insert(boundary.end(), loop.begin(), loop.end());
+        auto farthest = [&](uint32_t from) {
+            return *std::max_element(boundary.begin(), boundary.end(), [&](uint32_t a, uint32_t b) { return distance(from, a) < distance(from, b); });
+        };
+        uint32_t a = farthest(boundary[0]), b = farthest(a);
+        fixed_ = {static_cast<int32_t>(a), static_cast<int32_t>(b)};
+        defaults_ = {0.0, 0.0, distance(a, b), 0.0};
+    }
+
+    /**
+     * Split the energy matrix into the factorized free block and its coupling to the fixed values
+     * Unknowns are u then v of every free vertex for LSCM, and u and v as two columns for HARMONIC.
+     */
+    void assemble(const MeshView& mesh, const HalfEdgeMesh& topology) {
+        SparseMatrix L = cotangent_laplacian(mesh);
+        bool lscm = method_ == ParameterizationMethod::LSCM;
+        size_t blocks = lscm ? 2 : 1, n = free_count_, B = bound_count_;
+        std::vector<Eigen::Triplet<double>> free, coupling;
+        free.reserve(blocks * L.nonZeros());
+        // Entry (a,b) between components c and d of the vertex unknowns
+        auto add = [&](int32_t a, int c, int32_t b, int d, double w) {
+            int32_t i = index_[a], j = index_[b];
+            if (i < 0)
+                return;
+            if (j >= 0)
+                free.emplace_back(i + c * n, j + d * n, w);
+            else
+                coupling.emplace_back(i + c * n, -2 - j + d * B, w);
+        };
+        for (Eigen::Index col = 0; col < L.outerSize(); ++col)
+            for (SparseMatrix::InnerIterator it(L, col); it; ++it)
+                for (size_t c = 0; c < blocks; ++c)
+                    add(static_cast<int32_t>(it.row()), int(c), static_cast<int32_t>(col), int(c), it.value());
+        if (lscm) {
+            // Signed area 1/2 sum (u_i v_j - u_j v_i) over boundary half-edges i->j, subtracted twice
+            for (uint32_t h = 0; h < topology.halfedge_capacity(); ++h) {
+                if (!topology.boundary_edge(h))
+                    continue;
+                int32_t i = static_cast<int32_t>(topology.from(h)), j = static_cast<int32_t>(topology.to(h));
+                add(i, 0, j, 1, -0.5);
+                add(j, 1, i, 0, -0.5);
+                add(j, 0, i, 1, 0.5);
+                add(i, 1, j, 0, 0.5);
+            }
+        }
+
+        SparseMatrix matrix(blocks * n, blocks * n);
+        matrix.setFromTriplets(free.begin(), free.end());
+        coupling_.resize(blocks * n, blocks * B);
+        coupling_.setFromTriplets(coupling.begin(), coupling.end());
+        ldlt_.compute(matrix);
+        // Simplicial LDLT accepts zero pivots, so rank deficiency shows up in D
+        const auto& d = ldlt_.vectorD();
+        double scale = d.size() ? d.cwiseAbs().maxCoeff() : 0.0;
+        if (ldlt_.info() != Eigen::Success || (d.size() && d.cwiseAbs().minCoeff() <= 1e-12 * scale))
+            throw std::invalid_argument("The parameterization is singular; every connected part needs enough fixed vertices.");
+    }
+
+    ParameterizationMethod method_;
+    size_t vertex_count_;
+    std::vector<int32_t> fixed_;
+    std::vector<double> defaults_;
+    std::vector<int32_t> index_;  // index among the free vertices, or -2 - index among the bound ones
+    size_t free_count_ = 0;
+    size_t bound_count_ = 0;      // fixed vertices followed by vertices without faces
+    SparseMatrix coupling_;
+    Eigen::SimplicialLDLT<SparseMatrix> ldlt_;
+};
+
+/**
+ * Flatten many small meshes in parallel with their default fixed vertices
+ * @param vertices Row-major (V,3) vertices of all meshes
+ * @param vertex_offsets (M+1,) vertex ranges per mesh
+ * @param faces Row-major (F,3) faces of all meshes, indexing the vertices of their own mesh
+ * @param face_offsets (M+1,) face ranges per mesh
+ * @param count Number of meshes M
+ * @param method Energy to minimize
+ * @param uv Row-major (V,2) output positions
+ */
+inline void parameterize_many(const double* vertices, const int64_t* vertex_offsets, const int32_t* faces, const int64_t* face_offsets,
+                              size_t count, ParameterizationMethod method, double* uv) {
+    parallel_for(count, 1, [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            MeshView mesh{vertices + 3 * vertex_offsets[m], static_cast<size_t>(vertex_offsets[m + 1] - vertex_offsets[m]),
+                          faces + 3 * face_offsets[m], static_cast<size_t>(face_offsets[m + 1] - face_offsets[m])};
+            try {
+                Parameterization(mesh, method).solve(nullptr, uv + 2 * vertex_offsets[m]);
+            } catch (const std::invalid_argument& e) {
+                throw std::invalid_argument("Mesh " + std::to_string(m) + ": " + e.what());
+            }
+        }
+    });
+}
+
+} // namespace compas
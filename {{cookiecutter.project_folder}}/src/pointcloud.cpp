@@ -0,0 +1,71 @@
+#include "compas.h"
+#include "arrays.h"
+#include "normals.h"
+
+#include <nanobind/stl/optional.h>
+#include <optional>
+
+using namespace compas;
+
+/**
+ * Estimate point cloud normals and curvature in place
+ * @param points (N,3) coordinates
+ * @param normals (N,3) output unit normals
+ * @param curvature (N,) output surface variation, or None
+ * @param k Neighbours per point, the point itself included
+ * @param orientation "mst" to propagate along a spanning tree, "viewpoint" to face the viewpoint, "none" to skip
+ * @param viewpoint Viewpoint used by the "viewpoint" orientation
+ */
+void estimate_normals(const PointsIn& points, RowsOut<3> normals, std::optional<ValuesOut> curvature, size_t k, const std::string& orientation, const Eigen::Vector3d& viewpoint) {
+    size_t n = points.shape(0);
+    if (normals.shape(0) != n || (curvature && curvature->shape(0) != n))
+        throw std::invalid_argument("Output arrays must have one row per point.");
+    if (k < 3)
+        throw std::invalid_argument("At least 3 neighbours are needed to fit a plane.");
+    if (orientation != "mst" && orientation != "viewpoint" && orientation != "none")
+        throw std::invalid_argument("Unknown orientation '" + orientation + "', expected 'mst', 'viewpoint' or 'none'.");
+
+    nb::gil_scoped_release release;
+    KDTree tree(points.data(), n);
+    std::vector<uint32_t> neighbors = knn_graph(tree, k);
+    pca_normals(points.data(), neighbors.data(), n, k, normals.data(), curvature ? curvature->data() : nullptr);
+    if (orientation == "mst")
+        orient_mst(points.data(), neighbors.data(), n, k, normals.data());
+    else if (orientation == "viewpoint")
+        orient_towards(points.data(), n, viewpoint, normals.data());
+}
+
+/**
+ * k nearest neighbours of every point
+ * @param points (N,3) coordinates
+ * @param k Neighbours per point, the point itself included
+ * @return (N,k) int32 neighbour indices sorted by distance
+ * @throws std::invalid_argument unless 1 <= k <= N
+ */
+nb::ndarray<nb::numpy, int32_t> knn(const PointsIn& points, size_t k) {
+    size_t n = points.shape(0);
+    if (k == 0 || k > n)
+        throw std::invalid_argument("k must be between 1 and the number of points, " + std::to_string(n) + ".");
+    ArrayBuffer<int32_t> result(n * k);
+    {
+        nb::gil_scoped_release release;
+        KDTree tree(points.data(), n);
+        std::vector<uint32_t> neighbors = knn_graph(tree, k);
+        std::copy(neighbors.begin(), neighbors.end(), result.begin());
+    }
+    return to_ndarray(std::move(result), {n, k});
+}
+
+NB_MODULE(_pointcloud, m) {
+    m.doc() = "Point cloud neighbourhoods, normals and curvature.";
+    share_memory_ledger();
+
+    m.def("knn", &knn, "points"_a, "k"_a,
+          "Indices of the k nearest neighbours of every point");
+
+    m.def("estimate_normals", &estimate_normals, "points"_a, "normals"_a, "curvature"_a.none(), "k"_a = 16,
+          "orientation"_a = "mst", "viewpoint"_a = Eigen::Vector3d::Zero().eval(),
+          "Write PCA normals and surface variation of (N,3) points into caller-provided arrays");
+
+    def_arena_stats(m);
+}
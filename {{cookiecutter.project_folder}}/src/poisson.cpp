@@ -0,0 +1,40 @@
+#include "compas.h"
+#include "arrays.h"
+#include "poisson.h"
+
+using namespace compas;
+
+/**
+ * Screened Poisson surface reconstruction
+ * @param points (N,3) positions
+ * @param normals (N,3) outward normals
+ * @param depth Finest level, 2^depth cells along the longest side
+ * @param screening Weight of the point constraints
+ * @param padding Margin around the points as a fraction of their extent
+ * @param cycles Multigrid V-cycles on the dense levels
+ * @param smoothing Gauss-Seidel sweeps on every finer level
+ * @return Tuple of vertices (V,3) and faces (F,3)
+ */
+nb::tuple reconstruct(const PointsIn& points, const PointsIn& normals, int depth, double screening, double padding, int cycles, int smoothing) {
+    if (normals.shape(0) != points.shape(0))
+        throw std::invalid_argument("There must be one normal per point.");
+    ArrayBuffer<double> vertices;
+    ArrayBuffer<int32_t> faces;
+    {
+        nb::gil_scoped_release release;
+        PoissonReconstruction(points.data(), normals.data(), points.shape(0), PoissonOptions{depth, screening, padding, cycles, smoothing})
+            .extract(vertices, faces);
+    }
+    size_t V = vertices.size() / 3, F = faces.size() / 3;
+    return nb::make_tuple(to_ndarray(std::move(vertices), {V, 3}), to_ndarray(std::move(faces), {F, 3}));
+}
+
+NB_MODULE(_poisson, m) {
+    m.doc() = "Screened Poisson surface reconstruction from oriented points.";
+    share_memory_ledger();
+
+    m.def("reconstruct", &reconstruct, "points"_a, "normals"_a, "depth"_a = 8, "screening"_a = 4.0, "padding"_a = 0.1, "cycles"_a = 6,
+          "smoothing"_a = 24, "Fit a watertight surface to oriented points and extract it with marching cubes");
+
+    def_arena_stats(m);
+}
@@ -0,0 +1,552 @@
+// poisson.h - Screened Poisson surface reconstruction from oriented points
+#pragma once
+
+#include "arena.h"
+#include "marching.h"
+#include "memory.h"
+#include "mesh.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace compas {
+
+struct PoissonOptions {
+    int depth = 8;            // finest level has 2^depth cells along the longest side
+    double screening = 4.0;   // weight pulling the implicit function to the iso-value at the points
+    double padding = 0.1;     // margin around the points as a fraction of their extent
+    int cycles = 6;           // multigrid V-cycles on the dense levels
+    int smoothing = 24;       // Gauss-Seidel sweeps on every finer level
+};
+
+/**
+ * Screened Poisson surface reconstruction (Kazhdan and Hoppe 2013)
+ * Finds the function chi whose gradient best matches the point normals while chi is pulled to a
+ * common value at the points, then extracts that level set with marching cubes. chi is trilinear
+ * on a hierarchy of grids stored as 8^3 node blocks, an octree with blocks for leaves. Levels up
+ * to DENSE_DEPTH cover the whole domain and are solved with multigrid V-cycles. Finer levels only
+ * keep the blocks around the points; they start from the prolonged coarser solution, keep it
+ * on the rim of the band and are relaxed by red-black Gauss-Seidel in parallel (cascadic
+ * multigrid). Point constraints are splatted on every level with the same hat functions, so the
+ * coarse equations are the restrictions of the fine ones.
+ */
+class PoissonReconstruction {
+public:
+    static constexpr int DENSE_DEPTH = 5;
+    static constexpr int MIN_DEPTH = 2;
+    static constexpr int MAX_DEPTH = 12;
+
+    /**
+     * @param points Row-major (N,3) positions
+     * @param normals Row-major (N,3) outward normals, any length
+     * @param count Number of points N
+     * @param options Depth, screening and solver settings
+     * @throws std::invalid_argument if there are no points or an option is out of range
+     */
+    PoissonReconstruction(const double* points, const double* normals, size_t count, const PoissonOptions& options)
+        : options_(options), depth_(options.depth) {
+        if (count == 0)
+            throw std::invalid_argument("At least one point is required.");
+        if (depth_ < MIN_DEPTH || depth_ > MAX_DEPTH)
+            throw std::invalid_argument("The depth must be between " + std::to_string(MIN_DEPTH) + " and " + std::to_string(MAX_DEPTH) + ".");
+        if (!(options.screening >= 0.0) || !(options.padding >= 0.0))
+            throw std::invalid_argument("The screening weight and padding must not be negative.");
+
+        // Cube domain around the points, in units of finest cells
+        Box3 box;
+        for (size_t i = 0; i < count; ++i)
+            box.extend(Vec3(Eigen::Map<const Vec3>(points + 3 * i)));
+        double extent = std::max(box.sizes().maxCoeff(), 1e-12) * (1.0 + 2.0 * options.padding);
+        cells_ = 1 << depth_;
+        scale_ = cells_ / extent;
+        origin_ = box.center() - Vec3::Constant(0.5 * extent);
+        samples_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            Vec3 n = Eigen::Map<const Vec3>(normals + 3 * i);
+            double length = n.norm();
+            samples_[i] = {scale_ * (Eigen::Map<const Vec3>(points + 3 * i) - origin_), length > 0.0 ? Vec3(n / length) : Vec3::Zero()};
+        }
+
+        // Every sample stands for the same share of the occupied finest cells
+        std::vector<uint64_t> occupied(count);
+        for (size_t i = 0; i < count; ++i)
+            occupied[i] = cell_key(samples_[i].position, cells_);
+        std::sort(occupied.begin(), occupied.end());
+        weight_ = double(std::unique(occupied.begin(), occupied.end()) - occupied.begin()) / double(count);
+
+        int dense = std::min(depth_, DENSE_DEPTH);
+        for (int l = 0; l <= depth_; ++l)
+            levels_.push_back(l <= dense ? dense_level(l) : band_level(l));
+        int coarsest = std::min(MIN_DEPTH, depth_);
+        parallel_for(size_t(depth_ - coarsest + 1), 1, [&](size_t begin, size_t end) {
+            for (size_t l = coarsest + begin; l < coarsest + end; ++l)
+                splat(levels_[l], int(l) >= dense);
+        });
+        for (int c = 0; c < options.cycles; ++c)
+            v_cycle(dense);
+        for (int l = dense + 1; l <= depth_; ++l) {
+            prolong(levels_[l - 1], levels_[l], false);
+            for (int s = 0; s < options.smoothing; ++s)
+                smooth(levels_[l]);
+        }
+
+        double sum = 0.0;
+        for (const Sample& s : samples_)
+            sum += value(levels_.back(), s.position);
+        iso_ = sum / double(count);
+    }
+
+    /**
+     * @return Level of the implicit function at the surface, the mean over the points
+     */
+    double iso_value() const { return iso_; }
+
+    /**
+     * @return Number of grid nodes on all levels
+     */
+    size_t node_count() const {
+        size_t n = 0;
+        for (const Level& level : levels_)
+            n += level.x.size();
+        return n;
+    }
+
+    /**
+     * Implicit function at world positions, larger outside the surface
+     */
+    double evaluate(const Vec3& point) const { return value(levels_.back(), scale_ * (point - origin_)); }
+
+    /**
+     * Marching cubes over the finest level, in parallel over blocks
+     * @param vertices Output row-major (V,3) positions
+     * @param faces Output row-major (F,3) triangles with outward normals
+     */
+    void extract(ArrayBuffer<double>& vertices, ArrayBuffer<int32_t>& faces) const {
+        const Level& level = levels_.back();
+        const CubeEdges& edges = cube_edges();
+        const auto& table = marching_cubes_table();
+        size_t blocks = level.origins.size();
+        // Per block: crossed grid edges with their points, and triangles over those edges
+        std::vector<std::vector<std::pair<uint64_t, Vec3>>> block_points(blocks);
+        std::vector<std::vector<uint64_t>> block_triangles(blocks);
+        const uint64_t nodes = uint64_t(level.cells) + 1;
+
+        parallel_for(blocks, 1, [&](size_t begin, size_t end) {
+            for (size_t b = begin; b < end; ++b) {
+                const auto& o = level.origins[b];
+                for (int lk = 0; lk < B; ++lk)
+                    for (int lj = 0; lj < B; ++lj)
+                        for (int li = 0; li < B; ++li) {
+                            int i = o[0] + li, j = o[1] + lj, k = o[2] + lk;
+                            if (i >= level.cells || j >= level.cells || k >= level.cells)
+                                continue;
+                            std::array<double, 8> corner;
+                            int inside = 0;
+                            bool complete = true;
+                            for (int c = 0; c < 8 && complete; ++c) {
+                                uint32_t s = slot(level, i + (c & 1), j + (c >> 1 & 1), k + (c >> 2 & 1));
+                                complete = s != NONE;
+                                if (complete) {
+                                    corner[c] = level.x[s];
+                                    inside |= (corner[c] < iso_) << c;
+                                }
+                            }
+                            if (!complete || table[inside].empty())
+                                continue;
+                            for (const auto& triangle : table[inside])
+                                for (uint8_t e : triangle) {
+                                    int c0 = edges.corners[e][0], c1 = edges.corners[e][1];
+                                    uint64_t node = (uint64_t(k + (c0 >> 2 & 1)) * nodes + uint64_t(j + (c0 >> 1 & 1))) * nodes + uint64_t(i + (c0 & 1));
+                                    uint64_t key = 3 * node + edges.axis[e];
+                                    block_triangles[b].push_back(key);
+                                    double t = std::clamp((iso_ - corner[c0]) / (corner[c1] - corner[c0]), 0.0, 1.0);
+                                    Vec3 p(i + (c0 & 1), j + (c0 >> 1 & 1), k + (c0 >> 2 & 1));
+                                    p[edges.axis[e]] += t;
+                                    block_points[b].emplace_back(key, origin_ + p / scale_);
+                                }
+                        }
+                std::sort(block_points[b].begin(), block_points[b].end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+                block_points[b].erase(std::unique(block_points[b].begin(), block_points[b].end(), [](const auto& x, const auto& y) { return x.first == y.first; }),
+                                      block_points[b].end());
+            }
+        });
+
+        // Edges shared by neighbouring blocks become one vertex
+        std::vector<std::pair<uint64_t, Vec3>> all;
+        for (auto& points : block_points)
+            all.insert(all.end(), points.begin(), points.end());
+        std::sort(all.begin(), all.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+        all.erase(std::unique(all.begin(), all.end(), [](const auto& x, const auto& y) { return x.first == y.first; }), all.end());
+        vertices.resize(3 * all.size());
+        for (size_t v = 0; v < all.size(); ++v)
+            Eigen::Map<Vec3>(vertices.data() + 3 * v) = all[v].second;
+        faces.clear();
+        for (const auto& triangles : block_triangles)
+            for (uint64_t key : triangles) {
+                auto it = std::lower_bound(all.begin(), all.end(), key, [](const auto& x, uint64_t k) { return x.first < k; });
+                faces.push_back(static_cast<int32_t>(it - all.begin()));
+            }
+    }
+
+private:
+    static constexpr int B = 8;  // block edge in nodes
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    struct Sample {
+        Vec3 position;  // in finest cells
+        Vec3 normal;
+    };
+
+    struct Level {
+        int cells = 0;     // cells along each axis
+        int blocks = 0;    // blocks along each axis
+        double h = 1.0;    // cell size in finest cells
+        bool dense = true; // dense levels cover the domain, band levels keep their rim fixed
+        std::unordered_map<uint64_t, uint32_t> lookup;  // band levels: block key to block
+        std::vector<std::array<int, 3>> origins;        // first node of each block
+        std::vector<std::array<uint32_t, 6>> neighbors; // face-adjacent blocks (-x, +x, -y, +y, -z, +z)
+        std::vector<double> x, b, d;                    // solution, right-hand side and screening per node
+    };
+
+    static uint64_t cell_key(const Vec3& p, int cells) {
+        auto coordinate = [&](double v) { return uint64_t(std::clamp(int(std::floor(v)), 0, cells - 1)); };
+        return (coordinate(p[2]) * uint64_t(cells) + coordinate(p[1])) * uint64_t(cells) + coordinate(p[0]);
+    }
+
+    static uint32_t block(const Level& level, int bx, int by, int bz) {
+        if (bx < 0 || by < 0 || bz < 0 || bx >= level.blocks || by >= level.blocks || bz >= level.blocks)
+            return NONE;
+        uint64_t key = (uint64_t(bz) * level.blocks + uint64_t(by)) * level.blocks + uint64_t(bx);
+        if (level.dense)
+            return static_cast<uint32_t>(key);
+        auto it = level.lookup.find(key);
+        return it == level.lookup.end() ? NONE : it->second;
+    }
+
+    /**
+     * @return Storage index of node (i,j,k), NONE outside the domain or the stored blocks
+     */
+    static uint32_t slot(const Level& level, int i, int j, int k) {
+        if (i < 0 || j < 0 || k < 0 || i > level.cells || j > level.cells || k > level.cells)
+            return NONE;
+        uint32_t b = block(level, i / B, j / B, k / B);
+        return b == NONE ? NONE : b * B * B * B + uint32_t(i % B + B * (j % B + B * (k % B)));
+    }
+
+    void finish(Level& level) const {
+        size_t n = level.origins.size();
+        level.neighbors.resize(n);
+        for (size_t b = 0; b < n; ++b) {
+            const auto& o = level.origins[b];
+            for (int f = 0; f < 6; ++f) {
+                int step = f % 2 ? 1 : -1;
+                std::array<int, 3> c = {o[0] / B, o[1] / B, o[2] / B};
+                c[f / 2] += step;
+                level.neighbors[b][f] = block(level, c[0], c[1], c[2]);
+            }
+        }
+        level.x.assign(n * B * B * B, 0.0);
+        level.b.assign(n * B * B * B, 0.0);
+        level.d.assign(n * B * B * B, 0.0);
+    }
+
+    Level dense_level(int l) const {
+        Level level;
+        level.cells = 1 << l;
+        level.blocks = level.cells / B + 1;
+        level.h = double(1 << (depth_ - l));
+        for (int bz = 0; bz < level.blocks; ++bz)
+            for (int by = 0; by < level.blocks; ++by)
+                for (int bx = 0; bx < level.blocks; ++bx)
+                    level.origins.push_back({bx * B, by * B, bz * B});
+        finish(level);
+        return level;
+    }
+
+    /**
+     * Blocks holding points, grown by one block in every direction
+     */
+    Level band_level(int l) const {
+        Level level;
+        level.cells = 1 << l;
+        level.blocks = level.cells / B + 1;
+        level.h = double(1 << (depth_ - l));
+        level.dense = false;
+        auto unique = [](std::vector<uint64_t>& keys) {
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        };
+        std::vector<uint64_t> occupied, keys;
+        for (const Sample& s : samples_) {
+            uint64_t cell = cell_key(s.position / level.h, level.cells);
+            int c[3] = {int(cell % level.cells), int(cell / level.cells % level.cells), int(cell / level.cells / level.cells)};
+            occupied.push_back((uint64_t(c[2] / B) * level.blocks + uint64_t(c[1] / B)) * level.blocks + uint64_t(c[0] / B));
+        }
+        unique(occupied);
+        for (uint64_t key : occupied) {
+            int c[3] = {int(key % level.blocks), int(key / level.blocks % level.blocks), int(key / level.blocks / level.blocks)};
+            for (int dz = -1; dz <= 1; ++dz)
+                for (int dy = -1; dy <= 1; ++dy)
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        int bx = c[0] + dx, by = c[1] + dy, bz = c[2] + dz;
+                        if (bx >= 0 && by >= 0 && bz >= 0 && bx < level.blocks && by < level.blocks && bz < level.blocks)
+                            keys.push_back((uint64_t(bz) * level.blocks + uint64_t(by)) * level.blocks + uint64_t(bx));
+                    }
+        }
+        unique(keys);
+        for (uint64_t key : keys) {
+            level.lookup.emplace(key, static_cast<uint32_t>(level.origins.size()));
+            level.origins.push_back({int(key % level.blocks) * B, int(key / level.blocks % level.blocks) * B, int(key / level.blocks / level.blocks) * B});
+        }
+        finish(level);
+        return level;
+    }
+
+    /**
+     * Screening diagonal and, if requested, the divergence of the normal field
+     * Both are integrals against the trilinear hat function of each node: the screening lumps
+     * screening * w * phi_i(p) on the diagonal, the right-hand side is w * n . grad phi_i(p).
+     */
+    void splat(Level& level, bool rhs) const {
+        for (const Sample& s : samples_) {
+            Vec3 q = s.position / level.h;
+            int base[3];
+            double f[3];
+            for (int a = 0; a < 3; ++a) {
+                base[a] = std::clamp(int(std::floor(q[a])), 0, level.cells - 1);
+                f[a] = q[a] - base[a];
+            }
+            for (int c = 0; c < 8; ++c) {
+                int bit[3] = {c & 1, c >> 1 & 1, c >> 2 & 1};
+                double w[3], g[3];
+                for (int a = 0; a < 3; ++a) {
+                    w[a] = bit[a] ? f[a] : 1.0 - f[a];
+                    g[a] = (bit[a] ? 1.0 : -1.0) / level.h;
+                }
+                uint32_t i = slot(level, base[0] + bit[0], base[1] + bit[1], base[2] + bit[2]);
+                if (i == NONE)
+                    continue;
+                level.d[i] += options_.screening * weight_ * w[0] * w[1] * w[2];
+                if (rhs)
+                    level.b[i] += weight_ * (s.normal[0] * g[0] * w[1] * w[2] + s.normal[1] * w[0] * g[1] * w[2] + s.normal[2] * w[0] * w[1] * g[2]);
+            }
+        }
+    }
+
+    /**
+     * Visit the nodes of the domain in parallel over blocks
+     * @param fn Callable fn(slot, i, j, k, neighbors) with the storage index of the six stencil
+     *           neighbours, NONE where the neighbour is missing
+     */
+    template <class F>
+    void for_each_node(const Level& level, int color, F&& fn) const {
+        parallel_for(level.origins.size(), 8, [&](size_t begin, size_t end) {
+            for (size_t b = begin; b < end; ++b) {
+                const auto& o = level.origins[b];
+                uint32_t first = static_cast<uint32_t>(b * B * B * B);
+                for (int lk = 0; lk < B; ++lk)
+                    for (int lj = 0; lj < B; ++lj)
+                        for (int li = (color < 0 ? 0 : (lj + lk + o[0] + o[1] + o[2] + color) & 1); li < B; li += color < 0 ? 1 : 2) {
+                            int i = o[0] + li, j = o[1] + lj, k = o[2] + lk;
+                            if (i > level.cells || j > level.cells || k > level.cells)
+                                continue;
+                            uint32_t s = first + uint32_t(li + B * (lj + B * lk));
+                            int local[3] = {li, lj, lk}, global[3] = {i, j, k};
+                            uint32_t stride[3] = {1, B, B * B};
+                            std::array<uint32_t, 6> n;
+                            for (int a = 0; a < 3; ++a)
+                                for (int side = 0; side < 2; ++side) {
+                                    int step = side ? 1 : -1, g = global[a] + step;
+                                    uint32_t& out = n[2 * a + side];
+                                    if (g < 0 || g > level.cells)
+                                        out = NONE;
+                                    else if (local[a] + step >= 0 && local[a] + step < B)
+                                        out = side ? s + stride[a] : s - stride[a];
+                                    else {
+                                        uint32_t other = level.neighbors[b][2 * a + side];
+                                        out = other == NONE ? NONE : other * B * B * B + (s - first) + (side ? -(B - 1) : (B - 1)) * stride[a];
+                                    }
+                                }
+                            fn(s, n);
+                        }
+            }
+        });
+    }
+
+    /**
+     * One red-black Gauss-Seidel sweep of (h L + D) x = b, L the 7-point Laplacian
+     */
+    void smooth(Level& level) const {
+        for (int color = 0; color < 2; ++color)
+            for_each_node(level, color, [&](uint32_t s, const std::array<uint32_t, 6>& n) {
+                double sum = 0.0;
+                int count = 0;
+                for (uint32_t t : n)
+                    if (t != NONE) {
+                        sum += level.x[t];
+                        ++count;
+                    }
+                if (!level.dense && count < 6 - boundary_missing(level, s))
+                    return;
+                double diagonal = level.h * count + level.d[s];
+                if (diagonal > 0.0)
+                    level.x[s] = (level.b[s] + level.h * sum) / diagonal;
+            });
+    }
+
+    /**
+     * Stencil neighbours a node lacks because it lies on the domain boundary
+     */
+    static int boundary_missing(const Level& level, uint32_t s) {
+        const auto& o = level.origins[s / (B * B * B)];
+        uint32_t local = s % (B * B * B);
+        int g[3] = {o[0] + int(local % B), o[1] + int(local / B % B), o[2] + int(local / (B * B))};
+        int missing = 0;
+        for (int a = 0; a < 3; ++a)
+            missing += (g[a] == 0) + (g[a] == level.cells);
+        return missing;
+    }
+
+    /**
+     * Residual b - A x of a dense level
+     */
+    void residual(const Level& level, std::span<double> r) const {
+        for_each_node(level, -1, [&](uint32_t s, const std::array<uint32_t, 6>& n) {
+            double ax = level.d[s] * level.x[s];
+            for (uint32_t t : n)
+                if (t != NONE)
+                    ax += level.h * (level.x[s] - level.x[t]);
+            r[s] = level.b[s] - ax;
+        });
+    }
+
+    /**
+     * Nodes of the next coarser level and their weights in the trilinear prolongation, per axis
+     */
+    static int parents(int i, std::array<std::pair<int, double>, 2>& out) {
+        if (i % 2 == 0) {
+            out[0] = {i / 2, 1.0};
+            return 1;
+        }
+        out[0] = {i / 2, 0.5};
+        out[1] = {i / 2 + 1, 0.5};
+        return 2;
+    }
+
+    /**
+     * Trilinear prolongation of the coarse solution, added to or replacing the fine one
+     */
+    void prolong(const Level& coarse, Level& fine, bool add) const {
+        for_each_node(fine, -1, [&](uint32_t s, const std::array<uint32_t, 6>&) {
+            const auto& o = fine.origins[s / (B * B * B)];
+            uint32_t local = s % (B * B * B);
+            int g[3] = {o[0] + int(local % B), o[1] + int(local / B % B), o[2] + int(local / (B * B))};
+            std::array<std::array<std::pair<int, double>, 2>, 3> p;
+            int n[3];
+            for (int a = 0; a < 3; ++a)
+                n[a] = parents(g[a], p[a]);
+            double value = 0.0, total = 0.0;
+            for (int z = 0; z < n[2]; ++z)
+                for (int y = 0; y < n[1]; ++y)
+                    for (int x = 0; x < n[0]; ++x) {
+                        uint32_t t = slot(coarse, p[0][x].first, p[1][y].first, p[2][z].first);
+                        if (t == NONE)
+                            continue;
+                        double w = p[0][x].second * p[1][y].second * p[2][z].second;
+                        value += w * coarse.x[t];
+                        total += w;
+                    }
+            if (add)
+                fine.x[s] += value;
+            else if (total > 0.0)
+                fine.x[s] = value / total;
+        });
+    }
+
+    /**
+     * Right-hand side of the coarse correction: the transpose of the prolongation applied to r
+     */
+    void restrict_residual(const Level& fine, std::span<const double> r, Level& coarse) const {
+        for_each_node(coarse, -1, [&](uint32_t s, const std::array<uint32_t, 6>&) {
+            const auto& o = coarse.origins[s / (B * B * B)];
+            uint32_t local = s % (B * B * B);
+            int g[3] = {o[0] + int(local % B), o[1] + int(local / B % B), o[2] + int(local / (B * B))};
+            double sum = 0.0;
+            for (int dz = -1; dz <= 1; ++dz)
+                for (int dy = -1; dy <= 1; ++dy)
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        uint32_t t = slot(fine, 2 * g[0] + dx, 2 * g[1] + dy, 2 * g[2] + dz);
+                        if (t != NONE)
+                            sum += (dx ? 0.5 : 1.0) * (dy ? 0.5 : 1.0) * (dz ? 0.5 : 1.0) * r[t];
+                    }
+            coarse.b[s] = sum;
+            coarse.x[s] = 0.0;
+        });
+    }
+
+    void v_cycle(int l) {
+        Level& level = levels_[l];
+        if (l <= MIN_DEPTH) {
+            for (int s = 0; s < 64; ++s)
+                smooth(level);
+            return;
+        }
+        for (int s = 0; s < 2; ++s)
+            smooth(level);
+        {
+            Scratch scratch;
+            std::span<double> r = scratch.array(level.x.size(), 0.0);
+            residual(level, r);
+            restrict_residual(level, r, levels_[l - 1]);
+        }
+        v_cycle(l - 1);
+        prolong(levels_[l - 1], level, true);
+        for (int s = 0; s < 2; ++s)
+            smooth(level);
+    }
+
+    /**
+     * Trilinear interpolation of a level at a position in finest cells
+     */
+    static double value(const Level& level, const Vec3& position) {
+        Vec3 q = position / level.h;
+        int base[3];
+        double f[3];
+        for (int a = 0; a < 3; ++a) {
+            base[a] = std::clamp(int(std::floor(q[a])), 0, level.cells - 1);
+            f[a] = std::clamp(q[a] - base[a], 0.0, 1.0);
+        }
+        double sum = 0.0, total = 0.0;
+        for (int c = 0; c < 8; ++c) {
+            uint32_t s = slot(level, base[0] + (c & 1), base[1] + (c >> 1 & 1), base[2] + (c >> 2 & 1));
+            if (s == NONE)
+                continue;
+            double w = (c & 1 ? f[0] : 1.0 - f[0]) * (c >> 1 & 1 ? f[1] : 1.0 - f[1]) * (c >> 2 & 1 ? f[2] : 1.0 - f[2]);
+            sum += w * level.x[s];
+            total += w;
+        }
+        return total > 0.0 ? sum / total : 0.0;
+    }
+
+    PoissonOptions options_;
+    int depth_;
+    int cells_ = 0;
+    double scale_ = 1.0;
+    Vec3 origin_ = Vec3::Zero();
+    double weight_ = 1.0;
+    double iso_ = 0.0;
+    std::vector<Sample> samples_;
+    std::vector<Level> levels_;
+};
+
+} // namespace compas
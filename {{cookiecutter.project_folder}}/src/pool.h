@@ -0,0 +1,81 @@
+// pool.h - Index-based object pool with a free list
+#pragma once
+
+#include "memory.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Contiguous pool of objects addressed by 32-bit indices
+ * Released slots are recycled before the storage grows, so kernels that create and destroy
+ * many short-lived elements (simplices, heap entries) keep a stable, compact footprint.
+ * Indices stay valid across growth; references do not. Storage is accounted under MemoryTag::POOL.
+ */
+template <class T>
+class Pool {
+public:
+    /**
+     * @return Index of a default-initialized object
+     */
+    uint32_t acquire() {
+        if (!free_.empty()) {
+            uint32_t index = free_.back();
+            free_.pop_back();
+            items_[index] = T();
+            live_[index] = 1;
+            return index;
+        }
+        items_.emplace_back();
+        live_.push_back(1);
+        return static_cast<uint32_t>(items_.size() - 1);
+    }
+
+    /**
+     * Return an object to the pool
+     * @param index Index obtained from acquire()
+     */
+    void release(uint32_t index) {
+        live_[index] = 0;
+        free_.push_back(index);
+    }
+
+    void reserve(size_t n) {
+        items_.reserve(n);
+        live_.reserve(n);
+    }
+
+    void clear() {
+        items_.clear();
+        live_.clear();
+        free_.clear();
+    }
+
+    T& operator[](uint32_t index) { return items_[index]; }
+    const T& operator[](uint32_t index) const { return items_[index]; }
+
+    bool live(uint32_t index) const { return live_[index] != 0; }
+
+    /**
+     * @return Number of slots, live or free
+     */
+    size_t capacity() const { return items_.size(); }
+
+    /**
+     * @return Number of live objects
+     */
+    size_t size() const { return items_.size() - free_.size(); }
+
+private:
+    template <class U>
+    using Storage = std::vector<U, TrackedAllocator<U, MemoryTag::POOL>>;
+
+    Storage<T> items_;
+    Storage<uint8_t> live_;
+    Storage<uint32_t> free_;
+};
+
+} // namespace compas
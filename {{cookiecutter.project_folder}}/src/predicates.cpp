@@ -0,0 +1,73 @@
+#include "compas.h"
+#include "arrays.h"
+#include "parallel.h"
+#include "predicates.h"
+
+using namespace compas;
+
+/**
+ * Evaluate a predicate over rows of equally sized point arrays, in parallel chunks
+ * @param points One (N,D) array per predicate argument
+ * @return (N,) float64 determinants with exact signs
+ */
+template <Predicate P, int D, int Args>
+nb::ndarray<nb::numpy, double> evaluate(const std::array<RowsIn<D>, Args>& points) {
+    size_t n = points[0].shape(0);
+    for (const auto& p : points)
+        if (p.shape(0) != n)
+            throw std::invalid_argument("All point arrays must have the same number of rows.");
+
+    ArrayBuffer<double> out(n);
+    {
+        nb::gil_scoped_release release;
+        parallel_for(n, 4096, [&](size_t begin, size_t end) {
+            std::array<const double*, Args> rows;
+            for (int k = 0; k < Args; ++k)
+                rows[k] = points[k].data() + begin * D;
+            predicate_batch<P, Args>(end - begin, rows, D, out.data() + begin);
+        });
+    }
+    return to_ndarray(std::move(out), {n});
+}
+
+/**
+ * Predicate statistics as a dict mapping each predicate name to its "calls" and "exact" counts
+ * @return Counts accumulated over all threads since the last reset
+ */
+nb::dict stats() {
+    static const char* names[PREDICATE_COUNT] = {"orient2d", "orient3d", "incircle", "insphere"};
+    PredicateCounts counts = predicate_counts();
+    nb::dict result;
+    for (int k = 0; k < PREDICATE_COUNT; ++k) {
+        nb::dict entry;
+        entry["calls"] = counts.calls[k];
+        entry["exact"] = counts.exact[k];
+        result[names[k]] = entry;
+    }
+    return result;
+}
+
+NB_MODULE(_predicates, m) {
+    m.doc() = "Robust geometric predicates.";
+    share_memory_ledger();
+    share_predicate_counts();
+
+    m.def("orient2d", [](const RowsIn<2>& a, const RowsIn<2>& b, const RowsIn<2>& c) {
+        return evaluate<ORIENT2D, 2, 3>({a, b, c});
+    }, "a"_a, "b"_a, "c"_a, "Orientation of 2D point triples, positive if counterclockwise");
+
+    m.def("orient3d", [](const RowsIn<3>& a, const RowsIn<3>& b, const RowsIn<3>& c, const RowsIn<3>& d) {
+        return evaluate<ORIENT3D, 3, 4>({a, b, c, d});
+    }, "a"_a, "b"_a, "c"_a, "d"_a, "Orientation of 3D point quadruples, positive if d is below plane abc");
+
+    m.def("incircle", [](const RowsIn<2>& a, const RowsIn<2>& b, const RowsIn<2>& c, const RowsIn<2>& d) {
+        return evaluate<INCIRCLE, 2, 4>({a, b, c, d});
+    }, "a"_a, "b"_a, "c"_a, "d"_a, "Positive if d is inside the circle through counterclockwise a, b, c");
+
+    m.def("insphere", [](const RowsIn<3>& a, const RowsIn<3>& b, const RowsIn<3>& c, const RowsIn<3>& d, const RowsIn<3>& e) {
+        return evaluate<INSPHERE, 3, 5>({a, b, c, d, e});
+    }, "a"_a, "b"_a, "c"_a, "d"_a, "e"_a, "Positive if e is inside the sphere through positively oriented a, b, c, d");
+
+    m.def("stats", &stats, "Number of predicate evaluations and exact fallbacks per predicate");
+    m.def("reset_stats", &reset_predicate_counts, "Reset the predicate statistics");
+}
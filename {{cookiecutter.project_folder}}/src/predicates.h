@@ -0,0 +1,502 @@
+// predicates.h - Robust geometric predicates with a floating-point filter
+//
+// Each predicate first evaluates its determinant in plain double precision together with a
+// static error bound (Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+// Geometric Predicates", 1997). Only when the bound cannot certify the sign is the determinant
+// re-evaluated exactly with floating-point expansions. The returned value always has the
+// correct sign.
+#pragma once
+
+#include <Eigen/Core>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace compas {
+
+enum Predicate { ORIENT2D = 0, ORIENT3D = 1, INCIRCLE = 2, INSPHERE = 3, PREDICATE_COUNT = 4 };
+
+/**
+ * Number of predicate evaluations and how many of them needed the exact path
+ */
+struct PredicateCounts {
+    std::array<uint64_t, PREDICATE_COUNT> calls{};
+    std::array<uint64_t, PREDICATE_COUNT> exact{};
+};
+
+namespace detail {
+
+/**
+ * Counters owned by one thread; other threads only read them
+ */
+struct ThreadPredicateCounters {
+    std::array<std::atomic<uint64_t>, PREDICATE_COUNT> calls{};
+    std::array<std::atomic<uint64_t>, PREDICATE_COUNT> exact{};
+};
+
+/**
+ * Registry of live per-thread counters plus the totals of threads that have exited
+ */
+struct PredicateRegistry {
+    std::mutex mutex;
+    std::vector<ThreadPredicateCounters*> live;
+    PredicateCounts retired;
+};
+
+/**
+ * Registry used by this library, its own one unless redirected to one shared with other libraries
+ */
+inline std::atomic<PredicateRegistry*>& predicate_registry_slot() {
+    static PredicateRegistry local;
+    static std::atomic<PredicateRegistry*> slot{&local};
+    return slot;
+}
+
+inline PredicateRegistry& predicate_registry() { return *predicate_registry_slot().load(std::memory_order_acquire); }
+
+struct ThreadPredicateSlot {
+    ThreadPredicateCounters counters;
+    PredicateRegistry& registry = predicate_registry();
+
+    ThreadPredicateSlot() {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.live.push_back(&counters);
+    }
+
+    ~ThreadPredicateSlot() {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (int k = 0; k < PREDICATE_COUNT; ++k) {
+            registry.retired.calls[k] += counters.calls[k].load(std::memory_order_relaxed);
+            registry.retired.exact[k] += counters.exact[k].load(std::memory_order_relaxed);
+        }
+        std::erase(registry.live, &counters);
+    }
+};
+
+inline ThreadPredicateCounters& thread_predicate_counters() {
+    thread_local ThreadPredicateSlot slot;
+    return slot.counters;
+}
+
+inline void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+    // Single writer per counter, so a relaxed load/store pair avoids a locked add
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void count_predicate(Predicate p, uint64_t calls, uint64_t exact) {
+    auto& counters = thread_predicate_counters();
+    bump(counters.calls[p], calls);
+    if (exact)
+        bump(counters.exact[p], exact);
+}
+
+//====================== EXPANSION ARITHMETIC ======================//
+
+constexpr double EPSILON = 1.1102230246251565e-16;  // 2^-53
+constexpr double ORIENT2D_BOUND = (3.0 + 16.0 * EPSILON) * EPSILON;
+constexpr double ORIENT3D_BOUND = (7.0 + 56.0 * EPSILON) * EPSILON;
+constexpr double INCIRCLE_BOUND = (10.0 + 96.0 * EPSILON) * EPSILON;
+constexpr double INSPHERE_BOUND = (16.0 + 224.0 * EPSILON) * EPSILON;
+
+/**
+ * Nonoverlapping expansion ordered by increasing magnitude, never empty
+ */
+using Expansion = std::vector<double>;
+
+inline void two_sum(double a, double b, double& x, double& y) {
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+inline void fast_two_sum(double a, double b, double& x, double& y) {
+    x = a + b;
+    y = b - (x - a);
+}
+
+inline void two_product(double a, double b, double& x, double& y) {
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+/**
+ * Exact difference a - b as an expansion
+ */
+inline Expansion difference(double a, double b) {
+    double x = a - b;
+    double bv = a - x;
+    double av = x + bv;
+    double y = (a - av) + (bv - b);
+    return y != 0.0 ? Expansion{y, x} : Expansion{x};
+}
+
+/**
+ * Sum of two expansions with zero elimination
+ */
+inline Expansion sum(const Expansion& e, const Expansion& f) {
+    Expansion h;
+    h.reserve(e.size() + f.size());
+    size_t ei = 0, fi = 0;
+    double enow = e[0], fnow = f[0];
+    double q, qnew, hh;
+
+    auto next_e = [&]() { ++ei; if (ei < e.size()) enow = e[ei]; };
+    auto next_f = [&]() { ++fi; if (fi < f.size()) fnow = f[fi]; };
+
+    if ((fnow > enow) == (fnow > -enow)) { q = enow; next_e(); }
+    else { q = fnow; next_f(); }
+
+    if (ei < e.size() && fi < f.size()) {
+        if ((fnow > enow) == (fnow > -enow)) { fast_two_sum(enow, q, qnew, hh); next_e(); }
+        else { fast_two_sum(fnow, q, qnew, hh); next_f(); }
+        q = qnew;
+        if (hh != 0.0) h.push_back(hh);
+        while (ei < e.size() && fi < f.size()) {
+            if ((fnow > enow) == (fnow > -enow)) { two_sum(q, enow, qnew, hh); next_e(); }
+            else { two_sum(q, fnow, qnew, hh); next_f(); }
+            q = qnew;
+            if (hh != 0.0) h.push_back(hh);
+        }
+    }
+    while (ei < e.size()) {
+        two_sum(q, enow, qnew, hh);
+        next_e();
+        q = qnew;
+        if (hh != 0.0) h.push_back(hh);
+    }
+    while (fi < f.size()) {
+        two_sum(q, fnow, qnew, hh);
+        next_f();
+        q = qnew;
+        if (hh != 0.0) h.push_back(hh);
+    }
+    if (q != 0.0 || h.empty())
+        h.push_back(q);
+    return h;
+}
+
+/**
+ * Product of an expansion and a double with zero elimination
+ */
+inline Expansion scale(const Expansion& e, double b) {
+    Expansion h;
+    h.reserve(2 * e.size());
+    double q, hh, p1, p0, s;
+    two_product(e[0], b, q, hh);
+    if (hh != 0.0) h.push_back(hh);
+    for (size_t i = 1; i < e.size(); ++i) {
+        two_product(e[i], b, p1, p0);
+        two_sum(q, p0, s, hh);
+        if (hh != 0.0) h.push_back(hh);
+        fast_two_sum(p1, s, q, hh);
+        if (hh != 0.0) h.push_back(hh);
+    }
+    if (q != 0.0 || h.empty())
+        h.push_back(q);
+    return h;
+}
+
+inline Expansion product(const Expansion& e, const Expansion& f) {
+    Expansion h = scale(e, f[0]);
+    for (size_t i = 1; i < f.size(); ++i)
+        h = sum(h, scale(e, f[i]));
+    return h;
+}
+
+inline Expansion negate(Expansion e) {
+    for (double& x : e)
+        x = -x;
+    return e;
+}
+
+inline Expansion difference(const Expansion& e, const Expansion& f) {
+    return sum(e, negate(f));
+}
+
+/**
+ * Approximate value of an expansion, with the sign of its exact value
+ */
+inline double estimate(const Expansion& e) {
+    double x = 0.0;
+    for (double c : e)
+        x += c;
+    // The largest component carries the sign of the whole expansion
+    return (x > 0) == (e.back() > 0) && x != 0.0 ? x : e.back();
+}
+
+//====================== EXACT DETERMINANTS ======================//
+
+inline Expansion cross2(const Expansion& ax, const Expansion& ay, const Expansion& bx, const Expansion& by) {
+    return difference(product(ax, by), product(ay, bx));
+}
+
+inline double orient2d_exact(const double* a, const double* b, const double* c) {
+    return estimate(cross2(difference(a[0], c[0]), difference(a[1], c[1]), difference(b[0], c[0]), difference(b[1], c[1])));
+}
+
+inline double orient3d_exact(const double* a, const double* b, const double* c, const double* d) {
+    Expansion adx = difference(a[0], d[0]), ady = difference(a[1], d[1]), adz = difference(a[2], d[2]);
+    Expansion bdx = difference(b[0], d[0]), bdy = difference(b[1], d[1]), bdz = difference(b[2], d[2]);
+    Expansion cdx = difference(c[0], d[0]), cdy = difference(c[1], d[1]), cdz = difference(c[2], d[2]);
+    Expansion det = product(adz, cross2(bdx, bdy, cdx, cdy));
+    det = sum(det, product(bdz, cross2(cdx, cdy, adx, ady)));
+    det = sum(det, product(cdz, cross2(adx, ady, bdx, bdy)));
+    return estimate(det);
+}
+
+inline double incircle_exact(const double* a, const double* b, const double* c, const double* d) {
+    Expansion adx = difference(a[0], d[0]), ady = difference(a[1], d[1]);
+    Expansion bdx = difference(b[0], d[0]), bdy = difference(b[1], d[1]);
+    Expansion cdx = difference(c[0], d[0]), cdy = difference(c[1], d[1]);
+    Expansion alift = sum(product(adx, adx), product(ady, ady));
+    Expansion blift = sum(product(bdx, bdx), product(bdy, bdy));
+    Expansion clift = sum(product(cdx, cdx), product(cdy, cdy));
+    Expansion det = product(alift, cross2(bdx, bdy, cdx, cdy));
+    det = sum(det, product(blift, cross2(cdx, cdy, adx, ady)));
+    det = sum(det, product(clift, cross2(adx, ady, bdx, bdy)));
+    return estimate(det);
+}
+
+inline double insphere_exact(const double* a, const double* b, const double* c, const double* d, const double* e) {
+    Expansion aex = difference(a[0], e[0]), aey = difference(a[1], e[1]), aez = difference(a[2], e[2]);
+    Expansion bex = difference(b[0], e[0]), bey = difference(b[1], e[1]), bez = difference(b[2], e[2]);
+    Expansion cex = difference(c[0], e[0]), cey = difference(c[1], e[1]), cez = difference(c[2], e[2]);
+    Expansion dex = difference(d[0], e[0]), dey = difference(d[1], e[1]), dez = difference(d[2], e[2]);
+
+    Expansion ab = cross2(aex, aey, bex, bey);
+    Expansion bc = cross2(bex, bey, cex, cey);
+    Expansion cd = cross2(cex, cey, dex, dey);
+    Expansion da = cross2(dex, dey, aex, aey);
+    Expansion ac = cross2(aex, aey, cex, cey);
+    Expansion bd = cross2(bex, bey, dex, dey);
+
+    Expansion abc = sum(difference(product(aez, bc), product(bez, ac)), product(cez, ab));
+    Expansion bcd = sum(difference(product(bez, cd), product(cez, bd)), product(dez, bc));
+    Expansion cda = sum(sum(product(cez, da), product(dez, ac)), product(aez, cd));
+    Expansion dab = sum(sum(product(dez, ab), product(aez, bd)), product(bez, da));
+
+    auto lift = [](const Expansion& x, const Expansion& y, const Expansion& z) {
+        return sum(sum(product(x, x), product(y, y)), product(z, z));
+    };
+    Expansion det = difference(product(lift(dex, dey, dez), abc), product(lift(cex, cey, cez), dab));
+    det = sum(det, difference(product(lift(bex, bey, bez), cda), product(lift(aex, aey, aez), bcd)));
+    return estimate(det);
+}
+
+//====================== FILTERED DETERMINANTS ======================//
+
+/**
+ * Floating-point determinant and its error bound; the sign is certain when |det| > bound
+ */
+struct Filtered {
+    double det;
+    double bound;
+
+    bool certain() const { return det > bound || -det > bound; }
+};
+
+inline Filtered orient2d_filter(const double* a, const double* b, const double* c) {
+    double left = (a[0] - c[0]) * (b[1] - c[1]);
+    double right = (a[1] - c[1]) * (b[0] - c[0]);
+    return {left - right, ORIENT2D_BOUND * (std::abs(left) + std::abs(right))};
+}
+
+inline Filtered orient3d_filter(const double* a, const double* b, const double* c, const double* d) {
+    double adx = a[0] - d[0], ady = a[1] - d[1], adz = a[2] - d[2];
+    double bdx = b[0] - d[0], bdy = b[1] - d[1], bdz = b[2] - d[2];
+    double cdx = c[0] - d[0], cdy = c[1] - d[1], cdz = c[2] - d[2];
+    double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady, adxcdy = adx * cdy;
+    double adxbdy = adx * bdy, bdxady = bdx * ady;
+    double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+    double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz) +
+                       (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz) +
+                       (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+    return {det, ORIENT3D_BOUND * permanent};
+}
+
+inline Filtered incircle_filter(const double* a, const double* b, const double* c, const double* d) {
+    double adx = a[0] - d[0], ady = a[1] - d[1];
+    double bdx = b[0] - d[0], bdy = b[1] - d[1];
+    double cdx = c[0] - d[0], cdy = c[1] - d[1];
+    double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady, adxcdy = adx * cdy;
+    double adxbdy = adx * bdy, bdxady = bdx * ady;
+    double alift = adx * adx + ady * ady;
+    double blift = bdx * bdx + bdy * bdy;
+    double clift = cdx * cdx + cdy * cdy;
+    double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+    double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift +
+                       (std::abs(cdxady) + std::abs(adxcdy)) * blift +
+                       (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+    return {det, INCIRCLE_BOUND * permanent};
+}
+
+inline Filtered insphere_filter(const double* a, const double* b, const double* c, const double* d, const double* e) {
+    double aex = a[0] - e[0], aey = a[1] - e[1], aez = a[2] - e[2];
+    double bex = b[0] - e[0], bey = b[1] - e[1], bez = b[2] - e[2];
+    double cex = c[0] - e[0], cey = c[1] - e[1], cez = c[2] - e[2];
+    double dex = d[0] - e[0], dey = d[1] - e[1], dez = d[2] - e[2];
+
+    double aexbey = aex * bey, bexaey = bex * aey;
+    double bexcey = bex * cey, cexbey = cex * bey;
+    double cexdey = cex * dey, dexcey = dex * cey;
+    double dexaey = dex * aey, aexdey = aex * dey;
+    double aexcey = aex * cey, cexaey = cex * aey;
+    double bexdey = bex * dey, dexbey = dex * bey;
+    double ab = aexbey - bexaey, bc = bexcey - cexbey, cd = cexdey - dexcey;
+    double da = dexaey - aexdey, ac = aexcey - cexaey, bd = bexdey - dexbey;
+
+    double abc = aez * bc - bez * ac + cez * ab;
+    double bcd = bez * cd - cez * bd + dez * bc;
+    double cda = cez * da + dez * ac + aez * cd;
+    double dab = dez * ab + aez * bd + bez * da;
+
+    double alift = aex * aex + aey * aey + aez * aez;
+    double blift = bex * bex + bey * bey + bez * bez;
+    double clift = cex * cex + cey * cey + cez * cez;
+    double dlift = dex * dex + dey * dey + dez * dez;
+    double det = (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+
+    double az = std::abs(aez), bz = std::abs(bez), cz = std::abs(cez), dz = std::abs(dez);
+    double pab = std::abs(aexbey) + std::abs(bexaey), pbc = std::abs(bexcey) + std::abs(cexbey);
+    double pcd = std::abs(cexdey) + std::abs(dexcey), pda = std::abs(dexaey) + std::abs(aexdey);
+    double pac = std::abs(aexcey) + std::abs(cexaey), pbd = std::abs(bexdey) + std::abs(dexbey);
+    double permanent = (pcd * bz + pbd * cz + pbc * dz) * alift +
+                       (pda * cz + pac * dz + pcd * az) * blift +
+                       (pab * dz + pbd * az + pda * bz) * clift +
+                       (pbc * az + pac * bz + pab * cz) * dlift;
+    return {det, INSPHERE_BOUND * permanent};
+}
+
+} // namespace detail
+
+/**
+ * Positive if a, b, c are in counterclockwise order, negative if clockwise, zero if collinear
+ * @param a, b, c 2D points
+ * @return Twice the signed area of the triangle, with exact sign
+ */
+inline double orient2d(const double* a, const double* b, const double* c) {
+    detail::Filtered f = detail::orient2d_filter(a, b, c);
+    bool exact = !f.certain();
+    detail::count_predicate(ORIENT2D, 1, exact);
+    return exact ? detail::orient2d_exact(a, b, c) : f.det;
+}
+
+/**
+ * Positive if d lies below the plane through a, b, c, seen counterclockwise from above
+ * @param a, b, c, d 3D points
+ * @return Six times the signed volume of the tetrahedron, with exact sign
+ */
+inline double orient3d(const double* a, const double* b, const double* c, const double* d) {
+    detail::Filtered f = detail::orient3d_filter(a, b, c, d);
+    bool exact = !f.certain();
+    detail::count_predicate(ORIENT3D, 1, exact);
+    return exact ? detail::orient3d_exact(a, b, c, d) : f.det;
+}
+
+/**
+ * Positive if d lies inside the circle through a, b, c given in counterclockwise order
+ * @param a, b, c, d 2D points
+ * @return Incircle determinant, with exact sign
+ */
+inline double incircle(const double* a, const double* b, const double* c, const double* d) {
+    detail::Filtered f = detail::incircle_filter(a, b, c, d);
+    bool exact = !f.certain();
+    detail::count_predicate(INCIRCLE, 1, exact);
+    return exact ? detail::incircle_exact(a, b, c, d) : f.det;
+}
+
+/**
+ * Positive if e lies inside the sphere through a, b, c, d with orient3d(a, b, c, d) > 0
+ * @param a, b, c, d, e 3D points
+ * @return Insphere determinant, with exact sign
+ */
+inline double insphere(const double* a, const double* b, const double* c, const double* d, const double* e) {
+    detail::Filtered f = detail::insphere_filter(a, b, c, d, e);
+    bool exact = !f.certain();
+    detail::count_predicate(INSPHERE, 1, exact);
+    return exact ? detail::insphere_exact(a, b, c, d, e) : f.det;
+}
+
+inline double orient2d(const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c) {
+    return orient2d(a.data(), b.data(), c.data());
+}
+
+inline double orient3d(const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d) {
+    return orient3d(a.data(), b.data(), c.data(), d.data());
+}
+
+/**
+ * Evaluate a predicate over a batch of point tuples
+ * The filter runs as a separate pass over the whole batch, which keeps the exact code out of
+ * the common loop, then only the uncertain entries are re-evaluated exactly.
+ * @param n Number of tuples
+ * @param points Pointers to the first point of each argument, rows of `dim` doubles
+ * @param dim Point dimension
+ * @param out Output determinants, n values
+ */
+template <Predicate P, int Args>
+void predicate_batch(size_t n, const std::array<const double*, Args>& points, int dim, double* out) {
+    std::vector<double> bounds(n);
+    auto row = [&](int k, size_t i) { return points[k] + i * dim; };
+
+    for (size_t i = 0; i < n; ++i) {
+        detail::Filtered f;
+        if constexpr (P == ORIENT2D) f = detail::orient2d_filter(row(0, i), row(1, i), row(2, i));
+        else if constexpr (P == ORIENT3D) f = detail::orient3d_filter(row(0, i), row(1, i), row(2, i), row(3, i));
+        else if constexpr (P == INCIRCLE) f = detail::incircle_filter(row(0, i), row(1, i), row(2, i), row(3, i));
+        else f = detail::insphere_filter(row(0, i), row(1, i), row(2, i), row(3, i), row(4, i));
+        out[i] = f.det;
+        bounds[i] = f.bound;
+    }
+
+    uint64_t exact = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (out[i] > bounds[i] || -out[i] > bounds[i])
+            continue;
+        ++exact;
+        if constexpr (P == ORIENT2D) out[i] = detail::orient2d_exact(row(0, i), row(1, i), row(2, i));
+        else if constexpr (P == ORIENT3D) out[i] = detail::orient3d_exact(row(0, i), row(1, i), row(2, i), row(3, i));
+        else if constexpr (P == INCIRCLE) out[i] = detail::incircle_exact(row(0, i), row(1, i), row(2, i), row(3, i));
+        else out[i] = detail::insphere_exact(row(0, i), row(1, i), row(2, i), row(3, i), row(4, i));
+    }
+    detail::count_predicate(P, n, exact);
+}
+
+/**
+ * @return Predicate evaluations and exact fallbacks over all threads since the last reset
+ */
+inline PredicateCounts predicate_counts() {
+    auto& registry = detail::predicate_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    PredicateCounts counts = registry.retired;
+    for (auto* counters : registry.live) {
+        for (int k = 0; k < PREDICATE_COUNT; ++k) {
+            counts.calls[k] += counters->calls[k].load(std::memory_order_relaxed);
+            counts.exact[k] += counters->exact[k].load(std::memory_order_relaxed);
+        }
+    }
+    return counts;
+}
+
+/**
+ * Reset the predicate statistics of all threads
+ */
+inline void reset_predicate_counts() {
+    auto& registry = detail::predicate_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.retired = PredicateCounts();
+    for (auto* counters : registry.live) {
+        for (int k = 0; k < PREDICATE_COUNT; ++k) {
+            counters->calls[k].store(0, std::memory_order_relaxed);
+            counters->exact[k].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace compas
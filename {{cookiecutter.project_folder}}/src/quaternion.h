@@ -0,0 +1,195 @@
+// quaternion.h - Batched quaternion and dual quaternion kernels
+//
+// Quaternions are stored as (w, x, y, z) rows like compas.geometry.Quaternion; dual quaternions as
+// eight values, the real part followed by the dual part. Kernels map rows onto fixed-size Eigen
+// types so the per-row arithmetic is vectorized by Eigen.
+#pragma once
+
+#include "mesh.h"
+#include "parallel.h"
+#include "transform.h"
+
+#include <Eigen/Geometry>
+#include <cmath>
+#include <cstddef>
+
+namespace compas {
+
+using Quat = Eigen::Quaterniond;
+
+/**
+ * @param q Row (w, x, y, z)
+ */
+inline Quat load_quaternion(const double* q) {
+    return Quat(q[0], q[1], q[2], q[3]);
+}
+
+inline void store_quaternion(const Quat& q, double* out) {
+    out[0] = q.w();
+    out[1] = q.x();
+    out[2] = q.y();
+    out[3] = q.z();
+}
+
+/**
+ * Rigid transform as a unit dual quaternion q_r + eps q_d
+ */
+struct DualQuat {
+    Quat real = Quat::Identity();
+    Quat dual = Quat(0, 0, 0, 0);
+
+    static DualQuat load(const double* d) { return {load_quaternion(d), load_quaternion(d + 4)}; }
+
+    void store(double* out) const {
+        store_quaternion(real, out);
+        store_quaternion(dual, out + 4);
+    }
+
+    /**
+     * @param rotation Unit rotation quaternion
+     * @param translation Translation applied after the rotation
+     */
+    static DualQuat from_rigid(const Quat& rotation, const Vec3& translation) {
+        Quat t(0, translation[0], translation[1], translation[2]);
+        Quat dual = t * rotation;
+        dual.coeffs() *= 0.5;
+        return {rotation, dual};
+    }
+
+    Vec3 translation() const {
+        Quat t = dual * real.conjugate();
+        return 2.0 * t.vec();
+    }
+
+    DualQuat operator*(const DualQuat& other) const {
+        Quat d1 = real * other.dual, d2 = dual * other.real;
+        return {real * other.real, Quat(d1.coeffs() + d2.coeffs())};
+    }
+
+    /**
+     * Scale both parts so the real part has unit length
+     */
+    DualQuat normalized() const {
+        double norm = real.norm();
+        Quat r(real.coeffs() / norm), d(dual.coeffs() / norm);
+        // Remove the component of the dual part that breaks the unit constraint r . d = 0
+        d.coeffs() -= r.coeffs().dot(d.coeffs()) * r.coeffs();
+        return {r, d};
+    }
+};
+
+/**
+ * Apply fn(i) to every row of a batch in parallel
+ */
+template <class F>
+void for_rows(size_t n, F&& fn) {
+    parallel_for(n, 4096, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            fn(i);
+    });
+}
+
+/**
+ * out[i] = a[i] * b[i]; a stride of 0 broadcasts a single quaternion
+ */
+inline void quaternion_multiply(const double* a, const double* b, double* out, size_t n, size_t a_stride = 4, size_t b_stride = 4) {
+    for_rows(n, [&](size_t i) {
+        store_quaternion(load_quaternion(a + i * a_stride) * load_quaternion(b + i * b_stride), out + 4 * i);
+    });
+}
+
+inline void quaternion_normalize(const double* q, double* out, size_t n) {
+    for_rows(n, [&](size_t i) {
+        store_quaternion(load_quaternion(q + 4 * i).normalized(), out + 4 * i);
+    });
+}
+
+/**
+ * Spherical linear interpolation along the shorter arc
+ * @param t (N,) interpolation parameters, 0 gives a and 1 gives b
+ */
+inline void quaternion_slerp(const double* a, const double* b, const double* t, double* out, size_t n, size_t a_stride = 4, size_t b_stride = 4) {
+    for_rows(n, [&](size_t i) {
+        store_quaternion(load_quaternion(a + i * a_stride).slerp(t[i], load_quaternion(b + i * b_stride)), out + 4 * i);
+    });
+}
+
+/**
+ * Rotation matrices of unit quaternions as (N,4,4) homogeneous transforms
+ */
+inline void quaternion_to_matrix(const double* q, double* out, size_t n) {
+    for_rows(n, [&](size_t i) {
+        Matrix4Map m(out + 16 * i);
+        m.setIdentity();
+        m.topLeftCorner<3, 3>() = load_quaternion(q + 4 * i).normalized().toRotationMatrix();
+    });
+}
+
+/**
+ * Rotation part of (N,4,4) transforms as unit quaternions with non-negative w
+ */
+inline void quaternion_from_matrix(const double* m, double* out, size_t n) {
+    for_rows(n, [&](size_t i) {
+        Quat q(Eigen::Matrix3d(ConstMatrix4Map(m + 16 * i).topLeftCorner<3, 3>()));
+        q.normalize();
+        if (q.w() < 0)
+            q.coeffs() = -q.coeffs();
+        store_quaternion(q, out + 4 * i);
+    });
+}
+
+inline void dual_quaternion_multiply(const double* a, const double* b, double* out, size_t n, size_t a_stride = 8, size_t b_stride = 8) {
+    for_rows(n, [&](size_t i) {
+        (DualQuat::load(a + i * a_stride) * DualQuat::load(b + i * b_stride)).store(out + 8 * i);
+    });
+}
+
+/**
+ * Unit dual quaternions of rigid (N,4,4) transforms
+ */
+inline void dual_quaternion_from_matrix(const double* m, double* out, size_t n) {
+    for_rows(n, [&](size_t i) {
+        ConstMatrix4Map matrix(m + 16 * i);
+        Quat q(Eigen::Matrix3d(matrix.topLeftCorner<3, 3>()));
+        q.normalize();
+        if (q.w() < 0)
+            q.coeffs() = -q.coeffs();
+        DualQuat::from_rigid(q, matrix.topRightCorner<3, 1>()).store(out + 8 * i);
+    });
+}
+
+inline void dual_quaternion_to_matrix(const double* d, double* out, size_t n) {
+    for_rows(n, [&](size_t i) {
+        DualQuat dq = DualQuat::load(d + 8 * i).normalized();
+        Matrix4Map m(out + 16 * i);
+        m.setIdentity();
+        m.topLeftCorner<3, 3>() = dq.real.toRotationMatrix();
+        m.topRightCorner<3, 1>() = dq.translation();
+    });
+}
+
+/**
+ * Dual quaternion linear blending (Kavan et al. 2007)
+ * Each output is the normalized weighted sum of the k inputs, with inputs flipped onto the
+ * hemisphere of the first one so antipodal representations of the same rotation do not cancel.
+ * @param dq (K,8) dual quaternions
+ * @param k Number of dual quaternions K
+ * @param weights Row-major (N,K) blend weights
+ * @param out (N,8) blended unit dual quaternions
+ * @param n Number of blends N
+ */
+inline void dual_quaternion_blend(const double* dq, size_t k, const double* weights, double* out, size_t n) {
+    using Vector8 = Eigen::Matrix<double, 8, 1>;
+    for_rows(n, [&](size_t i) {
+        Vector8 sum = Vector8::Zero();
+        Eigen::Map<const Eigen::Vector4d> pivot(dq);
+        for (size_t j = 0; j < k; ++j) {
+            Eigen::Map<const Vector8> d(dq + 8 * j);
+            double w = weights[i * k + j];
+            sum += (d.head<4>().dot(pivot) < 0 ? -w : w) * d;
+        }
+        DualQuat::load(sum.data()).normalized().store(out + 8 * i);
+    });
+}
+
+} // namespace compas
@@ -0,0 +1,56 @@
+#include "compas.h"
+#include "arrays.h"
+#include "registration.h"
+
+#include <nanobind/stl/optional.h>
+#include <optional>
+
+using namespace compas;
+
+/**
+ * Align a source cloud to the ICP target
+ * @param self ICP target
+ * @param source (M,3) source points
+ * @param initial Initial 4x4 source-to-target transform
+ * @param max_iterations Iteration limit
+ * @param tolerance Stop when the RMS residual improves by less than this
+ * @param max_distance Reject correspondences farther apart than this
+ * @param method "point_to_plane" or "point_to_point"
+ * @return Tuple of the 4x4 transform, per-iteration RMS residuals and a convergence flag
+ */
+nb::tuple align(const ICP& self, const PointsIn& source, const Eigen::Matrix4d& initial, int max_iterations, double tolerance, double max_distance, const std::string& method) {
+    if (method != "point_to_plane" && method != "point_to_point")
+        throw std::invalid_argument("Unknown method '" + method + "', expected 'point_to_plane' or 'point_to_point'.");
+    ICPOptions options;
+    options.max_iterations = max_iterations;
+    options.tolerance = tolerance;
+    options.max_distance = max_distance;
+    options.point_to_plane = method == "point_to_plane";
+
+    ICPResult result;
+    {
+        nb::gil_scoped_release release;
+        result = self.align(source.data(), source.shape(0), initial, options);
+    }
+    size_t iterations = result.residuals.size();
+    return nb::make_tuple(result.transform, to_ndarray(std::move(result.residuals), {iterations}), result.converged);
+}
+
+NB_MODULE(_registration, m) {
+    m.doc() = "Point cloud registration.";
+    share_memory_ledger();
+
+    nb::class_<ICP>(m, "ICP")
+        .def("__init__", [](ICP* self, const PointsIn& points, std::optional<PointsIn> normals) {
+            if (normals && normals->shape(0) != points.shape(0))
+                throw std::invalid_argument("Expected one normal per target point.");
+            nb::gil_scoped_release release;
+            new (self) ICP(points.data(), points.shape(0), normals ? normals->data() : nullptr);
+        }, "points"_a, "normals"_a.none() = nb::none(), "Build the KD-tree and normals of an (N,3) target")
+        .def_prop_ro("size", &ICP::size)
+        .def("align", &align, "source"_a, "initial"_a = Eigen::Matrix4d::Identity().eval(), "max_iterations"_a = 50,
+             "tolerance"_a = 1e-6, "max_distance"_a = std::numeric_limits<double>::infinity(), "method"_a = "point_to_plane",
+             "Align (M,3) source points to the target");
+
+    def_arena_stats(m);
+}
@@ -0,0 +1,160 @@
+// registration.h - Iterative closest point registration against a persistent target
+#pragma once
+
+#include "arena.h"
+#include "kdtree.h"
+#include "memory.h"
+#include "normals.h"
+#include "parallel.h"
+
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace compas {
+
+struct ICPOptions {
+    int max_iterations = 50;
+    double tolerance = 1e-6;  // stop when the RMS residual improves by less than this
+    double max_distance = std::numeric_limits<double>::infinity();  // correspondences farther apart are rejected
+    bool point_to_plane = true;
+};
+
+struct ICPResult {
+    Eigen::Matrix4d transform = Eigen::Matrix4d::Identity();
+    ArrayBuffer<double> residuals;  // RMS residual of the correspondences of each iteration
+    bool converged = false;
+};
+
+/**
+ * ICP target with its KD-tree and normals, built once and aligned against many times
+ */
+class ICP {
+public:
+    /**
+     * @param points Row-major (N,3) target points, copied
+     * @param count Number of target points N
+     * @param normals Row-major (N,3) target normals, or null to estimate them from 16 neighbours
+     */
+    ICP(const double* points, size_t count, const double* normals = nullptr)
+        : tree_(points, count), points_(count), normals_(3 * count) {
+        if (count < 3)
+            throw std::invalid_argument("The ICP target needs at least 3 points.");
+        for (size_t i = 0; i < count; ++i)
+            points_[i] = Vec3(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+        if (normals) {
+            std::copy(normals, normals + 3 * count, normals_.begin());
+        } else {
+            size_t k = std::min<size_t>(16, count);
+            std::vector<uint32_t> neighbors = knn_graph(tree_, k);
+            pca_normals(points, neighbors.data(), count, k, normals_.data(), nullptr);
+        }
+    }
+
+    size_t size() const { return tree_.size(); }
+
+    /**
+     * Align a source cloud to the target
+     * Each iteration matches every transformed source point to its nearest target point in parallel,
+     * linearizes the rotation and solves the 6x6 normal equations for the incremental motion.
+     * @param source Row-major (M,3) source points
+     * @param count Number of source points M
+     * @param initial Initial source-to-target transform
+     * @param options Iteration limits and error metric
+     */
+    ICPResult align(const double* source, size_t count, const Eigen::Matrix4d& initial, const ICPOptions& options) const {
+        using Matrix6 = Eigen::Matrix<double, 6, 6>;
+        using Vector6 = Eigen::Matrix<double, 6, 1>;
+        struct Sums {
+            Matrix6 A = Matrix6::Zero();
+            Vector6 b = Vector6::Zero();
+            double error = 0.0;
+            size_t matches = 0;
+        };
+
+        ICPResult result;
+        result.transform = initial;
+        const size_t grain = 1024;
+        Scratch scratch;
+        std::span<Sums> chunks = scratch.array((count + grain - 1) / grain, Sums{});
+        double max_distance2 = options.max_distance * options.max_distance;
+
+        for (int iteration = 0; iteration < options.max_iterations; ++iteration) {
+            Eigen::Matrix3d R = result.transform.topLeftCorner<3, 3>();
+            Vec3 t = result.transform.topRightCorner<3, 1>();
+
+            // Per-chunk sums, reduced in chunk order so results do not depend on scheduling
+            parallel_for(count, grain, [&](size_t begin, size_t end) {
+                Sums sums;
+                Eigen::Matrix<double, 3, 6> J;
+                for (size_t i = begin; i < end; ++i) {
+                    Vec3 p = R * Eigen::Map<const Vec3>(source + 3 * i) + t;
+                    double best = max_distance2;
+                    uint32_t j = tree_.nearest(p, best);
+                    if (j == std::numeric_limits<uint32_t>::max())
+                        continue;
+                    const Vec3& q = points_[j];
+                    if (options.point_to_plane) {
+                        Vec3 n = Eigen::Map<const Vec3>(normals_.data() + 3 * size_t(j));
+                        Vector6 row;
+                        row << p.cross(n), n;
+                        double r = n.dot(p - q);
+                        sums.A.noalias() += row * row.transpose();
+                        sums.b.noalias() -= row * r;
+                        sums.error += r * r;
+                    } else {
+                        J.leftCols<3>() << 0, p[2], -p[1], -p[2], 0, p[0], p[1], -p[0], 0;
+                        J.rightCols<3>().setIdentity();
+                        Vec3 r = p - q;
+                        sums.A.noalias() += J.transpose() * J;
+                        sums.b.noalias() -= J.transpose() * r;
+                        sums.error += r.squaredNorm();
+                    }
+                    ++sums.matches;
+                }
+                chunks[begin / grain] = sums;
+            });
+
+            Sums total;
+            for (const Sums& sums : chunks) {
+                total.A += sums.A;
+                total.b += sums.b;
+                total.error += sums.error;
+                total.matches += sums.matches;
+            }
+            if (total.matches < 6)
+                break;
+            double rms = std::sqrt(total.error / double(total.matches));
+            result.residuals.push_back(rms);
+            if (result.residuals.size() > 1 && std::abs(result.residuals[result.residuals.size() - 2] - rms) < options.tolerance) {
+                result.converged = true;
+                break;
+            }
+
+            // x = (omega, translation); the rotation is rebuilt exactly from the axis-angle vector
+            Vector6 x = total.A.ldlt().solve(total.b);
+            if (!x.allFinite())
+                break;
+            Eigen::Matrix4d step = Eigen::Matrix4d::Identity();
+            double angle = x.head<3>().norm();
+            if (angle > 0)
+                step.topLeftCorner<3, 3>() = Eigen::AngleAxisd(angle, x.head<3>() / angle).toRotationMatrix();
+            step.topRightCorner<3, 1>() = x.tail<3>();
+            result.transform = step * result.transform;
+        }
+        return result;
+    }
+
+private:
+    KDTree tree_;
+    std::vector<Vec3> points_;     // target points in input order
+    std::vector<double> normals_;  // row-major target normals in input order
+};
+
+} // namespace compas
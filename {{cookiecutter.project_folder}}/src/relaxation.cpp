@@ -0,0 +1,74 @@
+#include "compas.h"
+#include "arrays.h"
+#include "relaxation.h"
+
+#include <nanobind/stl/optional.h>
+#include <optional>
+
+using namespace compas;
+
+using EdgesIn = nb::ndarray<const int32_t, nb::shape<-1, 2>, nb::c_contig, nb::device::cpu>;
+using MaskIn = nb::ndarray<const uint8_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Form-find a bar network by dynamic relaxation
+ * @param vertices (V,3) initial coordinates
+ * @param edges (E,2) vertex indices
+ * @param fixed (V,) non-zero for supports
+ * @param loads (V,3) external loads, or None
+ * @param force_densities (E,) force densities, or None
+ * @param stiffness (E,) axial stiffness EA, or None
+ * @param rest_lengths (E,) rest lengths, required with stiffness
+ * @param max_iterations Iteration limit
+ * @param tolerance Largest residual force norm at a free vertex
+ * @return Tuple of coordinates (V,3), residuals (V,3), axial forces (E,), iterations and convergence flag
+ */
+nb::tuple relax(const PointsIn& vertices, const EdgesIn& edges, const MaskIn& fixed, std::optional<PointsIn> loads,
+                std::optional<ValuesIn> force_densities, std::optional<ValuesIn> stiffness, std::optional<ValuesIn> rest_lengths,
+                int max_iterations, double tolerance) {
+    size_t V = vertices.shape(0), E = edges.shape(0);
+    check_edges(edges.data(), E, V);
+    if (fixed.shape(0) != V || (loads && loads->shape(0) != V))
+        throw std::invalid_argument("fixed and loads must have one row per vertex.");
+    if ((force_densities && force_densities->shape(0) != E) || (stiffness && stiffness->shape(0) != E) || (rest_lengths && rest_lengths->shape(0) != E))
+        throw std::invalid_argument("force_densities, stiffness and rest_lengths must have one entry per edge.");
+    if (stiffness && !rest_lengths)
+        throw std::invalid_argument("Rest lengths are required with stiffness.");
+    if (rest_lengths)
+        for (size_t e = 0; e < E; ++e)
+            if (!(rest_lengths->data()[e] > 0))
+                throw std::invalid_argument("Rest lengths must be positive.");
+
+    BarNetwork network;
+    network.vertex_count = V;
+    network.edges = edges.data();
+    network.edge_count = E;
+    network.force_densities = force_densities ? force_densities->data() : nullptr;
+    network.stiffness = stiffness ? stiffness->data() : nullptr;
+    network.rest_lengths = rest_lengths ? rest_lengths->data() : nullptr;
+    network.fixed = fixed.data();
+    network.loads = loads ? loads->data() : nullptr;
+    RelaxationOptions options;
+    options.max_iterations = max_iterations;
+    options.tolerance = tolerance;
+
+    ArrayBuffer<double> xyz(vertices.data(), vertices.data() + 3 * V);
+    RelaxationResult result;
+    {
+        nb::gil_scoped_release release;
+        result = dynamic_relaxation(network, xyz.data(), options);
+    }
+    return nb::make_tuple(to_ndarray(std::move(xyz), {V, 3}), to_ndarray(std::move(result.residuals), {V, 3}),
+                          to_ndarray(std::move(result.forces), {E}), result.iterations, result.converged);
+}
+
+NB_MODULE(_relaxation, m) {
+    m.doc() = "Dynamic relaxation form finding.";
+    share_memory_ledger();
+
+    m.def("dynamic_relaxation", &relax, "vertices"_a, "edges"_a, "fixed"_a, "loads"_a.none(), "force_densities"_a.none(),
+          "stiffness"_a.none(), "rest_lengths"_a.none(), "max_iterations"_a = 10000, "tolerance"_a = 1e-6,
+          "Find the equilibrium of a bar network by dynamic relaxation with kinetic damping");
+
+    def_arena_stats(m);
+}
@@ -0,0 +1,171 @@
+// relaxation.h - Dynamic relaxation with kinetic damping for cable nets and bar networks
+#pragma once
+
+#include "arena.h"
+#include "csr.h"
+#include "memory.h"
+#include "mesh.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Bar network borrowed from caller-owned buffers
+ * The axial force of edge e at length L is q[e] * L + stiffness[e] * (L - rest_lengths[e]) / rest_lengths[e],
+ * so q alone gives force-density behaviour and stiffness (EA) with rest lengths gives elastic bars.
+ */
+struct BarNetwork {
+    size_t vertex_count = 0;
+    const int32_t* edges = nullptr;
+    size_t edge_count = 0;
+    const double* force_densities = nullptr;  // (E,) or null for 0
+    const double* stiffness = nullptr;        // (E,) axial stiffness EA, or null for 0
+    const double* rest_lengths = nullptr;     // (E,) required if stiffness is set
+    const uint8_t* fixed = nullptr;           // (V,) non-zero for supports, or null
+    const double* loads = nullptr;            // (V,3) external loads, or null
+};
+
+struct RelaxationOptions {
+    int max_iterations = 10000;
+    double tolerance = 1e-6;  // largest residual force norm at a free vertex
+    double time_step = 1.0;
+};
+
+struct RelaxationResult {
+    ArrayBuffer<double> residuals;  // (V,3) out-of-balance forces, reactions at fixed vertices
+    ArrayBuffer<double> forces;     // (E,) axial forces, positive in tension
+    int iterations = 0;
+    bool converged = false;
+};
+
+/**
+ * Form-find a bar network by dynamic relaxation with kinetic damping (Barnes 1999)
+ * Each iteration computes edge forces in parallel over edges, then gathers them per vertex
+ * through the vertex-edge incidence lists, so no two threads write the same memory. Fictitious
+ * masses follow the stiffness of the incident edges so the time step is always stable. When the total
+ * kinetic energy drops, the last step is undone and all velocities are reset.
+ * @param network Edges, properties, supports and loads
+ * @param xyz Row-major (V,3) coordinates, the initial geometry on input and the equilibrium on output
+ * @param options Iteration limit and tolerance
+ */
+inline RelaxationResult dynamic_relaxation(const BarNetwork& network, double* xyz, const RelaxationOptions& options) {
+    const size_t V = network.vertex_count, E = network.edge_count;
+    const int32_t* edges = network.edges;
+    CSR incidence = vertex_edges(edges, E, V);
+
+    RelaxationResult result;
+    result.residuals.assign(3 * V, 0.0);
+    result.forces.assign(E, 0.0);
+    Scratch scratch;
+    std::span<double> tension = scratch.array<double>(E), velocity = scratch.array(3 * V, 0.0), mass = scratch.array(V, 0.0);
+    std::span<double> edge_force = scratch.array<double>(3 * E);
+
+    auto q = [&](size_t e) { return network.force_densities ? network.force_densities[e] : 0.0; };
+    auto k = [&](size_t e) { return network.stiffness ? network.stiffness[e] / network.rest_lengths[e] : 0.0; };
+    auto free = [&](size_t v) { return !network.fixed || !network.fixed[v]; };
+
+    // Edge forces as vectors from the first to the second vertex, scaled by force / length
+    auto update_forces = [&]() {
+        parallel_for(E, 4096, [&](size_t begin, size_t end) {
+            for (size_t e = begin; e < end; ++e) {
+                Eigen::Map<const Vec3> a(xyz + 3 * size_t(edges[2 * e])), b(xyz + 3 * size_t(edges[2 * e + 1]));
+                Vec3 d = b - a;
+                double length = d.norm();
+                double force = q(e) * length;
+                if (network.stiffness)
+                    force += network.stiffness[e] * (length - network.rest_lengths[e]) / network.rest_lengths[e];
+                result.forces[e] = force;
+                tension[e] = length > 0 ? force / length : 0.0;
+                Eigen::Map<Vec3>(edge_force.data() + 3 * e) = tension[e] * d;
+            }
+        });
+    };
+
+    // Residual per vertex gathered from incident edges; returns the largest free residual norm
+    const size_t grain = 4096;
+    std::span<double> chunk_max = scratch.array((V + grain - 1) / grain, 0.0), chunk_energy = scratch.array(chunk_max.size(), 0.0);
+    auto update_residuals = [&]() {
+        parallel_for(V, grain, [&](size_t begin, size_t end) {
+            double largest = 0.0;
+            for (size_t v = begin; v < end; ++v) {
+                Vec3 r = network.loads ? Vec3(Eigen::Map<const Vec3>(network.loads + 3 * v)) : Vec3::Zero();
+                for (uint32_t i = incidence.begin(v); i < incidence.end(v); ++i) {
+                    uint32_t e = incidence.items[i];
+                    Eigen::Map<const Vec3> f(edge_force.data() + 3 * size_t(e));
+                    if (static_cast<size_t>(edges[2 * e]) == v)
+                        r += f;
+                    if (static_cast<size_t>(edges[2 * e + 1]) == v)
+                        r -= f;
+                }
+                Eigen::Map<Vec3>(result.residuals.data() + 3 * v) = r;
+                if (free(v))
+                    largest = std::max(largest, r.norm());
+            }
+            chunk_max[begin / grain] = largest;
+        });
+        return chunk_max.empty() ? 0.0 : *std::max_element(chunk_max.begin(), chunk_max.end());
+    };
+
+    const double dt = options.time_step;
+    double previous_energy = 0.0;
+    update_forces();
+    double largest = update_residuals();
+    while (largest > options.tolerance && result.iterations < options.max_iterations) {
+        ++result.iterations;
+
+        // Fictitious masses from the axial and geometric stiffness of incident edges; m = dt^2 * sum
+        // keeps the Gershgorin bound of the largest frequency inside the stable range of the leapfrog step
+        parallel_for(V, grain, [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) {
+                double stiffness = 0.0;
+                for (uint32_t i = incidence.begin(v); i < incidence.end(v); ++i) {
+                    uint32_t e = incidence.items[i];
+                    stiffness += k(e) + std::abs(tension[e]);
+                }
+                mass[v] = std::max(dt * dt * stiffness, 1e-12);
+            }
+        });
+
+        parallel_for(V, grain, [&](size_t begin, size_t end) {
+            double energy = 0.0;
+            for (size_t v = begin; v < end; ++v) {
+                if (!free(v))
+                    continue;
+                Eigen::Map<Vec3> u(velocity.data() + 3 * v), x(xyz + 3 * v);
+                u += (dt / mass[v]) * Eigen::Map<const Vec3>(result.residuals.data() + 3 * v);
+                x += dt * u;
+                energy += mass[v] * u.squaredNorm();
+            }
+            chunk_energy[begin / grain] = energy;
+        });
+        double energy = 0.0;
+        for (double e : chunk_energy)
+            energy += e;
+
+        if (energy < previous_energy) {
+            // Kinetic energy peak passed: step back and restart from rest
+            parallel_for(V, grain, [&](size_t begin, size_t end) {
+                for (size_t v = begin; v < end; ++v) {
+                    Eigen::Map<Vec3> u(velocity.data() + 3 * v), x(xyz + 3 * v);
+                    x -= dt * u;
+                    u.setZero();
+                }
+            });
+            previous_energy = 0.0;
+        } else {
+            previous_energy = energy;
+        }
+        update_forces();
+        largest = update_residuals();
+    }
+    result.converged = largest <= options.tolerance;
+    return result;
+}
+
+} // namespace compas
@@ -0,0 +1,36 @@
+#include "compas.h"
+#include "arrays.h"
+#include "remesh.h"
+
+using namespace compas;
+
+/**
+ * Isotropic remeshing of a triangle mesh
+ * @param vertices (V,3) vertex coordinates
+ * @param faces (F,3) vertex indices per face
+ * @param target_length Target edge length
+ * @param iterations Number of split, collapse, flip and smoothing rounds
+ * @param project Project smoothed vertices back onto the input surface
+ * @return Tuple of vertices (V',3) and faces (F',3)
+ */
+nb::tuple remesh_mesh(const PointsIn& vertices, const FacesIn& faces, double target_length, int iterations, bool project) {
+    MeshView mesh = mesh_view(vertices, faces);
+    ArrayBuffer<double> points;
+    ArrayBuffer<int32_t> triangles;
+    {
+        nb::gil_scoped_release release;
+        remesh(mesh, RemeshOptions{target_length, iterations, project}).compact(points, triangles);
+    }
+    size_t V = points.size() / 3, F = triangles.size() / 3;
+    return nb::make_tuple(to_ndarray(std::move(points), {V, 3}), to_ndarray(std::move(triangles), {F, 3}));
+}
+
+NB_MODULE(_remesh, m) {
+    m.doc() = "Isotropic remeshing of triangle meshes.";
+    share_memory_ledger();
+
+    m.def("remesh", &remesh_mesh, "vertices"_a, "faces"_a, "target_length"_a, "iterations"_a = 10, "project"_a = true,
+          "Remesh a manifold triangle mesh towards a uniform target edge length");
+
+    def_arena_stats(m);
+}
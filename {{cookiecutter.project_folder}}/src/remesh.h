@@ -0,0 +1,257 @@
+// remesh.h - Isotropic remeshing by edge splits, collapses, flips and tangential smoothing
+#pragma once
+
+#include "arena.h"
+#include "closest.h"
+#include "halfedge.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace compas {
+
+struct RemeshOptions {
+    double target_length = 1.0;
+    int iterations = 10;
+    bool project = true;  // project smoothed vertices back onto the input surface
+};
+
+/**
+ * Greedy colouring of the live vertices so that no two neighbours share a colour
+ * @param mesh Half-edge mesh
+ * @param include Callable include(v) selecting the vertices to colour
+ * @return Vertices grouped by colour, each group in increasing index order
+ */
+template <class F>
+std::vector<std::vector<uint32_t>> color_vertices(const HalfEdgeMesh& mesh, F&& include) {
+    constexpr uint32_t NONE = HalfEdgeMesh::NONE;
+    Scratch scratch;
+    std::span<uint32_t> color = scratch.array(mesh.vertex_capacity(), NONE);
+    std::vector<std::vector<uint32_t>> groups;
+    std::vector<uint8_t> used;
+    for (uint32_t v = 0; v < mesh.vertex_capacity(); ++v) {
+        if (!mesh.vertex_alive(v) || !include(v))
+            continue;
+        used.assign(groups.size() + 1, 0);
+        mesh.for_each_neighbor(v, [&](uint32_t u) {
+            if (color[u] != NONE)
+                used[color[u]] = 1;
+        });
+        color[v] = static_cast<uint32_t>(std::find(used.begin(), used.end(), 0) - used.begin());
+        if (color[v] == groups.size())
+            groups.emplace_back();
+        groups[color[v]].push_back(v);
+    }
+    return groups;
+}
+
+/**
+ * Isotropic remeshing towards a target edge length (Botsch and Kobbelt 2004)
+ * Each iteration splits edges longer than 4/3 of the target, collapses edges shorter than 4/5 of it,
+ * flips edges to bring valences towards 6 (4 on the boundary) and moves vertices to the centroid of
+ * their neighbours within the tangent plane, then back onto the input surface. Splits and
+ * collapses run sequentially. Flips and smoothing run in parallel over colour classes: flips of
+ * one class touch disjoint vertex sets, smoothed vertices of one class are never neighbours, so
+ * the results do not depend on the number of threads. Boundary vertices are never moved or
+ * removed; boundary edges are only split.
+ * @param input Manifold triangle mesh
+ * @param options Target length, iterations and projection
+ * @return Remeshed mesh, compact() gives the output arrays
+ */
+inline HalfEdgeMesh remesh(const MeshView& input, const RemeshOptions& options) {
+    if (!(options.target_length > 0.0))
+        throw std::invalid_argument("The target edge length must be positive.");
+    HalfEdgeMesh mesh(input);
+    MeshProjector surface(input);
+    constexpr uint32_t NONE = HalfEdgeMesh::NONE;
+    const double high = 4.0 / 3.0 * options.target_length, low = 4.0 / 5.0 * options.target_length;
+    const double high2 = high * high, low2 = low * low;
+
+    auto length2 = [&](uint32_t h) { return (mesh.points[mesh.to(h)] - mesh.points[mesh.from(h)]).squaredNorm(); };
+    auto edge = [&](uint32_t h) {
+        return mesh.face_alive(HalfEdgeMesh::face(h)) && (mesh.twin(h) == NONE || h < mesh.twin(h));
+    };
+
+    // Longest edge first, keyed by its end vertices: a split rewrites the half-edges of its faces,
+    // so half-edge indices do not identify an edge for long, but vertices never move in this phase
+    auto split_long_edges = [&]() {
+        std::priority_queue<std::tuple<double, uint32_t, uint32_t>> queue;
+        auto push = [&](uint32_t a, uint32_t b) {
+            double l2 = (mesh.points[b] - mesh.points[a]).squaredNorm();
+            if (l2 > high2)
+                queue.emplace(l2, a, b);
+        };
+        for (uint32_t h = 0; h < mesh.halfedge_capacity(); ++h)
+            if (edge(h))
+                push(mesh.from(h), mesh.to(h));
+        while (!queue.empty()) {
+            auto [l2, a, b] = queue.top();
+            queue.pop();
+            uint32_t h = mesh.find_halfedge(a, b);
+            if (h == NONE)
+                h = mesh.find_halfedge(b, a);
+            if (h == NONE)
+                continue;  // split already
+            uint32_t c = mesh.opposite(h), d = mesh.twin(h) == NONE ? NONE : mesh.opposite(mesh.twin(h));
+            uint32_t m = mesh.split(h, 0.5 * (mesh.points[a] + mesh.points[b]));
+            for (uint32_t v : {a, b, c, d})
+                if (v != NONE)
+                    push(v, m);
+        }
+    };
+
+    // The merged vertex must not create long edges or fold the faces around it
+    auto keeps_shape = [&](uint32_t h, const Vec3& point) {
+        bool valid = true;
+        for (uint32_t v : {mesh.from(h), mesh.to(h)})
+            mesh.for_each_neighbor(v, [&](uint32_t u) { valid &= (mesh.points[u] - point).squaredNorm() <= high2; });
+        return valid && mesh.collapse_keeps_orientation(h, point);
+    };
+
+    auto collapse_short_edges = [&]() {
+        size_t count = mesh.halfedge_capacity();
+        for (uint32_t h = 0; h < count; ++h) {
+            if (!edge(h) || mesh.twin(h) == NONE || length2(h) >= low2)
+                continue;
+            // Remove the interior vertex; between two interior vertices the survivor moves to the midpoint
+            uint32_t g = mesh.boundary_vertex(mesh.from(h)) ? mesh.twin(h) : h;
+            uint32_t a = mesh.from(g), b = mesh.to(g);
+            if (mesh.boundary_vertex(a) || !mesh.can_collapse(g))
+                continue;
+            Vec3 point = mesh.boundary_vertex(b) ? mesh.points[b] : Vec3(0.5 * (mesh.points[a] + mesh.points[b]));
+            if (!keeps_shape(g, point))
+                continue;
+            mesh.collapse(g);
+            mesh.points[b] = point;
+        }
+    };
+
+    auto target = [&](uint32_t v) { return mesh.boundary_vertex(v) ? 4 : 6; };
+    auto flip_gain = [&](uint32_t h) {
+        if (mesh.twin(h) == NONE)
+            return 0;
+        std::array<uint32_t, 4> v = {mesh.from(h), mesh.to(h), mesh.opposite(h), mesh.opposite(mesh.twin(h))};
+        std::array<int, 4> change = {-1, -1, 1, 1};
+        int before = 0, after = 0;
+        for (int k = 0; k < 4; ++k) {
+            int valence = static_cast<int>(mesh.valence(v[k]));
+            before += std::abs(valence - target(v[k]));
+            after += std::abs(valence + change[k] - target(v[k]));
+        }
+        if (after >= before || !mesh.can_flip(h))
+            return 0;
+        // The new faces must keep the orientation of the old ones
+        const Vec3 &a = mesh.points[v[0]], &b = mesh.points[v[1]], &c = mesh.points[v[2]], &d = mesh.points[v[3]];
+        Vec3 n = (b - a).cross(c - a) + (a - b).cross(d - b);
+        if ((a - c).cross(d - c).dot(n) <= 0.0 || (b - d).cross(c - d).dot(n) <= 0.0)
+            return 0;
+        return before - after;
+    };
+
+    auto equalize_valences = [&]() {
+        size_t count = mesh.halfedge_capacity();
+        Scratch scratch;
+        std::span<uint8_t> candidate = scratch.array<uint8_t>(count);
+        parallel_for(count, 1024, [&](size_t begin, size_t end) {
+            for (size_t h = begin; h < end; ++h)
+                candidate[h] = edge(static_cast<uint32_t>(h)) && flip_gain(static_cast<uint32_t>(h)) > 0;
+        });
+
+        // Colour the candidates so that flips of one colour touch disjoint vertices
+        using Footprint = std::array<uint32_t, 4>;
+        std::span<uint64_t> used = scratch.array<uint64_t>(mesh.vertex_capacity(), 0);
+        std::vector<std::vector<std::pair<uint32_t, Footprint>>> classes(64);
+        for (uint32_t h = 0; h < count; ++h) {
+            if (!candidate[h])
+                continue;
+            Footprint v = {mesh.from(h), mesh.to(h), mesh.opposite(h), mesh.opposite(mesh.twin(h))};
+            uint64_t taken = used[v[0]] | used[v[1]] | used[v[2]] | used[v[3]];
+            if (taken == ~uint64_t(0))
+                continue;  // left for the next iteration
+            int color = std::countr_one(taken);
+            for (uint32_t u : v)
+                used[u] |= uint64_t(1) << color;
+            classes[color].emplace_back(h, v);
+        }
+
+        for (auto& flips : classes) {
+            // Earlier classes may have changed the faces around a candidate, which also breaks the colouring
+            flips.erase(std::remove_if(flips.begin(), flips.end(), [&](const auto& flip) {
+                uint32_t h = flip.first;
+                return !mesh.face_alive(HalfEdgeMesh::face(h)) || mesh.twin(h) == NONE ||
+                       Footprint{mesh.from(h), mesh.to(h), mesh.opposite(h), mesh.opposite(mesh.twin(h))} != flip.second;
+            }), flips.end());
+            parallel_for(flips.size(), 64, [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k)
+                    if (flip_gain(flips[k].first) > 0)
+                        mesh.flip(flips[k].first);
+            });
+        }
+    };
+
+    auto tangential_relaxation = [&]() {
+        auto groups = color_vertices(mesh, [&](uint32_t v) { return !mesh.boundary_vertex(v); });
+        for (const auto& group : groups) {
+            parallel_for(group.size(), 256, [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k) {
+                    uint32_t v = group[k];
+                    Vec3 centroid = Vec3::Zero(), normal = Vec3::Zero();
+                    double area = 0.0;
+                    mesh.for_each_outgoing(v, [&](uint32_t h) {
+                        // Area-weighted centroid of the one-ring faces
+                        Vec3 n = mesh.face_normal(HalfEdgeMesh::face(h));
+                        double w = n.norm();
+                        centroid += w * (mesh.points[mesh.to(h)] + mesh.points[mesh.opposite(h)] + mesh.points[v]) / 3.0;
+                        area += w;
+                        normal += n;
+                    });
+                    if (!(area > 0.0) || !(normal.norm() > 0.0))
+                        continue;
+                    centroid /= area;
+                    normal.normalize();
+                    Vec3& p = mesh.points[v];
+                    p = centroid + normal * normal.dot(p - centroid);
+                }
+            });
+        }
+    };
+
+    auto project_to_surface = [&]() {
+        Scratch scratch;
+        std::span<uint32_t> moved = scratch.array<uint32_t>(mesh.vertex_capacity());
+        size_t count = 0;
+        for (uint32_t v = 0; v < mesh.vertex_capacity(); ++v)
+            if (mesh.vertex_alive(v) && !mesh.boundary_vertex(v))
+                moved[count++] = v;
+        moved = moved.first(count);
+        std::span<double> points = scratch.array<double>(3 * moved.size());
+        for (size_t k = 0; k < moved.size(); ++k)
+            std::copy(mesh.points[moved[k]].data(), mesh.points[moved[k]].data() + 3, points.data() + 3 * k);
+        Projection projection = surface.project(points.data(), moved.size());
+        for (size_t k = 0; k < moved.size(); ++k)
+            if (projection.ids[k] >= 0)
+                mesh.points[moved[k]] = Eigen::Map<const Vec3>(projection.points.data() + 3 * k);
+    };
+
+    for (int i = 0; i < options.iterations; ++i) {
+        split_long_edges();
+        collapse_short_edges();
+        equalize_valences();
+        tangential_relaxation();
+        if (options.project)
+            project_to_surface();
+    }
+    return mesh;
+}
+
+} // namespace compas
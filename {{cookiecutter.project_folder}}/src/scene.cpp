@@ -0,0 +1,131 @@
+#include "compas.h"
+#include "arrays.h"
+#include "scene.h"
+
+#include <mutex>
+#include <shared_mutex>
+
+using namespace compas;
+
+using IndicesIn = nb::ndarray<const int32_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+using TransformIn = nb::ndarray<const double, nb::shape<4, 4>, nb::c_contig, nb::device::cpu>;
+using TransformsIn = nb::ndarray<const double, nb::shape<-1, 4, 4>, nb::c_contig, nb::device::cpu>;
+using TransformsView = nb::ndarray<nb::numpy, const double, nb::shape<-1, 4, 4>>;
+
+/**
+ * Read-only view of a transform buffer
+ * The capsule holds a reference to the shared buffer, so the view stays valid after nodes are
+ * added or the scene graph is garbage collected.
+ */
+TransformsView buffer_view(const std::shared_ptr<std::vector<double>>& buffer) {
+    auto* owner = new std::shared_ptr<std::vector<double>>(buffer);
+    nb::capsule deleter(owner, [](void* p) noexcept {
+        delete static_cast<std::shared_ptr<std::vector<double>>*>(p);
+    });
+    return TransformsView((*owner)->data(), {(*owner)->size() / 16, 4, 4}, deleter);
+}
+
+/**
+ * Scene graph shared by Python threads
+ * update() runs without the GIL, so it and every mutator hold the mutex exclusively while the
+ * reads hold it shared; views are created after the lock is released, from a copy of the buffer.
+ */
+struct SharedSceneGraph {
+    SceneGraph graph;
+    std::shared_mutex mutex;
+
+    SharedSceneGraph() = default;
+    SharedSceneGraph(const int32_t* parents, const double* locals, size_t count) : graph(parents, locals, count) {}
+};
+
+/**
+ * Set the local transforms of many nodes
+ * @param self Scene graph
+ * @param indices (K,) node indices
+ * @param locals (K,4,4) local transforms
+ */
+void set_locals(SharedSceneGraph& self, const IndicesIn& indices, const TransformsIn& locals) {
+    if (indices.shape(0) != locals.shape(0))
+        throw std::invalid_argument("Expected one transform per node index.");
+    std::unique_lock<std::shared_mutex> write(self.mutex);
+    self.graph.set_locals(indices.data(), locals.data(), indices.shape(0));
+}
+
+/**
+ * Recompute dirty world transforms without the GIL
+ * @param self Scene graph
+ * @return Number of recomputed nodes
+ */
+size_t update(SharedSceneGraph& self) {
+    nb::gil_scoped_release release;
+    std::unique_lock<std::shared_mutex> write(self.mutex);
+    return self.graph.update();
+}
+
+/**
+ * World transforms of all nodes, updated first if needed
+ * @param self Scene graph
+ * @return (N,4,4) read-only view of the world transforms, of the current nodes only
+ */
+TransformsView worlds_view(SharedSceneGraph& self) {
+    std::shared_ptr<std::vector<double>> worlds;
+    {
+        nb::gil_scoped_release release;
+        std::unique_lock<std::shared_mutex> write(self.mutex);
+        self.graph.update();
+        worlds = self.graph.worlds();
+    }
+    return buffer_view(worlds);
+}
+
+NB_MODULE(_scene, m) {
+    m.doc() = "Transform hierarchies with incremental world transform evaluation.";
+    share_memory_ledger();
+
+    nb::class_<SharedSceneGraph>(m, "SceneGraph")
+        .def(nb::init<>())
+        .def("__init__", [](SharedSceneGraph* self, const IndicesIn& parents, const TransformsIn& locals) {
+            if (parents.shape(0) != locals.shape(0))
+                throw std::invalid_argument("Expected one local transform per node.");
+            new (self) SharedSceneGraph(parents.data(), locals.data(), parents.shape(0));
+        }, "parents"_a, "locals"_a, "Create nodes from (N,) parent indices, -1 for roots, and (N,4,4) local transforms")
+        .def("__len__", [](SharedSceneGraph& self) {
+            std::shared_lock<std::shared_mutex> read(self.mutex);
+            return self.graph.size();
+        })
+        .def("add", [](SharedSceneGraph& self, int32_t parent, const TransformIn& local) {
+            std::unique_lock<std::shared_mutex> write(self.mutex);
+            return self.graph.add(parent, local.data());
+        }, "parent"_a, "local"_a, "Append a node and return its index")
+        .def("set_parent", [](SharedSceneGraph& self, uint32_t index, int32_t parent) {
+            std::unique_lock<std::shared_mutex> write(self.mutex);
+            self.graph.set_parent(index, parent);
+        }, "index"_a, "parent"_a, "Move a node and its subtree under another parent, -1 to make it a root")
+        .def("set_local", [](SharedSceneGraph& self, uint32_t index, const TransformIn& local) {
+            std::unique_lock<std::shared_mutex> write(self.mutex);
+            self.graph.set_local(index, local.data());
+        }, "index"_a, "local"_a, "Set the local transform of a node")
+        .def("set_locals", &set_locals, "indices"_a, "locals"_a, "Set the local transforms of many nodes")
+        .def("parent", [](SharedSceneGraph& self, uint32_t index) {
+            std::shared_lock<std::shared_mutex> read(self.mutex);
+            if (index >= self.graph.size())
+                throw std::out_of_range("Node " + std::to_string(index) + " does not exist.");
+            return self.graph.parent(index);
+        }, "index"_a, "Parent index of a node, -1 for roots")
+        .def("update", &update, "Recompute dirty world transforms and return the number of recomputed nodes")
+        .def_prop_ro("dirty", [](SharedSceneGraph& self) {
+            std::shared_lock<std::shared_mutex> read(self.mutex);
+            return self.graph.dirty();
+        })
+        .def_prop_ro("locals", [](SharedSceneGraph& self) {
+            std::shared_ptr<std::vector<double>> locals;
+            {
+                std::shared_lock<std::shared_mutex> read(self.mutex);
+                locals = self.graph.locals();
+            }
+            return buffer_view(locals);
+        })
+        .def_prop_ro("worlds", &worlds_view);
+
+    def_arena_stats(m);
+}
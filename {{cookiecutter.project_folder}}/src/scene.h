@@ -0,0 +1,260 @@
+// scene.h - Transform hierarchy with incremental world transform evaluation
+#pragma once
+
+#include "arena.h"
+#include "parallel.h"
+#include "transform.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Flat, parent-indexed tree of frames
+ * Every node stores a local transform relative to its parent; world transforms are
+ * world[i] = world[parent[i]] * local[i]. Changing a local transform only marks the node
+ * dirty; update() recomputes the dirty nodes and their descendants, one depth level at a
+ * time so that all nodes of a level can be evaluated in parallel.
+ * The transform buffers are shared so that array views can keep them alive; a buffer seen by a
+ * view is replaced rather than reallocated when nodes are added, leaving the view on the old nodes.
+ */
+class SceneGraph {
+public:
+    SceneGraph() = default;
+
+    /**
+     * @param parents (N,) parent index per node, -1 for roots
+     * @param locals Row-major (N,4,4) local transforms
+     * @param count Number of nodes N
+     */
+    SceneGraph(const int32_t* parents, const double* locals, size_t count)
+        : parents_(parents, parents + count), locals_(std::make_shared<std::vector<double>>(locals, locals + 16 * count)),
+          worlds_(std::make_shared<std::vector<double>>(16 * count)), dirty_(count, 1) {
+        for (size_t i = 0; i < count; ++i)
+            check_parent(i, parents_[i]);
+        rebuild();
+        pending_.resize(count);
+        for (size_t i = 0; i < count; ++i)
+            pending_[i] = static_cast<uint32_t>(i);
+    }
+
+    size_t size() const { return parents_.size(); }
+
+    /**
+     * Append a node
+     * Views of the transform buffers taken before keep the previous nodes.
+     * @return Index of the new node
+     */
+    uint32_t add(int32_t parent, const double* local) {
+        uint32_t index = static_cast<uint32_t>(parents_.size());
+        check_parent(index, parent);
+        grow(locals_);
+        grow(worlds_);
+        std::copy(local, local + 16, locals_->end() - 16);
+        parents_.push_back(parent);
+        dirty_.push_back(0);
+        mark(index);
+        topology_changed_ = true;
+        return index;
+    }
+
+    /**
+     * Move a node and its subtree under another parent
+     * @throws std::invalid_argument if this would create a cycle
+     */
+    void set_parent(uint32_t index, int32_t parent) {
+        check_index(index);
+        check_parent(index, parent);
+        for (int32_t p = parent; p >= 0; p = parents_[p])
+            if (static_cast<uint32_t>(p) == index)
+                throw std::invalid_argument("Node " + std::to_string(parent) + " is a descendant of node " + std::to_string(index) + ".");
+        parents_[index] = parent;
+        mark(index);
+        topology_changed_ = true;
+    }
+
+    void set_local(uint32_t index, const double* local) {
+        check_index(index);
+        std::copy(local, local + 16, locals_->data() + 16 * size_t(index));
+        mark(index);
+    }
+
+    /**
+     * Set the local transforms of many nodes, none of them if an index is invalid
+     * @param indices (K,) node indices
+     * @param locals Row-major (K,4,4) local transforms
+     * @param count Number of nodes K
+     */
+    void set_locals(const int32_t* indices, const double* locals, size_t count) {
+        for (size_t k = 0; k < count; ++k)
+            check_index(static_cast<uint32_t>(indices[k]));
+        for (size_t k = 0; k < count; ++k)
+            set_local(static_cast<uint32_t>(indices[k]), locals + 16 * k);
+    }
+
+    int32_t parent(uint32_t index) const { return parents_[index]; }
+    const double* local(uint32_t index) const { return locals_->data() + 16 * size_t(index); }
+
+    /**
+     * Row-major (N,4,4) local transforms of all nodes
+     */
+    const std::shared_ptr<std::vector<double>>& locals() const { return locals_; }
+
+    /**
+     * Row-major (N,4,4) world transforms of all nodes, valid after update()
+     */
+    const std::shared_ptr<std::vector<double>>& worlds() const { return worlds_; }
+
+    bool dirty() const { return !pending_.empty(); }
+
+    /**
+     * Recompute the world transforms of dirty nodes and their descendants
+     * @return Number of recomputed nodes
+     */
+    size_t update() {
+        if (pending_.empty())
+            return 0;
+        if (topology_changed_)
+            rebuild();
+
+        // Bucket the dirty nodes by depth with a counting sort
+        Scratch scratch;
+        size_t levels = size_t(max_depth_) + 1;
+        std::span<uint32_t> offsets = scratch.array<uint32_t>(levels + 1, 0), cursor = scratch.array<uint32_t>(levels);
+        std::span<uint32_t> pending = scratch.array<uint32_t>(pending_.size());
+        for (uint32_t i : pending_)
+            ++offsets[depth_[i] + 1];
+        for (size_t d = 0; d < levels; ++d)
+            offsets[d + 1] += offsets[d];
+        std::copy(offsets.begin(), offsets.end() - 1, cursor.begin());
+        for (uint32_t i : pending_)
+            pending[cursor[depth_[i]]++] = i;
+        pending_.clear();
+
+        // Each level is the dirty nodes of its depth plus the children queued by the level above;
+        // a node is queued at most once, since queued nodes are marked dirty
+        std::span<uint32_t> queue = scratch.array<uint32_t>(parents_.size());
+        size_t count = 0, begin = 0, end = 0;
+        for (size_t d = 0; d < levels; ++d) {
+            for (uint32_t k = offsets[d]; k < offsets[d + 1]; ++k)
+                queue[end++] = pending[k];
+            std::span<const uint32_t> level = queue.subspan(begin, end - begin);
+            begin = end;
+            parallel_for(level.size(), 256, [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k) {
+                    uint32_t i = level[k];
+                    double* world = worlds_->data() + 16 * size_t(i);
+                    if (parents_[i] < 0)
+                        std::copy(local(i), local(i) + 16, world);
+                    else
+                        multiply_transform(worlds_->data() + 16 * size_t(parents_[i]), local(i), world);
+                }
+            });
+            count += level.size();
+            if (d + 1 < levels) {
+                for (uint32_t i : level) {
+                    for (uint32_t c = child_offsets_[i]; c < child_offsets_[i + 1]; ++c) {
+                        uint32_t child = children_[c];
+                        if (!dirty_[child]) {
+                            dirty_[child] = 1;
+                            queue[end++] = child;
+                        }
+                    }
+                }
+            }
+            for (uint32_t i : level)
+                dirty_[i] = 0;
+        }
+        return count;
+    }
+
+private:
+    void check_index(uint32_t index) const {
+        if (index >= parents_.size())
+            throw std::out_of_range("Node " + std::to_string(index) + " does not exist.");
+    }
+
+    void check_parent(size_t index, int32_t parent) const {
+        if (parent < -1 || (parent >= 0 && static_cast<size_t>(parent) >= parents_.size()) || static_cast<size_t>(parent) == index)
+            throw std::out_of_range("Invalid parent " + std::to_string(parent) + " for node " + std::to_string(index) + ".");
+    }
+
+    /**
+     * Make room for one more transform, in a new buffer if a view holds the current one
+     */
+    static void grow(std::shared_ptr<std::vector<double>>& buffer) {
+        if (buffer.use_count() > 1)
+            buffer = std::make_shared<std::vector<double>>(*buffer);
+        buffer->resize(buffer->size() + 16);
+    }
+
+    void mark(uint32_t index) {
+        if (!dirty_[index]) {
+            dirty_[index] = 1;
+            pending_.push_back(index);
+        }
+    }
+
+    /**
+     * Recompute depths and the children lists after parents changed
+     * @throws std::invalid_argument if the parent links contain a cycle
+     */
+    void rebuild() {
+        size_t n = parents_.size();
+        depth_.assign(n, -1);
+        max_depth_ = 0;
+        Scratch scratch;
+        std::span<uint32_t> path = scratch.array<uint32_t>(n);
+        for (size_t i = 0; i < n; ++i) {
+            // Walk up to the first node with a known depth, then assign depths on the way back
+            uint32_t v = static_cast<uint32_t>(i);
+            size_t top = 0;
+            while (depth_[v] < 0) {
+                if (top == n)
+                    throw std::invalid_argument("The parent links contain a cycle.");
+                path[top++] = v;
+                if (parents_[v] < 0)
+                    break;
+                v = static_cast<uint32_t>(parents_[v]);
+            }
+            int32_t d = depth_[v] >= 0 ? depth_[v] : -1;
+            while (top)
+                depth_[path[--top]] = ++d;
+            max_depth_ = std::max(max_depth_, d);
+        }
+
+        child_offsets_.assign(n + 1, 0);
+        for (size_t i = 0; i < n; ++i)
+            if (parents_[i] >= 0)
+                ++child_offsets_[parents_[i] + 1];
+        for (size_t i = 0; i < n; ++i)
+            child_offsets_[i + 1] += child_offsets_[i];
+        children_.resize(child_offsets_[n]);
+        std::span<uint32_t> cursor = scratch.array<uint32_t>(n);
+        std::copy(child_offsets_.begin(), child_offsets_.end() - 1, cursor.begin());
+        for (size_t i = 0; i < n; ++i)
+            if (parents_[i] >= 0)
+                children_[cursor[parents_[i]]++] = static_cast<uint32_t>(i);
+        topology_changed_ = false;
+    }
+
+    std::vector<int32_t> parents_;
+    std::shared_ptr<std::vector<double>> locals_ = std::make_shared<std::vector<double>>();  // row-major (N,4,4)
+    std::shared_ptr<std::vector<double>> worlds_ = std::make_shared<std::vector<double>>();  // row-major (N,4,4)
+    std::vector<uint8_t> dirty_;
+    std::vector<uint32_t> pending_;  // nodes marked dirty since the last update
+
+    bool topology_changed_ = true;
+    std::vector<int32_t> depth_;
+    int32_t max_depth_ = 0;
+    std::vector<uint32_t> child_offsets_;
+    std::vector<uint32_t> children_;
+};
+
+} // namespace compas
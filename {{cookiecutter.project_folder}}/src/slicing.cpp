@@ -0,0 +1,40 @@
+#include "compas.h"
+#include "arrays.h"
+#include "slicing.h"
+
+using namespace compas;
+
+/**
+ * Slice a mesh with many planes
+ * @param vertices (V,3) vertex coordinates
+ * @param faces (F,3) vertex indices per face
+ * @param origins (K,3) points on the planes
+ * @param normals (K,3) plane normals
+ * @return Tuple of points (P,3), polyline offsets (L+1,), plane index (L,) and closed flag (L,) per polyline
+ */
+nb::tuple slice_mesh_planes(const PointsIn& vertices, const FacesIn& faces, const PointsIn& origins, const PointsIn& normals) {
+    MeshView mesh = mesh_view(vertices, faces);
+    if (origins.shape(0) != normals.shape(0))
+        throw std::invalid_argument("Expected as many plane normals as plane origins.");
+
+    Contours contours;
+    {
+        nb::gil_scoped_release release;
+        contours = slice_mesh(mesh, origins.data(), normals.data(), origins.shape(0));
+    }
+    size_t points = contours.points.size() / 3, polylines = contours.planes.size();
+    return nb::make_tuple(to_ndarray(std::move(contours.points), {points, 3}),
+                          to_ndarray(std::move(contours.offsets), {polylines + 1}),
+                          to_ndarray(std::move(contours.planes), {polylines}),
+                          to_ndarray(std::move(contours.closed), {polylines}));
+}
+
+NB_MODULE(_slicing, m) {
+    m.doc() = "Plane slicing of triangle meshes.";
+    share_memory_ledger();
+
+    m.def("slice_mesh", &slice_mesh_planes, "vertices"_a, "faces"_a, "origins"_a, "normals"_a,
+          "Intersect a mesh with (K,3) planes and chain the segments into polylines");
+
+    def_arena_stats(m);
+}
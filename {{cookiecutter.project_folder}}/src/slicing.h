@@ -0,0 +1,164 @@
+// slicing.h - Plane slicing of triangle meshes into polylines
+#pragma once
+
+#include "arena.h"
+#include "memory.h"
+#include "mesh.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace compas {
+
+/**
+ * Polylines produced by slicing a mesh, stored back to back
+ * Closed polylines repeat their first point at the end.
+ */
+struct Contours {
+    ArrayBuffer<double> points;     // (P,3) polyline vertices
+    ArrayBuffer<int64_t> offsets;   // (L+1,) vertex offsets per polyline
+    ArrayBuffer<int32_t> planes;    // (L,) plane index per polyline
+    ArrayBuffer<uint8_t> closed;    // (L,) 1 if the polyline is closed
+
+    Contours() : offsets(1, 0) {}
+
+    void append(const Contours& other) {
+        int64_t base = offsets.back();
+        points.insert(points.end(), other.points.begin(), other.points.end());
+        for (size_t i = 1; i < other.offsets.size(); ++i)
+            offsets.push_back(base + other.offsets[i]);
+        planes.insert(planes.end(), other.planes.begin(), other.planes.end());
+        closed.insert(closed.end(), other.closed.begin(), other.closed.end());
+    }
+};
+
+/**
+ * Intersect a mesh with one plane and chain the segments into polylines
+ * Vertices on the plane count as lying on its positive side, so every crossed face contributes
+ * exactly one segment between two crossed edges. Segments are keyed by their edges and chained
+ * through tables sorted by edge; contours run counterclockwise seen from the tip of the normal for
+ * closed, consistently oriented meshes.
+ * @param mesh Triangle mesh
+ * @param origin Point on the plane
+ * @param normal Plane normal
+ * @param plane Plane index recorded with each polyline
+ */
+inline Contours slice_plane(const MeshView& mesh, const Vec3& origin, const Vec3& normal, int32_t plane) {
+    Contours result;
+    Scratch scratch;
+    std::span<double> distance = scratch.array<double>(mesh.vertex_count);
+    for (size_t v = 0; v < mesh.vertex_count; ++v)
+        distance[v] = normal.dot(mesh.vertex(v) - origin);
+
+    auto edge_key = [](uint32_t i, uint32_t j) {
+        return i < j ? (uint64_t(i) << 32) | j : (uint64_t(j) << 32) | i;
+    };
+
+    // One segment per crossed face, from the edge leaving the positive side to the edge entering it
+    std::span<std::pair<uint64_t, uint64_t>> segments = scratch.array<std::pair<uint64_t, uint64_t>>(mesh.face_count);
+    size_t count = 0;
+    for (size_t f = 0; f < mesh.face_count; ++f) {
+        const int32_t* face = mesh.faces + 3 * f;
+        uint64_t from = 0, to = 0;
+        int crossings = 0;
+        for (int k = 0; k < 3; ++k) {
+            uint32_t i = static_cast<uint32_t>(face[k]), j = static_cast<uint32_t>(face[(k + 1) % 3]);
+            bool above_i = distance[i] >= 0, above_j = distance[j] >= 0;
+            if (above_i == above_j)
+                continue;
+            (above_i ? from : to) = edge_key(i, j);
+            ++crossings;
+        }
+        if (crossings == 2)
+            segments[count++] = {from, to};
+    }
+    if (count == 0)
+        return result;
+    segments = segments.first(count);
+
+    // Segments by start and end edge; on non-manifold edges the first segment wins
+    using Entry = std::pair<uint64_t, uint32_t>;
+    std::span<Entry> outgoing = scratch.array<Entry>(count), incoming = scratch.array<Entry>(count);
+    for (uint32_t s = 0; s < count; ++s) {
+        outgoing[s] = {segments[s].first, s};
+        incoming[s] = {segments[s].second, s};
+    }
+    std::sort(outgoing.begin(), outgoing.end());
+    std::sort(incoming.begin(), incoming.end());
+    constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+    auto find = [](std::span<const Entry> table, uint64_t key) {
+        auto it = std::lower_bound(table.begin(), table.end(), Entry(key, 0));
+        return it != table.end() && it->first == key ? it->second : none;
+    };
+
+    auto emit = [&](uint64_t key) {
+        uint32_t i = static_cast<uint32_t>(key >> 32), j = static_cast<uint32_t>(key);
+        double t = distance[i] / (distance[i] - distance[j]);
+        Vec3 p = mesh.vertex(i) + t * (mesh.vertex(j) - mesh.vertex(i));
+        size_t n = result.points.size();
+        // Crossings through a vertex on the plane produce repeated points
+        if (n > 3 * size_t(result.offsets.back()) && p == Vec3(result.points[n - 3], result.points[n - 2], result.points[n - 1]))
+            return;
+        result.points.insert(result.points.end(), p.data(), p.data() + 3);
+    };
+
+    std::span<uint8_t> used = scratch.array<uint8_t>(count, 0);
+    auto chain = [&](uint32_t s) {
+        uint64_t start = segments[s].first;
+        emit(start);
+        while (true) {
+            used[s] = 1;
+            uint64_t end = segments[s].second;
+            emit(end);
+            uint32_t next = find(outgoing, end);
+            if (end == start || next == none || used[next])
+                break;
+            s = next;
+        }
+        int64_t points = static_cast<int64_t>(result.points.size() / 3);
+        if (points - result.offsets.back() < 2) {
+            result.points.resize(3 * result.offsets.back());
+            return;
+        }
+        result.offsets.push_back(points);
+        result.planes.push_back(plane);
+        result.closed.push_back(segments[s].second == start);
+    };
+
+    // Open chains first, starting where no segment comes in, then the remaining closed loops
+    for (uint32_t s = 0; s < count; ++s)
+        if (!used[s] && find(incoming, segments[s].first) == none)
+            chain(s);
+    for (uint32_t s = 0; s < count; ++s)
+        if (!used[s])
+            chain(s);
+    return result;
+}
+
+/**
+ * Slice a mesh with many planes in parallel
+ * @param mesh Triangle mesh
+ * @param origins Row-major (K,3) points on the planes
+ * @param normals Row-major (K,3) plane normals
+ * @param count Number of planes K
+ * @return Polylines of all planes, ordered by plane
+ */
+inline Contours slice_mesh(const MeshView& mesh, const double* origins, const double* normals, size_t count) {
+    std::vector<Contours> slices(count);
+    parallel_for(count, 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+            slices[k] = slice_plane(mesh, Vec3(origins[3 * k], origins[3 * k + 1], origins[3 * k + 2]),
+                                    Vec3(normals[3 * k], normals[3 * k + 1], normals[3 * k + 2]), static_cast<int32_t>(k));
+    });
+    Contours result;
+    for (const Contours& slice : slices)
+        result.append(slice);
+    return result;
+}
+
+} // namespace compas
@@ -0,0 +1,65 @@
+#include "compas.h"
+#include "arrays.h"
+#include "subdivision.h"
+
+using namespace compas;
+
+using IndicesIn = nb::ndarray<const int32_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+using MatrixIn = nb::ndarray<const double, nb::ndim<2>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Parse the name of a subdivision scheme
+ */
+SubdivisionScheme subdivision_scheme(const std::string& name) {
+    if (name == "catmull-clark")
+        return SubdivisionScheme::CATMULL_CLARK;
+    if (name == "loop")
+        return SubdivisionScheme::LOOP;
+    throw std::invalid_argument("Unknown subdivision scheme '" + name + "', expected 'catmull-clark' or 'loop'.");
+}
+
+/**
+ * Subdivide values attached to the input vertices
+ * @param values (V,D) values per input vertex, usually coordinates
+ * @return (V',D) values per subdivided vertex
+ */
+nb::ndarray<nb::numpy, double> apply(const Subdivision& self, const MatrixIn& values) {
+    if (values.shape(0) != self.input_vertex_count())
+        throw std::invalid_argument("values must have one row per input vertex.");
+    size_t dim = values.shape(1);
+    ArrayBuffer<double> out(self.vertex_count() * dim);
+    {
+        nb::gil_scoped_release release;
+        self.apply(values.data(), dim, out.data());
+    }
+    return to_ndarray(std::move(out), {self.vertex_count(), dim});
+}
+
+NB_MODULE(_subdivision, m) {
+    m.doc() = "Catmull-Clark and Loop subdivision through precomputed stencil tables.";
+    share_memory_ledger();
+
+    nb::class_<Subdivision>(m, "Subdivision")
+        .def("__init__",
+             [](Subdivision* self, const IndicesIn& faces, const OffsetsIn& offsets, size_t vertex_count, const std::string& scheme, int levels) {
+                 size_t F = offsets.shape(0) > 0 ? offsets.shape(0) - 1 : 0;
+                 check_offsets(offsets, F, faces.shape(0), "offsets");
+                 SubdivisionScheme rules = subdivision_scheme(scheme);
+                 nb::gil_scoped_release release;
+                 new (self) Subdivision(faces.data(), offsets.data(), F, vertex_count, rules, levels);
+             },
+             "faces"_a, "offsets"_a, "vertex_count"_a, "scheme"_a, "levels"_a,
+             "Subdivide the topology and compose the stencils of all levels")
+        .def_prop_ro("input_vertex_count", &Subdivision::input_vertex_count)
+        .def_prop_ro("vertex_count", &Subdivision::vertex_count)
+        .def_prop_ro("face_count", &Subdivision::face_count)
+        .def_prop_ro("stencil_size", &Subdivision::stencil_size)
+        .def("faces", [](const Subdivision& self) {
+                 ArrayBuffer<int32_t> faces(self.faces().begin(), self.faces().end());
+                 return to_ndarray(std::move(faces), {self.face_count(), self.face_size()});
+             },
+             "Vertex indices of the subdivided faces")
+        .def("apply", &apply, "values"_a, "Subdivide values attached to the input vertices");
+
+    def_arena_stats(m);
+}
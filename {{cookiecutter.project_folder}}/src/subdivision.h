@@ -0,0 +1,396 @@
+// subdivision.h - Catmull-Clark and Loop subdivision through precomputed stencil tables
+#pragma once
+
+#include "arena.h"
+#include "parallel.h"
+
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace compas {
+
+enum class SubdivisionScheme { CATMULL_CLARK, LOOP };
+
+/**
+ * Polygon mesh connectivity with numbered edges
+ * Corner k of the flat face array starts the half-edge from faces[k] to the next corner of its
+ * face. Each undirected edge has an index, and its one or two half-edges point to it.
+ */
+struct PolygonTopology {
+    size_t vertex_count = 0;
+    std::vector<int32_t> faces;    // flat corner array
+    std::vector<int64_t> offsets;  // (F+1,) corner offsets per face
+    std::vector<uint32_t> corner_face;
+    std::vector<uint32_t> corner_edge;
+    std::vector<std::array<uint32_t, 2>> edges;         // vertex pairs
+    std::vector<std::array<uint32_t, 2>> edge_corners;  // corners starting each half-edge, NONE on the boundary
+    std::vector<uint32_t> vertex_offsets;               // (V+1,) ranges into vertex_corners
+    std::vector<uint32_t> vertex_corners;               // corners grouped by vertex
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    size_t face_count() const { return offsets.size() - 1; }
+    size_t face_size(size_t f) const { return static_cast<size_t>(offsets[f + 1] - offsets[f]); }
+    bool boundary_edge(uint32_t e) const { return edge_corners[e][1] == NONE; }
+
+    uint32_t next(uint32_t k) const {
+        uint32_t f = corner_face[k];
+        return k + 1 < offsets[f + 1] ? k + 1 : static_cast<uint32_t>(offsets[f]);
+    }
+
+    uint32_t prev(uint32_t k) const {
+        uint32_t f = corner_face[k];
+        return k > offsets[f] ? k - 1 : static_cast<uint32_t>(offsets[f + 1] - 1);
+    }
+
+    /**
+     * @param face_indices Flat vertex indices of all faces
+     * @param face_offsets (F+1,) corner offsets per face
+     * @param face_count Number of faces F
+     * @param count Number of vertices V
+     * @throws std::out_of_range if a face references a missing vertex
+     * @throws std::invalid_argument if a face has fewer than three corners or an edge is not manifold
+     */
+    PolygonTopology(const int32_t* face_indices, const int64_t* face_offsets, size_t face_count, size_t count)
+        : vertex_count(count), faces(face_indices, face_indices + face_offsets[face_count]), offsets(face_offsets, face_offsets + face_count + 1) {
+        size_t C = faces.size();
+        corner_face.resize(C);
+        for (size_t f = 0; f < face_count; ++f) {
+            if (offsets[f + 1] - offsets[f] < 3)
+                throw std::invalid_argument("Face " + std::to_string(f) + " has fewer than three corners.");
+            for (int64_t k = offsets[f]; k < offsets[f + 1]; ++k)
+                corner_face[k] = static_cast<uint32_t>(f);
+        }
+        for (int32_t v : faces)
+            if (v < 0 || static_cast<size_t>(v) >= vertex_count)
+                throw std::out_of_range("A face references missing vertex " + std::to_string(v));
+
+        // Corners grouped by vertex; the twin of a->b starts at one of the corners of b
+        vertex_offsets.assign(vertex_count + 1, 0);
+        vertex_corners.resize(C);
+        for (int32_t v : faces)
+            ++vertex_offsets[v + 1];
+        for (size_t v = 0; v < vertex_count; ++v)
+            vertex_offsets[v + 1] += vertex_offsets[v];
+        {
+            Scratch scratch;
+            std::span<uint32_t> cursor = scratch.array<uint32_t>(vertex_count);
+            std::copy(vertex_offsets.begin(), vertex_offsets.end() - 1, cursor.begin());
+            for (uint32_t k = 0; k < C; ++k)
+                vertex_corners[cursor[faces[k]]++] = k;
+        }
+        corner_edge.assign(C, NONE);
+        for (uint32_t k = 0; k < C; ++k) {
+            if (corner_edge[k] != NONE)
+                continue;
+            uint32_t a = faces[k], b = faces[next(k)];
+            if (a == b)
+                throw std::invalid_argument("Face " + std::to_string(corner_face[k]) + " repeats a vertex.");
+            uint32_t e = static_cast<uint32_t>(edges.size());
+            edges.push_back({a, b});
+            edge_corners.push_back({k, NONE});
+            corner_edge[k] = e;
+            auto fail = [&]() {
+                throw std::invalid_argument("Edge (" + std::to_string(a) + ", " + std::to_string(b) + ") is not manifold or its faces are inconsistently oriented.");
+            };
+            for (uint32_t i = vertex_offsets[b]; i < vertex_offsets[b + 1]; ++i) {
+                uint32_t t = vertex_corners[i];
+                if (static_cast<uint32_t>(faces[next(t)]) != a)
+                    continue;
+                if (corner_edge[t] != NONE || edge_corners[e][1] != NONE)
+                    fail();
+                corner_edge[t] = e;
+                edge_corners[e][1] = t;
+            }
+            for (uint32_t i = vertex_offsets[a]; i < vertex_offsets[a + 1]; ++i)
+                if (vertex_corners[i] != k && static_cast<uint32_t>(faces[next(vertex_corners[i])]) == b)
+                    fail();
+        }
+    }
+};
+
+/**
+ * Subdivision of a fixed topology, evaluated as one sparse product per set of positions
+ * All levels are composed into a single stencil table whose rows give every vertex of the
+ * final mesh as a weighted sum of input vertices. Building the table costs one symbolic pass per
+ * level; subdividing moved vertices afterwards is a row-parallel sparse matrix-vector product.
+ * Catmull-Clark accepts any polygons and produces quads; Loop requires triangles. Boundaries
+ * follow the cubic B-spline crease rules; corners, that is boundary vertices with only two edges or
+ * with more than two boundary edges, are kept in place.
+ */
+class Subdivision {
+public:
+    using Stencils = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+    /**
+     * @param faces Flat vertex indices of all faces
+     * @param offsets (F+1,) corner offsets per face
+     * @param face_count Number of faces F
+     * @param vertex_count Number of input vertices V
+     * @param scheme Subdivision rules
+     * @param levels Number of subdivision steps, at least 1
+     */
+    Subdivision(const int32_t* faces, const int64_t* offsets, size_t face_count, size_t vertex_count, SubdivisionScheme scheme, int levels) {
+        if (levels < 1)
+            throw std::invalid_argument("levels must be at least 1.");
+        PolygonTopology topology(faces, offsets, face_count, vertex_count);
+        if (scheme == SubdivisionScheme::LOOP)
+            for (size_t f = 0; f < face_count; ++f)
+                if (topology.offsets[f + 1] - topology.offsets[f] != 3)
+                    throw std::invalid_argument("Loop subdivision requires triangles, face " + std::to_string(f) + " is not.");
+
+        for (int level = 0; level < levels; ++level) {
+            Stencils step = scheme == SubdivisionScheme::LOOP ? loop(topology) : catmull_clark(topology);
+            stencils_ = level == 0 ? std::move(step) : compose(step, stencils_);
+        }
+        faces_ = std::move(topology.faces);
+        face_count_ = topology.face_count();
+        face_size_ = scheme == SubdivisionScheme::LOOP ? 3 : 4;
+    }
+
+    size_t input_vertex_count() const { return static_cast<size_t>(stencils_.cols()); }
+    size_t vertex_count() const { return static_cast<size_t>(stencils_.rows()); }
+    size_t face_count() const { return face_count_; }
+    size_t face_size() const { return face_size_; }
+    size_t stencil_size() const { return static_cast<size_t>(stencils_.nonZeros()); }
+
+    /**
+     * @return Flat (F, face_size()) vertex indices of the subdivided faces
+     */
+    const std::vector<int32_t>& faces() const { return faces_; }
+
+    const Stencils& stencils() const { return stencils_; }
+
+    /**
+     * Subdivide positions, or any per-vertex values
+     * @param values Row-major (V,dim) input values
+     * @param dim Values per vertex
+     * @param out Row-major (vertex_count(),dim) output values
+     */
+    void apply(const double* values, size_t dim, double* out) const {
+        const int* outer = stencils_.outerIndexPtr();
+        const int* inner = stencils_.innerIndexPtr();
+        const double* weights = stencils_.valuePtr();
+        parallel_for(vertex_count(), 1024, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                double* row = out + dim * i;
+                std::fill(row, row + dim, 0.0);
+                for (int k = outer[i]; k < outer[i + 1]; ++k) {
+                    const double* source = values + dim * size_t(inner[k]);
+                    for (size_t d = 0; d < dim; ++d)
+                        row[d] += weights[k] * source[d];
+                }
+            }
+        });
+    }
+
+private:
+    using Row = std::vector<std::pair<int, double>>;
+
+    /**
+     * Build a stencil table row by row in parallel
+     * @param fill Callable fill(i, row) appending (column, weight) pairs of row i, columns may repeat
+     */
+    template <class F>
+    static Stencils assemble(size_t rows, size_t cols, F&& fill) {
+        constexpr size_t GRAIN = 1024;
+        const size_t chunks = (rows + GRAIN - 1) / GRAIN;
+        std::vector<Row> chunk_entries(chunks);
+        std::vector<Row> worker_rows(thread_count());
+        Scratch scratch;
+        std::span<int> counts = scratch.array(rows + 1, 0);
+        parallel_for(rows, GRAIN, [&](size_t begin, size_t end, size_t worker) {
+            Row& row = worker_rows[worker];
+            Row& entries = chunk_entries[begin / GRAIN];
+            for (size_t i = begin; i < end; ++i) {
+                row.clear();
+                fill(i, row);
+                std::sort(row.begin(), row.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+                size_t first = entries.size();
+                for (const auto& [j, w] : row) {
+                    if (entries.size() > first && entries.back().first == j)
+                        entries.back().second += w;
+                    else
+                        entries.emplace_back(j, w);
+                }
+                counts[i + 1] = static_cast<int>(entries.size() - first);
+            }
+        });
+
+        for (size_t i = 0; i < rows; ++i)
+            counts[i + 1] += counts[i];
+        Stencils result(static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(cols));
+        result.resizeNonZeros(counts[rows]);
+        std::copy(counts.begin(), counts.end(), result.outerIndexPtr());
+        parallel_for(chunks, 1, [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                int k = counts[c * GRAIN];
+                for (const auto& [j, w] : chunk_entries[c]) {
+                    result.innerIndexPtr()[k] = j;
+                    result.valuePtr()[k++] = w;
+                }
+            }
+        });
+        return result;
+    }
+
+    /**
+     * Product step * previous: every row of the step mixes a few rows of the previous table
+     */
+    static Stencils compose(const Stencils& step, const Stencils& previous) {
+        return assemble(static_cast<size_t>(step.rows()), static_cast<size_t>(previous.cols()), [&](size_t i, Row& row) {
+            for (Stencils::InnerIterator s(step, static_cast<Eigen::Index>(i)); s; ++s)
+                for (Stencils::InnerIterator p(previous, s.index()); p; ++p)
+                    row.emplace_back(static_cast<int>(p.index()), s.value() * p.value());
+        });
+    }
+
+    /**
+     * Vertex rule on the boundary: crease vertices with two boundary edges follow the cubic
+     * B-spline, corners and isolated vertices stay
+     * @return False if v is an interior vertex, which is left to the scheme
+     */
+    static bool boundary_row(const PolygonTopology& t, uint32_t v, Row& row) {
+        uint32_t begin = t.vertex_offsets[v], end = t.vertex_offsets[v + 1];
+        size_t degree = end - begin;
+        std::array<int, 2> creases;
+        size_t boundary = 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            uint32_t k = t.vertex_corners[i], before = t.prev(k);
+            // Outgoing boundary edge, and incoming boundary edge which no corner of v starts
+            for (auto [edge, neighbor] : {std::pair{t.corner_edge[k], t.next(k)}, std::pair{t.corner_edge[before], before}}) {
+                if (!t.boundary_edge(edge))
+                    continue;
+                if (boundary < 2)
+                    creases[boundary] = t.faces[neighbor];
+                ++boundary;
+            }
+        }
+        degree += boundary / 2;
+        if (degree > 0 && boundary == 0)
+            return false;
+        if (boundary == 2 && degree > 2) {
+            row.emplace_back(v, 0.75);
+            row.emplace_back(creases[0], 0.125);
+            row.emplace_back(creases[1], 0.125);
+        } else {
+            row.emplace_back(v, 1.0);
+        }
+        return true;
+    }
+
+    static void face_row(const PolygonTopology& t, uint32_t f, double weight, Row& row) {
+        double w = weight / double(t.face_size(f));
+        for (int64_t k = t.offsets[f]; k < t.offsets[f + 1]; ++k)
+            row.emplace_back(t.faces[k], w);
+    }
+
+    /**
+     * One Catmull-Clark step (Catmull and Clark 1978)
+     * New vertices are ordered as vertex points, edge points, face points; every face of n
+     * corners becomes n quads. Replaces the topology with the subdivided one.
+     */
+    static Stencils catmull_clark(PolygonTopology& t) {
+        const size_t V = t.vertex_count, E = t.edges.size(), F = t.face_count();
+        Stencils step = assemble(V + E + F, V, [&](size_t i, Row& row) {
+            if (i < V) {
+                // (n - 2) / n P + 1 / n^2 (sum of neighbours + sum of face points)
+                uint32_t v = static_cast<uint32_t>(i);
+                if (boundary_row(t, v, row))
+                    return;
+                double n = double(t.vertex_offsets[v + 1] - t.vertex_offsets[v]);
+                row.emplace_back(v, (n - 2.0) / n);
+                for (uint32_t j = t.vertex_offsets[v]; j < t.vertex_offsets[v + 1]; ++j) {
+                    uint32_t k = t.vertex_corners[j];
+                    row.emplace_back(t.faces[t.next(k)], 1.0 / (n * n));
+                    face_row(t, t.corner_face[k], 1.0 / (n * n), row);
+                }
+            } else if (i < V + E) {
+                // Midpoint on the boundary, else the average of the ends and the two face points
+                uint32_t e = static_cast<uint32_t>(i - V);
+                bool boundary = t.boundary_edge(e);
+                for (uint32_t v : t.edges[e])
+                    row.emplace_back(v, boundary ? 0.5 : 0.25);
+                if (!boundary)
+                    for (uint32_t k : t.edge_corners[e])
+                        face_row(t, t.corner_face[k], 0.25, row);
+            } else {
+                face_row(t, static_cast<uint32_t>(i - V - E), 1.0, row);
+            }
+        });
+
+        Scratch scratch;
+        std::span<int32_t> faces = scratch.array<int32_t>(4 * t.faces.size());
+        std::span<int64_t> offsets = scratch.array<int64_t>(t.faces.size() + 1);
+        for (uint32_t k = 0; k < t.faces.size(); ++k) {
+            int32_t quad[4] = {t.faces[k], int32_t(V + t.corner_edge[k]), int32_t(V + E + t.corner_face[k]), int32_t(V + t.corner_edge[t.prev(k)])};
+            std::copy(quad, quad + 4, faces.begin() + 4 * k);
+        }
+        for (size_t i = 0; i < offsets.size(); ++i)
+            offsets[i] = static_cast<int64_t>(4 * i);
+        t = PolygonTopology(faces.data(), offsets.data(), offsets.size() - 1, V + E + F);
+        return step;
+    }
+
+    /**
+     * One Loop step (Loop 1987)
+     * New vertices are ordered as vertex points, edge points; every triangle becomes four.
+     * Replaces the topology with the subdivided one.
+     */
+    static Stencils loop(PolygonTopology& t) {
+        const size_t V = t.vertex_count, E = t.edges.size(), F = t.face_count();
+        Stencils step = assemble(V + E, V, [&](size_t i, Row& row) {
+            if (i < V) {
+                // (1 - n beta) P + beta * sum of neighbours
+                uint32_t v = static_cast<uint32_t>(i);
+                if (boundary_row(t, v, row))
+                    return;
+                double n = double(t.vertex_offsets[v + 1] - t.vertex_offsets[v]);
+                double c = 0.375 + 0.25 * std::cos(2.0 * std::numbers::pi / n), beta = (0.625 - c * c) / n;
+                row.emplace_back(v, 1.0 - n * beta);
+                for (uint32_t j = t.vertex_offsets[v]; j < t.vertex_offsets[v + 1]; ++j)
+                    row.emplace_back(t.faces[t.next(t.vertex_corners[j])], beta);
+            } else {
+                // 3/8 of the ends and 1/8 of the opposite vertices, midpoint on the boundary
+                uint32_t e = static_cast<uint32_t>(i - V);
+                bool boundary = t.boundary_edge(e);
+                for (uint32_t v : t.edges[e])
+                    row.emplace_back(v, boundary ? 0.5 : 0.375);
+                if (!boundary)
+                    for (uint32_t k : t.edge_corners[e])
+                        row.emplace_back(t.faces[t.prev(k)], 0.125);
+            }
+        });
+
+        Scratch scratch;
+        std::span<int32_t> faces = scratch.array<int32_t>(12 * F);
+        std::span<int64_t> offsets = scratch.array<int64_t>(F * 4 + 1);
+        for (size_t f = 0; f < F; ++f) {
+            int64_t k = t.offsets[f];
+            int32_t a = t.faces[k], b = t.faces[k + 1], c = t.faces[k + 2];
+            int32_t ab = int32_t(V + t.corner_edge[k]), bc = int32_t(V + t.corner_edge[k + 1]), ca = int32_t(V + t.corner_edge[k + 2]);
+            int32_t triangles[12] = {a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca};
+            std::copy(triangles, triangles + 12, faces.begin() + 12 * f);
+        }
+        for (size_t i = 0; i < offsets.size(); ++i)
+            offsets[i] = static_cast<int64_t>(3 * i);
+        t = PolygonTopology(faces.data(), offsets.data(), offsets.size() - 1, V + E);
+        return step;
+    }
+
+    Stencils stencils_;  // (vertex_count, input_vertex_count)
+    std::vector<int32_t> faces_;
+    size_t face_count_ = 0;
+    size_t face_size_ = 0;
+};
+
+} // namespace compas
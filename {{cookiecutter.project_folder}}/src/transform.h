@@ -0,0 +1,39 @@
+// transform.h - Batched 4x4 homogeneous transforms stored as row-major (N,4,4) arrays
+#pragma once
+
+#include "parallel.h"
+
+#include <Eigen/Core>
+#include <cstddef>
+
+namespace compas {
+
+using Matrix4 = Eigen::Matrix<double, 4, 4, Eigen::RowMajor>;
+using Matrix4Map = Eigen::Map<Matrix4>;
+using ConstMatrix4Map = Eigen::Map<const Matrix4>;
+
+/**
+ * out = a * b for one pair of row-major 4x4 matrices
+ * out may not alias a or b.
+ */
+inline void multiply_transform(const double* a, const double* b, double* out) {
+    Matrix4Map(out).noalias() = ConstMatrix4Map(a) * ConstMatrix4Map(b);
+}
+
+/**
+ * out[i] = a[i] * b[i] over a batch of row-major 4x4 matrices
+ * @param a (N,4,4) left factors, or a single (4,4) matrix if a_stride is 0
+ * @param b (N,4,4) right factors, or a single (4,4) matrix if b_stride is 0
+ * @param out (N,4,4) products
+ * @param n Number of products N
+ * @param a_stride Distance in doubles between consecutive left factors, 16 or 0
+ * @param b_stride Distance in doubles between consecutive right factors, 16 or 0
+ */
+inline void multiply_transforms(const double* a, const double* b, double* out, size_t n, size_t a_stride = 16, size_t b_stride = 16) {
+    parallel_for(n, 4096, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            multiply_transform(a + i * a_stride, b + i * b_stride, out + 16 * i);
+    });
+}
+
+} // namespace compas
@@ -0,0 +1,189 @@
+#include "compas.h"
+#include "arrays.h"
+#include "quaternion.h"
+#include "transform.h"
+
+using namespace compas;
+
+using AnyIn = nb::ndarray<const double, nb::c_contig, nb::device::cpu>;
+
+/**
+ * Batch of fixed-size rows, a single row broadcasts over the other operand
+ */
+struct Batch {
+    const double* data;
+    size_t count;
+    size_t stride;
+};
+
+/**
+ * Interpret an array as rows of a given shape
+ * @param array (N, *row) or a single row of shape `row`
+ * @param row Shape of one row, (4,), (8,) or (4,4)
+ * @param name Name used in the error message
+ */
+Batch batch(const AnyIn& array, std::initializer_list<size_t> row, const char* name) {
+    size_t rank = row.size(), size = 1;
+    std::string dims;
+    for (size_t s : row) {
+        size *= s;
+        dims += ", " + std::to_string(s);
+    }
+    bool single = array.ndim() == rank, many = array.ndim() == rank + 1;
+    bool valid = single || many;
+    size_t axis = many ? 1 : 0;
+    for (size_t s : row)
+        valid = valid && array.shape(axis++) == s;
+    if (!valid)
+        throw std::invalid_argument(std::string(name) + " must have shape (N" + dims + ") or (" + dims.substr(2) + ").");
+    if (single)
+        return {array.data(), 1, 0};
+    return {array.data(), array.shape(0), size};
+}
+
+/**
+ * Number of results of a binary operation with broadcasting
+ */
+size_t broadcast(const Batch& a, const Batch& b) {
+    if (a.stride && b.stride && a.count != b.count)
+        throw std::invalid_argument("Operands have different batch sizes.");
+    return a.stride ? a.count : b.count;
+}
+
+/**
+ * Products of (N,4) quaternions, a single quaternion broadcasts
+ */
+nb::ndarray<nb::numpy, double> multiply_quaternions(const AnyIn& a, const AnyIn& b) {
+    Batch qa = batch(a, {4}, "a"), qb = batch(b, {4}, "b");
+    size_t n = broadcast(qa, qb);
+    ArrayBuffer<double> out(4 * n);
+    {
+        nb::gil_scoped_release release;
+        quaternion_multiply(qa.data, qb.data, out.data(), n, qa.stride, qb.stride);
+    }
+    return to_ndarray(std::move(out), {n, 4});
+}
+
+nb::ndarray<nb::numpy, double> normalize_quaternions(const RowsIn<4>& q) {
+    size_t n = q.shape(0);
+    ArrayBuffer<double> out(4 * n);
+    {
+        nb::gil_scoped_release release;
+        quaternion_normalize(q.data(), out.data(), n);
+    }
+    return to_ndarray(std::move(out), {n, 4});
+}
+
+/**
+ * Spherical interpolation between (N,4) quaternions at (N,) parameters
+ */
+nb::ndarray<nb::numpy, double> slerp_quaternions(const AnyIn& a, const AnyIn& b, const ValuesIn& t) {
+    Batch qa = batch(a, {4}, "a"), qb = batch(b, {4}, "b");
+    size_t n = t.shape(0);
+    if ((qa.stride && qa.count != n) || (qb.stride && qb.count != n))
+        throw std::invalid_argument("Expected one interpolation parameter per quaternion.");
+    ArrayBuffer<double> out(4 * n);
+    {
+        nb::gil_scoped_release release;
+        quaternion_slerp(qa.data, qb.data, t.data(), out.data(), n, qa.stride, qb.stride);
+    }
+    return to_ndarray(std::move(out), {n, 4});
+}
+
+nb::ndarray<nb::numpy, double> quaternions_to_matrices(const RowsIn<4>& q) {
+    size_t n = q.shape(0);
+    ArrayBuffer<double> out(16 * n);
+    {
+        nb::gil_scoped_release release;
+        quaternion_to_matrix(q.data(), out.data(), n);
+    }
+    return to_ndarray(std::move(out), {n, 4, 4});
+}
+
+nb::ndarray<nb::numpy, double> quaternions_from_matrices(const AnyIn& m) {
+    Batch matrices = batch(m, {4, 4}, "matrices");
+    size_t n = matrices.count;
+    ArrayBuffer<double> out(4 * n);
+    {
+        nb::gil_scoped_release release;
+        quaternion_from_matrix(matrices.data, out.data(), n);
+    }
+    return to_ndarray(std::move(out), {n, 4});
+}
+
+nb::ndarray<nb::numpy, double> multiply_dual_quaternions(const AnyIn& a, const AnyIn& b) {
+    Batch da = batch(a, {8}, "a"), db = batch(b, {8}, "b");
+    size_t n = broadcast(da, db);
+    ArrayBuffer<double> out(8 * n);
+    {
+        nb::gil_scoped_release release;
+        dual_quaternion_multiply(da.data, db.data, out.data(), n, da.stride, db.stride);
+    }
+    return to_ndarray(std::move(out), {n, 8});
+}
+
+nb::ndarray<nb::numpy, double> dual_quaternions_from_matrices(const AnyIn& m) {
+    Batch matrices = batch(m, {4, 4}, "matrices");
+    size_t n = matrices.count;
+    ArrayBuffer<double> out(8 * n);
+    {
+        nb::gil_scoped_release release;
+        dual_quaternion_from_matrix(matrices.data, out.data(), n);
+    }
+    return to_ndarray(std::move(out), {n, 8});
+}
+
+nb::ndarray<nb::numpy, double> dual_quaternions_to_matrices(const RowsIn<8>& d) {
+    size_t n = d.shape(0);
+    ArrayBuffer<double> out(16 * n);
+    {
+        nb::gil_scoped_release release;
+        dual_quaternion_to_matrix(d.data(), out.data(), n);
+    }
+    return to_ndarray(std::move(out), {n, 4, 4});
+}
+
+/**
+ * Blend K dual quaternions with (N,K) weights
+ */
+nb::ndarray<nb::numpy, double> blend_dual_quaternions(const RowsIn<8>& d, const nb::ndarray<const double, nb::ndim<2>, nb::c_contig, nb::device::cpu>& weights) {
+    size_t k = d.shape(0), n = weights.shape(0);
+    if (k == 0 || weights.shape(1) != k)
+        throw std::invalid_argument("Expected (N, K) weights for K > 0 dual quaternions.");
+    ArrayBuffer<double> out(8 * n);
+    {
+        nb::gil_scoped_release release;
+        dual_quaternion_blend(d.data(), k, weights.data(), out.data(), n);
+    }
+    return to_ndarray(std::move(out), {n, 8});
+}
+
+/**
+ * Products of (N,4,4) transforms, a single (4,4) transform broadcasts
+ */
+nb::ndarray<nb::numpy, double> multiply_matrices(const AnyIn& a, const AnyIn& b) {
+    Batch ma = batch(a, {4, 4}, "a"), mb = batch(b, {4, 4}, "b");
+    size_t n = broadcast(ma, mb);
+    ArrayBuffer<double> out(16 * n);
+    {
+        nb::gil_scoped_release release;
+        multiply_transforms(ma.data, mb.data, out.data(), n, ma.stride, mb.stride);
+    }
+    return to_ndarray(std::move(out), {n, 4, 4});
+}
+
+NB_MODULE(_transforms, m) {
+    m.doc() = "Batched transforms, quaternions and dual quaternions.";
+    share_memory_ledger();
+
+    m.def("multiply_matrices", &multiply_matrices, "a"_a, "b"_a, "Products of (N,4,4) transforms");
+    m.def("multiply_quaternions", &multiply_quaternions, "a"_a, "b"_a, "Products of (N,4) quaternions");
+    m.def("normalize_quaternions", &normalize_quaternions, "q"_a, "Unit quaternions");
+    m.def("slerp_quaternions", &slerp_quaternions, "a"_a, "b"_a, "t"_a, "Spherical linear interpolation of (N,4) quaternions");
+    m.def("quaternions_to_matrices", &quaternions_to_matrices, "q"_a, "(N,4,4) rotation matrices of (N,4) quaternions");
+    m.def("quaternions_from_matrices", &quaternions_from_matrices, "matrices"_a, "(N,4) quaternions of the rotation part of (N,4,4) matrices");
+    m.def("multiply_dual_quaternions", &multiply_dual_quaternions, "a"_a, "b"_a, "Products of (N,8) dual quaternions");
+    m.def("dual_quaternions_to_matrices", &dual_quaternions_to_matrices, "d"_a, "(N,4,4) rigid transforms of (N,8) dual quaternions");
+    m.def("dual_quaternions_from_matrices", &dual_quaternions_from_matrices, "matrices"_a, "(N,8) dual quaternions of rigid (N,4,4) transforms");
+    m.def("blend_dual_quaternions", &blend_dual_quaternions, "d"_a, "weights"_a, "Dual quaternion linear blending of (K,8) dual quaternions with (N,K) weights");
+}
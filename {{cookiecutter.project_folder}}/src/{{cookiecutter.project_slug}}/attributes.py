@@ -0,0 +1,170 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _attributes
+
+_TYPES = {
+    "float": _attributes.AttributeType.FLOAT,
+    "int": _attributes.AttributeType.INT,
+    "vec3": _attributes.AttributeType.VEC3,
+    "string": _attributes.AttributeType.STRING,
+}
+
+
+class AttributeStore:
+    """Typed attribute columns for one kind of mesh element.
+
+    Every column has one row per element and one of the types ``"float"``, ``"int"``, ``"vec3"``
+    or ``"string"``. Strings are interned per column and stored as int64 ids, -1 meaning no value.
+    Columns are contiguous native buffers, so ``store["name"]`` is a writable NumPy view without copying.
+    A view keeps its buffer alive; after :meth:`resize` it no longer tracks the store and should be fetched again.
+
+    Parameters
+    ----------
+    size : int, optional
+        Number of elements.
+
+    """
+
+    def __init__(self, size=0):
+        self._store = _attributes.AttributeStore(size)
+
+    def __len__(self):
+        return len(self._store)
+
+    def __contains__(self, name):
+        return name in self._store
+
+    def __getitem__(self, name):
+        if name not in self._store:
+            raise KeyError(name)
+        return self._store.column(name)
+
+    def __delitem__(self, name):
+        if name not in self._store:
+            raise KeyError(name)
+        self._store.remove(name)
+
+    def names(self):
+        """Column names in insertion order."""
+        return self._store.names()
+
+    def type(self, name):
+        """Type of a column as one of ``"float"``, ``"int"``, ``"vec3"`` or ``"string"``."""
+        native = self._store.type(name)
+        return next(key for key, value in _TYPES.items() if value == native)
+
+    @property
+    def nbytes(self):
+        """Bytes held by the column buffers and string tables."""
+        return self._store.nbytes
+
+    def add(self, name, type="float", default=None):
+        """Add a column filled with a default value.
+
+        Parameters
+        ----------
+        name : str
+            Column name.
+        type : {"float", "int", "vec3", "string"}, optional
+            Element type.
+        default : float | int | array_like, optional
+            Value of new rows, zero if omitted. String columns always default to no value.
+
+        """
+        if type not in _TYPES:
+            raise ValueError("Unknown attribute type {!r}.".format(type))
+        if default is not None:
+            default = np.ascontiguousarray(np.atleast_1d(default), dtype=np.float64)
+        self._store.add(name, _TYPES[type], default)
+
+    def resize(self, size):
+        """Change the number of elements, new rows take the column defaults."""
+        self._store.resize(size)
+
+    def get(self, name, indices=None):
+        """Copy the values of a column for the given elements.
+
+        Parameters
+        ----------
+        name : str
+            Column name.
+        indices : array_like, optional
+            Element indices, all elements if omitted.
+
+        Returns
+        -------
+        numpy.ndarray | list
+            (K,) or (K, 3) values, or a list of strings with None for missing values.
+
+        """
+        if indices is None:
+            values = self._store.column(name).copy()
+        else:
+            values = self._store.get(name, np.ascontiguousarray(indices, dtype=np.int32))
+        if self.type(name) == "string":
+            strings = self._store.strings(name)
+            return [strings[i] if i >= 0 else None for i in values.tolist()]
+        return values
+
+    def set(self, name, indices, values):
+        """Write the values of a column for the given elements.
+
+        Parameters
+        ----------
+        name : str
+            Column name.
+        indices : array_like
+            (K,) element indices; with repeated indices the last value wins.
+        values : array_like
+            (K,) or (K, 3) values, or K strings for string columns, None for no value.
+
+        """
+        indices = np.ascontiguousarray(indices, dtype=np.int32)
+        kind = self.type(name)
+        if kind == "string":
+            values = list(values)
+            present = [k for k, value in enumerate(values) if value is not None]
+            ids = np.full(len(values), -1, dtype=np.int64)
+            ids[present] = self._store.intern(name, [values[k] for k in present])
+            self._store.set(name, indices, ids)
+        elif kind == "int":
+            self._store.set(name, indices, np.ascontiguousarray(values, dtype=np.int64).reshape(-1))
+        else:
+            self._store.set(name, indices, np.ascontiguousarray(values, dtype=np.float64))
+
+    def strings(self, name):
+        """String table of a string column, indexed by the stored ids."""
+        return self._store.strings(name)
+
+
+class MeshAttributes:
+    """Attribute stores for the vertices, edges and faces of a mesh.
+
+    Elements are addressed by their index in the mesh arrays, so the stores attach to any mesh
+    with contiguous element indices, such as (V, 3) vertices with (F, 3) faces.
+
+    Parameters
+    ----------
+    vertex_count : int
+        Number of vertices.
+    face_count : int, optional
+        Number of faces.
+    edge_count : int, optional
+        Number of edges.
+
+    """
+
+    def __init__(self, vertex_count, face_count=0, edge_count=0):
+        self.vertices = AttributeStore(vertex_count)
+        self.faces = AttributeStore(face_count)
+        self.edges = AttributeStore(edge_count)
+
+    @classmethod
+    def from_arrays(cls, vertices, faces, edges=None):
+        """Create stores sized for vertex, face and optional edge arrays."""
+        return cls(len(vertices), len(faces), 0 if edges is None else len(edges))
+
+    @property
+    def nbytes(self):
+        """Bytes held by all stores."""
+        return self.vertices.nbytes + self.faces.nbytes + self.edges.nbytes
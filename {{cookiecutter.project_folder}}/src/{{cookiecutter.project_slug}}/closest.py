@@ -0,0 +1,83 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _closest
+
+
+class PolylineProjector:
+    """Closest-point queries against a fixed set of polylines.
+
+    The segment hierarchy is built once in the constructor and reused by every call to :meth:`project`.
+
+    Parameters
+    ----------
+    polylines : list of array_like
+        (M, 3) vertices per polyline, each with at least two vertices.
+
+    """
+
+    def __init__(self, polylines):
+        points = [np.asarray(p, dtype=np.float64).reshape(-1, 3) for p in polylines]
+        offsets = np.zeros(len(points) + 1, dtype=np.int64)
+        np.cumsum([len(p) for p in points], out=offsets[1:])
+        vertices = np.concatenate(points) if points else np.zeros((0, 3))
+        self._projector = _closest.PolylineProjector(np.ascontiguousarray(vertices), offsets)
+
+    def project(self, points, max_distance=np.inf):
+        """Project points onto the nearest polyline.
+
+        Parameters
+        ----------
+        points : array_like
+            (N, 3) query points.
+        max_distance : float, optional
+            Points farther than this from every polyline are left unmatched.
+
+        Returns
+        -------
+        tuple
+            Closest points (N, 3), distances (N,), polyline ids (N,) and parameters (N,).
+            The integer part of a parameter is the segment index, the fractional part the position along it.
+            Unmatched points have id -1 and infinite distance.
+
+        """
+        return self._projector.project(np.ascontiguousarray(points, dtype=np.float64), max_distance)
+
+
+class MeshProjector:
+    """Closest-point queries against a fixed triangle mesh.
+
+    The face hierarchy is built once in the constructor and reused by every call to :meth:`project`.
+
+    Parameters
+    ----------
+    vertices : array_like
+        (V, 3) vertex coordinates.
+    faces : array_like
+        (F, 3) vertex indices per face.
+
+    """
+
+    def __init__(self, vertices, faces):
+        self._projector = _closest.MeshProjector(
+            np.ascontiguousarray(vertices, dtype=np.float64),
+            np.ascontiguousarray(faces, dtype=np.int32),
+        )
+
+    def project(self, points, max_distance=np.inf):
+        """Project points onto the mesh surface.
+
+        Parameters
+        ----------
+        points : array_like
+            (N, 3) query points.
+        max_distance : float, optional
+            Points farther than this from the mesh are left unmatched.
+
+        Returns
+        -------
+        tuple
+            Closest points (N, 3), distances (N,), face ids (N,) and barycentric coordinates (N, 3).
+            Unmatched points have id -1 and infinite distance.
+
+        """
+        return self._projector.project(np.ascontiguousarray(points, dtype=np.float64), max_distance)
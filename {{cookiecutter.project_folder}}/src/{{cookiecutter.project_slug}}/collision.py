@@ -0,0 +1,62 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _collision
+
+
+def _mesh_arrays(mesh):
+    vertices, faces = mesh
+    return np.ascontiguousarray(vertices, dtype=np.float64), np.ascontiguousarray(faces, dtype=np.int32)
+
+
+def box_pairs(boxes):
+    """Find all pairs of overlapping axis-aligned boxes.
+
+    Parameters
+    ----------
+    boxes : array_like
+        (N, 6) boxes as ``xmin, ymin, zmin, xmax, ymax, zmax``.
+
+    Returns
+    -------
+    numpy.ndarray
+        (K, 2) int32 array of box index pairs with ``i < j``.
+
+    """
+    return _collision.box_pairs(np.ascontiguousarray(boxes, dtype=np.float64))
+
+
+def face_pairs(mesh_a, mesh_b):
+    """Find all pairs of intersecting faces between two triangle meshes.
+
+    Parameters
+    ----------
+    mesh_a : tuple
+        ``(vertices, faces)`` of the first mesh, as (V, 3) floats and (F, 3) ints.
+    mesh_b : tuple
+        ``(vertices, faces)`` of the second mesh.
+
+    Returns
+    -------
+    numpy.ndarray
+        (K, 2) int32 array of face pairs, face of ``mesh_a`` first.
+
+    """
+    return _collision.face_pairs(*_mesh_arrays(mesh_a), *_mesh_arrays(mesh_b))
+
+
+def mesh_pairs(meshes):
+    """Find all pairs of colliding triangle meshes.
+
+    Parameters
+    ----------
+    meshes : list[tuple]
+        ``(vertices, faces)`` per mesh, as (V, 3) floats and (F, 3) ints.
+
+    Returns
+    -------
+    numpy.ndarray
+        (K, 2) int32 array of mesh index pairs with ``i < j``.
+
+    """
+    arrays = [_mesh_arrays(mesh) for mesh in meshes]
+    return _collision.mesh_pairs([v for v, _ in arrays], [f for _, f in arrays])
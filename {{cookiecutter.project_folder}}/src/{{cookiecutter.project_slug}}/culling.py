@@ -0,0 +1,110 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _culling
+
+
+def frustum_planes(matrix):
+    """Clipping planes of a view-projection matrix.
+
+    Parameters
+    ----------
+    matrix : array_like
+        (4, 4) matrix mapping points, as column vectors, to clip space with ``-w <= z <= w``.
+
+    Returns
+    -------
+    numpy.ndarray
+        (6, 4) planes ``a, b, c, d`` with unit inward normals, in the order
+        left, right, bottom, top, near, far.
+
+    """
+    return _culling.frustum_planes(np.ascontiguousarray(matrix, dtype=np.float64))
+
+
+class BoxSet:
+    """Axis-aligned bounding boxes of many objects for visibility and region queries.
+
+    Boxes are stored per coordinate and grouped in blocks with their own bounds, so queries
+    skip or accept whole blocks and test the rest in vectorized loops. Moving objects with
+    :meth:`update` only refits the blocks that hold them.
+
+    Parameters
+    ----------
+    boxes : array_like
+        (N, 6) boxes as ``xmin, ymin, zmin, xmax, ymax, zmax``.
+
+    """
+
+    def __init__(self, boxes):
+        self._set = _culling.BoxSet(np.ascontiguousarray(boxes, dtype=np.float64).reshape(-1, 6))
+
+    def __len__(self):
+        return len(self._set)
+
+    @property
+    def boxes(self):
+        """numpy.ndarray: Copy of the (N, 6) boxes."""
+        return self._set.boxes()
+
+    def update(self, indices, boxes):
+        """Replace the boxes of moved objects.
+
+        Parameters
+        ----------
+        indices : array_like
+            (K,) object indices.
+        boxes : array_like
+            (K, 6) new boxes.
+
+        """
+        self._set.update(
+            np.ascontiguousarray(indices, dtype=np.int32),
+            np.ascontiguousarray(boxes, dtype=np.float64).reshape(-1, 6),
+        )
+
+    def frustum(self, planes=None, matrix=None):
+        """Find the objects inside a view frustum or another convex region.
+
+        A box is culled only when it lies entirely outside one plane, so boxes near the
+        corners of the region may be kept.
+
+        Parameters
+        ----------
+        planes : array_like, optional
+            (P, 4) planes ``a, b, c, d``, inside where ``a x + b y + c z + d >= 0``.
+        matrix : array_like, optional
+            (4, 4) view-projection matrix, used instead of ``planes``.
+
+        Returns
+        -------
+        numpy.ndarray
+            (K,) uint32 indices of the kept objects, in increasing order.
+
+        """
+        if matrix is not None:
+            planes = frustum_planes(matrix)
+        elif planes is None:
+            raise ValueError("Either planes or matrix is required.")
+        return self._set.frustum(np.ascontiguousarray(planes, dtype=np.float64).reshape(-1, 4))
+
+    def box(self, box):
+        """Find the objects whose boxes overlap a query box, touching boxes included.
+
+        Returns
+        -------
+        numpy.ndarray
+            (K,) uint32 indices in increasing order.
+
+        """
+        return self._set.box(np.ascontiguousarray(box, dtype=np.float64).reshape(1, 6))
+
+    def sphere(self, center, radius):
+        """Find the objects whose boxes intersect a ball.
+
+        Returns
+        -------
+        numpy.ndarray
+            (K,) uint32 indices in increasing order.
+
+        """
+        return self._set.sphere(np.ascontiguousarray(center, dtype=np.float64).reshape(1, 3), float(radius))
@@ -0,0 +1,175 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _curves
+
+
+def _offsets(lengths):
+    offsets = np.zeros(len(lengths) + 1, dtype=np.int64)
+    np.cumsum(lengths, out=offsets[1:])
+    return offsets
+
+
+def evaluate_curves(curves, params, order=0):
+    """Evaluate many NURBS curves in one call.
+
+    Parameters
+    ----------
+    curves : list
+        Curves as (points, weights, knots, degree) tuples, weights may be None.
+    params : list
+        One array of parameters per curve.
+    order : int, optional
+        Highest derivative to compute.
+
+    Returns
+    -------
+    list of numpy.ndarray
+        Per curve, a (N, order + 1, 3) array of points followed by their derivatives.
+
+    """
+    points = [np.asarray(c[0], dtype=np.float64).reshape(-1, 3) for c in curves]
+    weights = [np.ones(len(p)) if c[1] is None else np.asarray(c[1], dtype=np.float64) for p, c in zip(points, curves)]
+    knots = [np.asarray(c[2], dtype=np.float64) for c in curves]
+    params = [np.asarray(t, dtype=np.float64).reshape(-1) for t in params]
+    if len(params) != len(curves):
+        raise ValueError("Expected one parameter array per curve.")
+    if not curves:
+        return []
+    result = _curves.evaluate_curves(
+        np.ascontiguousarray(np.concatenate(points)),
+        np.ascontiguousarray(np.concatenate(weights)),
+        _offsets([len(p) for p in points]),
+        np.ascontiguousarray(np.concatenate(knots)),
+        _offsets([len(k) for k in knots]),
+        np.array([c[3] for c in curves], dtype=np.int32),
+        np.ascontiguousarray(np.concatenate(params)),
+        _offsets([len(t) for t in params]),
+        order,
+    )
+    return np.split(result, np.cumsum([len(t) for t in params])[:-1])
+
+
+def evaluate_curve(points, knots, degree, params, weights=None, order=0):
+    """Evaluate a NURBS curve.
+
+    Parameters
+    ----------
+    points : array_like
+        (M, 3) control points.
+    knots : array_like
+        (M + degree + 1,) knot vector.
+    degree : int
+        Degree of the curve.
+    params : array_like
+        (N,) parameters.
+    weights : array_like, optional
+        (M,) weights, None for a non-rational curve.
+    order : int, optional
+        Highest derivative to compute.
+
+    Returns
+    -------
+    numpy.ndarray
+        (N, 3) points if order is 0, otherwise (N, order + 1, 3) points and derivatives.
+
+    """
+    result = evaluate_curves([(points, weights, knots, degree)], [params], order)[0]
+    return result[:, 0] if order == 0 else result
+
+
+def evaluate_surface(points, knots_u, knots_v, degree_u, degree_v, params, weights=None, derivatives=False):
+    """Evaluate a NURBS surface at scattered parameters.
+
+    Parameters
+    ----------
+    points : array_like
+        (U, V, 3) control points.
+    knots_u, knots_v : array_like
+        Knot vectors in u and v.
+    degree_u, degree_v : int
+        Degrees in u and v.
+    params : array_like
+        (N, 2) parameters.
+    weights : array_like, optional
+        (U, V) weights, None for a non-rational surface.
+    derivatives : bool, optional
+        Also return the partial derivatives.
+
+    Returns
+    -------
+    numpy.ndarray
+        (N, 3) points, or (N, 3, 3) point, dS/du and dS/dv if derivatives is True.
+
+    """
+    points = np.ascontiguousarray(points, dtype=np.float64)
+    weights = np.ones(points.shape[:2]) if weights is None else np.ascontiguousarray(weights, dtype=np.float64)
+    result = _curves.evaluate_surface(
+        points,
+        weights,
+        np.ascontiguousarray(knots_u, dtype=np.float64),
+        np.ascontiguousarray(knots_v, dtype=np.float64),
+        degree_u,
+        degree_v,
+        np.ascontiguousarray(params, dtype=np.float64).reshape(-1, 2),
+        derivatives,
+    )
+    return result if derivatives else result[:, 0]
+
+
+def evaluate_surface_grid(points, knots_u, knots_v, degree_u, degree_v, us, vs, weights=None, derivatives=False):
+    """Evaluate a NURBS surface on the parameter grid us x vs.
+
+    Basis functions are computed once per u and once per v, which makes this much faster than
+    :func:`evaluate_surface` for tessellation.
+
+    Returns
+    -------
+    numpy.ndarray
+        (Nu, Nv, 3) points, or (Nu, Nv, 3, 3) point, dS/du and dS/dv if derivatives is True.
+
+    """
+    points = np.ascontiguousarray(points, dtype=np.float64)
+    weights = np.ones(points.shape[:2]) if weights is None else np.ascontiguousarray(weights, dtype=np.float64)
+    result = _curves.evaluate_surface_grid(
+        points,
+        weights,
+        np.ascontiguousarray(knots_u, dtype=np.float64),
+        np.ascontiguousarray(knots_v, dtype=np.float64),
+        degree_u,
+        degree_v,
+        np.ascontiguousarray(us, dtype=np.float64),
+        np.ascontiguousarray(vs, dtype=np.float64),
+        derivatives,
+    )
+    return result if derivatives else result[:, :, 0]
+
+
+def evaluate_polylines(polylines, params):
+    """Evaluate many polylines by normalized arc length.
+
+    Parameters
+    ----------
+    polylines : list of array_like
+        (M, 3) vertices per polyline.
+    params : list of array_like
+        Parameters in [0, 1] per polyline.
+
+    Returns
+    -------
+    list of numpy.ndarray
+        Per polyline, a (N, 2, 3) array of points and derivatives.
+
+    """
+    points = [np.asarray(p, dtype=np.float64).reshape(-1, 3) for p in polylines]
+    params = [np.asarray(t, dtype=np.float64).reshape(-1) for t in params]
+    if len(params) != len(points):
+        raise ValueError("Expected one parameter array per polyline.")
+    if not points:
+        return []
+    result = _curves.evaluate_polylines(
+        np.ascontiguousarray(np.concatenate(points)),
+        _offsets([len(p) for p in points]),
+        np.ascontiguousarray(np.concatenate(params)),
+        _offsets([len(t) for t in params]),
+    )
+    return np.split(result, np.cumsum([len(t) for t in params])[:-1])
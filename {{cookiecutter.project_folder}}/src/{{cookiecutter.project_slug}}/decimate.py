@@ -0,0 +1,59 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _decimate
+
+
+def _mesh_arrays(mesh):
+    vertices, faces = mesh
+    return np.ascontiguousarray(vertices, dtype=np.float64), np.ascontiguousarray(faces, dtype=np.int32)
+
+
+def decimate(mesh, target_faces=None, max_error=None):
+    """Simplify a triangle mesh by quadric error edge collapses.
+
+    Edges are collapsed in order of increasing error until the face count drops to ``target_faces``
+    or the next collapse would exceed ``max_error``. Boundary vertices stay in place.
+
+    Parameters
+    ----------
+    mesh : tuple
+        ``(vertices, faces)`` as (V, 3) floats and (F, 3) ints, manifold and consistently oriented.
+    target_faces : int, optional
+        Number of faces to reach, no limit if omitted.
+    max_error : float, optional
+        Largest quadric error of a collapse, an area-weighted squared distance; no limit if omitted.
+
+    Returns
+    -------
+    tuple
+        Vertices (V', 3) and faces (F', 3) of the simplified mesh.
+
+    """
+    if target_faces is None and max_error is None:
+        raise ValueError("Either target_faces or max_error is required.")
+    return _decimate.decimate(
+        *_mesh_arrays(mesh),
+        0 if target_faces is None else int(target_faces),
+        np.inf if max_error is None else float(max_error),
+    )
+
+
+def decimate_clustering(mesh, cell_size):
+    """Simplify a triangle mesh by merging the vertices within each cell of a uniform grid.
+
+    Much faster than :func:`decimate` on very large meshes, but the result may not be manifold.
+
+    Parameters
+    ----------
+    mesh : tuple
+        ``(vertices, faces)`` as (V, 3) floats and (F, 3) ints.
+    cell_size : float
+        Edge length of the grid cells.
+
+    Returns
+    -------
+    tuple
+        Vertices (V', 3) and faces (F', 3) of the simplified mesh.
+
+    """
+    return _decimate.cluster(*_mesh_arrays(mesh), float(cell_size))
@@ -0,0 +1,38 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _delaunay
+
+
+def delaunay_2d(points):
+    """Delaunay triangulation of points in the XY plane.
+
+    Parameters
+    ----------
+    points : array_like
+        (N, 2) or (N, 3) points, the Z coordinate is ignored.
+
+    Returns
+    -------
+    numpy.ndarray
+        (T, 3) int32 point indices per triangle, in counterclockwise order.
+
+    """
+    points = np.asarray(points, dtype=np.float64)
+    return _delaunay.delaunay_2d(np.ascontiguousarray(points[:, :2]))
+
+
+def delaunay_3d(points):
+    """Delaunay tetrahedralization of 3D points.
+
+    Parameters
+    ----------
+    points : array_like
+        (N, 3) points.
+
+    Returns
+    -------
+    numpy.ndarray
+        (T, 4) int32 point indices per tetrahedron, positively oriented.
+
+    """
+    return _delaunay.delaunay_3d(np.ascontiguousarray(points, dtype=np.float64))
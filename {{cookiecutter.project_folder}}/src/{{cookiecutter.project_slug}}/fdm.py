@@ -0,0 +1,89 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _fdm
+
+
+def _optional(values, dtype=np.float64):
+    return None if values is None else np.ascontiguousarray(values, dtype=dtype)
+
+
+class ForceDensity:
+    """Force density network with a cached sparse factorization.
+
+    The connectivity matrix and the sparsity pattern of ``Ci^T Q Ci`` are built once,
+    so solving for new force densities only repeats the numeric factorization.
+
+    Parameters
+    ----------
+    edges : array_like
+        (E, 2) vertex indices.
+    fixed : array_like
+        Indices of the fixed vertices, or a (V,) boolean mask.
+    vertex_count : int, optional
+        Number of vertices, required when ``fixed`` holds indices.
+
+    """
+
+    def __init__(self, edges, fixed, vertex_count=None):
+        edges = np.ascontiguousarray(edges, dtype=np.int32)
+        fixed = np.asarray(fixed)
+        if fixed.dtype != bool:
+            if vertex_count is None:
+                vertex_count = int(edges.max()) + 1 if edges.size else 0
+            mask = np.zeros(vertex_count, dtype=bool)
+            mask[fixed.astype(np.int64)] = True
+            fixed = mask
+        self._network = _fdm.ForceDensity(edges, np.ascontiguousarray(fixed, dtype=np.uint8))
+
+    @property
+    def vertex_count(self):
+        return self._network.vertex_count
+
+    @property
+    def edge_count(self):
+        return self._network.edge_count
+
+    @property
+    def free_count(self):
+        return self._network.free_count
+
+    def solve(self, q, vertices, loads=None):
+        """Solve for the equilibrium of one set of force densities.
+
+        Parameters
+        ----------
+        q : array_like
+            (E,) force densities.
+        vertices : array_like
+            (V, 3) coordinates, only the fixed vertices are used.
+        loads : array_like, optional
+            (V, 3) external loads.
+
+        Returns
+        -------
+        tuple
+            Coordinates (V, 3), edge lengths (E,) and axial forces (E,).
+
+        """
+        return self._network.solve(np.ascontiguousarray(q, dtype=np.float64), np.ascontiguousarray(vertices, dtype=np.float64), _optional(loads))
+
+    def solve_many(self, q, vertices, loads=None):
+        """Solve for the equilibria of many sets of force densities in parallel.
+
+        Parameters
+        ----------
+        q : array_like
+            (B, E) force densities, one set per row.
+        vertices : array_like
+            (V, 3) coordinates, only the fixed vertices are used.
+        loads : array_like, optional
+            (V, 3) external loads, shared by all sets.
+
+        Returns
+        -------
+        tuple
+            Coordinates (B, V, 3) and axial forces (B, E).
+
+        """
+        q = np.ascontiguousarray(np.atleast_2d(q), dtype=np.float64)
+        return self._network.solve_many(q, np.ascontiguousarray(vertices, dtype=np.float64), _optional(loads))
@@ -0,0 +1,118 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _graph
+
+
+class Graph:
+    """Undirected weighted graph stored as compressed adjacency lists.
+
+    Traversals, components, shortest paths and spanning trees run natively and in parallel,
+    and return the same results for any number of threads.
+
+    Parameters
+    ----------
+    edges : array_like
+        (E, 2) vertex indices. Loops and parallel edges are allowed.
+    vertex_count : int, optional
+        Number of vertices, one more than the largest index in ``edges`` if omitted.
+    weights : array_like, optional
+        (E,) non-negative edge weights, 1 if omitted.
+
+    """
+
+    def __init__(self, edges, vertex_count=None, weights=None):
+        edges = np.ascontiguousarray(edges, dtype=np.int32).reshape(-1, 2)
+        if vertex_count is None:
+            vertex_count = int(edges.max()) + 1 if edges.size else 0
+        if weights is not None:
+            weights = np.ascontiguousarray(weights, dtype=np.float64)
+        self._graph = _graph.Graph(edges, vertex_count, weights)
+
+    @property
+    def vertex_count(self):
+        return self._graph.vertex_count
+
+    @property
+    def edge_count(self):
+        return self._graph.edge_count
+
+    def adjacency(self):
+        """Adjacency lists in CSR form.
+
+        Returns
+        -------
+        tuple
+            Offsets (V+1,), neighbours (2E,) and the edge reaching each neighbour (2E,).
+            The neighbours of ``v`` are ``neighbours[offsets[v]:offsets[v + 1]]``.
+
+        """
+        return self._graph.adjacency()
+
+    def bfs(self, source):
+        """Breadth-first search from a vertex.
+
+        Returns
+        -------
+        tuple
+            Hop counts (V,) and tree parents (V,), -1 for unreachable vertices and the source's parent.
+
+        """
+        return self._graph.bfs(source)
+
+    def connected_components(self):
+        """Connected components.
+
+        Returns
+        -------
+        tuple
+            Component label per vertex (V,), numbered in order of their smallest vertex, and the number of components.
+
+        """
+        return self._graph.components()
+
+    def shortest_paths(self, source, method="delta", delta=None):
+        """Shortest paths from a vertex.
+
+        Parameters
+        ----------
+        source : int
+            Start vertex.
+        method : {"delta", "dijkstra"}, optional
+            Parallel delta-stepping or sequential Dijkstra.
+        delta : float, optional
+            Bucket width for delta-stepping, the mean edge weight if omitted.
+
+        Returns
+        -------
+        tuple
+            Distances (V,), infinite for unreachable vertices, and tree parents (V,).
+
+        """
+        return self._graph.shortest_paths(source, method, 0.0 if delta is None else delta)
+
+    def distance_matrix(self, sources):
+        """Shortest path lengths from many vertices as an (S, V) array."""
+        return self._graph.distance_matrix(np.ascontiguousarray(np.atleast_1d(sources), dtype=np.int32))
+
+    def minimum_spanning_tree(self):
+        """Minimum spanning forest, with ties broken by edge index.
+
+        Returns
+        -------
+        tuple
+            Indices of the forest edges in increasing order and their total weight.
+
+        """
+        return self._graph.minimum_spanning_tree()
+
+    @staticmethod
+    def path(parents, source, target):
+        """Vertices from ``source`` to ``target`` along a tree returned by :meth:`bfs` or :meth:`shortest_paths`.
+
+        Returns an empty list if ``target`` was not reached from ``source``.
+
+        """
+        path = [int(target)]
+        while parents[path[-1]] >= 0:
+            path.append(int(parents[path[-1]]))
+        return path[::-1] if path[-1] == source else []
@@ -0,0 +1,137 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _kinematics
+
+REVOLUTE = 0
+PRISMATIC = 1
+FIXED = 2
+
+
+class Chain:
+    """Serial kinematic chain with batched forward kinematics.
+
+    Joints follow the URDF convention: the frame of joint ``j`` is the previous frame times
+    ``origins[j]`` times the joint motion, a rotation about or translation along ``axes[j]``.
+
+    Parameters
+    ----------
+    origins : array_like
+        (J, 4, 4) joint origins relative to the previous joint frame.
+    axes : array_like
+        (J, 3) joint axes in the joint frames.
+    types : array_like
+        (J,) joint types, :data:`REVOLUTE`, :data:`PRISMATIC` or :data:`FIXED`.
+    tool : array_like, optional
+        (4, 4) end-effector transform in the last joint frame.
+
+    """
+
+    def __init__(self, origins=None, axes=None, types=None, tool=None, _chain=None):
+        if _chain is not None:
+            self._chain = _chain
+            return
+        if tool is not None:
+            tool = np.ascontiguousarray(tool, dtype=np.float64)
+        self._chain = _kinematics.Chain(
+            np.ascontiguousarray(origins, dtype=np.float64).reshape(-1, 4, 4),
+            np.ascontiguousarray(axes, dtype=np.float64).reshape(-1, 3),
+            np.ascontiguousarray(types, dtype=np.int32),
+            tool,
+        )
+
+    @classmethod
+    def from_dh(cls, a, alpha, d, theta=None, types=None):
+        """Create a chain from Denavit-Hartenberg parameters.
+
+        Frame ``j`` is ``Rz(theta[j] + q[j]) Tz(d[j]) Tx(a[j]) Rx(alpha[j])``, with the joint value
+        added to ``d[j]`` instead for prismatic joints.
+
+        """
+        a = np.ascontiguousarray(a, dtype=np.float64)
+        theta = np.zeros(len(a)) if theta is None else np.ascontiguousarray(theta, dtype=np.float64)
+        types = np.zeros(len(a), dtype=np.int32) if types is None else np.ascontiguousarray(types, dtype=np.int32)
+        chain = _kinematics.Chain.from_dh(
+            a,
+            np.ascontiguousarray(alpha, dtype=np.float64),
+            np.ascontiguousarray(d, dtype=np.float64),
+            theta,
+            types,
+        )
+        return cls(_chain=chain)
+
+    def __len__(self):
+        return len(self._chain)
+
+    @property
+    def dofs(self):
+        """int: Number of joint values, the number of non-fixed joints."""
+        return self._chain.dofs
+
+    def _configurations(self, q, name="q"):
+        q = np.atleast_2d(np.asarray(q, dtype=np.float64))
+        if q.ndim != 2 or q.shape[1] != self.dofs:
+            raise ValueError("Expected {} with {} joint values per configuration, got an array of shape {}.".format(name, self.dofs, q.shape))
+        return np.ascontiguousarray(q)
+
+    def forward(self, q, all_frames=False):
+        """Evaluate forward kinematics for many configurations.
+
+        Parameters
+        ----------
+        q : array_like
+            (N, dofs) joint values, or a single configuration.
+        all_frames : bool, optional
+            Return every joint frame followed by the end-effector frame.
+
+        Returns
+        -------
+        numpy.ndarray
+            (N, 4, 4) end-effector frames, or (N, J + 1, 4, 4) frames if ``all_frames`` is True.
+
+        """
+        return self._chain.forward(self._configurations(q), all_frames)
+
+    def set_limits(self, lower, upper):
+        """Set the limits of the non-fixed joints from (dofs,) lower and upper bounds."""
+        self._chain.set_limits(np.ascontiguousarray(lower, dtype=np.float64), np.ascontiguousarray(upper, dtype=np.float64))
+
+    def jacobians(self, q):
+        """Geometric Jacobians of (N, dofs) configurations as (N, 6, dofs) arrays, linear rows first."""
+        return self._chain.jacobians(self._configurations(q))
+
+    def inverse(self, targets, seeds, max_iterations=100, position_tolerance=1e-6, orientation_tolerance=1e-6, orientation_weight=1.0, damping=1e-3):
+        """Solve inverse kinematics for many targets by damped least squares.
+
+        Parameters
+        ----------
+        targets : array_like
+            (N, 4, 4) target end-effector frames.
+        seeds : array_like
+            (N, dofs) initial joint values, or a single configuration used for every target.
+        max_iterations : int, optional
+            Iteration limit per target.
+        position_tolerance : float, optional
+            Position error below which a target counts as reached.
+        orientation_tolerance : float, optional
+            Orientation error in radians below which a target counts as reached.
+        orientation_weight : float, optional
+            Weight of the orientation error, 0 to solve for the position only.
+        damping : float, optional
+            Initial Levenberg-Marquardt damping, adapted during the iteration.
+
+        Returns
+        -------
+        tuple
+            Joint values (N, dofs), success flags (N,), iterations (N,), position errors (N,) and orientation errors (N,).
+
+        """
+        targets = np.asarray(targets, dtype=np.float64)
+        if targets.shape[-2:] != (4, 4) or targets.ndim > 3:
+            raise ValueError("Expected (N, 4, 4) target frames, got an array of shape {}.".format(targets.shape))
+        targets = np.ascontiguousarray(targets.reshape(-1, 4, 4))
+        seeds = self._configurations(seeds, "seeds")
+        seeds = np.ascontiguousarray(np.broadcast_to(seeds, (len(targets), self.dofs)))
+        q, success, iterations, position_error, orientation_error = self._chain.inverse(
+            targets, seeds, max_iterations, position_tolerance, orientation_tolerance, orientation_weight, damping
+        )
+        return q, success.astype(bool), iterations, position_error, orientation_error
@@ -0,0 +1,114 @@
+from importlib import import_module
+
+from {{cookiecutter.project_slug}} import _memory
+
+# Extensions whose kernels take their temporaries from scratch arenas
+_ARENA_MODULES = (
+    "_closest",
+    "_collision",
+    "_culling",
+    "_curves",
+    "_decimate",
+    "_delaunay",
+    "_fdm",
+    "_geodesic",
+    "_graph",
+    "_kinematics",
+    "_parameterize",
+    "_pointcloud",
+    "_poisson",
+    "_registration",
+    "_relaxation",
+    "_remesh",
+    "_scene",
+    "_slicing",
+    "_subdivision",
+)
+
+
+def _modules():
+    return [import_module("{{cookiecutter.project_slug}}." + name) for name in _ARENA_MODULES]
+
+
+def arena_stats():
+    """Statistics of the per-thread scratch arenas of all native kernels.
+
+    Kernels allocate their temporaries from a monotonic arena that is rewound, not freed, when
+    they return, so once the arenas have grown to the high-water mark, repeated calls of the same
+    size make no heap allocations: ``chunk_allocations`` stops increasing.
+
+    Returns
+    -------
+    dict
+        ``"reserved"`` bytes held by the arenas, the ``"high_water"`` bytes one arena had in use at
+        once, the number of heap ``"chunk_allocations"`` and of threads currently owning an arena in ``"arenas"``.
+
+    """
+    stats = [module.arena_stats() for module in _modules()]
+    return {
+        "reserved": sum(s["reserved"] for s in stats),
+        "high_water": max(s["high_water"] for s in stats),
+        "chunk_allocations": sum(s["chunk_allocations"] for s in stats),
+        "arenas": sum(s["arenas"] for s in stats),
+    }
+
+
+def reset_arena_stats():
+    """Restart the arena high-water mark and allocation count."""
+    for module in _modules():
+        module.reset_arena_stats()
+
+
+def trim_arenas():
+    """Free the arena memory kept for future worker threads.
+
+    Returns
+    -------
+    int
+        Number of bytes returned to the system allocator.
+
+    """
+    return sum(module.trim_arenas() for module in _modules())
+
+
+def memory_stats():
+    """Memory held by the native extensions, per subsystem.
+
+    Allocations are tagged by the subsystem that owns them: ``"arrays"`` for result buffers
+    handed to NumPy, ``"arena"`` for scratch arenas, ``"pool"`` for object pools of long-running
+    kernels and ``"attributes"`` for attribute store columns.
+
+    Returns
+    -------
+    dict
+        Maps each tag and ``"total"`` to a dict with the ``"live"`` and ``"peak"`` bytes, the
+        ``"count"`` of live allocations and the number of ``"allocations"`` made.
+
+    """
+    return _memory.memory_stats()
+
+
+def reset_memory_peaks():
+    """Restart the peaks of :func:`memory_stats` from the live bytes."""
+    _memory.reset_memory_peaks()
+
+
+def set_memory_limit(limit):
+    """Set a soft limit on the memory held by all subsystems together.
+
+    An allocation that would exceed the limit raises ``MemoryError`` instead, so a worker fails
+    cleanly before the operating system runs out of memory. Memory allocated outside the tracked
+    subsystems, such as sparse factorizations, does not count.
+
+    Parameters
+    ----------
+    limit : int or None
+        Limit in bytes, or None to remove it.
+
+    """
+    _memory.set_memory_limit(None if limit is None else int(limit))
+
+
+def memory_limit():
+    """The soft memory limit in bytes, or None."""
+    return _memory.memory_limit()
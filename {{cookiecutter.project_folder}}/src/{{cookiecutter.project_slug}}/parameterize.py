@@ -0,0 +1,111 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _parameterize
+
+
+def _mesh_arrays(mesh):
+    vertices, faces = mesh
+    return np.ascontiguousarray(vertices, dtype=np.float64), np.ascontiguousarray(faces, dtype=np.int32)
+
+
+class Parameterization:
+    """Flattening of a triangle mesh into the plane with a cached sparse factorization.
+
+    ``"harmonic"`` fixes a set of vertices, by default the longest boundary loop on a circle of the
+    same length, and minimizes the Dirichlet energy of the others. ``"lscm"`` fixes two vertices,
+    by default the two boundary vertices farthest apart, and minimizes the conformal distortion
+    with a free boundary. The system of the free vertices is factorized once, so solving for new
+    positions of the fixed vertices is cheap.
+
+    Parameters
+    ----------
+    mesh : tuple
+        ``(vertices, faces)`` as (V, 3) floats and (F, 3) ints, manifold and consistently oriented.
+    method : {"lscm", "harmonic"}, optional
+        Energy to minimize.
+    fixed : array_like, optional
+        Indices of the fixed vertices, at least two for ``"lscm"``. Their positions must then be
+        given to :meth:`solve`.
+
+    """
+
+    def __init__(self, mesh, method="lscm", fixed=None):
+        if fixed is not None:
+            fixed = np.ascontiguousarray(fixed, dtype=np.int32).ravel()
+        self._parameterization = _parameterize.Parameterization(*_mesh_arrays(mesh), method, fixed)
+
+    @property
+    def fixed(self):
+        """numpy.ndarray: (K,) indices of the fixed vertices."""
+        return self._parameterization.fixed()
+
+    @property
+    def default_positions(self):
+        """numpy.ndarray: (K, 2) default positions of the fixed vertices, empty if they were given."""
+        return self._parameterization.default_positions()
+
+    def solve(self, positions=None):
+        """Positions of all vertices in the plane.
+
+        Parameters
+        ----------
+        positions : array_like, optional
+            (K, 2) positions of the fixed vertices, in the order of :attr:`fixed`.
+            Required if the fixed vertices were given, the defaults otherwise.
+
+        Returns
+        -------
+        numpy.ndarray
+            (V, 2) UV coordinates.
+
+        """
+        if positions is not None:
+            positions = np.ascontiguousarray(positions, dtype=np.float64).reshape(-1, 2)
+        return self._parameterization.solve(positions)
+
+
+def parameterize(mesh, method="lscm"):
+    """Flatten a disk-like triangle mesh into the plane.
+
+    Parameters
+    ----------
+    mesh : tuple
+        ``(vertices, faces)`` as (V, 3) floats and (F, 3) ints, manifold, consistently oriented and
+        with at least one boundary loop.
+    method : {"lscm", "harmonic"}, optional
+        Least squares conformal map with a free boundary, or harmonic map onto a circle.
+
+    Returns
+    -------
+    numpy.ndarray
+        (V, 2) UV coordinates.
+
+    """
+    return Parameterization(mesh, method).solve()
+
+
+def parameterize_many(meshes, method="lscm"):
+    """Flatten many small meshes, such as fabrication panels, in parallel.
+
+    Parameters
+    ----------
+    meshes : list of tuple
+        ``(vertices, faces)`` per mesh, as in :func:`parameterize`.
+    method : {"lscm", "harmonic"}, optional
+        Energy to minimize.
+
+    Returns
+    -------
+    list of numpy.ndarray
+        (V_i, 2) UV coordinates per mesh.
+
+    """
+    arrays = [_mesh_arrays(mesh) for mesh in meshes]
+    vertex_offsets = np.zeros(len(arrays) + 1, dtype=np.int64)
+    face_offsets = np.zeros(len(arrays) + 1, dtype=np.int64)
+    np.cumsum([len(vertices) for vertices, _ in arrays], out=vertex_offsets[1:])
+    np.cumsum([len(faces) for _, faces in arrays], out=face_offsets[1:])
+    vertices = np.concatenate([v for v, _ in arrays]) if arrays else np.zeros((0, 3))
+    faces = np.concatenate([f.reshape(-1, 3) for _, f in arrays]) if arrays else np.zeros((0, 3), dtype=np.int32)
+    uv = _parameterize.solve_many(np.ascontiguousarray(vertices), vertex_offsets, np.ascontiguousarray(faces, dtype=np.int32), face_offsets, method)
+    return np.split(uv, vertex_offsets[1:-1])
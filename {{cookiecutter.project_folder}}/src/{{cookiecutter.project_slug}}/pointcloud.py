@@ -0,0 +1,57 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _pointcloud
+
+
+def knn(points, k):
+    """Find the k nearest neighbours of every point.
+
+    Parameters
+    ----------
+    points : array_like
+        (N, 3) points.
+    k : int
+        Number of neighbours, the point itself included, from 1 to N.
+
+    Returns
+    -------
+    numpy.ndarray
+        (N, k) int32 neighbour indices sorted by distance.
+
+    """
+    return _pointcloud.knn(np.ascontiguousarray(points, dtype=np.float64), k)
+
+
+def estimate_normals(points, k=16, orientation="mst", viewpoint=None, normals=None, curvature=None):
+    """Estimate normals and curvature of a point cloud by PCA of kNN neighbourhoods.
+
+    Parameters
+    ----------
+    points : array_like
+        (N, 3) points.
+    k : int, optional
+        Number of neighbours per point, the point itself included.
+    orientation : {"mst", "viewpoint", "none"}, optional
+        Propagate a consistent orientation along a minimum spanning tree,
+        flip normals towards ``viewpoint``, or leave them unoriented.
+    viewpoint : array_like, optional
+        Viewpoint for ``orientation="viewpoint"``, the origin by default.
+    normals : numpy.ndarray, optional
+        Contiguous (N, 3) float64 array to write the normals into.
+    curvature : numpy.ndarray, optional
+        Contiguous (N,) float64 array to write the surface variation into.
+
+    Returns
+    -------
+    tuple
+        Unit normals (N, 3) and surface variation (N,), which is 0 on planes and at most 1/3.
+
+    """
+    points = np.ascontiguousarray(points, dtype=np.float64)
+    if normals is None:
+        normals = np.empty((len(points), 3))
+    if curvature is None:
+        curvature = np.empty(len(points))
+    viewpoint = np.zeros(3) if viewpoint is None else np.asarray(viewpoint, dtype=np.float64)
+    _pointcloud.estimate_normals(points, normals, curvature, k, orientation, viewpoint)
+    return normals, curvature
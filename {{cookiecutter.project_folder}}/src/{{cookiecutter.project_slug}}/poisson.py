@@ -0,0 +1,43 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _poisson
+
+
+def poisson_reconstruction(points, normals, depth=8, screening=4.0, padding=0.1, cycles=6, smoothing=24):
+    """Reconstruct a watertight surface from an oriented point cloud.
+
+    Solves the screened Poisson equation on a hierarchy of grids that is only refined near the
+    points, then extracts the surface with marching cubes.
+
+    Parameters
+    ----------
+    points : array_like
+        (N, 3) point positions.
+    normals : array_like
+        (N, 3) outward normals, for example from :func:`estimate_normals`.
+    depth : int, optional
+        The finest grid has ``2 ** depth`` cells along the longest side of the points.
+    screening : float, optional
+        How strongly the surface is pulled through the points; 0 gives the plain Poisson surface.
+    padding : float, optional
+        Margin around the points as a fraction of their extent.
+    cycles : int, optional
+        Multigrid V-cycles on the coarse levels.
+    smoothing : int, optional
+        Relaxation sweeps on every level finer than the multigrid ones.
+
+    Returns
+    -------
+    tuple
+        Vertices (V, 3) and faces (F, 3) of the surface, with outward normals.
+
+    """
+    return _poisson.reconstruct(
+        np.ascontiguousarray(points, dtype=np.float64),
+        np.ascontiguousarray(normals, dtype=np.float64),
+        int(depth),
+        float(screening),
+        float(padding),
+        int(cycles),
+        int(smoothing),
+    )
@@ -0,0 +1,98 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _predicates
+
+
+def _rows(points, dim):
+    points = np.atleast_2d(np.asarray(points, dtype=np.float64))
+    if points.ndim != 2 or points.shape[1] != dim:
+        raise ValueError("Expected points with {} coordinates, got an array of shape {}.".format(dim, points.shape))
+    return np.ascontiguousarray(points)
+
+
+def orient2d(a, b, c):
+    """Orientation of 2D point triples.
+
+    Parameters
+    ----------
+    a, b, c : array_like
+        (N, 2) points.
+
+    Returns
+    -------
+    numpy.ndarray
+        (N,) determinants, positive where ``a, b, c`` are counterclockwise, with exact sign.
+
+    """
+    return _predicates.orient2d(_rows(a, 2), _rows(b, 2), _rows(c, 2))
+
+
+def orient3d(a, b, c, d):
+    """Orientation of 3D point quadruples.
+
+    Parameters
+    ----------
+    a, b, c, d : array_like
+        (N, 3) points.
+
+    Returns
+    -------
+    numpy.ndarray
+        (N,) determinants, positive where ``d`` lies below the plane through counterclockwise ``a, b, c``, with exact sign.
+
+    """
+    return _predicates.orient3d(_rows(a, 3), _rows(b, 3), _rows(c, 3), _rows(d, 3))
+
+
+def incircle(a, b, c, d):
+    """Position of 2D points relative to the circles through point triples.
+
+    Parameters
+    ----------
+    a, b, c, d : array_like
+        (N, 2) points, with ``a, b, c`` in counterclockwise order.
+
+    Returns
+    -------
+    numpy.ndarray
+        (N,) determinants, positive where ``d`` lies inside the circle, with exact sign.
+
+    """
+    return _predicates.incircle(_rows(a, 2), _rows(b, 2), _rows(c, 2), _rows(d, 2))
+
+
+def insphere(a, b, c, d, e):
+    """Position of 3D points relative to the spheres through point quadruples.
+
+    Parameters
+    ----------
+    a, b, c, d, e : array_like
+        (N, 3) points, with ``orient3d(a, b, c, d) > 0``.
+
+    Returns
+    -------
+    numpy.ndarray
+        (N,) determinants, positive where ``e`` lies inside the sphere, with exact sign.
+
+    """
+    return _predicates.insphere(_rows(a, 3), _rows(b, 3), _rows(c, 3), _rows(d, 3), _rows(e, 3))
+
+
+def stats():
+    """Number of evaluations and exact fallbacks per predicate.
+
+    The counts are shared by all extensions of this package, so they include the predicates
+    evaluated inside the Delaunay triangulation and the collision tests.
+
+    Returns
+    -------
+    dict
+        Maps ``"orient2d"``, ``"orient3d"``, ``"incircle"`` and ``"insphere"`` to dicts with ``"calls"`` and ``"exact"`` counts.
+
+    """
+    return _predicates.stats()
+
+
+def reset_stats():
+    """Reset the predicate statistics."""
+    _predicates.reset_stats()
@@ -0,0 +1,50 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _registration
+
+
+class ICP:
+    """Iterative closest point registration against a fixed target cloud.
+
+    The KD-tree and normals of the target are built once in the constructor and reused by every call to :meth:`align`.
+
+    Parameters
+    ----------
+    points : array_like
+        (N, 3) target points.
+    normals : array_like, optional
+        (N, 3) target normals, estimated from the 16 nearest neighbours if omitted.
+
+    """
+
+    def __init__(self, points, normals=None):
+        if normals is not None:
+            normals = np.ascontiguousarray(normals, dtype=np.float64)
+        self._icp = _registration.ICP(np.ascontiguousarray(points, dtype=np.float64), normals)
+
+    def align(self, source, initial=None, max_iterations=50, tolerance=1e-6, max_distance=np.inf, method="point_to_plane"):
+        """Align a source cloud to the target.
+
+        Parameters
+        ----------
+        source : array_like
+            (M, 3) source points.
+        initial : array_like, optional
+            Initial 4x4 source-to-target transform, the identity by default.
+        max_iterations : int, optional
+            Iteration limit.
+        tolerance : float, optional
+            Stop when the RMS residual improves by less than this.
+        max_distance : float, optional
+            Reject correspondences farther apart than this.
+        method : {"point_to_plane", "point_to_point"}, optional
+            Error metric minimized in each iteration.
+
+        Returns
+        -------
+        tuple
+            The 4x4 source-to-target transform, the RMS residual of each iteration and whether the iteration converged.
+
+        """
+        initial = np.eye(4) if initial is None else np.asarray(initial, dtype=np.float64)
+        return self._icp.align(np.ascontiguousarray(source, dtype=np.float64), initial, max_iterations, tolerance, max_distance, method)
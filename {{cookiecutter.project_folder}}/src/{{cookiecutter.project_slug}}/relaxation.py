@@ -0,0 +1,60 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _relaxation
+
+
+def _optional(values, dtype=np.float64):
+    return None if values is None else np.ascontiguousarray(values, dtype=dtype)
+
+
+def dynamic_relaxation(vertices, edges, fixed, loads=None, force_densities=None, stiffness=None, rest_lengths=None, max_iterations=10000, tolerance=1e-6):
+    """Find the equilibrium geometry of a cable net or bar network by dynamic relaxation.
+
+    The axial force of an edge of length ``L`` is ``q * L + EA * (L - L0) / L0``.
+    Force densities alone give force-density behaviour, stiffness with rest lengths gives elastic bars.
+
+    Parameters
+    ----------
+    vertices : array_like
+        (V, 3) initial coordinates.
+    edges : array_like
+        (E, 2) vertex indices.
+    fixed : array_like
+        Indices of the fixed vertices, or a (V,) boolean mask.
+    loads : array_like, optional
+        (V, 3) external loads.
+    force_densities : array_like, optional
+        (E,) force densities ``q``.
+    stiffness : array_like, optional
+        (E,) axial stiffness ``EA``.
+    rest_lengths : array_like, optional
+        (E,) rest lengths ``L0``, required with ``stiffness``.
+    max_iterations : int, optional
+        Iteration limit.
+    tolerance : float, optional
+        Largest residual force norm allowed at a free vertex.
+
+    Returns
+    -------
+    tuple
+        Coordinates (V, 3), residual forces (V, 3) with the reactions at fixed vertices,
+        axial forces (E,), the number of iterations and whether the tolerance was reached.
+
+    """
+    vertices = np.ascontiguousarray(vertices, dtype=np.float64)
+    fixed = np.asarray(fixed)
+    if fixed.dtype != bool or fixed.shape != (len(vertices),):
+        mask = np.zeros(len(vertices), dtype=bool)
+        mask[fixed.astype(np.int64)] = True
+        fixed = mask
+    return _relaxation.dynamic_relaxation(
+        vertices,
+        np.ascontiguousarray(edges, dtype=np.int32),
+        np.ascontiguousarray(fixed, dtype=np.uint8),
+        _optional(loads),
+        _optional(force_densities),
+        _optional(stiffness),
+        _optional(rest_lengths),
+        max_iterations,
+        tolerance,
+    )
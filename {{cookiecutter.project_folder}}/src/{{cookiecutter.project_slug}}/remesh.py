@@ -0,0 +1,36 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _remesh
+
+
+def remesh(mesh, target_length, iterations=10, project=True):
+    """Remesh a triangle mesh towards a uniform edge length.
+
+    Each iteration splits long edges, collapses short edges, flips edges to equalize vertex
+    valences and relaxes the vertices tangentially. Boundary vertices stay in place.
+
+    Parameters
+    ----------
+    mesh : tuple
+        ``(vertices, faces)`` as (V, 3) floats and (F, 3) ints, manifold and consistently oriented.
+    target_length : float
+        Target edge length.
+    iterations : int, optional
+        Number of remeshing iterations.
+    project : bool, optional
+        Project the relaxed vertices back onto the input surface.
+
+    Returns
+    -------
+    tuple
+        Vertices (V', 3) and faces (F', 3) of the new mesh.
+
+    """
+    vertices, faces = mesh
+    return _remesh.remesh(
+        np.ascontiguousarray(vertices, dtype=np.float64),
+        np.ascontiguousarray(faces, dtype=np.int32),
+        float(target_length),
+        int(iterations),
+        bool(project),
+    )
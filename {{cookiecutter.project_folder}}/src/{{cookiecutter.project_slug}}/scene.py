@@ -0,0 +1,75 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _scene
+
+
+class SceneGraph:
+    """Hierarchy of frames with cached world transforms.
+
+    Nodes are stored in flat arrays indexed by node. Changing a local transform or a parent only
+    marks the affected node dirty; world transforms of dirty nodes and their descendants are
+    recomputed on the next access to :attr:`worlds` or call to :meth:`update`.
+
+    Parameters
+    ----------
+    parents : array_like, optional
+        (N,) parent index per node, -1 for roots.
+    locals : array_like, optional
+        (N, 4, 4) local transforms relative to the parent.
+
+    """
+
+    def __init__(self, parents=None, locals=None):
+        if parents is None:
+            self._graph = _scene.SceneGraph()
+        else:
+            self._graph = _scene.SceneGraph(
+                np.ascontiguousarray(parents, dtype=np.int32),
+                np.ascontiguousarray(locals, dtype=np.float64).reshape(-1, 4, 4),
+            )
+
+    def __len__(self):
+        return len(self._graph)
+
+    def add(self, parent=-1, local=None):
+        """Append a node and return its index.
+
+        Arrays previously returned by :attr:`worlds` and :attr:`locals` stay valid but no longer
+        follow the graph: they keep the nodes and transforms from before the addition.
+
+        """
+        local = np.eye(4) if local is None else np.ascontiguousarray(local, dtype=np.float64)
+        return self._graph.add(parent, local)
+
+    def set_parent(self, index, parent):
+        """Move a node and its subtree under another parent, -1 to make it a root."""
+        self._graph.set_parent(index, parent)
+
+    def set_local(self, index, local):
+        """Set the local transform of one node."""
+        self._graph.set_local(index, np.ascontiguousarray(local, dtype=np.float64))
+
+    def set_locals(self, indices, locals):
+        """Set the local transforms of many nodes from (K,) indices and (K, 4, 4) transforms."""
+        self._graph.set_locals(
+            np.ascontiguousarray(indices, dtype=np.int32),
+            np.ascontiguousarray(locals, dtype=np.float64).reshape(-1, 4, 4),
+        )
+
+    def parent(self, index):
+        """Parent index of a node, -1 for roots."""
+        return self._graph.parent(index)
+
+    def update(self):
+        """Recompute dirty world transforms and return the number of recomputed nodes."""
+        return self._graph.update()
+
+    @property
+    def locals(self):
+        """numpy.ndarray: Read-only (N, 4, 4) view of the local transforms."""
+        return self._graph.locals
+
+    @property
+    def worlds(self):
+        """numpy.ndarray: Read-only (N, 4, 4) view of the world transforms, updated on access."""
+        return self._graph.worlds
@@ -0,0 +1,50 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _slicing
+
+
+def slice_mesh(mesh, origins, normals):
+    """Slice a triangle mesh with many planes.
+
+    Parameters
+    ----------
+    mesh : tuple
+        ``(vertices, faces)`` as (V, 3) floats and (F, 3) ints.
+    origins : array_like
+        (K, 3) points on the planes.
+    normals : array_like
+        (K, 3) plane normals.
+
+    Returns
+    -------
+    tuple
+        Points (P, 3), polyline offsets (L + 1,), plane index (L,) and closed flag (L,) per polyline.
+        Polyline ``i`` is ``points[offsets[i]:offsets[i + 1]]``; closed polylines repeat their first point.
+
+    """
+    vertices, faces = mesh
+    origins = np.ascontiguousarray(origins, dtype=np.float64).reshape(-1, 3)
+    normals = np.ascontiguousarray(np.broadcast_to(np.asarray(normals, dtype=np.float64), origins.shape))
+    points, offsets, planes, closed = _slicing.slice_mesh(
+        np.ascontiguousarray(vertices, dtype=np.float64),
+        np.ascontiguousarray(faces, dtype=np.int32),
+        origins,
+        normals,
+    )
+    return points, offsets, planes, closed.astype(bool)
+
+
+def slice_mesh_polylines(mesh, origins, normals):
+    """Slice a triangle mesh with many planes and group the polylines per plane.
+
+    Returns
+    -------
+    list of list of numpy.ndarray
+        For each plane, its polylines as (M, 3) arrays.
+
+    """
+    points, offsets, planes, _ = slice_mesh(mesh, origins, normals)
+    result = [[] for _ in range(len(np.atleast_2d(origins)))]
+    for i, plane in enumerate(planes):
+        result[plane].append(points[offsets[i]:offsets[i + 1]])
+    return result
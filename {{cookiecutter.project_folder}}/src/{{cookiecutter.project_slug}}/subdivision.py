@@ -0,0 +1,97 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _subdivision
+
+
+class Subdivision:
+    """Catmull-Clark or Loop subdivision of a fixed mesh topology.
+
+    The subdivided connectivity and one stencil table for all levels are computed once. Every
+    call to :meth:`apply` is then a single sparse product, so animating or optimizing the control
+    vertices only pays for the multiplication.
+
+    Parameters
+    ----------
+    faces : list of list of int or array_like
+        Vertex indices per face, polygons for ``"catmull-clark"`` and triangles for ``"loop"``,
+        manifold and consistently oriented.
+    scheme : {"catmull-clark", "loop"}, optional
+        Subdivision rules. Catmull-Clark produces quads, Loop produces triangles.
+    levels : int, optional
+        Number of subdivision steps.
+    vertex_count : int, optional
+        Number of control vertices, by default one more than the largest index in ``faces``.
+
+    Notes
+    -----
+    Boundary edges follow the cubic B-spline crease rules, boundary vertices with only two edges
+    and non-manifold boundary vertices stay in place.
+
+    """
+
+    def __init__(self, faces, scheme="catmull-clark", levels=1, vertex_count=None):
+        faces = [np.asarray(face, dtype=np.int32).ravel() for face in faces]
+        offsets = np.zeros(len(faces) + 1, dtype=np.int64)
+        np.cumsum([len(face) for face in faces], out=offsets[1:])
+        indices = np.concatenate(faces) if faces else np.zeros(0, dtype=np.int32)
+        if vertex_count is None:
+            vertex_count = int(indices.max()) + 1 if len(indices) else 0
+        self._subdivision = _subdivision.Subdivision(np.ascontiguousarray(indices), offsets, int(vertex_count), scheme, int(levels))
+
+    @property
+    def vertex_count(self):
+        """int: Number of subdivided vertices."""
+        return self._subdivision.vertex_count
+
+    @property
+    def face_count(self):
+        """int: Number of subdivided faces."""
+        return self._subdivision.face_count
+
+    @property
+    def faces(self):
+        """numpy.ndarray: (F', 4) quads or (F', 3) triangles of the subdivided mesh."""
+        return self._subdivision.faces()
+
+    def apply(self, vertices):
+        """Subdivide control vertices, or any other values attached to them.
+
+        Parameters
+        ----------
+        vertices : array_like
+            (V, D) values per control vertex, usually (V, 3) coordinates.
+
+        Returns
+        -------
+        numpy.ndarray
+            (V', D) values per subdivided vertex. The first V rows belong to the control vertices.
+
+        """
+        values = np.asarray(vertices, dtype=np.float64)
+        flat = values.ndim == 1
+        result = self._subdivision.apply(np.ascontiguousarray(values.reshape(len(values), -1)))
+        return result.ravel() if flat else result
+
+
+def subdivide(mesh, scheme="catmull-clark", levels=1):
+    """Subdivide a mesh once; use :class:`Subdivision` to subdivide moving vertices repeatedly.
+
+    Parameters
+    ----------
+    mesh : tuple
+        ``(vertices, faces)`` as (V, 3) floats and a list of polygons or an (F, k) int array.
+    scheme : {"catmull-clark", "loop"}, optional
+        Subdivision rules.
+    levels : int, optional
+        Number of subdivision steps.
+
+    Returns
+    -------
+    tuple
+        Vertices (V', 3) and faces (F', 4) or (F', 3) of the subdivided mesh.
+
+    """
+    vertices, faces = mesh
+    vertices = np.asarray(vertices, dtype=np.float64)
+    subdivision = Subdivision(faces, scheme, levels, len(vertices))
+    return subdivision.apply(vertices), subdivision.faces
@@ -0,0 +1,112 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}} import _transforms
+
+
+def _rows(array):
+    return np.ascontiguousarray(array, dtype=np.float64)
+
+
+def multiply_matrices(a, b):
+    """Multiply batches of 4x4 transforms.
+
+    Parameters
+    ----------
+    a, b : array_like
+        (N, 4, 4) transforms, or a single (4, 4) transform applied to every item of the other batch.
+
+    Returns
+    -------
+    numpy.ndarray
+        (N, 4, 4) products ``a[i] @ b[i]``.
+
+    """
+    return _transforms.multiply_matrices(_rows(a), _rows(b))
+
+
+def multiply_quaternions(a, b):
+    """Multiply batches of quaternions stored as ``(w, x, y, z)``.
+
+    Parameters
+    ----------
+    a, b : array_like
+        (N, 4) quaternions, or a single quaternion applied to every item of the other batch.
+
+    Returns
+    -------
+    numpy.ndarray
+        (N, 4) products.
+
+    """
+    return _transforms.multiply_quaternions(_rows(a), _rows(b))
+
+
+def normalize_quaternions(q):
+    """Scale (N, 4) quaternions to unit length."""
+    return _transforms.normalize_quaternions(_rows(q).reshape(-1, 4))
+
+
+def slerp_quaternions(a, b, t):
+    """Spherically interpolate between quaternions along the shorter arc.
+
+    Parameters
+    ----------
+    a, b : array_like
+        (N, 4) quaternions or single quaternions.
+    t : float or array_like
+        Interpolation parameters, broadcast to (N,).
+
+    Returns
+    -------
+    numpy.ndarray
+        (N, 4) interpolated quaternions.
+
+    """
+    a, b = _rows(a), _rows(b)
+    n = max(len(a) if a.ndim == 2 else 1, len(b) if b.ndim == 2 else 1)
+    t = np.ascontiguousarray(np.broadcast_to(np.asarray(t, dtype=np.float64), (n,)))
+    return _transforms.slerp_quaternions(a, b, t)
+
+
+def quaternions_to_matrices(q):
+    """Convert (N, 4) quaternions to (N, 4, 4) rotation matrices."""
+    return _transforms.quaternions_to_matrices(_rows(q).reshape(-1, 4))
+
+
+def quaternions_from_matrices(matrices):
+    """Convert the rotation part of (N, 4, 4) transforms to (N, 4) unit quaternions with ``w >= 0``."""
+    return _transforms.quaternions_from_matrices(_rows(matrices))
+
+
+def multiply_dual_quaternions(a, b):
+    """Multiply batches of (N, 8) dual quaternions, a single dual quaternion broadcasts."""
+    return _transforms.multiply_dual_quaternions(_rows(a), _rows(b))
+
+
+def dual_quaternions_to_matrices(d):
+    """Convert (N, 8) dual quaternions to (N, 4, 4) rigid transforms."""
+    return _transforms.dual_quaternions_to_matrices(_rows(d).reshape(-1, 8))
+
+
+def dual_quaternions_from_matrices(matrices):
+    """Convert rigid (N, 4, 4) transforms to (N, 8) unit dual quaternions, real part first."""
+    return _transforms.dual_quaternions_from_matrices(_rows(matrices))
+
+
+def blend_dual_quaternions(d, weights):
+    """Blend rigid transforms by dual quaternion linear blending.
+
+    Parameters
+    ----------
+    d : array_like
+        (K, 8) dual quaternions.
+    weights : array_like
+        (N, K) blend weights.
+
+    Returns
+    -------
+    numpy.ndarray
+        (N, 8) blended unit dual quaternions.
+
+    """
+    return _transforms.blend_dual_quaternions(_rows(d).reshape(-1, 8), _rows(weights).reshape(-1, len(d)))
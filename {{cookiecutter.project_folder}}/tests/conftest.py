@@ -0,0 +1,67 @@
+import numpy as np
+import pytest
+
+
+def make_icosphere(level=0):
+    """Unit icosphere as ``(vertices, faces)`` with outward facing triangles."""
+    t = (1.0 + 5.0**0.5) / 2.0
+    vertices = [[-1, t, 0], [1, t, 0], [-1, -t, 0], [1, -t, 0], [0, -1, t], [0, 1, t], [0, -1, -t], [0, 1, -t], [t, 0, -1], [t, 0, 1], [-t, 0, -1], [-t, 0, 1]]
+    vertices = [list(np.array(v, dtype=float) / np.linalg.norm(v)) for v in vertices]
+    faces = [[0, 11, 5], [0, 5, 1], [0, 1, 7], [0, 7, 10], [0, 10, 11], [1, 5, 9], [5, 11, 4], [11, 10, 2], [10, 7, 6], [7, 1, 8]]
+    faces += [[3, 9, 4], [3, 4, 2], [3, 2, 6], [3, 6, 8], [3, 8, 9], [4, 9, 5], [2, 4, 11], [6, 2, 10], [8, 6, 7], [9, 8, 1]]
+    for _ in range(level):
+        midpoints = {}
+
+        def midpoint(a, b):
+            key = (min(a, b), max(a, b))
+            if key not in midpoints:
+                p = (np.array(vertices[a]) + np.array(vertices[b])) / 2.0
+                vertices.append(list(p / np.linalg.norm(p)))
+                midpoints[key] = len(vertices) - 1
+            return midpoints[key]
+
+        refined = []
+        for a, b, c in faces:
+            x, y, z = midpoint(a, b), midpoint(b, c), midpoint(c, a)
+            refined += [[a, x, z], [b, y, x], [c, z, y], [x, y, z]]
+        faces = refined
+    return np.array(vertices, dtype=np.float64), np.array(faces, dtype=np.int32)
+
+
+def make_grid(n, size=1.0):
+    """Flat (n+1) x (n+1) grid in the XY plane as ``(vertices, faces)``."""
+    x, y = np.meshgrid(np.linspace(0.0, size, n + 1), np.linspace(0.0, size, n + 1), indexing="ij")
+    vertices = np.column_stack([x.ravel(), y.ravel(), np.zeros(x.size)])
+    i, j = np.meshgrid(np.arange(n), np.arange(n), indexing="ij")
+    a = (i * (n + 1) + j).ravel()
+    b, c = a + 1, a + n + 1
+    faces = np.concatenate([np.column_stack([a, c, b]), np.column_stack([b, c, c + 1])])
+    return vertices, faces.astype(np.int32)
+
+
+def edge_counts(faces):
+    """Number of faces on each undirected edge."""
+    edges = np.sort(np.concatenate([faces[:, [0, 1]], faces[:, [1, 2]], faces[:, [2, 0]]]), axis=1)
+    _, counts = np.unique(edges, axis=0, return_counts=True)
+    return counts
+
+
+def is_closed_manifold(faces):
+    """Every edge has exactly two faces and every directed edge appears once."""
+    directed = np.concatenate([faces[:, [0, 1]], faces[:, [1, 2]], faces[:, [2, 0]]])
+    return bool(np.all(edge_counts(faces) == 2) and len(np.unique(directed, axis=0)) == len(directed))
+
+
+def enclosed_volume(vertices, faces):
+    a, b, c = vertices[faces[:, 0]], vertices[faces[:, 1]], vertices[faces[:, 2]]
+    return float(np.einsum("ij,ij->i", a, np.cross(b, c)).sum() / 6.0)
+
+
+@pytest.fixture
+def icosphere():
+    return make_icosphere
+
+
+@pytest.fixture
+def grid():
+    return make_grid
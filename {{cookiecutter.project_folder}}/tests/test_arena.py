@@ -0,0 +1,59 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}}.geodesic import GeodesicSolver
+from {{cookiecutter.project_slug}}.graph import Graph
+from {{cookiecutter.project_slug}}.memory import arena_stats
+from {{cookiecutter.project_slug}}.memory import memory_stats
+from {{cookiecutter.project_slug}}.memory import reset_arena_stats
+from {{cookiecutter.project_slug}}.memory import trim_arenas
+from {{cookiecutter.project_slug}}.slicing import slice_mesh
+
+
+def test_stats_keys():
+    stats = arena_stats()
+    assert set(stats) == {"reserved", "high_water", "chunk_allocations", "arenas"}
+    assert all(value >= 0 for value in stats.values())
+
+
+def test_repeated_queries_reuse_the_arena(icosphere):
+    solver = GeodesicSolver(icosphere(3))
+    first = solver.distances([0])
+    reset_arena_stats()
+    for _ in range(5):
+        assert np.array_equal(solver.distances([0]), first)
+    stats = arena_stats()
+    assert stats["chunk_allocations"] == 0
+    assert stats["high_water"] >= 8 * 4 * solver.vertex_count
+
+
+def test_spanning_tree_reuses_the_arena():
+    rng = np.random.default_rng(0)
+    edges = rng.integers(0, 20_000, size=(100_000, 2))
+    edges = edges[edges[:, 0] != edges[:, 1]]
+    graph = Graph(edges, 20_000, rng.random(len(edges)))
+    expected = graph.minimum_spanning_tree()
+    graph.minimum_spanning_tree()
+    reset_arena_stats()
+    for _ in range(3):
+        selected, total = graph.minimum_spanning_tree()
+        assert np.array_equal(selected, expected[0]) and total == expected[1]
+    assert arena_stats()["chunk_allocations"] == 0
+
+
+def test_repeated_slices_reuse_the_arena(icosphere):
+    mesh = icosphere(4)
+    expected = slice_mesh(mesh, [[0.0, 0.0, 0.3]], [0.0, 0.0, 1.0])
+    reset_arena_stats()
+    for _ in range(5):
+        points, offsets, planes, closed = slice_mesh(mesh, [[0.0, 0.0, 0.3]], [0.0, 0.0, 1.0])
+        assert np.array_equal(points, expected[0]) and np.array_equal(offsets, expected[1])
+    stats = arena_stats()
+    assert stats["chunk_allocations"] == 0
+    assert stats["high_water"] >= 8 * len(mesh[0])
+
+
+def test_trim_returns_parked_chunks():
+    before = memory_stats()["arena"]["live"]
+    released = trim_arenas()
+    assert released >= 0
+    assert memory_stats()["arena"]["live"] == before - released
@@ -0,0 +1,120 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.attributes import AttributeStore
+from {{cookiecutter.project_slug}}.attributes import MeshAttributes
+from {{cookiecutter.project_slug}}.memory import memory_stats
+
+
+def test_columns_start_at_their_defaults():
+    store = AttributeStore(4)
+    store.add("weight", default=2.5)
+    store.add("label", "int", default=7)
+    store.add("normal", "vec3", default=[0.0, 0.0, 1.0])
+    store.add("name", "string")
+    assert len(store) == 4
+    assert store.names() == ["weight", "label", "normal", "name"]
+    assert [store.type(name) for name in store.names()] == ["float", "int", "vec3", "string"]
+    assert np.array_equal(store["weight"], np.full(4, 2.5))
+    assert store["label"].dtype == np.int64 and np.array_equal(store["label"], np.full(4, 7))
+    assert np.array_equal(store["normal"], np.tile([0.0, 0.0, 1.0], (4, 1)))
+    assert store.get("name") == [None] * 4
+
+
+def test_views_write_through_to_the_store():
+    store = AttributeStore(5)
+    store.add("height")
+    column = store["height"]
+    column[:] = np.arange(5.0)
+    assert np.array_equal(store.get("height", [4, 0]), [4.0, 0.0])
+    store.set("height", [1], [10.0])
+    assert column[1] == 10.0
+
+
+def test_set_and_get_by_index():
+    store = AttributeStore(6)
+    store.add("normal", "vec3")
+    store.add("label", "int")
+    store.set("normal", [0, 3], [[1.0, 0.0, 0.0], [0.0, 1.0, 0.0]])
+    store.set("label", [2, 2, 5], [1, 2, 3])
+    assert np.array_equal(store.get("normal", [3, 0, 1]), [[0.0, 1.0, 0.0], [1.0, 0.0, 0.0], [0.0, 0.0, 0.0]])
+    assert np.array_equal(store["label"], [0, 0, 2, 0, 0, 3])
+
+
+def test_strings_are_interned_per_column():
+    store = AttributeStore(4)
+    store.add("name", "string")
+    store.add("other", "string")
+    store.set("name", [0, 1, 2], ["a", "b", "a"])
+    store.set("other", [3], ["b"])
+    assert store.get("name") == ["a", "b", "a", None]
+    assert store.get("name", [2, 3]) == ["a", None]
+    assert store.strings("name") == ["a", "b"]
+    assert np.array_equal(store["name"], [0, 1, 0, -1])
+    assert store.strings("other") == ["b"]
+    store.set("name", [0], [None])
+    assert store.get("name", [0]) == [None]
+
+
+def test_resize_fills_new_rows_with_defaults():
+    store = AttributeStore(2)
+    store.add("weight", default=1.5)
+    store.add("normal", "vec3", default=[1.0, 2.0, 3.0])
+    store.set("weight", [0, 1], [4.0, 5.0])
+    store.resize(4)
+    assert np.array_equal(store["weight"], [4.0, 5.0, 1.5, 1.5])
+    assert np.array_equal(store["normal"][3], [1.0, 2.0, 3.0])
+    store.resize(1)
+    assert np.array_equal(store["weight"], [4.0])
+
+
+def test_views_outlive_resize_and_removal():
+    store = AttributeStore(3)
+    store.add("weight")
+    column = store["weight"]
+    column[:] = [1.0, 2.0, 3.0]
+    store.resize(5)
+    assert np.array_equal(column, [1.0, 2.0, 3.0])
+    assert np.array_equal(store["weight"], [1.0, 2.0, 3.0, 0.0, 0.0])
+    column[0] = 9.0
+    assert store["weight"][0] == 1.0
+    del store["weight"]
+    assert "weight" not in store
+    assert np.array_equal(column, [9.0, 2.0, 3.0])
+
+
+def test_errors():
+    store = AttributeStore(3)
+    store.add("weight")
+    with pytest.raises(ValueError):
+        store.add("weight")
+    with pytest.raises(ValueError):
+        store.add("colour", "rgb")
+    with pytest.raises(KeyError):
+        store["missing"]
+    with pytest.raises(KeyError):
+        del store["missing"]
+    with pytest.raises(IndexError):
+        store.get("weight", [3])
+    with pytest.raises(IndexError):
+        store.set("weight", [-1], [1.0])
+    with pytest.raises(ValueError):
+        store.set("weight", [0, 1], [1.0])
+
+
+def test_columns_are_accounted():
+    before = memory_stats()["attributes"]["live"]
+    store = AttributeStore(10_000)
+    store.add("normal", "vec3")
+    assert store.nbytes >= 240_000
+    assert memory_stats()["attributes"]["live"] - before >= 240_000
+    del store
+    assert memory_stats()["attributes"]["live"] == before
+
+
+def test_mesh_attributes_size_the_stores(icosphere):
+    vertices, faces = icosphere(1)
+    attributes = MeshAttributes.from_arrays(vertices, faces)
+    assert (len(attributes.vertices), len(attributes.faces), len(attributes.edges)) == (42, 80, 0)
+    attributes.faces.add("area")
+    assert attributes.nbytes == attributes.faces.nbytes > 0
@@ -0,0 +1,75 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.closest import MeshProjector
+from {{cookiecutter.project_slug}}.closest import PolylineProjector
+
+
+def segment_distances(points, a, b):
+    """Distances from (N, 3) points to (S, 3) segments ab as an (N, S) array."""
+    ab = b - a
+    t = np.clip(np.einsum("nsk,sk->ns", points[:, None] - a[None], ab) / np.einsum("sk,sk->s", ab, ab), 0.0, 1.0)
+    return np.linalg.norm(points[:, None] - (a[None] + t[..., None] * ab[None]), axis=2)
+
+
+def test_polyline_projection_matches_brute_force():
+    rng = np.random.default_rng(0)
+    polylines = [np.cumsum(rng.normal(size=(m, 3)), axis=0) for m in (5, 12, 2)]
+    points = rng.normal(scale=3.0, size=(200, 3))
+    closest, distances, ids, params = PolylineProjector(polylines).project(points)
+
+    expected = np.min([segment_distances(points, p[:-1], p[1:]).min(axis=1) for p in polylines], axis=0)
+    assert np.allclose(distances, expected)
+    assert np.allclose(np.linalg.norm(points - closest, axis=1), distances)
+    # The parameter locates the closest point on its polyline
+    for point, polyline, param in zip(closest, ids, params):
+        vertices = polylines[polyline]
+        segment = min(int(param), len(vertices) - 2)
+        t = param - segment
+        assert np.allclose(point, (1.0 - t) * vertices[segment] + t * vertices[segment + 1])
+
+
+def test_polyline_search_radius():
+    projector = PolylineProjector([[[0.0, 0.0, 0.0], [1.0, 0.0, 0.0]]])
+    closest, distances, ids, params = projector.project([[0.5, 0.5, 0.0], [0.5, 3.0, 0.0]], max_distance=1.0)
+    assert np.allclose(closest[0], [0.5, 0.0, 0.0])
+    assert np.allclose(distances[0], 0.5) and np.isclose(params[0], 0.5)
+    assert ids[1] == -1 and np.isinf(distances[1])
+
+
+def test_mesh_projection_onto_a_grid_clamps_to_the_square(grid):
+    vertices, faces = grid(8)
+    points = np.random.default_rng(1).uniform(-0.5, 1.5, (300, 3))
+    closest, distances, ids, barycentric = MeshProjector(vertices, faces).project(points)
+    expected = np.column_stack([np.clip(points[:, :2], 0.0, 1.0), np.zeros(300)])
+    assert np.allclose(closest, expected)
+    assert np.allclose(distances, np.linalg.norm(points - expected, axis=1))
+    assert np.all(ids >= 0)
+    assert np.allclose(barycentric.sum(axis=1), 1.0)
+    assert np.all(barycentric >= -1e-12)
+    assert np.allclose(np.einsum("nk,nkj->nj", barycentric, vertices[faces[ids]]), closest)
+
+
+def test_mesh_projection_onto_a_sphere(icosphere):
+    vertices, faces = icosphere(3)
+    directions = np.random.default_rng(2).normal(size=(200, 3))
+    directions /= np.linalg.norm(directions, axis=1)[:, None]
+    closest, distances, ids, _ = MeshProjector(vertices, faces).project(2.0 * directions)
+    assert np.all(np.linalg.norm(closest, axis=1) > 0.99)
+    assert np.allclose(distances, 1.0, atol=0.01)
+    # Never farther than the nearest vertex
+    nearest_vertex = np.linalg.norm(2.0 * directions[:, None] - vertices[None], axis=2).min(axis=1)
+    assert np.all(distances <= nearest_vertex + 1e-9)
+
+
+def test_mesh_search_radius(grid):
+    vertices, faces = grid(2)
+    _, distances, ids, _ = MeshProjector(vertices, faces).project([[0.5, 0.5, 2.0]], max_distance=1.0)
+    assert ids[0] == -1 and np.isinf(distances[0])
+
+
+def test_negative_search_radius_raises(grid):
+    with pytest.raises(ValueError):
+        PolylineProjector([[[0.0, 0.0, 0.0], [1.0, 0.0, 0.0]]]).project([[0.0, 1.0, 0.0]], max_distance=-1.0)
+    with pytest.raises(ValueError):
+        MeshProjector(*grid(2)).project([[0.0, 0.0, 1.0]], max_distance=-1.0)
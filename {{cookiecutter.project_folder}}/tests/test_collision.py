@@ -0,0 +1,63 @@
+import numpy as np
+
+from conftest import make_icosphere
+from {{cookiecutter.project_slug}}.collision import box_pairs
+from {{cookiecutter.project_slug}}.collision import face_pairs
+from {{cookiecutter.project_slug}}.collision import mesh_pairs
+
+
+def sphere(center, radius=1.0, level=2):
+    vertices, faces = make_icosphere(level)
+    return vertices * radius + center, faces
+
+
+def sorted_rows(pairs):
+    return pairs[np.lexsort(pairs.T[::-1])] if len(pairs) else pairs.reshape(0, 2)
+
+
+def test_box_pairs_match_brute_force():
+    rng = np.random.default_rng(0)
+    lower = rng.uniform(0.0, 10.0, (300, 3))
+    boxes = np.hstack([lower, lower + rng.uniform(0.1, 1.5, (300, 3))])
+    overlap = np.all(boxes[:, None, :3] <= boxes[None, :, 3:], axis=2) & np.all(boxes[None, :, :3] <= boxes[:, None, 3:], axis=2)
+    expected = np.argwhere(np.triu(overlap, 1))
+    assert np.array_equal(box_pairs(boxes), expected)
+
+
+def test_single_triangles():
+    triangle = (np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0]]), np.array([[0, 1, 2]]))
+    crossing = (np.array([[0.2, 0.2, -1.0], [0.2, 0.2, 1.0], [2.0, 2.0, 0.5]]), np.array([[0, 1, 2]]))
+    above = (np.array([[0.0, 0.0, 0.1], [1.0, 0.0, 0.1], [0.0, 1.0, 0.1]]), np.array([[0, 1, 2]]))
+    touching = (np.array([[1.0, 0.0, 0.0], [2.0, 0.0, 1.0], [2.0, 1.0, -1.0]]), np.array([[0, 1, 2]]))
+    coplanar = (np.array([[0.3, 0.3, 0.0], [2.0, 0.3, 0.0], [0.3, 2.0, 0.0]]), np.array([[0, 1, 2]]))
+    assert np.array_equal(face_pairs(triangle, crossing), [[0, 0]])
+    assert len(face_pairs(triangle, above)) == 0
+    assert np.array_equal(face_pairs(triangle, touching), [[0, 0]])
+    assert np.array_equal(face_pairs(triangle, coplanar), [[0, 0]])
+
+
+def test_overlapping_spheres_meet_along_their_intersection():
+    a, b = sphere([0.0, 0.0, 0.0]), sphere([1.0, 0.0, 0.0])
+    pairs = face_pairs(a, b)
+    assert len(pairs) > 0
+    # Reported faces of a straddle the surface of b, up to the sag of the faces
+    distances = np.linalg.norm(a[0][a[1][pairs[:, 0]]] - [1.0, 0.0, 0.0], axis=2)
+    assert np.all(distances.min(axis=1) <= 1.05)
+    assert np.all(distances.max(axis=1) >= 0.95)
+    assert np.array_equal(sorted_rows(face_pairs(b, a)[:, ::-1]), sorted_rows(pairs))
+
+
+def test_separated_and_nested_spheres_do_not_touch():
+    assert len(face_pairs(sphere([0.0, 0.0, 0.0]), sphere([2.5, 0.0, 0.0]))) == 0
+    assert len(face_pairs(sphere([0.0, 0.0, 0.0]), sphere([0.1, 0.0, 0.0], 0.5))) == 0
+
+
+def test_mesh_pairs_finds_touching_meshes():
+    meshes = [
+        sphere([0.0, 0.0, 0.0]),
+        sphere([1.5, 0.0, 0.0]),
+        sphere([10.0, 0.0, 0.0]),
+        sphere([3.0, 0.0, 0.0]),
+        sphere([0.0, 0.0, 0.0], 0.3),
+    ]
+    assert np.array_equal(mesh_pairs(meshes), [[0, 1], [1, 3]])
@@ -0,0 +1,85 @@
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.culling import BoxSet
+from {{cookiecutter.project_slug}}.culling import frustum_planes
+
+
+def random_boxes(rng, n):
+    lower = rng.uniform(-10.0, 10.0, (n, 3))
+    return np.hstack([lower, lower + rng.uniform(0.0, 1.0, (n, 3))])
+
+
+def overlapping(boxes, query):
+    return np.flatnonzero(np.all(boxes[:, :3] <= query[3:], axis=1) & np.all(boxes[:, 3:] >= query[:3], axis=1))
+
+
+def test_box_query_matches_brute_force():
+    rng = np.random.default_rng(0)
+    boxes = random_boxes(rng, 1000)
+    query = np.array([-2.0, -3.0, -1.0, 4.0, 2.0, 5.0])
+    assert np.array_equal(BoxSet(boxes).box(query), overlapping(boxes, query))
+
+
+def test_sphere_query_matches_brute_force():
+    rng = np.random.default_rng(1)
+    boxes = random_boxes(rng, 1000)
+    center = np.array([1.0, -2.0, 0.5])
+    nearest = np.clip(center, boxes[:, :3], boxes[:, 3:])
+    expected = np.flatnonzero(np.sum((nearest - center) ** 2, axis=1) <= 16.0)
+    assert np.array_equal(BoxSet(boxes).sphere(center, 4.0), expected)
+
+
+def test_frustum_of_an_orthographic_view_is_its_box():
+    rng = np.random.default_rng(2)
+    boxes = random_boxes(rng, 1000)
+    # Maps [-5, 5] x [-5, 5] x [-5, 5] to clip space
+    matrix = np.diag([0.2, 0.2, 0.2, 1.0])
+    planes = frustum_planes(matrix)
+    assert np.allclose(np.linalg.norm(planes[:, :3], axis=1), 1.0)
+    expected = overlapping(boxes, np.array([-5.0, -5.0, -5.0, 5.0, 5.0, 5.0]))
+    assert np.array_equal(BoxSet(boxes).frustum(matrix=matrix), expected)
+
+
+def test_queries_see_updates():
+    rng = np.random.default_rng(3)
+    boxes = random_boxes(rng, 500)
+    boxset = BoxSet(boxes)
+    query = np.array([20.0, 20.0, 20.0, 21.0, 21.0, 21.0])
+    assert len(boxset.box(query)) == 0
+    moved = np.array([7, 300, 499])
+    boxes[moved] = [20.2, 20.2, 20.2, 20.4, 20.4, 20.4]
+    boxset.update(moved, boxes[moved])
+    assert np.array_equal(boxset.box(query), moved)
+    assert np.array_equal(boxset.boxes, boxes)
+
+
+
+def test_update_checks_every_index_first():
+    boxes = random_boxes(np.random.default_rng(4), 10)
+    boxset = BoxSet(boxes)
+    with pytest.raises(IndexError):
+        boxset.update([2, 10], np.zeros((2, 6)))
+    assert np.array_equal(boxset.boxes, boxes)
+
+
+def test_concurrent_queries_and_updates():
+    rng = np.random.default_rng(4)
+    boxes = random_boxes(rng, 5000)
+    boxset = BoxSet(boxes)
+    query = np.array([-10.0, -10.0, -10.0, 0.0, 11.0, 11.0])
+    expected = overlapping(boxes, query)
+
+    def work(k):
+        if k % 2:
+            # Rewrite boxes with their own values: blocks become dirty, results stay the same
+            indices = np.arange(k, 5000, 97)
+            boxset.update(indices, boxes[indices])
+            return expected
+        return boxset.box(query)
+
+    with ThreadPoolExecutor(8) as pool:
+        for result in pool.map(work, range(64)):
+            assert np.array_equal(result, expected)
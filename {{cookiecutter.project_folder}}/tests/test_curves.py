@@ -0,0 +1,96 @@
+from math import comb
+
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.curves import evaluate_curve
+from {{cookiecutter.project_slug}}.curves import evaluate_curves
+from {{cookiecutter.project_slug}}.curves import evaluate_polylines
+from {{cookiecutter.project_slug}}.curves import evaluate_surface
+from {{cookiecutter.project_slug}}.curves import evaluate_surface_grid
+
+
+def bezier(points, t):
+    n = len(points) - 1
+    basis = np.array([comb(n, i) * t**i * (1.0 - t) ** (n - i) for i in range(n + 1)])
+    return basis.T @ points
+
+
+def test_cubic_bezier_and_its_derivative():
+    points = np.array([[0.0, 0.0, 0.0], [1.0, 2.0, 0.0], [3.0, 2.0, 1.0], [4.0, 0.0, 0.0]])
+    t = np.linspace(0.0, 1.0, 21)
+    result = evaluate_curve(points, [0, 0, 0, 0, 1, 1, 1, 1], 3, t, order=1)
+    assert result.shape == (21, 2, 3)
+    assert np.allclose(result[:, 0], bezier(points, t))
+    assert np.allclose(result[:, 1], 3.0 * bezier(np.diff(points, axis=0), t))
+
+
+def test_rational_quadratic_is_a_circular_arc():
+    points = [[1.0, 0.0, 0.0], [1.0, 1.0, 0.0], [0.0, 1.0, 0.0]]
+    weights = [1.0, np.sqrt(0.5), 1.0]
+    result = evaluate_curve(points, [0, 0, 0, 1, 1, 1], 2, np.linspace(0.0, 1.0, 33), weights=weights, order=1)
+    assert np.allclose(np.linalg.norm(result[:, 0], axis=1), 1.0)
+    # The derivative is tangent to the circle
+    assert np.allclose(np.einsum("ij,ij->i", result[:, 0], result[:, 1]), 0.0)
+
+
+def test_clamped_spline_interpolates_its_end_points():
+    points = np.random.default_rng(0).random((7, 3))
+    knots = [0, 0, 0, 0, 0.25, 0.5, 0.75, 1, 1, 1, 1]
+    ends = evaluate_curve(points, knots, 3, [0.0, 1.0])
+    assert np.allclose(ends, points[[0, -1]])
+
+
+def test_batch_matches_single_curves():
+    rng = np.random.default_rng(1)
+    curves = [(rng.random((5, 3)), None, [0, 0, 0, 0.5, 1, 1, 1, 1], 3), (rng.random((3, 3)), rng.uniform(0.5, 2.0, 3), [0, 0, 1, 2, 2], 1)]
+    params = [np.linspace(0.0, 1.0, 7), np.linspace(0.0, 2.0, 4)]
+    results = evaluate_curves(curves, params, order=1)
+    for (points, weights, knots, degree), t, result in zip(curves, params, results):
+        assert np.allclose(result, evaluate_curve(points, knots, degree, t, weights=weights, order=1))
+
+
+def test_invalid_curves_raise():
+    with pytest.raises(ValueError):
+        evaluate_curve(np.zeros((4, 3)), [0, 0, 1, 1], 3, [0.5])
+    with pytest.raises(ValueError):
+        evaluate_curves([(np.zeros((2, 3)), None, [0, 0, 1, 1], 1)], [])
+
+
+def test_no_curves_give_an_empty_list():
+    assert evaluate_curves([], []) == []
+    assert evaluate_polylines([], []) == []
+
+
+def test_bilinear_surface():
+    points = np.array([[[0.0, 0.0, 0.0], [0.0, 1.0, 1.0]], [[2.0, 0.0, 0.0], [2.0, 1.0, -1.0]]])
+    uv = np.random.default_rng(2).random((10, 2))
+    result = evaluate_surface(points, [0, 0, 1, 1], [0, 0, 1, 1], 1, 1, uv, derivatives=True)
+    u, v = uv[:, :1], uv[:, 1:]
+    expected = (1 - u) * (1 - v) * points[0, 0] + (1 - u) * v * points[0, 1] + u * (1 - v) * points[1, 0] + u * v * points[1, 1]
+    assert np.allclose(result[:, 0], expected)
+    assert np.allclose(result[:, 1], (1 - v) * (points[1, 0] - points[0, 0]) + v * (points[1, 1] - points[0, 1]))
+    assert np.allclose(result[:, 2], (1 - u) * (points[0, 1] - points[0, 0]) + u * (points[1, 1] - points[1, 0]))
+
+
+def test_surface_grid_matches_scattered_evaluation():
+    rng = np.random.default_rng(3)
+    points = rng.random((4, 5, 3))
+    weights = rng.uniform(0.5, 2.0, (4, 5))
+    knots_u, knots_v = [0, 0, 0, 0.5, 1, 1, 1], [0, 0, 0, 0, 0.5, 1, 1, 1, 1]
+    us, vs = np.linspace(0.0, 1.0, 6), np.linspace(0.0, 1.0, 7)
+    grid = evaluate_surface_grid(points, knots_u, knots_v, 2, 3, us, vs, weights=weights, derivatives=True)
+    uv = np.stack(np.meshgrid(us, vs, indexing="ij"), axis=-1).reshape(-1, 2)
+    scattered = evaluate_surface(points, knots_u, knots_v, 2, 3, uv, weights=weights, derivatives=True)
+    assert grid.shape == (6, 7, 3, 3)
+    assert np.allclose(grid.reshape(-1, 3, 3), scattered)
+
+
+def test_polylines_by_arc_length():
+    square = [[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [1.0, 1.0, 0.0], [0.0, 1.0, 0.0]]
+    line = [[0.0, 0.0, 0.0], [0.0, 0.0, 2.0]]
+    first, second = evaluate_polylines([square, line], [[0.0, 0.25, 0.5, 0.75, 1.0], [0.5]])
+    assert np.allclose(first[:, 0], [[0, 0, 0], [0.75, 0, 0], [1, 0.5, 0], [0.75, 1, 0], [0, 1, 0]])
+    assert np.allclose(first[1, 1], [3.0, 0.0, 0.0])
+    assert np.allclose(first[2, 1], [0.0, 3.0, 0.0])
+    assert np.allclose(second, [[[0.0, 0.0, 1.0], [0.0, 0.0, 2.0]]])
@@ -0,0 +1,103 @@
+import numpy as np
+import pytest
+from conftest import edge_counts
+from conftest import enclosed_volume
+from conftest import is_closed_manifold
+
+from {{cookiecutter.project_slug}}.decimate import decimate
+from {{cookiecutter.project_slug}}.decimate import decimate_clustering
+
+
+def boundary_vertices(faces):
+    edges = np.sort(np.concatenate([faces[:, [0, 1]], faces[:, [1, 2]], faces[:, [2, 0]]]), axis=1)
+    unique, counts = np.unique(edges, axis=0, return_counts=True)
+    return np.unique(unique[counts == 1])
+
+
+@pytest.mark.parametrize("target", [2000, 500, 100])
+def test_sphere_reaches_the_target_and_stays_closed(icosphere, target):
+    mesh = icosphere(4)
+    vertices, faces = decimate(mesh, target)
+    assert 0.9 * target <= len(faces) <= target
+    assert is_closed_manifold(faces)
+    assert len(vertices) - len(faces) // 2 == 2  # Euler characteristic of a sphere
+    assert len(np.unique(faces)) == len(vertices)
+    assert abs(enclosed_volume(vertices, faces) / enclosed_volume(*mesh) - 1.0) < 0.05
+    assert np.allclose(np.linalg.norm(vertices, axis=1), 1.0, atol=0.05)
+
+
+def test_faces_keep_their_orientation(icosphere):
+    vertices, faces = decimate(icosphere(3), 200)
+    a, b, c = vertices[faces[:, 0]], vertices[faces[:, 1]], vertices[faces[:, 2]]
+    normals = np.cross(b - a, c - a)
+    assert np.all(np.einsum("ij,ij->i", normals, a + b + c) > 0.0)
+
+
+def test_flat_regions_collapse_without_error(grid):
+    vertices, faces = grid(16)
+    out_vertices, out_faces = decimate((vertices, faces), max_error=1e-12)
+    assert len(out_faces) < len(faces) // 4
+    assert np.all(edge_counts(out_faces) <= 2)
+    assert np.allclose(out_vertices[:, 2], 0.0)
+    # Boundary vertices stay in place and the region keeps its area
+    boundary = vertices[boundary_vertices(faces)]
+    for point in boundary:
+        assert np.min(np.linalg.norm(out_vertices - point, axis=1)) < 1e-12
+    a, b, c = out_vertices[out_faces[:, 0]], out_vertices[out_faces[:, 1]], out_vertices[out_faces[:, 2]]
+    assert np.isclose(0.5 * np.cross(b - a, c - a)[:, 2].sum(), 1.0)
+
+
+def test_error_bound_stops_on_curved_surfaces(icosphere):
+    mesh = icosphere(2)
+    vertices, faces = decimate(mesh, max_error=0.0)
+    assert len(faces) == len(mesh[1])
+    assert len(decimate(mesh, max_error=1e-3)[1]) < len(mesh[1])
+
+
+def test_error_bound_applies_to_collapses_onto_the_boundary():
+    angles = np.linspace(0.0, 2.0 * np.pi, 6, endpoint=False)
+    vertices = np.vstack([[0.0, 0.0, 0.5], np.column_stack([np.cos(angles), np.sin(angles), np.zeros(6)])])
+    faces = np.array([[0, 1 + k, 1 + (k + 1) % 6] for k in range(6)])
+    # The apex can only move onto a boundary vertex, costing its squared distances to the apex planes
+    a, b, c = vertices[faces[:, 0]], vertices[faces[:, 1]], vertices[faces[:, 2]]
+    normals = np.cross(b - a, c - a)
+    areas = 0.5 * np.linalg.norm(normals, axis=1)
+    cost = np.sum(areas * (np.einsum("ij,ij->i", vertices[1] - a, normals) / (2.0 * areas)) ** 2)
+    assert len(decimate((vertices, faces), 4, max_error=0.99 * cost)[1]) == 6
+    out_vertices, out_faces = decimate((vertices, faces), 4, max_error=1.01 * cost)
+    assert len(out_faces) == 4
+    assert np.allclose(out_vertices[:, 2], 0.0)
+
+
+def test_target_above_the_face_count_changes_nothing(icosphere):
+    mesh = icosphere(1)
+    vertices, faces = decimate(mesh, 1000)
+    assert len(faces) == 80 and len(vertices) == 42
+
+
+def test_clustering_merges_vertices_per_cell(icosphere):
+    mesh = icosphere(4)
+    vertices, faces = decimate_clustering(mesh, 0.25)
+    cells = np.unique(np.floor(mesh[0] / 0.25), axis=0)
+    assert len(vertices) <= len(cells)
+    assert 0 < len(faces) < len(mesh[1]) // 4
+    assert np.all((faces[:, 0] != faces[:, 1]) & (faces[:, 1] != faces[:, 2]) & (faces[:, 2] != faces[:, 0]))
+    assert len(np.unique(np.sort(faces, axis=1), axis=0)) == len(faces)
+    assert np.all(np.linalg.norm(vertices, axis=1) < 1.0 + 0.25)
+
+
+def test_clustering_with_small_cells_keeps_the_mesh(icosphere):
+    mesh = icosphere(2)
+    vertices, faces = decimate_clustering(mesh, 1e-3)
+    assert len(vertices) == len(mesh[0]) and len(faces) == len(mesh[1])
+    assert is_closed_manifold(faces)
+
+
+def test_invalid_arguments_raise(icosphere):
+    mesh = icosphere(0)
+    with pytest.raises(ValueError):
+        decimate(mesh)
+    with pytest.raises(ValueError):
+        decimate_clustering(mesh, 0.0)
+    with pytest.raises(IndexError):
+        decimate((mesh[0], mesh[1] + 12), 10)
@@ -0,0 +1,100 @@
+import numpy as np
+
+from {{cookiecutter.project_slug}}.delaunay import delaunay_2d
+from {{cookiecutter.project_slug}}.delaunay import delaunay_3d
+from {{cookiecutter.project_slug}}.memory import memory_stats
+from {{cookiecutter.project_slug}}.memory import reset_memory_peaks
+
+
+def circumspheres(points, simplices):
+    """Centers and squared radii of the circumspheres of (T, D + 1) simplices."""
+    corners = points[simplices]
+    edges = corners[:, 1:] - corners[:, :1]
+    rhs = 0.5 * np.einsum("tij,tij->ti", edges, edges)
+    centers = corners[:, 0] + np.linalg.solve(edges, rhs[..., None])[..., 0]
+    return centers, np.sum((centers - corners[:, 0]) ** 2, axis=1)
+
+
+def hull_area(points):
+    """Area of the convex hull of 2D points by the monotone chain."""
+    points = sorted(map(tuple, points))
+
+    def chain(points):
+        hull = []
+        for p in points:
+            while len(hull) > 1 and np.cross(np.subtract(hull[-1], hull[-2]), np.subtract(p, hull[-2])) <= 0:
+                hull.pop()
+            hull.append(p)
+        return hull[:-1]
+
+    hull = np.array(chain(points) + chain(points[::-1]))
+    return 0.5 * abs(np.dot(hull[:, 0], np.roll(hull[:, 1], -1)) - np.dot(hull[:, 1], np.roll(hull[:, 0], -1)))
+
+
+def test_triangles_have_empty_circumcircles():
+    points = np.random.default_rng(0).random((400, 2))
+    triangles = delaunay_2d(points)
+    centers, radii = circumspheres(points, triangles)
+    distances = np.sum((points[None] - centers[:, None]) ** 2, axis=2)
+    assert np.all(distances >= radii[:, None] * (1.0 - 1e-9))
+
+
+def test_triangles_are_counterclockwise_and_cover_the_hull():
+    points = np.random.default_rng(1).random((400, 2))
+    triangles = delaunay_2d(points)
+    a, b, c = (points[triangles[:, k]] for k in range(3))
+    areas = 0.5 * np.cross(b - a, c - a)
+    assert np.all(areas > 0.0)
+    assert np.isclose(areas.sum(), hull_area(points))
+    # Euler's formula for a triangulated convex polygon
+    assert len(np.unique(triangles)) == 400
+
+
+def test_tetrahedra_have_empty_circumspheres():
+    points = np.random.default_rng(2).random((300, 3))
+    tetrahedra = delaunay_3d(points)
+    a, b, c, d = (points[tetrahedra[:, k]] for k in range(4))
+    volumes = np.einsum("ij,ij->i", b - a, np.cross(c - a, d - a)) / 6.0
+    assert np.all(volumes != 0.0)
+    assert len(np.unique(np.sign(volumes))) == 1
+    centers, radii = circumspheres(points, tetrahedra)
+    distances = np.sum((points[None] - centers[:, None]) ** 2, axis=2)
+    assert np.all(distances >= radii[:, None] * (1.0 - 1e-9))
+
+
+def test_unit_cube_is_filled():
+    points = np.random.default_rng(3).random((300, 3))
+    corners = np.array([[i, j, k] for i in (0, 1) for j in (0, 1) for k in (0, 1)], dtype=float)
+    points = np.vstack([corners, points])
+    tetrahedra = delaunay_3d(points)
+    a, b, c, d = (points[tetrahedra[:, k]] for k in range(4))
+    volumes = np.abs(np.einsum("ij,ij->i", b - a, np.cross(c - a, d - a))) / 6.0
+    assert np.isclose(volumes.sum(), 1.0)
+
+
+def test_duplicate_points_are_skipped():
+    # Either copy of a duplicate may be kept, so compare the triangles by point rather than by index
+    points = np.random.default_rng(4).random((100, 2))
+    triangles = delaunay_2d(np.vstack([points, points[:10]])) % 100
+    expected = {tuple(sorted(t)) for t in delaunay_2d(points)}
+    assert len(triangles) == len(expected)
+    assert {tuple(sorted(t)) for t in triangles} == expected
+
+
+def test_points_in_general_position_follow_input_order():
+    # The insertion order is internal: indices refer to the input rows
+    points = np.random.default_rng(5).random((50, 2))
+    permutation = np.random.default_rng(6).permutation(50)
+    triangles = delaunay_2d(points[permutation])
+    expected = {tuple(sorted(t)) for t in delaunay_2d(points)}
+    assert {tuple(sorted(permutation[t])) for t in triangles} == expected
+
+
+def test_working_buffers_are_tracked():
+    n = 20_000
+    points = np.random.default_rng(5).random((n, 3))
+    reset_memory_peaks()
+    before = memory_stats()["arrays"]["peak"]
+    simplices = delaunay_3d(points)
+    # The reordered copy of the points and the insertion order are held while the result is built
+    assert memory_stats()["arrays"]["peak"] - before >= simplices.nbytes + (3 * 8 + 4) * n
@@ -0,0 +1,74 @@
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.fdm import ForceDensity
+
+
+def make_net(n):
+    """Square net of n x n vertices with the boundary fixed and a unit load down on every vertex."""
+    index = np.arange(n * n).reshape(n, n)
+    edges = np.vstack([np.column_stack([index[:, :-1].ravel(), index[:, 1:].ravel()]), np.column_stack([index[:-1].ravel(), index[1:].ravel()])])
+    x, y = np.meshgrid(np.linspace(0.0, 1.0, n), np.linspace(0.0, 1.0, n))
+    vertices = np.column_stack([x.ravel(), y.ravel(), np.zeros(n * n)])
+    fixed = np.zeros(n * n, dtype=bool)
+    fixed[index[[0, -1]].ravel()] = fixed[index[:, [0, -1]].ravel()] = True
+    loads = np.zeros((n * n, 3))
+    loads[:, 2] = -1.0
+    return edges, fixed, vertices, loads
+
+
+def residuals(edges, q, xyz, loads):
+    vectors = xyz[edges[:, 1]] - xyz[edges[:, 0]]
+    result = loads.copy()
+    np.add.at(result, edges[:, 0], q[:, None] * vectors)
+    np.add.at(result, edges[:, 1], -q[:, None] * vectors)
+    return result
+
+
+def test_free_vertices_are_in_equilibrium():
+    edges, fixed, vertices, loads = make_net(8)
+    network = ForceDensity(edges, fixed)
+    q = np.random.default_rng(0).uniform(1.0, 5.0, len(edges))
+    xyz, lengths, forces = network.solve(q, vertices, loads)
+    assert np.allclose(xyz[fixed], vertices[fixed])
+    assert np.allclose(residuals(edges, q, xyz, loads)[~fixed], 0.0, atol=1e-9)
+    assert np.allclose(lengths, np.linalg.norm(xyz[edges[:, 1]] - xyz[edges[:, 0]], axis=1))
+    assert np.allclose(forces, q * lengths)
+    assert np.all(xyz[~fixed, 2] < 0.0)
+
+
+def test_solve_many_matches_solve():
+    edges, fixed, vertices, loads = make_net(6)
+    network = ForceDensity(edges, fixed)
+    q = np.random.default_rng(1).uniform(1.0, 5.0, (4, len(edges)))
+    xyz, forces = network.solve_many(q, vertices, loads)
+    assert xyz.shape == (4, 36, 3) and forces.shape == (4, len(edges))
+    for b in range(4):
+        expected, _, expected_forces = network.solve(q[b], vertices, loads)
+        assert np.allclose(xyz[b], expected)
+        assert np.allclose(forces[b], expected_forces)
+
+
+def test_concurrent_solves_share_a_network():
+    edges, fixed, vertices, loads = make_net(20)
+    network = ForceDensity(edges, fixed)
+    q = np.random.default_rng(2).uniform(1.0, 5.0, (32, len(edges)))
+    expected = [network.solve(row, vertices, loads)[0] for row in q]
+    with ThreadPoolExecutor(8) as pool:
+        results = list(pool.map(lambda row: network.solve(row, vertices, loads)[0], q))
+    for result, reference in zip(results, expected):
+        assert np.array_equal(result, reference)
+
+
+def test_unsupported_vertices_raise():
+    edges = np.array([[0, 1], [2, 3]])
+    with pytest.raises(ValueError):
+        ForceDensity(edges, [0], vertex_count=4).solve(np.ones(2), np.zeros((4, 3)))
+
+
+def test_solve_checks_the_force_densities():
+    edges, fixed, vertices, _ = make_net(4)
+    with pytest.raises(ValueError):
+        ForceDensity(edges, fixed).solve(np.ones(len(edges) - 1), vertices)
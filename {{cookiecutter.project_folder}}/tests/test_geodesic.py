@@ -0,0 +1,68 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.geodesic import GeodesicSolver
+
+
+def great_circle(vertices, sources):
+    """Exact distance on the unit sphere to the nearest source vertex."""
+    return np.min(np.arccos(np.clip(vertices @ vertices[np.atleast_1d(sources)].T, -1.0, 1.0)), axis=1)
+
+
+def test_sphere_distances_follow_great_circle_arcs(icosphere):
+    errors = []
+    for level in (3, 4):
+        vertices, faces = icosphere(level)
+        distances = GeodesicSolver((vertices, faces)).distances(0)
+        assert distances[0] == 0.0 and np.all(distances >= 0.0)
+        errors.append(np.abs(distances - great_circle(vertices, 0)))
+    assert errors[1].max() < 0.04 and errors[1].mean() < 0.02
+    assert errors[1].max() < errors[0].max()
+
+
+def test_distances_to_the_nearest_of_many_sources(icosphere):
+    vertices, faces = icosphere(4)
+    solver = GeodesicSolver((vertices, faces))
+    antipode = int(np.argmin(vertices @ vertices[0]))
+    assert np.abs(solver.distances([0, antipode]) - great_circle(vertices, [0, antipode])).max() < 0.04
+    equator = int(np.argmin(np.abs(vertices @ vertices[0])))
+    distances = solver.distances([0, equator])
+    assert np.allclose(distances[[0, equator]], 0.0, atol=1e-3)
+    assert np.abs(distances - great_circle(vertices, [0, equator])).max() < 0.1
+
+
+def test_flat_distances_are_euclidean(grid):
+    vertices, faces = grid(16)
+    solver = GeodesicSolver((vertices, faces))
+    for source in (0, 8 * 17 + 8):
+        assert np.abs(solver.distances(source) - np.linalg.norm(vertices - vertices[source], axis=1)).max() < 0.06
+
+
+def test_many_source_sets_match_single_queries(icosphere):
+    solver = GeodesicSolver(icosphere(2))
+    sets = [[0], [5, 17], [3], [0, 1, 2]]
+    distances = solver.distances_many(sets)
+    assert distances.shape == (4, solver.vertex_count)
+    for row, sources in zip(distances, sets):
+        assert np.allclose(row, solver.distances(sources))
+
+
+def test_disconnected_parts_are_unreachable(icosphere):
+    vertices, faces = icosphere(2)
+    solver = GeodesicSolver((np.vstack([vertices, vertices + 3.0]), np.vstack([faces, faces + len(vertices)])))
+    assert solver.vertex_count == 2 * len(vertices) and solver.face_count == 2 * len(faces)
+    distances = solver.distances(0)
+    assert np.all(np.isfinite(distances[: len(vertices)]))
+    assert np.all(np.isinf(distances[len(vertices) :]))
+    both = solver.distances([0, len(vertices)])
+    assert np.allclose(both[: len(vertices)], both[len(vertices) :])
+
+
+def test_invalid_input_raises(icosphere):
+    mesh = icosphere(1)
+    with pytest.raises(ValueError):
+        GeodesicSolver(mesh, time_factor=0.0)
+    with pytest.raises(IndexError):
+        GeodesicSolver(mesh).distances(42)
+    with pytest.raises(IndexError):
+        GeodesicSolver((mesh[0], mesh[1] + 1))
@@ -0,0 +1,137 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.graph import Graph
+
+
+def random_graph(seed, V=40, E=90, integer_weights=False):
+    """Random multigraph with loops, parallel edges and a few isolated vertices beyond the edges."""
+    rng = np.random.default_rng(seed)
+    edges = rng.integers(0, V - 4, (E, 2))
+    edges[:3] = [[0, 0], [1, 2], [2, 1]]
+    weights = rng.integers(1, 4, E).astype(float) if integer_weights else rng.uniform(0.1, 2.0, E)
+    return edges, weights, V
+
+
+def floyd_warshall(edges, weights, V):
+    distances = np.full((V, V), np.inf)
+    np.fill_diagonal(distances, 0.0)
+    for (a, b), w in zip(edges, weights):
+        distances[a, b] = distances[b, a] = min(distances[a, b], w)
+    for k in range(V):
+        distances = np.minimum(distances, distances[:, k, None] + distances[None, k, :])
+    return distances
+
+
+def kruskal(edges, weights, V):
+    parent = list(range(V))
+
+    def root(v):
+        while parent[v] != v:
+            parent[v] = parent[parent[v]]
+            v = parent[v]
+        return v
+
+    selected = []
+    for e in np.argsort(weights, kind="stable"):
+        a, b = root(edges[e][0]), root(edges[e][1])
+        if a != b:
+            parent[a] = b
+            selected.append(e)
+    return np.sort(selected)
+
+
+def test_adjacency_lists_every_edge_end():
+    edges, _, V = random_graph(0)
+    graph = Graph(edges, V)
+    offsets, neighbours, incident = graph.adjacency()
+    assert graph.vertex_count == V and graph.edge_count == len(edges)
+    assert offsets[0] == 0 and offsets[-1] == len(neighbours) == len(incident) == 2 * len(edges)
+    for v in range(V):
+        for u, e in zip(neighbours[offsets[v] : offsets[v + 1]], incident[offsets[v] : offsets[v + 1]]):
+            assert sorted(edges[e]) == sorted([u, v])
+    assert np.array_equal(np.diff(offsets), np.bincount(edges.ravel(), minlength=V))
+
+
+def test_vertex_count_defaults_to_the_largest_index():
+    assert Graph([[0, 3], [1, 2]]).vertex_count == 4
+    assert Graph(np.zeros((0, 2))).vertex_count == 0
+
+
+def test_bfs_matches_hop_distances():
+    edges, _, V = random_graph(1)
+    hops = floyd_warshall(edges, np.ones(len(edges)), V)
+    depth, parents = Graph(edges, V).bfs(3)
+    assert np.array_equal(depth, np.where(np.isinf(hops[3]), -1, hops[3]))
+    for v in range(V):
+        if v == 3 or depth[v] < 0:
+            assert parents[v] == -1
+        else:
+            assert depth[parents[v]] == depth[v] - 1 and hops[parents[v], v] == 1
+
+
+def test_components_follow_reachability():
+    edges, _, V = random_graph(2, E=30)
+    reachable = np.isfinite(floyd_warshall(edges, np.ones(len(edges)), V))
+    labels, count = Graph(edges, V).connected_components()
+    assert np.array_equal(labels[:, None] == labels[None, :], reachable)
+    assert count == len(np.unique(labels)) and count > 4
+    first = [int(np.flatnonzero(labels == label)[0]) for label in range(count)]
+    assert first == sorted(first)
+
+
+@pytest.mark.parametrize("method", ["delta", "dijkstra"])
+def test_shortest_paths_match_floyd_warshall(method):
+    edges, weights, V = random_graph(3)
+    expected = floyd_warshall(edges, weights, V)
+    graph = Graph(edges, V, weights)
+    for source in (0, 5, V - 1):
+        distances, parents = graph.shortest_paths(source, method)
+        assert np.allclose(distances, expected[source])
+        for v in np.flatnonzero(np.isfinite(distances)):
+            if v != source:
+                assert np.isclose(distances[parents[v]] + expected[parents[v], v], distances[v])
+                assert Graph.path(parents, source, v)[0] == source
+        assert np.all(parents[np.isinf(distances)] == -1)
+        assert Graph.path(parents, source, V - 1) == ([V - 1] if source == V - 1 else [])
+
+
+def test_delta_stepping_is_independent_of_the_bucket_width():
+    edges, weights, V = random_graph(4, V=200, E=800)
+    graph = Graph(edges, V, weights)
+    reference = graph.shortest_paths(7, "dijkstra")[0]
+    for delta in (0.05, 0.5, 10.0):
+        assert np.allclose(graph.shortest_paths(7, delta=delta)[0], reference)
+
+
+def test_distance_matrix_rows_are_single_source_distances():
+    edges, weights, V = random_graph(5)
+    expected = floyd_warshall(edges, weights, V)
+    sources = [0, 4, 4, 11]
+    assert np.allclose(Graph(edges, V, weights).distance_matrix(sources), expected[sources])
+
+
+def test_minimum_spanning_forest_matches_kruskal():
+    edges, weights, V = random_graph(6, integer_weights=True)
+    selected, total = Graph(edges, V, weights).minimum_spanning_tree()
+    expected = kruskal(edges, weights, V)
+    assert np.array_equal(selected, expected)
+    assert np.isclose(total, weights[expected].sum())
+    _, count = Graph(edges, V).connected_components()
+    assert len(selected) == V - count
+
+
+def test_invalid_input_raises():
+    with pytest.raises(IndexError):
+        Graph([[0, 5]], vertex_count=3)
+    with pytest.raises(ValueError):
+        Graph([[0, 1]], weights=[-1.0])
+    with pytest.raises(ValueError):
+        Graph([[0, 1]], weights=[1.0, 2.0])
+    graph = Graph([[0, 1]])
+    with pytest.raises(ValueError):
+        graph.shortest_paths(0, method="bellman-ford")
+    with pytest.raises(IndexError):
+        graph.bfs(2)
+    with pytest.raises(IndexError):
+        graph.distance_matrix([0, 2])
@@ -0,0 +1,97 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.kinematics import Chain
+
+
+@pytest.fixture
+def arm():
+    # Planar arm with two revolute joints and unit links
+    return Chain.from_dh([1.0, 1.0], [0.0, 0.0], [0.0, 0.0])
+
+
+def test_planar_arm_reaches_its_analytic_position(arm):
+    q = np.random.default_rng(0).uniform(-np.pi, np.pi, (50, 2))
+    frames = arm.forward(q)
+    assert frames.shape == (50, 4, 4)
+    x = np.cos(q[:, 0]) + np.cos(q[:, 0] + q[:, 1])
+    y = np.sin(q[:, 0]) + np.sin(q[:, 0] + q[:, 1])
+    assert np.allclose(frames[:, :3, 3], np.column_stack([x, y, np.zeros(50)]))
+    assert np.allclose(np.linalg.det(frames[:, :3, :3]), 1.0)
+
+
+def test_jacobians_match_finite_differences(arm):
+    q = np.random.default_rng(1).uniform(-np.pi, np.pi, (10, 2))
+    jacobians = arm.jacobians(q)
+    step = 1e-6
+    for j in range(2):
+        dq = np.zeros(2)
+        dq[j] = step
+        difference = (arm.forward(q + dq)[:, :3, 3] - arm.forward(q - dq)[:, :3, 3]) / (2.0 * step)
+        assert np.allclose(jacobians[:, :3, j], difference, atol=1e-6)
+    assert np.allclose(jacobians[:, 5, :], 1.0)
+
+
+def test_inverse_recovers_reachable_frames(arm):
+    q = np.random.default_rng(2).uniform(0.2, 1.2, (20, 2))
+    targets = arm.forward(q)
+    solution, success, _, position_error, _ = arm.inverse(targets, [0.5, 0.5])
+    assert success.all()
+    assert np.all(position_error < 1e-6)
+    assert np.allclose(arm.forward(solution), targets, atol=1e-5)
+
+
+def test_single_configuration_is_a_batch_of_one(arm):
+    assert arm.forward([0.0, 0.0]).shape == (1, 4, 4)
+    assert np.allclose(arm.forward([0.0, 0.0])[0, :3, 3], [2.0, 0.0, 0.0])
+
+
+@pytest.mark.parametrize("q", [np.zeros((3, 3)), np.zeros(4), np.zeros((2, 1, 2))])
+def test_configurations_with_the_wrong_shape_raise(arm, q):
+    with pytest.raises(ValueError):
+        arm.forward(q)
+    with pytest.raises(ValueError):
+        arm.jacobians(q)
+    with pytest.raises(ValueError):
+        arm.inverse(np.tile(np.eye(4), (3, 1, 1)), q)
+
+
+def test_targets_must_be_frames(arm):
+    with pytest.raises(ValueError):
+        arm.inverse(np.zeros((2, 3, 4)), [0.0, 0.0])
+
+
+def test_position_only_inverse_of_a_redundant_arm():
+    arm = Chain.from_dh([1.0, 1.0, 1.0], [0.0, 0.0, 0.0], [0.0, 0.0, 0.0])
+    rng = np.random.default_rng(3)
+    radius, angle = rng.uniform(0.5, 2.5, 50), rng.uniform(0.0, 2.0 * np.pi, 50)
+    targets = np.tile(np.eye(4), (50, 1, 1))
+    targets[:, 0, 3], targets[:, 1, 3] = radius * np.cos(angle), radius * np.sin(angle)
+    q, success, _, position_error, _ = arm.inverse(targets, [0.3, 0.3, 0.3], orientation_weight=0.0)
+    assert success.all() and np.all(position_error < 1e-6)
+    assert np.allclose(arm.forward(q)[:, :3, 3], targets[:, :3, 3], atol=1e-6)
+
+
+def test_unreachable_targets_stretch_towards_the_target(arm):
+    target = np.eye(4)
+    target[:2, 3] = [2.5, 2.5]
+    q, success, _, position_error, _ = arm.inverse(target, [0.3, 0.3], orientation_weight=0.0)
+    assert not success[0]
+    assert np.isclose(position_error[0], np.hypot(2.5, 2.5) - 2.0, atol=1e-6)
+    assert np.allclose(q[0], [np.pi / 4.0, 0.0], atol=1e-4)
+
+
+def test_inverse_respects_joint_limits(arm):
+    arm.set_limits([-0.1, 0.0], [0.1, 0.5])
+    target = np.eye(4)
+    target[:2, 3] = [0.0, 1.5]
+    q, success, _, _, _ = arm.inverse(target, [0.0, 0.0], orientation_weight=0.0)
+    assert not success[0]
+    assert np.all((q[0] >= [-0.1, 0.0]) & (q[0] <= [0.1, 0.5]))
+    with pytest.raises(ValueError):
+        arm.set_limits([0.5, 0.0], [0.0, 1.0])
+    # A bad pair for the second joint leaves the first joint's limits unchanged too
+    with pytest.raises(ValueError):
+        arm.set_limits([-1.0, 0.5], [1.0, 0.0])
+    q, _, _, _, _ = arm.inverse(target, [0.0, 0.0], orientation_weight=0.0)
+    assert np.all((q[0] >= [-0.1, 0.0]) & (q[0] <= [0.1, 0.5]))
@@ -0,0 +1,58 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.memory import memory_limit
+from {{cookiecutter.project_slug}}.memory import memory_stats
+from {{cookiecutter.project_slug}}.memory import reset_memory_peaks
+from {{cookiecutter.project_slug}}.memory import set_memory_limit
+from {{cookiecutter.project_slug}}.predicates import orient2d
+
+
+@pytest.fixture
+def no_limit():
+    yield
+    set_memory_limit(None)
+
+
+def test_stats_cover_every_subsystem():
+    stats = memory_stats()
+    assert set(stats) == {"arrays", "arena", "pool", "attributes", "total"}
+    for counters in stats.values():
+        assert set(counters) == {"live", "peak", "count", "allocations"}
+        assert counters["peak"] >= counters["live"] >= 0
+    assert stats["total"]["live"] == sum(stats[tag]["live"] for tag in ("arrays", "arena", "pool", "attributes"))
+
+
+def test_result_arrays_are_held_until_collected():
+    n = 100_000
+    before = memory_stats()["arrays"]["live"]
+    result = orient2d(np.zeros((n, 2)), np.ones((n, 2)), np.eye(2)[np.zeros(n, dtype=int)])
+    assert memory_stats()["arrays"]["live"] - before >= 8 * n
+    del result
+    assert memory_stats()["arrays"]["live"] == before
+
+
+def test_peaks_restart_from_live():
+    orient2d(np.zeros((50_000, 2)), np.ones((50_000, 2)), np.ones((50_000, 2)))
+    reset_memory_peaks()
+    stats = memory_stats()
+    assert stats["arrays"]["peak"] == stats["arrays"]["live"]
+
+
+def test_limit_raises_before_allocating(no_limit):
+    n = 1_000_000
+    set_memory_limit(memory_stats()["total"]["live"] + 1024)
+    assert memory_limit() is not None
+    before = memory_stats()["arrays"]
+    with pytest.raises(MemoryError):
+        orient2d(np.zeros((n, 2)), np.ones((n, 2)), np.ones((n, 2)))
+    after = memory_stats()["arrays"]
+    assert after["live"] == before["live"] and after["allocations"] == before["allocations"]
+    set_memory_limit(None)
+    assert memory_limit() is None
+    assert len(orient2d(np.zeros((n, 2)), np.ones((n, 2)), np.ones((n, 2)))) == n
+
+
+def test_limit_must_be_positive():
+    with pytest.raises(ValueError):
+        set_memory_limit(0)
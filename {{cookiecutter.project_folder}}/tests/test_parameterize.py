@@ -0,0 +1,105 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.parameterize import Parameterization
+from {{cookiecutter.project_slug}}.parameterize import parameterize
+from {{cookiecutter.project_slug}}.parameterize import parameterize_many
+
+
+def hemisphere(icosphere, level=3):
+    """Upper half of an icosphere, a disk with a curved interior."""
+    vertices, faces = icosphere(level)
+    faces = faces[np.all(vertices[faces, 2] > -1e-9, axis=1)]
+    used, faces = np.unique(faces, return_inverse=True)
+    return vertices[used], faces.reshape(-1, 3).astype(np.int32)
+
+
+def signed_areas(uv, faces):
+    a, b, c = uv[faces[:, 0]], uv[faces[:, 1]], uv[faces[:, 2]]
+    return 0.5 * ((b - a)[:, 0] * (c - a)[:, 1] - (b - a)[:, 1] * (c - a)[:, 0])
+
+
+def boundary_vertices(faces):
+    edges = np.sort(np.concatenate([faces[:, [0, 1]], faces[:, [1, 2]], faces[:, [2, 0]]]), axis=1)
+    unique, counts = np.unique(edges, axis=0, return_counts=True)
+    return np.unique(unique[counts == 1])
+
+
+def test_lscm_of_a_flat_mesh_is_a_similarity(grid):
+    vertices, faces = grid(8)
+    vertices = vertices * [2.0, 1.0, 0.0]
+    uv = parameterize((vertices, faces))
+    z, w = vertices[:, 0] + 1j * vertices[:, 1], uv[:, 0] + 1j * uv[:, 1]
+    (scale, shift), *_ = np.linalg.lstsq(np.column_stack([z, np.ones_like(z)]), w, rcond=None)
+    assert np.allclose(scale * z + shift, w, atol=1e-9)
+    assert np.isclose(abs(scale), 1.0)  # the default fixed vertices keep their true distance
+
+
+def test_lscm_with_fixed_vertices_reproduces_the_plane(grid):
+    vertices, faces = grid(6)
+    parameterization = Parameterization((vertices, faces), fixed=[0, 48])
+    assert np.array_equal(parameterization.fixed, [0, 48]) and parameterization.default_positions.shape == (0, 2)
+    assert np.allclose(parameterization.solve(vertices[[0, 48], :2]), vertices[:, :2])
+
+
+def test_harmonic_spreads_the_boundary_over_a_circle(grid):
+    vertices, faces = grid(8)
+    uv = parameterize((vertices, faces), "harmonic")
+    boundary = boundary_vertices(faces)
+    radii = np.linalg.norm(uv[boundary] - uv[boundary].mean(axis=0), axis=1)
+    assert np.allclose(radii, 4.0 / (2.0 * np.pi))
+    interior = np.setdiff1d(np.arange(len(vertices)), boundary)
+    assert np.all(np.linalg.norm(uv[interior] - uv[boundary].mean(axis=0), axis=1) < radii[0])
+    assert np.all(signed_areas(uv, faces) > 0.0)
+
+
+def test_harmonic_reproduces_linear_boundaries(grid):
+    vertices, faces = grid(6)
+    boundary = boundary_vertices(faces)
+    uv = Parameterization((vertices, faces), "harmonic", boundary).solve(vertices[boundary, :2])
+    assert np.allclose(uv, vertices[:, :2])
+
+
+@pytest.mark.parametrize("method", ["lscm", "harmonic"])
+def test_curved_disk_flattens_without_flips(icosphere, method):
+    vertices, faces = hemisphere(icosphere)
+    uv = parameterize((vertices, faces), method)
+    assert uv.shape == (len(vertices), 2) and np.all(np.isfinite(uv))
+    assert np.all(signed_areas(uv, faces) > 0.0)
+
+
+def test_solve_is_linear_in_the_fixed_positions(icosphere):
+    vertices, faces = hemisphere(icosphere, 2)
+    parameterization = Parameterization((vertices, faces), "harmonic")
+    defaults = parameterization.default_positions
+    assert len(defaults) == len(parameterization.fixed) == len(boundary_vertices(faces))
+    uv = parameterization.solve()
+    assert np.allclose(uv[parameterization.fixed], defaults)
+    assert np.allclose(parameterization.solve(2.0 * defaults + [1.0, -3.0]), 2.0 * uv + [1.0, -3.0])
+
+
+def test_many_meshes_match_single_solves(grid, icosphere):
+    meshes = [grid(4), hemisphere(icosphere, 2), grid(7)]
+    for method in ("lscm", "harmonic"):
+        for uv, mesh in zip(parameterize_many(meshes, method), meshes):
+            assert np.allclose(uv, parameterize(mesh, method))
+
+
+def test_invalid_input_raises(grid, icosphere):
+    mesh = grid(3)
+    with pytest.raises(ValueError):
+        parameterize(icosphere(1))
+    with pytest.raises(ValueError):
+        parameterize(mesh, "arap")
+    with pytest.raises(ValueError):
+        Parameterization(mesh, fixed=[0])
+    with pytest.raises(ValueError):
+        Parameterization(mesh, fixed=[0, 0])
+    with pytest.raises(IndexError):
+        Parameterization(mesh, fixed=[0, 16])
+    with pytest.raises(ValueError):
+        Parameterization(mesh, fixed=[0, 15]).solve()
+    with pytest.raises(ValueError):
+        Parameterization(mesh, fixed=[0, 15]).solve(np.zeros((3, 2)))
+    with pytest.raises(ValueError):
+        parameterize_many([mesh, icosphere(0)])
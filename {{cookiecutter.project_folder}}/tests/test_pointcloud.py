@@ -0,0 +1,42 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.pointcloud import estimate_normals
+from {{cookiecutter.project_slug}}.pointcloud import knn
+
+
+def test_knn_matches_brute_force():
+    points = np.random.default_rng(0).random((500, 3))
+    result = knn(points, 6)
+    distances = np.linalg.norm(points[:, None] - points[None], axis=2)
+    expected = np.argsort(distances, axis=1, kind="stable")[:, :6]
+    assert result.shape == (500, 6)
+    assert np.array_equal(result[:, 0], np.arange(500))
+    assert np.allclose(np.take_along_axis(distances, result, axis=1), np.take_along_axis(distances, expected, axis=1))
+
+
+@pytest.mark.parametrize("k", [0, 11])
+def test_knn_rejects_k_outside_the_cloud(k):
+    with pytest.raises(ValueError):
+        knn(np.random.default_rng(1).random((10, 3)), k)
+
+
+def test_sphere_normals_point_outward(icosphere):
+    vertices, _ = icosphere(3)
+    normals, curvature = estimate_normals(vertices, k=8)
+    assert np.allclose(np.linalg.norm(normals, axis=1), 1.0)
+    assert np.all(np.einsum("ij,ij->i", normals, vertices) > 0.99)
+    assert np.all((curvature >= 0.0) & (curvature <= 1.0 / 3.0 + 1e-12))
+
+
+def test_plane_normals_face_the_viewpoint():
+    rng = np.random.default_rng(2)
+    points = np.column_stack([rng.random((300, 2)), np.zeros(300)])
+    normals, curvature = estimate_normals(points, k=10, orientation="viewpoint", viewpoint=[0.5, 0.5, -1.0])
+    assert np.allclose(normals, [0.0, 0.0, -1.0])
+    assert np.allclose(curvature, 0.0, atol=1e-12)
+
+
+def test_estimate_normals_needs_three_neighbours():
+    with pytest.raises(ValueError):
+        estimate_normals(np.zeros((10, 3)), k=2)
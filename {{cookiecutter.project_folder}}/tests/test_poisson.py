@@ -0,0 +1,41 @@
+import numpy as np
+import pytest
+from conftest import is_closed_manifold
+from conftest import enclosed_volume
+
+from {{cookiecutter.project_slug}}.poisson import poisson_reconstruction
+
+
+def fibonacci_sphere(n):
+    i = np.arange(n) + 0.5
+    z = 1.0 - 2.0 * i / n
+    r = np.sqrt(1.0 - z * z)
+    a = np.pi * (3.0 - np.sqrt(5.0)) * i
+    return np.column_stack([r * np.cos(a), r * np.sin(a), z])
+
+
+@pytest.mark.parametrize("depth", [5, 6, 7])
+def test_sphere_is_watertight(depth):
+    points = fibonacci_sphere(4000)
+    vertices, faces = poisson_reconstruction(points, points, depth=depth)
+    assert is_closed_manifold(faces)
+    assert len(vertices) - len(faces) // 2 == 2
+    assert enclosed_volume(vertices, faces) == pytest.approx(4.0 / 3.0 * np.pi, rel=0.02)
+    assert np.allclose(np.linalg.norm(vertices, axis=1), 1.0, atol=0.05)
+
+
+def test_nearly_touching_spheres_stay_manifold():
+    # The gap between the spheres puts sign patterns with ambiguous cube faces on the grid
+    rng = np.random.default_rng(3)
+    normals = rng.normal(size=(3000, 3))
+    normals /= np.linalg.norm(normals, axis=1)[:, None]
+    points = normals + np.where(np.arange(3000) % 2, 1.05, -1.05)[:, None] * [1.0, 0.0, 0.0]
+    vertices, faces = poisson_reconstruction(points, normals, depth=6)
+    assert is_closed_manifold(faces)
+    assert len(vertices) - len(faces) // 2 == 4  # two spheres
+    assert enclosed_volume(vertices, faces) == pytest.approx(8.0 / 3.0 * np.pi, rel=0.02)
+
+
+def test_requires_points():
+    with pytest.raises(ValueError):
+        poisson_reconstruction(np.zeros((0, 3)), np.zeros((0, 3)))
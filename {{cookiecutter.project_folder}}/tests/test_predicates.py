@@ -0,0 +1,62 @@
+from fractions import Fraction
+
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.collision import face_pairs
+from {{cookiecutter.project_slug}}.predicates import incircle
+from {{cookiecutter.project_slug}}.predicates import insphere
+from {{cookiecutter.project_slug}}.predicates import orient2d
+from {{cookiecutter.project_slug}}.predicates import orient3d
+from {{cookiecutter.project_slug}}.predicates import reset_stats
+from {{cookiecutter.project_slug}}.predicates import stats
+
+
+def exact_orient2d(a, b, c):
+    a, b, c = ([Fraction(x) for x in p] for p in (a, b, c))
+    return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0])
+
+
+def test_orient2d_sign_is_exact_near_a_line():
+    # Points within a few ulps of the line y = x, where the naive determinant rounds to noise
+    rng = np.random.default_rng(0)
+    a = np.tile([0.5, 0.5], (200, 1))
+    b = np.tile([12.0, 12.0], (200, 1))
+    c = 24.0 + rng.integers(-4, 5, (200, 2)) * np.spacing(24.0)
+    expected = np.sign([float(exact_orient2d(*p)) for p in zip(a, b, c)])
+    assert np.array_equal(np.sign(orient2d(a, b, c)), expected)
+
+
+def test_signs_of_simple_configurations():
+    assert orient2d([0.0, 0.0], [1.0, 0.0], [0.0, 1.0])[0] > 0.0
+    assert orient2d([0.0, 0.0], [1.0, 1.0], [2.0, 2.0])[0] == 0.0
+    assert orient3d([0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [0.0, 0.0, -1.0])[0] > 0.0
+    assert incircle([1.0, 0.0], [0.0, 1.0], [-1.0, 0.0], [0.0, 0.5])[0] > 0.0
+    assert incircle([1.0, 0.0], [0.0, 1.0], [-1.0, 0.0], [0.0, -1.0])[0] == 0.0
+    a, b, c, d = [1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [-1.0, 0.0, 0.0], [0.0, 0.0, 1.0]
+    if orient3d(a, b, c, d)[0] < 0.0:
+        a, b = b, a
+    assert insphere(a, b, c, d, [0.0, 0.0, 0.0])[0] > 0.0
+    assert insphere(a, b, c, d, [0.0, 0.0, -1.0])[0] == 0.0
+    assert insphere(a, b, c, d, [0.0, 0.0, -2.0])[0] < 0.0
+
+
+@pytest.mark.parametrize("points", [np.zeros((4, 3)), np.zeros(3), np.zeros((2, 2, 2))])
+def test_points_with_the_wrong_dimension_raise(points):
+    with pytest.raises(ValueError):
+        orient2d(points, points, points)
+
+
+def test_mismatched_counts_raise():
+    with pytest.raises(ValueError):
+        orient2d(np.zeros((3, 2)), np.zeros((3, 2)), np.zeros((2, 2)))
+
+
+def test_stats_count_predicates_of_other_modules():
+    reset_stats()
+    a = ([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 1.0, 0.0]], [[0, 1, 2]])
+    b = ([[0.2, 0.2, -1.0], [0.2, 0.2, 1.0], [0.8, 0.9, 0.0]], [[0, 1, 2]])
+    assert len(face_pairs(a, b)) == 1
+    assert stats()["orient3d"]["calls"] > 0
+    reset_stats()
+    assert stats()["orient3d"]["calls"] == 0
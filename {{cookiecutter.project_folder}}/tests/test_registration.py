@@ -0,0 +1,76 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.registration import ICP
+
+
+def surface(n, seed):
+    """Samples of a wavy height field, which has no sliding symmetry, and their unit normals."""
+    x, y = np.random.default_rng(seed).uniform(-1.0, 1.0, (2, n))
+    z = 0.3 * np.sin(3.0 * x) * np.cos(2.0 * y) + 0.2 * x * y
+    dzdx = 0.9 * np.cos(3.0 * x) * np.cos(2.0 * y) + 0.2 * y
+    dzdy = -0.6 * np.sin(3.0 * x) * np.sin(2.0 * y) + 0.2 * x
+    normals = np.column_stack([-dzdx, -dzdy, np.ones(n)])
+    return np.column_stack([x, y, z]), normals / np.linalg.norm(normals, axis=1)[:, None]
+
+
+def rigid(angle, axis, translation):
+    axis = np.asarray(axis, dtype=float) / np.linalg.norm(axis)
+    k = np.array([[0.0, -axis[2], axis[1]], [axis[2], 0.0, -axis[0]], [-axis[1], axis[0], 0.0]])
+    matrix = np.eye(4)
+    matrix[:3, :3] = np.eye(3) + np.sin(angle) * k + (1.0 - np.cos(angle)) * k @ k
+    matrix[:3, 3] = translation
+    return matrix
+
+
+def apply(matrix, points):
+    return points @ matrix[:3, :3].T + matrix[:3, 3]
+
+
+@pytest.mark.parametrize("method", ["point_to_plane", "point_to_point"])
+def test_recovers_the_motion_of_a_subset(method):
+    target, _ = surface(4000, 0)
+    motion = rigid(np.radians(4.0), [1.0, 2.0, 3.0], [0.03, -0.02, 0.05])
+    source = apply(motion, target[::3])
+    transform, residuals, converged = ICP(target).align(source, method=method, max_iterations=100)
+    assert converged
+    assert residuals[-1] < 1e-6
+    assert np.allclose(transform @ motion, np.eye(4), atol=1e-6)
+
+
+def test_point_to_plane_aligns_independent_samples():
+    # Point-to-point would stop at the spacing of the samples, point-to-plane slides along the surface
+    target, _ = surface(4000, 0)
+    motion = rigid(np.radians(4.0), [1.0, 2.0, 3.0], [0.03, -0.02, 0.05])
+    source = apply(motion, surface(1500, 1)[0])
+    transform, residuals, converged = ICP(target).align(source)
+    assert converged
+    assert residuals[-1] < 0.05 * residuals[0]
+    assert np.allclose(transform @ motion, np.eye(4), atol=1e-3)
+
+
+def test_initial_transform_is_used():
+    target, _ = surface(2000, 2)
+    motion = rigid(np.radians(3.0), [0.0, 0.0, 1.0], [0.5, 0.0, 0.0])
+    source = apply(motion, target)
+    transform, residuals, converged = ICP(target).align(source, initial=np.linalg.inv(motion))
+    assert converged and residuals[0] < 1e-9
+    assert np.allclose(transform, np.linalg.inv(motion))
+
+
+def test_exact_normals_are_used():
+    target, normals = surface(4000, 3)
+    motion = rigid(np.radians(2.0), [1.0, -1.0, 0.5], [0.02, 0.01, -0.03])
+    source = apply(motion, surface(1500, 4)[0])
+    transform, _, converged = ICP(target, normals).align(source)
+    assert converged
+    assert np.allclose(transform @ motion, np.eye(4), atol=1e-3)
+
+
+def test_invalid_arguments_raise():
+    with pytest.raises(ValueError):
+        ICP(np.zeros((2, 3)))
+    with pytest.raises(ValueError):
+        ICP(surface(100, 5)[0]).align(surface(10, 6)[0], method="point_to_line")
+    with pytest.raises(ValueError):
+        ICP(surface(100, 5)[0], np.zeros((99, 3)))
@@ -0,0 +1,76 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.fdm import ForceDensity
+from {{cookiecutter.project_slug}}.relaxation import dynamic_relaxation
+
+
+def make_net(n):
+    """Square net of n x n vertices with the boundary fixed and a unit load down on every vertex."""
+    index = np.arange(n * n).reshape(n, n)
+    edges = np.vstack([np.column_stack([index[:, :-1].ravel(), index[:, 1:].ravel()]), np.column_stack([index[:-1].ravel(), index[1:].ravel()])])
+    x, y = np.meshgrid(np.linspace(0.0, 1.0, n), np.linspace(0.0, 1.0, n))
+    vertices = np.column_stack([x.ravel(), y.ravel(), np.zeros(n * n)])
+    fixed = np.zeros(n * n, dtype=bool)
+    fixed[index[[0, -1]].ravel()] = fixed[index[:, [0, -1]].ravel()] = True
+    loads = np.zeros((n * n, 3))
+    loads[:, 2] = -1.0
+    return edges, fixed, vertices, loads
+
+
+def test_force_densities_match_the_linear_solve():
+    edges, fixed, vertices, loads = make_net(6)
+    q = 1.0 + np.arange(len(edges)) % 5
+    xyz, residuals, forces, iterations, converged = dynamic_relaxation(vertices, edges, fixed, loads, force_densities=q, tolerance=1e-8)
+    expected, lengths, expected_forces = ForceDensity(edges, fixed).solve(q, vertices, loads)
+    assert converged and 0 < iterations < 10000
+    assert np.allclose(xyz, expected, atol=1e-7)
+    assert np.allclose(forces, expected_forces, atol=1e-6)
+    assert np.all(np.linalg.norm(residuals[~fixed], axis=1) <= 1e-8)
+    assert np.allclose(residuals.sum(axis=0), loads.sum(axis=0))
+
+
+def test_fixed_vertices_accept_indices_or_a_mask():
+    edges, fixed, vertices, loads = make_net(5)
+    q = np.ones(len(edges))
+    by_mask = dynamic_relaxation(vertices, edges, fixed, loads, force_densities=q)[0]
+    by_index = dynamic_relaxation(vertices, edges, np.flatnonzero(fixed), loads, force_densities=q)[0]
+    assert np.array_equal(by_mask, by_index)
+    assert np.array_equal(by_mask[fixed], vertices[fixed])
+
+
+def test_elastic_bar_stretches_under_its_load():
+    vertices = np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0]])
+    loads = np.array([[0.0, 0.0, 0.0], [10.0, 0.0, 0.0]])
+    xyz, residuals, forces, _, converged = dynamic_relaxation(vertices, [[0, 1]], [0], loads, stiffness=[100.0], rest_lengths=[1.0], tolerance=1e-9)
+    assert converged
+    assert np.allclose(xyz[1], [1.1, 0.0, 0.0])
+    assert np.allclose(forces, [10.0])
+    assert np.allclose(residuals[0], [10.0, 0.0, 0.0])
+
+
+def test_two_bar_truss_sags_into_equilibrium():
+    vertices = np.array([[-1.0, 0.0, 0.0], [1.0, 0.0, 0.0], [0.0, 0.0, -1.0]])
+    loads = np.array([[0.0, 0.0, 0.0], [0.0, 0.0, 0.0], [0.0, 0.0, -10.0]])
+    rest = np.full(2, np.sqrt(2.0))
+    xyz, _, forces, _, converged = dynamic_relaxation(vertices, [[0, 2], [1, 2]], [0, 1], loads, stiffness=[1000.0, 1000.0], rest_lengths=rest, tolerance=1e-9)
+    assert converged
+    depth = -xyz[2, 2]
+    length = np.hypot(1.0, depth)
+    assert np.allclose(xyz[2, :2], 0.0) and depth > 1.0
+    assert np.allclose(forces, 1000.0 * (length - rest) / rest)
+    assert np.isclose(2.0 * forces[0] * depth / length, 10.0)
+
+
+def test_iteration_limit_reports_no_convergence():
+    edges, fixed, vertices, loads = make_net(6)
+    _, _, _, iterations, converged = dynamic_relaxation(vertices, edges, fixed, loads, force_densities=np.ones(len(edges)), max_iterations=5)
+    assert iterations == 5 and not converged
+
+
+def test_stiffness_requires_positive_rest_lengths():
+    vertices = np.array([[0.0, 0.0, 0.0], [1.0, 0.0, 0.0]])
+    with pytest.raises(ValueError):
+        dynamic_relaxation(vertices, [[0, 1]], [0], stiffness=[100.0])
+    with pytest.raises(ValueError):
+        dynamic_relaxation(vertices, [[0, 1]], [0], stiffness=[100.0], rest_lengths=[0.0])
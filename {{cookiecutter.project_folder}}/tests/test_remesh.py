@@ -0,0 +1,33 @@
+import numpy as np
+import pytest
+from conftest import edge_counts
+from conftest import is_closed_manifold
+
+from {{cookiecutter.project_slug}}.remesh import remesh
+
+
+@pytest.mark.parametrize("level, target", [(0, 0.5), (1, 0.3), (2, 0.15), (3, 0.05)])
+def test_closed_mesh_terminates_and_stays_closed(icosphere, level, target):
+    vertices, faces = remesh(icosphere(level), target)
+    assert is_closed_manifold(faces)
+    assert len(vertices) - len(faces) // 2 == 2  # Euler characteristic of a sphere
+    lengths = np.linalg.norm(vertices[faces] - vertices[np.roll(faces, 1, axis=1)], axis=2)
+    assert lengths.max() <= 1.5 * target
+    # Projected onto the input, which lies between its inscribed sphere and the unit sphere
+    radii = np.linalg.norm(vertices, axis=1)
+    assert np.all(radii <= 1.0 + 1e-9) and np.all(radii >= 0.79)
+
+
+def test_open_grid_keeps_boundary(grid):
+    vertices, faces = grid(10)
+    out_vertices, out_faces = remesh((vertices, faces), 0.05)
+    assert np.all(edge_counts(out_faces) <= 2)
+    corners = np.array([[0, 0, 0], [1, 0, 0], [0, 1, 0], [1, 1, 0]], dtype=float)
+    for corner in corners:
+        assert np.min(np.linalg.norm(out_vertices - corner, axis=1)) < 1e-12
+    assert np.allclose(out_vertices[:, 2], 0.0)
+
+
+def test_rejects_non_positive_length(icosphere):
+    with pytest.raises(ValueError):
+        remesh(icosphere(0), 0.0)
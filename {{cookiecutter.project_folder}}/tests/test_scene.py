@@ -0,0 +1,75 @@
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.scene import SceneGraph
+
+
+def translation(x, y=0.0, z=0.0):
+    matrix = np.eye(4)
+    matrix[:3, 3] = [x, y, z]
+    return matrix
+
+
+def test_world_transforms_compose_along_the_chain():
+    graph = SceneGraph([-1, 0, 1], np.stack([translation(1.0), translation(2.0), translation(0.0, 3.0)]))
+    worlds = graph.worlds
+    assert np.allclose(worlds[:, :3, 3], [[1, 0, 0], [3, 0, 0], [3, 3, 0]])
+
+
+def test_update_only_recomputes_dirty_subtree():
+    graph = SceneGraph([-1, 0, -1], np.stack([np.eye(4)] * 3))
+    graph.update()
+    graph.set_local(0, translation(5.0))
+    assert graph.update() == 2
+    assert np.allclose(graph.worlds[1, :3, 3], [5, 0, 0])
+    assert np.allclose(graph.worlds[2], np.eye(4))
+
+
+def test_views_survive_growth():
+    graph = SceneGraph([-1], translation(1.0)[None])
+    worlds, locals = graph.worlds, graph.locals
+    for i in range(1000):
+        graph.add(i, translation(1.0))
+    # The old views keep the single node they were taken with
+    assert worlds.shape == (1, 4, 4) and locals.shape == (1, 4, 4)
+    assert np.allclose(worlds[0], translation(1.0))
+    assert np.allclose(graph.worlds[-1, :3, 3], [1001, 0, 0])
+
+
+def test_views_outlive_the_graph():
+    graph = SceneGraph([-1, 0], np.stack([translation(1.0), translation(1.0)]))
+    worlds = graph.worlds
+    del graph
+    assert np.allclose(worlds[1, :3, 3], [2, 0, 0])
+
+
+def test_rejects_cycles():
+    graph = SceneGraph([-1, 0, 1], np.stack([np.eye(4)] * 3))
+    with pytest.raises(ValueError):
+        graph.set_parent(0, 2)
+
+
+def test_set_locals_checks_every_index_first():
+    graph = SceneGraph([-1, 0, 1], np.stack([np.eye(4)] * 3))
+    with pytest.raises(IndexError):
+        graph.set_locals([0, 1, 3], np.stack([translation(1.0)] * 3))
+    assert np.allclose(graph.locals, np.eye(4))
+    assert np.allclose(graph.worlds, np.eye(4))
+
+
+def test_threads_share_a_graph():
+    graph = SceneGraph([-1], translation(1.0)[None])
+
+    def grow(_):
+        for _ in range(200):
+            index = graph.add(0, translation(0.0, 1.0))
+            graph.set_local(index, translation(0.0, 2.0))
+            graph.update()
+            assert graph.worlds.shape[0] > index
+
+    with ThreadPoolExecutor(4) as pool:
+        list(pool.map(grow, range(4)))
+    assert len(graph) == 801
+    assert np.allclose(graph.worlds[1:, :3, 3], [1.0, 2.0, 0.0])
@@ -0,0 +1,53 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.slicing import slice_mesh
+from {{cookiecutter.project_slug}}.slicing import slice_mesh_polylines
+
+
+def signed_area(polyline):
+    x, y = polyline[:-1, 0], polyline[:-1, 1]
+    return 0.5 * np.sum(x * np.roll(y, -1) - np.roll(x, -1) * y)
+
+
+@pytest.mark.parametrize("height", [-0.7, -0.2, 0.0, 0.45])
+def test_sphere_slices_are_closed_circles(icosphere, height):
+    points, offsets, planes, closed = slice_mesh(icosphere(3), [[0.0, 0.0, height]], [0.0, 0.0, 1.0])
+    assert len(offsets) == 2 and closed[0] and planes[0] == 0
+    assert np.allclose(points[0], points[-1])
+    assert np.allclose(points[:, 2], height)
+    radius = np.sqrt(1.0 - height**2)
+    assert np.all(np.linalg.norm(points[:, :2], axis=1) <= radius + 1e-12)
+    # Counterclockwise seen from the tip of the normal, enclosing almost the whole disc
+    assert signed_area(points) == pytest.approx(np.pi * radius**2, rel=0.03)
+
+
+def test_planes_that_miss_the_mesh_give_nothing(icosphere):
+    points, offsets, planes, closed = slice_mesh(icosphere(2), [[0.0, 0.0, 1.5]], [0.0, 0.0, 1.0])
+    assert len(points) == 0 and np.array_equal(offsets, [0])
+    assert len(planes) == 0 and len(closed) == 0
+
+
+def test_open_surfaces_give_open_polylines(grid):
+    points, offsets, planes, closed = slice_mesh(grid(6), [[0.3, 0.0, 0.0]], [1.0, 0.0, 0.0])
+    assert len(offsets) == 2 and not closed[0]
+    assert np.allclose(points[:, 0], 0.3)
+    assert np.isclose(np.linalg.norm(np.diff(points, axis=0), axis=1).sum(), 1.0)
+    assert np.isclose(np.ptp(points[:, 1]), 1.0)
+
+
+def test_polylines_are_grouped_by_plane(icosphere):
+    heights = np.linspace(-0.9, 0.9, 7)
+    origins = np.column_stack([np.zeros(7), np.zeros(7), heights])
+    origins = np.vstack([origins, [[0.0, 0.0, 3.0]]])
+    polylines = slice_mesh_polylines(icosphere(3), origins, [0.0, 0.0, 1.0])
+    assert [len(p) for p in polylines] == [1] * 7 + [0]
+    for height, (polyline,) in zip(heights, polylines[:7]):
+        assert np.allclose(polyline[:, 2], height)
+
+
+def test_two_spheres_give_two_loops(icosphere):
+    vertices, faces = icosphere(2)
+    mesh = (np.vstack([vertices, vertices + [3.0, 0.0, 0.0]]), np.vstack([faces, faces + len(vertices)]))
+    _, offsets, planes, closed = slice_mesh(mesh, [[0.0, 0.0, 0.1]], [0.0, 0.0, 1.0])
+    assert len(offsets) == 3 and np.all(closed) and np.all(planes == 0)
@@ -0,0 +1,122 @@
+import numpy as np
+import pytest
+from conftest import is_closed_manifold
+
+from {{cookiecutter.project_slug}}.subdivision import Subdivision
+from {{cookiecutter.project_slug}}.subdivision import subdivide
+
+CUBE_VERTICES = np.array([[x, y, z] for z in (-1.0, 1.0) for y in (-1.0, 1.0) for x in (-1.0, 1.0)])
+CUBE_FACES = [[0, 2, 3, 1], [4, 5, 7, 6], [0, 1, 5, 4], [2, 6, 7, 3], [0, 4, 6, 2], [1, 3, 7, 5]]
+
+
+def same_points(a, b):
+    """Whether two point sets are equal up to the order of their rows."""
+    return len(a) == len(b) and all(np.min(np.linalg.norm(b - p, axis=1)) < 1e-12 for p in a)
+
+
+def quad_grid(n):
+    """Flat n x n grid of unit square quads."""
+    x, y = np.meshgrid(np.arange(n + 1.0), np.arange(n + 1.0), indexing="ij")
+    vertices = np.column_stack([x.ravel(), y.ravel(), np.zeros(x.size)])
+    i, j = np.meshgrid(np.arange(n), np.arange(n), indexing="ij")
+    a = (i * (n + 1) + j).ravel()
+    return vertices, np.column_stack([a, a + n + 1, a + n + 2, a + 1])
+
+
+def loop_reference(vertices, faces):
+    """One step of Loop subdivision of a closed triangle mesh written out directly."""
+    n = np.bincount(faces.ravel())
+    neighbours = np.zeros_like(vertices)
+    opposite = {}
+    for face in faces:
+        for k in range(3):
+            a, b, c = face[k], face[(k + 1) % 3], face[(k + 2) % 3]
+            neighbours[a] += vertices[b]
+            opposite.setdefault((min(a, b), max(a, b)), []).append(c)
+    beta = (0.625 - (0.375 + 0.25 * np.cos(2.0 * np.pi / n)) ** 2) / n
+    points = (1.0 - n * beta)[:, None] * vertices + beta[:, None] * neighbours
+    edges = [0.375 * (vertices[a] + vertices[b]) + 0.125 * vertices[c].sum(axis=0) for (a, b), c in opposite.items()]
+    return np.vstack([points, edges])
+
+
+def test_catmull_clark_cube_follows_the_rules():
+    vertices, faces = subdivide((CUBE_VERTICES, CUBE_FACES))
+    assert vertices.shape == (26, 3) and faces.shape == (24, 4)
+    # Corners of valence 3 move to (F + 2R) / 3 = 5/9 of the corner
+    assert np.allclose(vertices[:8], 5.0 / 9.0 * CUBE_VERTICES)
+    face_points = np.array([[s * (axis == k) for k in range(3)] for axis in range(3) for s in (-1.0, 1.0)])
+    edge_points = np.array([p for p in np.array(np.meshgrid(*[[-0.75, 0.0, 0.75]] * 3)).reshape(3, -1).T if np.count_nonzero(p) == 2])
+    assert same_points(vertices[8:], np.vstack([face_points, edge_points]))
+
+
+def test_catmull_clark_keeps_a_closed_surface():
+    subdivision = Subdivision(CUBE_FACES, levels=3)
+    vertices = subdivision.apply(CUBE_VERTICES)
+    faces = subdivision.faces
+    assert subdivision.face_count == len(faces) == 6 * 4**3
+    assert subdivision.vertex_count == len(vertices) == len(faces) + 2  # Euler characteristic of a sphere
+    directed = np.column_stack([faces.ravel(), np.roll(faces, -1, axis=1).ravel()])
+    assert len(np.unique(directed, axis=0)) == len(directed)
+    assert len(np.unique(np.sort(directed, axis=1), axis=0)) == len(directed) // 2
+    # The surface shrinks inside the control cube to a near sphere
+    assert np.abs(vertices).max() < 1.0
+    assert np.allclose(np.linalg.norm(vertices, axis=1), 0.86, atol=0.03)
+
+
+def test_catmull_clark_refines_a_uniform_grid_uniformly():
+    vertices, faces = quad_grid(4)
+    out_vertices, out_faces = subdivide((vertices, faces), levels=2)
+    expected, _ = quad_grid(16)
+    assert same_points(out_vertices, expected / 4.0)
+    assert len(out_faces) == 16 * len(faces)
+
+
+def test_loop_matches_the_rules_on_an_icosahedron(icosphere):
+    vertices, faces = icosphere(0)
+    out_vertices, out_faces = subdivide((vertices, faces), "loop")
+    reference = loop_reference(vertices, faces)
+    assert np.allclose(out_vertices[:12], reference[:12])
+    assert same_points(out_vertices, reference)
+    assert out_faces.shape == (80, 3) and is_closed_manifold(out_faces)
+
+
+def test_loop_keeps_orientation(icosphere):
+    vertices, faces = subdivide(icosphere(1), "loop", levels=2)
+    assert len(faces) == 80 * 16 and is_closed_manifold(faces)
+    a, b, c = vertices[faces[:, 0]], vertices[faces[:, 1]], vertices[faces[:, 2]]
+    assert np.all(np.einsum("ij,ij->i", np.cross(b - a, c - a), a + b + c) > 0.0)
+
+
+def test_loop_boundary_stays_in_the_plane(grid):
+    vertices, faces = grid(4)
+    out_vertices, _ = subdivide((vertices, faces), "loop", levels=2)
+    assert np.allclose(out_vertices[:, 2], 0.0)
+    assert np.all((out_vertices[:, :2] >= -1e-12) & (out_vertices[:, :2] <= 1.0 + 1e-12))
+    # Corners with two boundary edges stay in place
+    assert np.allclose(out_vertices[0], vertices[0]) and np.allclose(out_vertices[len(vertices) - 1], vertices[-1])
+
+
+@pytest.mark.parametrize("scheme, faces", [("catmull-clark", CUBE_FACES), ("loop", None)])
+def test_stencils_are_affine(icosphere, scheme, faces):
+    if faces is None:
+        faces = icosphere(1)[1]
+    subdivision = Subdivision(faces, scheme, levels=2)
+    count = max(max(face) for face in faces) + 1
+    assert np.allclose(subdivision.apply(np.full(count, 3.0)), 3.0)
+    values = np.random.default_rng(0).normal(size=(count, 5))
+    assert np.allclose(subdivision.apply(2.0 * values + 1.0), 2.0 * subdivision.apply(values) + 1.0)
+
+
+def test_invalid_input_raises(icosphere):
+    with pytest.raises(ValueError):
+        Subdivision(CUBE_FACES, "loop")
+    with pytest.raises(ValueError):
+        Subdivision(CUBE_FACES, "doo-sabin")
+    with pytest.raises(ValueError):
+        Subdivision(CUBE_FACES, levels=0)
+    with pytest.raises(ValueError):
+        Subdivision([[0, 1, 2], [0, 1, 2]])
+    with pytest.raises(IndexError):
+        Subdivision(CUBE_FACES, vertex_count=6)
+    with pytest.raises(ValueError):
+        Subdivision(CUBE_FACES).apply(np.zeros((7, 3)))
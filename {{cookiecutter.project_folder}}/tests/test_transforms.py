@@ -0,0 +1,114 @@
+import numpy as np
+import pytest
+
+from {{cookiecutter.project_slug}}.transforms import blend_dual_quaternions
+from {{cookiecutter.project_slug}}.transforms import dual_quaternions_from_matrices
+from {{cookiecutter.project_slug}}.transforms import dual_quaternions_to_matrices
+from {{cookiecutter.project_slug}}.transforms import multiply_dual_quaternions
+from {{cookiecutter.project_slug}}.transforms import multiply_matrices
+from {{cookiecutter.project_slug}}.transforms import multiply_quaternions
+from {{cookiecutter.project_slug}}.transforms import normalize_quaternions
+from {{cookiecutter.project_slug}}.transforms import quaternions_from_matrices
+from {{cookiecutter.project_slug}}.transforms import quaternions_to_matrices
+from {{cookiecutter.project_slug}}.transforms import slerp_quaternions
+
+
+def random_quaternions(n, seed):
+    q = np.random.default_rng(seed).normal(size=(n, 4))
+    return q / np.linalg.norm(q, axis=1)[:, None]
+
+
+def random_rigid(n, seed):
+    matrices = quaternions_to_matrices(random_quaternions(n, seed))
+    matrices[:, :3, 3] = np.random.default_rng(seed + 1).normal(size=(n, 3))
+    return matrices
+
+
+def hamilton(a, b):
+    w1, x1, y1, z1 = a.T
+    w2, x2, y2, z2 = b.T
+    return np.column_stack([
+        w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2,
+        w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2,
+        w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2,
+        w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2,
+    ])
+
+
+def test_matrix_products_broadcast():
+    a = np.random.default_rng(0).normal(size=(20, 4, 4))
+    b = np.random.default_rng(1).normal(size=(20, 4, 4))
+    assert np.allclose(multiply_matrices(a, b), a @ b)
+    assert np.allclose(multiply_matrices(a[3], b), a[3] @ b)
+    assert np.allclose(multiply_matrices(a, b[5]), a @ b[5])
+
+
+def test_quaternion_products_follow_hamilton():
+    a, b = random_quaternions(50, 2), random_quaternions(50, 3)
+    assert np.allclose(multiply_quaternions(a, b), hamilton(a, b))
+    assert np.allclose(multiply_quaternions([0.0, 1.0, 0.0, 0.0], [0.0, 0.0, 1.0, 0.0]), [[0.0, 0.0, 0.0, 1.0]])
+    # Products of quaternions compose their rotations
+    assert np.allclose(quaternions_to_matrices(hamilton(a, b)), quaternions_to_matrices(a) @ quaternions_to_matrices(b))
+
+
+def test_quaternion_matrix_round_trip():
+    q = random_quaternions(100, 4)
+    matrices = quaternions_to_matrices(q)
+    assert np.allclose(matrices[:, :3, :3] @ np.swapaxes(matrices[:, :3, :3], 1, 2), np.eye(3))
+    assert np.allclose(matrices[:, 3], [0.0, 0.0, 0.0, 1.0])
+    back = quaternions_from_matrices(matrices)
+    assert np.all(back[:, 0] >= 0.0)
+    assert np.allclose(back, q * np.sign(q[:, :1]))
+
+
+def test_rotation_about_z():
+    angle = 0.7
+    matrix = quaternions_to_matrices([np.cos(angle / 2.0), 0.0, 0.0, np.sin(angle / 2.0)])[0]
+    assert np.allclose(matrix[:3, :3], [[np.cos(angle), -np.sin(angle), 0.0], [np.sin(angle), np.cos(angle), 0.0], [0.0, 0.0, 1.0]])
+
+
+def test_normalize():
+    q = np.random.default_rng(5).normal(size=(30, 4)) * 3.0
+    assert np.allclose(normalize_quaternions(q), q / np.linalg.norm(q, axis=1)[:, None])
+
+
+def test_slerp_follows_the_shorter_arc():
+    identity = np.tile([1.0, 0.0, 0.0, 0.0], (5, 1))
+    turn = np.tile([np.cos(0.6), 0.0, 0.0, np.sin(0.6)], (5, 1))  # 1.2 rad about z
+    t = np.linspace(0.0, 1.0, 5)
+    result = slerp_quaternions(identity, turn, t)
+    assert np.allclose(result, np.column_stack([np.cos(0.6 * t), np.zeros(5), np.zeros(5), np.sin(0.6 * t)]))
+    # -turn is the same rotation, interpolating towards it must not go the long way round
+    assert np.allclose(quaternions_to_matrices(slerp_quaternions(identity, -turn, t)), quaternions_to_matrices(result))
+
+
+def test_dual_quaternions_round_trip_and_compose():
+    a, b = random_rigid(40, 6), random_rigid(40, 8)
+    da, db = dual_quaternions_from_matrices(a), dual_quaternions_from_matrices(b)
+    assert np.allclose(np.linalg.norm(da[:, :4], axis=1), 1.0)
+    assert np.allclose(dual_quaternions_to_matrices(da), a)
+    assert np.allclose(dual_quaternions_to_matrices(multiply_dual_quaternions(da, db)), a @ b)
+
+
+def test_blending():
+    d = dual_quaternions_from_matrices(random_rigid(3, 10))
+    assert np.allclose(dual_quaternions_to_matrices(blend_dual_quaternions(d, np.eye(3))), dual_quaternions_to_matrices(d))
+    # Blending two turns about the same axis halfway turns by the mean angle and translates by the mean
+    turns = np.zeros((2, 4, 4))
+    for k, angle in enumerate([0.2, 1.0]):
+        turns[k] = quaternions_to_matrices([np.cos(angle / 2.0), 0.0, 0.0, np.sin(angle / 2.0)])[0]
+    turns[:, 2, 3] = [1.0, 3.0]
+    blended = dual_quaternions_to_matrices(blend_dual_quaternions(dual_quaternions_from_matrices(turns), [[0.5, 0.5]]))[0]
+    assert np.allclose(blended[:3, :3], quaternions_to_matrices([np.cos(0.3), 0.0, 0.0, np.sin(0.3)])[0][:3, :3])
+    assert np.allclose(blended[:3, 3], [0.0, 0.0, 2.0])
+
+
+def test_invalid_shapes_raise():
+    with pytest.raises(ValueError):
+        multiply_quaternions(np.zeros((3, 3)), np.zeros((3, 3)))
+    with pytest.raises(ValueError):
+        multiply_quaternions(np.zeros((3, 4)), np.zeros((2, 4)))
+    with pytest.raises(ValueError):
+        multiply_matrices(np.zeros((2, 3, 3)), np.eye(4))
+    with pytest.raises(ValueError):
+        blend_dual_quaternions(np.zeros((0, 8)), np.zeros((1, 0)))